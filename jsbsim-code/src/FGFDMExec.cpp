@@ -48,6 +48,8 @@ INCLUDES
 #include <iomanip>
 
 #include "FGFDMExec.h"
+#include "FGProfiler.h"
+#include "input_output/FGPropertyProfiler.h"
 #include "models/atmosphere/FGStandardAtmosphere.h"
 #include "models/atmosphere/FGWinds.h"
 #include "models/FGFCS.h"
@@ -67,6 +69,8 @@ INCLUDES
 #include "initialization/FGTrim.h"
 #include "input_output/FGScript.h"
 #include "input_output/FGXMLFileRead.h"
+#include "input_output/FGStateArchive.h"
+#include "math/FGFunction.h"
 
 using namespace std;
 
@@ -75,10 +79,17 @@ namespace JSBSim {
 IDENT(IdSrc,"$Id: FGFDMExec.cpp,v 1.194 2017/03/03 23:00:39 bcoconni Exp $");
 IDENT(IdHdr,ID_FDMEXEC);
 
+// Header of the arrays filled by SaveState(). The version must be incremented
+// each time the content of the state is modified.
+static const double StateMagic = 1246970451.0; // "JSBS"
+static const double StateVersion = 1.0;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+bool FGFDMExec::property_arena_enabled = true;
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 // Constructor
 
@@ -89,7 +100,11 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root, unsigned int* fdmctr) : Root(root)
   IC              = 0;
   Trim            = 0;
   Script          = 0;
+  Propagate       = 0;
   disperse        = 0;
+  StateNodesCollected = false;
+  StateSize       = 0;
+  XMLCache = std::make_shared<FGXMLDocumentCache>();
 
   RootDir = "";
 
@@ -101,6 +116,7 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root, unsigned int* fdmctr) : Root(root)
   ResetMode = 0;
   RandomSeed = 0;
   HoldDown = false;
+  messageId = 0;
 
   IncrementThenHolding = false;  // increment then hold is off by default
   TimeStepsUntilHold = -1;
@@ -123,6 +139,10 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root, unsigned int* fdmctr) : Root(root)
   if (Root == 0) {                 // Then this is the root FDM
     Root = new FGPropertyManager;  // Create the property manager
     StandAlone = true;
+    if (property_arena_enabled) {
+      PropertyArena = new SGPropertyNodeArena;
+      Root->GetNode()->setArena(PropertyArena);
+    }
   }
 
   if (FDMctr == 0) {
@@ -149,6 +169,36 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root, unsigned int* fdmctr) : Root(root)
     std::cerr << "Could not process JSBSIM_DISPERSIONS environment variable: Assumed NO dispersions." << endl;
   }
 
+  // The sections of the models are registered first so that their indices
+  // match the eModels enum.
+  static const char* ModelSections[eNumStandardModels] = {
+    "propagate", "input", "inertial", "atmosphere", "winds", "systems",
+    "massbalance", "auxiliary", "propulsion", "aerodynamics",
+    "groundreactions", "externalreactions", "buoyantforces", "aircraft",
+    "accelerations", "output"
+  };
+
+  Profiler = new FGProfiler(instance);
+  for (unsigned int i=0; i<eNumStandardModels; i++)
+    Profiler->AddSection(ModelSections[i]);
+
+  PrintProfile = false;
+  char* profile = getenv("JSBSIM_PROFILE");
+  if (profile && atoi(profile) != 0) {
+    Profiler->SetEnabled(true);
+    PrintProfile = true;
+  }
+
+  // Profiling the properties before the models are created lets it count the
+  // reads of the values which would otherwise be read from their storage.
+  PropertyProfiler = new FGPropertyProfiler(instance);
+  PrintPropertyProfile = false;
+  profile = getenv("JSBSIM_PROPERTY_PROFILE");
+  if (profile && atoi(profile) != 0) {
+    PropertyProfiler->SetEnabled(true);
+    PrintPropertyProfile = true;
+  }
+
   Debug(0);
   // this is to catch errors in binding member functions to the property tree.
   try {
@@ -170,8 +220,8 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root, unsigned int* fdmctr) : Root(root)
   instance->Tie("simulation/randomseed", this, (iPMF)&FGFDMExec::SRand, &FGFDMExec::SRand, false);
   instance->Tie("simulation/terminate", (int *)&Terminate);
   instance->Tie("simulation/pause", (int *)&holding);
-  instance->Tie("simulation/sim-time-sec", this, &FGFDMExec::GetSimTime);
-  instance->Tie("simulation/dt", this, &FGFDMExec::GetDeltaT);
+  instance->Tie("simulation/sim-time-sec", this, &FGFDMExec::sim_time);
+  instance->Tie("simulation/dt", this, &FGFDMExec::dT);
   instance->Tie("simulation/jsbsim-debug", this, &FGFDMExec::GetDebugLevel, &FGFDMExec::SetDebugLevel);
   instance->Tie("simulation/frame", (int *)&Frame, false);
   instance->Tie("simulation/trim-completed", (int *)&trim_completed, false);
@@ -184,9 +234,14 @@ FGFDMExec::FGFDMExec(FGPropertyManager* root, unsigned int* fdmctr) : Root(root)
 
 FGFDMExec::~FGFDMExec()
 {
+  if (PrintProfile) Profiler->Print(cout);
+  if (PrintPropertyProfile) PropertyProfiler->Print(cout);
+
   try {
     Unbind();
     DeAllocate();
+    delete Profiler;
+    delete PropertyProfiler;
 
     delete instance;
 
@@ -209,8 +264,6 @@ FGFDMExec::~FGFDMExec()
   ChildFDMList.clear();
 
   PropertyCatalog.clear();
-  
-  SetGroundCallback(0);
 
   if (FDMctr != 0) (*FDMctr)--;
 
@@ -300,6 +353,20 @@ bool FGFDMExec::DeAllocate(void)
   delete IC;
   delete Trim;
 
+  Propagate = 0;
+  IC = 0;
+
+  // The streams are numbered in the order of their creation, so the numbering
+  // restarts with the models.
+  RandomStreams.clear();
+
+  StateNodes.clear();
+  StateNodesCollected = false;
+  StateSize = 0;
+
+  Profiler->ResetStatistics();
+  PropertyProfiler->ResetStatistics();
+
   Error       = 0;
 
   modelLoaded = false;
@@ -325,10 +392,15 @@ bool FGFDMExec::Run(void)
   if (Script != 0 && !IntegrationSuspended()) success = Script->RunScript();
 
   for (unsigned int i = 0; i < Models.size(); i++) {
+    FGProfiler::Timer timer(Profiler, i);
     LoadInputs(i);
     Models[i]->Run(holding);
   }
 
+  // The models have now copied the location of the vehicle along with the
+  // current ground callback.
+  RetiredGroundCallbacks.clear();
+
   if (ResetMode) {
     unsigned int mode = ResetMode;
 
@@ -553,6 +625,10 @@ bool FGFDMExec::RunIC(void)
 {
   FGPropulsion* propulsion = (FGPropulsion*)Models[ePropulsion];
 
+  // The functions loaded after the model (by a script for instance) are
+  // compiled before they are evaluated.
+  CompileFunctions();
+
   SuspendIntegration(); // saves the integration rate, dt, then sets it to 0.0.
   Initialize(IC);
 
@@ -563,7 +639,17 @@ bool FGFDMExec::RunIC(void)
   Propagate->InitializeDerivatives();
   ResumeIntegration(); // Restores the integration rate to what it was.
 
+  vector<string> undefined = instance->ResolveLateBoundValues();
+
   if (debug_lvl > 0) {
+    if (!undefined.empty()) {
+      cerr << endl << fgred << highint
+           << "  The following properties are still undefined after the"
+           << " initialization:" << reset << endl;
+      for (unsigned int i=0; i < undefined.size(); ++i)
+        cerr << "    " << undefined[i] << endl;
+    }
+
     MassBalance->GetMassPropertiesReport(0);
 
     cout << endl << fgblue << highint
@@ -588,6 +674,119 @@ bool FGFDMExec::RunIC(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+bool FGFDMExec::SaveState(vector<double>& state)
+{
+  FGStateArchive ar(state);
+  double magic = StateMagic;
+  double version = StateVersion;
+  double size = 0.0;
+
+  ar & magic & version & size;
+  SerializeState(ar);
+
+  if (!ar.Close()) return false;
+
+  StateSize = state.size();
+  state[2] = StateSize;
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGFDMExec::RestoreState(const vector<double>& state)
+{
+  // The size of the states of this model is computed once for all by saving
+  // the current state.
+  if (StateSize == 0) {
+    vector<double> current;
+    if (!SaveState(current)) return false;
+  }
+
+  // The header is checked first so that an inconsistent state is not
+  // partially restored.
+  if (state.size() != StateSize || state[0] != StateMagic
+      || state[1] != StateVersion || state[2] != StateSize) {
+    cerr << "The state does not match the model " << modelName << endl;
+    return false;
+  }
+
+  FGStateArchive ar(state);
+  double magic, version, size;
+
+  ar & magic & version & size;
+  SerializeState(ar);
+
+  if (!ar.Close()) {
+    cerr << "The state does not match the model " << modelName << endl;
+    return false;
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::SerializeState(FGStateArchive& ar)
+{
+  ar & sim_time & dT & Frame;
+
+  for (unsigned int i=0; i<RandomStreams.size(); i++)
+    RandomStreams[i]->SerializeState(ar);
+
+  // The inputs of the models are stored with their outputs since some of them
+  // are read through the properties before they are updated by LoadInputs().
+  for (unsigned int i=0; i<Models.size(); i++)
+    Models[i]->SerializeState(ar);
+
+  if (Script) Script->SerializeState(ar);
+
+  for (unsigned int i=0; i<ChildFDMList.size(); i++)
+    ChildFDMList[i]->exec->SerializeState(ar);
+
+  // The values of the properties which are tied to a member of a model have
+  // already been processed. The other ones (local properties, outputs of the
+  // FCS components, etc.) are listed once for all.
+  if (!StateNodesCollected) {
+    CollectStateNodes(instance->GetNode());
+    StateNodesCollected = true;
+  }
+
+  for (unsigned int i=0; i<StateNodes.size(); i++) {
+    double value = StateNodes[i]->getDoubleValue();
+    ar & value;
+    if (!ar.IsSaving()) StateNodes[i]->setDoubleValue(value);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::CollectStateNodes(FGPropertyNode* node)
+{
+  int nChildren = node->nChildren();
+
+  if (nChildren == 0) {
+    if (node->isTied()) return;
+
+    switch (node->getType()) {
+    case simgear::props::BOOL:
+    case simgear::props::INT:
+    case simgear::props::LONG:
+    case simgear::props::FLOAT:
+    case simgear::props::DOUBLE:
+      StateNodes.push_back(node);
+      break;
+    default:
+      break;
+    }
+    return;
+  }
+
+  for (int i=0; i<nChildren; i++)
+    CollectStateNodes(static_cast<FGPropertyNode*>(node->getChild(i)));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGFDMExec::Initialize(FGInitialCondition* FGIC)
 {
   Propagate->SetInitialState(FGIC);
@@ -634,6 +833,132 @@ void FGFDMExec::SetHoldDown(bool hd)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGFDMExec::SetGroundCallback(FGGroundCallback* gc)
+{
+  // The locations cached by the models keep pointing to the previous callback
+  // until the next call to Run() copies the vehicle location again.
+  if (GroundCallback.valid() && GroundCallback != gc)
+    RetiredGroundCallbacks.push_back(GroundCallback);
+
+  GroundCallback = gc;
+
+  // The vehicle and the initial conditions locations must query the terrain
+  // of this instance only.
+  if (Propagate) Propagate->SetGroundCallback(gc);
+  if (IC) IC->SetGroundCallback(gc);
+
+  // The child FDMs fly over the terrain of their parent.
+  for (unsigned int i=0; i<ChildFDMList.size(); i++)
+    ChildFDMList[i]->exec->SetGroundCallback(gc);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::PutMessage(const Message& msg)
+{
+  Messages.push(msg);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::PutMessage(const string& text)
+{
+  Message msg;
+  msg.text = text;
+  msg.fdmId = IdFDM;
+  msg.messageId = messageId++;
+  msg.subsystem = "FDM";
+  msg.type = Message::eText;
+  Messages.push(msg);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::PutMessage(const string& text, bool bVal)
+{
+  Message msg;
+  msg.text = text;
+  msg.fdmId = IdFDM;
+  msg.messageId = messageId++;
+  msg.subsystem = "FDM";
+  msg.type = Message::eBool;
+  msg.bVal = bVal;
+  Messages.push(msg);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::PutMessage(const string& text, int iVal)
+{
+  Message msg;
+  msg.text = text;
+  msg.fdmId = IdFDM;
+  msg.messageId = messageId++;
+  msg.subsystem = "FDM";
+  msg.type = Message::eInteger;
+  msg.iVal = iVal;
+  Messages.push(msg);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::PutMessage(const string& text, double dVal)
+{
+  Message msg;
+  msg.text = text;
+  msg.fdmId = IdFDM;
+  msg.messageId = messageId++;
+  msg.subsystem = "FDM";
+  msg.type = Message::eDouble;
+  msg.dVal = dVal;
+  Messages.push(msg);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::ProcessMessage(void)
+{
+  if (Messages.empty()) return;
+  localMsg = Messages.front();
+
+  while (SomeMessages()) {
+      switch (localMsg.type) {
+      case JSBSim::FGJSBBase::Message::eText:
+        cout << localMsg.messageId << ": " << localMsg.text << endl;
+        break;
+      case JSBSim::FGJSBBase::Message::eBool:
+        cout << localMsg.messageId << ": " << localMsg.text << " " << localMsg.bVal << endl;
+        break;
+      case JSBSim::FGJSBBase::Message::eInteger:
+        cout << localMsg.messageId << ": " << localMsg.text << " " << localMsg.iVal << endl;
+        break;
+      case JSBSim::FGJSBBase::Message::eDouble:
+        cout << localMsg.messageId << ": " << localMsg.text << " " << localMsg.dVal << endl;
+        break;
+      default:
+        cerr << "Unrecognized message type." << endl;
+        break;
+      }
+      Messages.pop();
+      if (SomeMessages()) localMsg = Messages.front();
+      else break;
+  }
+
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGJSBBase::Message* FGFDMExec::ProcessNextMessage(void)
+{
+  if (Messages.empty()) return NULL;
+  localMsg = Messages.front();
+
+  Messages.pop();
+  return &localMsg;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 vector <string> FGFDMExec::EnumerateFDMs(void)
 {
   vector <string> FDMList;
@@ -677,6 +1002,55 @@ bool FGFDMExec::LoadModel(const SGPath& AircraftPath, const SGPath& EnginePath,
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 bool FGFDMExec::LoadModel(const string& model, bool addModelToPath)
+{
+  // The documents cached by a previous load are discarded so that the files
+  // are read again. A child FDM shares the documents of its parent.
+  if (!IsChild) XMLCache = std::make_shared<FGXMLDocumentCache>();
+
+  return ReadModel(model, addModelToPath);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGFDMExec* FGFDMExec::Clone(void)
+{
+  if (!modelLoaded) {
+    cerr << "Error: attempted to clone an executive with no aircraft loaded"
+         << endl;
+    return 0L;
+  }
+
+  FGFDMExec* clone = new FGFDMExec();
+
+  clone->RootDir = RootDir;
+  clone->AircraftPath = AircraftPath;
+  clone->EnginePath = EnginePath;
+  clone->SystemsPath = SystemsPath;
+  clone->XMLCache = XMLCache;
+
+  // The default ground callback holds the terrain elevation so each instance
+  // needs its own copy.
+  FGDefaultGroundCallback* gc = dynamic_cast<FGDefaultGroundCallback*>(GroundCallback.ptr());
+  if (gc)
+    clone->SetGroundCallback(new FGDefaultGroundCallback(*gc));
+  else
+    clone->SetGroundCallback(GroundCallback.ptr());
+
+  if (!clone->ReadModel(modelName, FullAircraftPath != AircraftPath)) {
+    delete clone;
+    return 0L;
+  }
+
+  clone->Setdt(dT);
+  clone->SRand(RandomSeed);
+  clone->IC->CopyFrom(*IC);
+
+  return clone;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGFDMExec::ReadModel(const string& model, bool addModelToPath)
 {
   SGPath aircraftCfgFileName;
   bool result = false; // initialize result to false, indicating input file not yet read
@@ -699,8 +1073,7 @@ bool FGFDMExec::LoadModel(const string& model, bool addModelToPath)
   }
 
   int saved_debug_lvl = debug_lvl;
-  FGXMLFileRead XMLFileRead;
-  Element *document = XMLFileRead.LoadXMLDocument(aircraftCfgFileName); // "document" is a class member
+  Element *document = XMLCache->LoadXMLDocument(aircraftCfgFileName);
 
   if (document) {
     if (IsChild) debug_lvl = 0;
@@ -883,6 +1256,13 @@ bool FGFDMExec::LoadModel(const string& model, bool addModelToPath)
   for (unsigned int i=0; i< Models.size(); i++) LoadInputs(i);
 
   if (result) {
+    // Most of the properties that were referenced before being defined are
+    // now available: their values are bound to their node once for all.
+    instance->ResolveLateBoundValues();
+
+    // The functions are compiled once their properties are bound.
+    CompileFunctions();
+
     struct PropertyCatalogStructure masterPCS;
     masterPCS.base_string = "";
     masterPCS.node = Root->GetNode();
@@ -1062,6 +1442,7 @@ bool FGFDMExec::ReadChild(Element* el)
 
   child->exec = new FGFDMExec(Root, FDMctr);
   child->exec->SetChild(true);
+  child->exec->SetGroundCallback(GroundCallback);
 
   string childAircraft = el->GetAttributeValue("name");
   string sMated = el->GetAttributeValue("mated");
@@ -1072,6 +1453,7 @@ bool FGFDMExec::ReadChild(Element* el)
   child->exec->SetAircraftPath( AircraftPath );
   child->exec->SetEnginePath( EnginePath );
   child->exec->SetSystemsPath( SystemsPath );
+  child->exec->XMLCache = XMLCache;
   child->exec->LoadModel(childAircraft);
 
   Element* location = el->FindElement("location");
@@ -1112,6 +1494,37 @@ FGTrim* FGFDMExec::GetTrim(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+FGRandom* FGFDMExec::GetRandomStream(void)
+{
+  // The FDM ID is included in the stream number so that a child FDM does not
+  // replicate the random sequences of its parent.
+  unsigned int stream = (IdFDM << 16) + RandomStreams.size();
+  FGRandom* rng = new FGRandom(RandomSeed, stream);
+
+  RandomStreams.push_back(rng);
+
+  // A stream requested after the state has been sized (e.g. by a simplex
+  // trim) changes the size of the state.
+  StateSize = 0;
+
+  return rng;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExec::CompileFunctions(void)
+{
+  // The functions unregister themselves when they are compiled so the set is
+  // copied before it is iterated.
+  set<const FGFunction*> functions = UncompiledFunctions;
+  set<const FGFunction*>::iterator it;
+
+  for (it = functions.begin(); it != functions.end(); ++it)
+    (*it)->Compile();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGFDMExec::CheckIncrementalHold(void)
 {
   // Only check if increment then hold is on
@@ -1158,8 +1571,13 @@ void FGFDMExec::DoTrim(int mode)
 void FGFDMExec::SRand(int sr)
 {
   RandomSeed = sr;
-  gaussian_random_number_phase = 0;
-  srand(RandomSeed);
+
+  for (unsigned int i=0; i<RandomStreams.size(); i++)
+    RandomStreams[i]->Seed(RandomSeed);
+
+  // Also restart the random numbers used by the dispersions of the next
+  // model loaded from this thread.
+  GetThreadRandomStream().Seed(RandomSeed);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -41,6 +41,9 @@ SENTRY
 INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+#include <memory>
+#include <queue>
+#include <set>
 #include <vector>
 #include <string>
 
@@ -48,6 +51,7 @@ INCLUDES
 #include "input_output/FGPropertyManager.h"
 #include "models/FGPropagate.h"
 #include "math/FGColumnVector3.h"
+#include "math/FGRandom.h"
 #include "models/FGOutput.h"
 #include "simgear/misc/sg_path.hxx"
 
@@ -65,6 +69,7 @@ namespace JSBSim {
 
 class FGScript;
 class FGTrim;
+class FGFunction;
 class FGAerodynamics;
 class FGAircraft;
 class FGAtmosphere;
@@ -80,6 +85,10 @@ class FGInput;
 class FGPropulsion;
 class FGMassBalance;
 class FGTrim;
+class FGStateArchive;
+class FGXMLDocumentCache;
+class FGProfiler;
+class FGPropertyProfiler;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -261,14 +270,43 @@ public:
       @return true if successful */
   bool RunIC(void);
 
+  /** Saves the state of the simulation in an array of doubles.
+      The state contains the simulation time, the integrators and the past
+      values of all the models, the position of the random number streams and
+      the value of the properties that are not tied to a model member. Once
+      restored by RestoreState(), the simulation continues exactly as if it
+      had not been interrupted, which is much faster than running the initial
+      conditions again (and trimming the aircraft) to start a new run.
+      The array is resized the first time a state is saved in it: further
+      calls do not allocate any memory.
+      @param state the array in which the state is saved.
+      @return true if successful. */
+  bool SaveState(std::vector<double>& state);
+
+  /** Restores a state saved by SaveState().
+      The state must have been saved by this instance or by an instance that
+      has loaded the same model (aircraft, systems and script). The properties
+      created after the first call to SaveState() or RestoreState() are not
+      part of the state.
+      @param state the array that contains the state.
+      @return false if the size or the header of the state do not match the
+              model, in which case the simulation is left untouched. */
+  bool RestoreState(const std::vector<double>& state);
+
   /** Sets the ground callback pointer. For optimal memory management, a shared
       pointer is used internally that maintains a reference counter. The calling
       application must therefore use FGGroundCallback_ptr 'smart pointers' to
       manage their copy of the ground callback.
+      Each FGFDMExec instance owns its ground callback so that several instances
+      with different terrains can be run concurrently from separate threads.
+      The ground callback is passed down to the locations of the vehicle and
+      of the initial conditions which do not own it. The previous ground
+      callback is kept alive until the next call to Run() since the models
+      keep a copy of the vehicle location until then.
       @param gc A pointer to a ground callback object
       @see FGGroundCallback
    */
-  void SetGroundCallback(FGGroundCallback* gc) { FGLocation::SetGroundCallback(gc); }
+  void SetGroundCallback(FGGroundCallback* gc);
 
   /** Loads an aircraft model.
       @param AircraftPath path to the aircraft/ directory. For instance:
@@ -301,6 +339,44 @@ public:
       @return true if successful*/
   bool LoadModel(const std::string& model, bool addModelToPath = true);
 
+  /** Creates a new instance of the model loaded by this instance.
+      The XML documents of the aircraft, engines and systems are not read
+      again: they are shared with this instance, and so are the data of the
+      tables. The clone has its own property tree and its own state, it is
+      initialized with a copy of the initial conditions of this instance and
+      of its random seed so that it can fly once RunIC() has been called.
+      The values of the properties that have been modified by the user, the
+      script and the output directives are not copied. If this instance uses
+      a custom ground callback, it is shared by the clone. Clone() must not be
+      called concurrently from several threads for the same instance nor for
+      instances cloned from one another, and these instances must not be
+      deleted concurrently either since they share the reference count of the
+      ground callback.
+      @return a pointer to the new instance that must be deleted by the
+              caller or 0L if the clone could not be built. */
+  FGFDMExec* Clone(void);
+
+  /** Returns the cache of the XML documents read by this instance. It is
+      shared with the instances cloned from this one. */
+  FGXMLDocumentCache* GetXMLCache(void) {return XMLCache.get();}
+
+  /** Returns the profiler that measures the time spent in each model, system
+      channel and output during a frame. The sections of the models have the
+      same indices than the eModels enum. */
+  FGProfiler* GetProfiler(void) {return Profiler;}
+
+  /** Returns the profiler that counts the reads, writes and lookups of each
+      property of this instance. */
+  FGPropertyProfiler* GetPropertyProfiler(void) {return PropertyProfiler;}
+
+  /** Enables or disables the allocation of the property nodes from an arena.
+      When enabled (the default), the instances that create their own
+      property tree allocate its nodes from an arena: the tree is built from a
+      few large blocks and its nodes are all released at once. This only
+      affects the instances created afterwards.
+      @see SGPropertyNodeArena */
+  static void SetPropertyArena(bool enable) { property_arena_enabled = enable; }
+
   /** Loads a script
       @param Script The full path name and file name for the script to be loaded.
       @param deltaT The simulation integration step size, if given.  If no value is supplied
@@ -378,13 +454,31 @@ public:
       @return A pointer to the current ground callback object.
       @see FGGroundCallback
    */
-  FGGroundCallback* GetGroundCallback(void) {return FGLocation::GetGroundCallback();}
+  FGGroundCallback* GetGroundCallback(void) {return GroundCallback;}
   /// Retrieves the script object
   FGScript* GetScript(void) {return Script;}
   /// Returns a pointer to the FGInitialCondition object
   FGInitialCondition* GetIC(void)      {return IC;}
   /// Returns a pointer to the FGTrim object
   FGTrim* GetTrim(void);
+  /** Creates a new random number stream. Each component that needs random
+      numbers should request its own stream when it is loaded: the streams are
+      numbered in the order of their creation and are all seeded from the
+      property simulation/randomseed. Setting that property restarts all the
+      streams of this FDM so that a run can be replayed bit for bit. A stream
+      created after SaveState() has been called extends the state, so the
+      states saved before can no longer be restored.
+      @return a pointer to the new stream. */
+  FGRandom* GetRandomStream(void);
+
+  /** Registers a function to be compiled once the model is loaded (see
+      FGFunction::Compile).
+      @param f the function to compile. */
+  void AddUncompiledFunction(const FGFunction* f) { UncompiledFunctions.insert(f); }
+
+  /** Unregisters a function which has been compiled or destroyed.
+      @param f the function to unregister. */
+  void RemoveUncompiledFunction(const FGFunction* f) { UncompiledFunctions.erase(f); }
   ///@}
 
   /// Retrieves the engine path.
@@ -599,6 +693,44 @@ public:
   */
   bool GetHoldDown(void) const {return HoldDown;}
 
+  ///@name JSBSim Messaging functions
+  /// Each instance has its own queue so that instances can run concurrently.
+  //@{
+  /** Places a Message structure on the Message queue.
+      @param msg pointer to a Message structure
+      @return pointer to a Message structure */
+  void PutMessage(const Message& msg);
+  /** Creates a message with the given text and places it on the queue.
+      @param text message text
+      @return pointer to a Message structure */
+  void PutMessage(const std::string& text);
+  /** Creates a message with the given text and boolean value and places it on the queue.
+      @param text message text
+      @param bVal boolean value associated with the message
+      @return pointer to a Message structure */
+  void PutMessage(const std::string& text, bool bVal);
+  /** Creates a message with the given text and integer value and places it on the queue.
+      @param text message text
+      @param iVal integer value associated with the message
+      @return pointer to a Message structure */
+  void PutMessage(const std::string& text, int iVal);
+  /** Creates a message with the given text and double value and places it on the queue.
+      @param text message text
+      @param dVal double value associated with the message
+      @return pointer to a Message structure */
+  void PutMessage(const std::string& text, double dVal);
+  /** Reads the message on the queue (but does not delete it).
+      @return 1 if some messages */
+  int SomeMessages(void) { return !Messages.empty(); }
+  /** Reads the message on the queue and removes it from the queue.
+      This function also prints out the message.*/
+  void ProcessMessage(void);
+  /** Reads the next message on the queue and removes it from the queue.
+      This function also prints out the message.
+      @return a pointer to the message, or NULL if there are no messages.*/
+  Message* ProcessNextMessage(void);
+  //@}
+
 private:
   int Error;
   unsigned int Frame;
@@ -649,6 +781,23 @@ private:
   FGScript*           Script;
   FGInitialCondition* IC;
   FGTrim*             Trim;
+  FGProfiler*         Profiler;
+  bool                PrintProfile;
+  FGPropertyProfiler* PropertyProfiler;
+  bool                PrintPropertyProfile;
+  SGPropertyNodeArena_ptr PropertyArena;
+
+  static bool property_arena_enabled;
+
+  FGGroundCallback_ptr GroundCallback;
+  std::vector<FGGroundCallback_ptr> RetiredGroundCallbacks;
+  std::shared_ptr<FGXMLDocumentCache> XMLCache;
+  std::vector<FGRandom_ptr> RandomStreams;
+  std::set<const FGFunction*> UncompiledFunctions;
+
+  std::vector<FGPropertyNode_ptr> StateNodes;
+  bool StateNodesCollected;
+  size_t StateSize;
 
   FGPropertyManager* Root;
   bool StandAlone;
@@ -656,6 +805,10 @@ private:
 
   bool HoldDown;
 
+  std::queue <Message> Messages;
+  Message localMsg;
+  unsigned int messageId;
+
   // The FDM counter is used to give each child FDM an unique ID. The root FDM has the ID 0
   unsigned int*      FDMctr;
 
@@ -665,10 +818,14 @@ private:
 
   bool ReadFileHeader(Element*);
   bool ReadChild(Element*);
+  bool ReadModel(const std::string& model, bool addModelToPath);
   bool ReadPrologue(Element*);
   void SRand(int sr);
   int  SRand(void) const {return RandomSeed;}
   void LoadInputs(unsigned int idx);
+  void SerializeState(FGStateArchive& ar);
+  void CollectStateNodes(FGPropertyNode* node);
+  void CompileFunctions(void);
   void LoadPlanetConstants(void);
   void LoadModelConstants(void);
   bool Allocate(void);
@@ -0,0 +1,329 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGFDMExecPool.cpp
+ Date started: 10/17/26
+ Purpose:      Steps a pool of FGFDMExec instances from a set of threads
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+Each thread owns a queue of instances to step. A thread takes its tasks from the
+front of its own queue and, once it is empty, steals tasks from the back of the
+queues of the other threads.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <exception>
+#include <iostream>
+#include <sstream>
+
+#include "FGFDMExecPool.h"
+#include "FGFDMExec.h"
+#include "input_output/FGPropertyManager.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_FDMEXECPOOL);
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGFDMExecPool::FGFDMExecPool(unsigned int nFDMs, unsigned int nThreads)
+  : nInputs(0), nOutputs(0), Generation(0), StepsPerTask(0), Pending(0),
+    Quit(false)
+{
+  for (unsigned int i=0; i<nFDMs; i++)
+    FDMs.push_back(new FGFDMExec());
+
+  Status.resize(nFDMs, 1);
+  Errors.resize(nFDMs);
+
+  if (nThreads == 0) nThreads = thread::hardware_concurrency();
+  if (nThreads > nFDMs) nThreads = nFDMs;
+  if (nThreads == 0) nThreads = 1;
+
+  for (unsigned int i=0; i<nThreads; i++)
+    Queues.push_back(new WorkQueue);
+
+  // The queue #0 belongs to the thread that calls StepAll().
+  for (unsigned int i=1; i<nThreads; i++)
+    Workers.push_back(thread(&FGFDMExecPool::WorkerLoop, this, i));
+
+  Debug(0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGFDMExecPool::~FGFDMExecPool()
+{
+  {
+    lock_guard<mutex> lock(PoolMutex);
+    Quit = true;
+  }
+  StartCond.notify_all();
+
+  for (unsigned int i=0; i<Workers.size(); i++)
+    Workers[i].join();
+
+  for (unsigned int i=0; i<Queues.size(); i++)
+    delete Queues[i];
+
+  for (unsigned int i=0; i<FDMs.size(); i++)
+    delete FDMs[i];
+
+  Debug(1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExecPool::SetInputProperties(const vector<string>& names)
+{
+  nInputs = names.size();
+  InputNodes.clear();
+
+  for (unsigned int i=0; i<FDMs.size(); i++) {
+    FGPropertyManager* PropertyManager = FDMs[i]->GetPropertyManager();
+    for (unsigned int j=0; j<nInputs; j++)
+      InputNodes.push_back(PropertyManager->GetNode(names[j], true));
+  }
+
+  // Initialize the buffer with the current values so that the inputs which
+  // are not modified by the user keep their value.
+  Inputs.resize(FDMs.size()*nInputs);
+  for (unsigned int i=0; i<InputNodes.size(); i++)
+    Inputs[i] = InputNodes[i]->getDoubleValue();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExecPool::SetOutputProperties(const vector<string>& names)
+{
+  nOutputs = names.size();
+  OutputNodes.clear();
+
+  for (unsigned int i=0; i<FDMs.size(); i++) {
+    FGPropertyManager* PropertyManager = FDMs[i]->GetPropertyManager();
+    for (unsigned int j=0; j<nOutputs; j++) {
+      FGPropertyNode* node = PropertyManager->GetNode(names[j]);
+      if (!node) {
+        nOutputs = 0;
+        OutputNodes.clear();
+        Outputs.clear();
+        throw("Could not find the property " + names[j]);
+      }
+      OutputNodes.push_back(node);
+    }
+  }
+
+  Outputs.resize(FDMs.size()*nOutputs);
+  for (unsigned int i=0; i<OutputNodes.size(); i++)
+    Outputs[i] = OutputNodes[i]->getDoubleValue();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGFDMExecPool::StepAll(unsigned int nSteps)
+{
+  StepsPerTask = nSteps;
+  Pending = FDMs.size();
+
+  for (unsigned int i=0; i<FDMs.size(); i++) {
+    WorkQueue* queue = Queues[i % Queues.size()];
+    lock_guard<mutex> lock(queue->Mutex);
+    queue->Tasks.push_back(i);
+  }
+
+  {
+    lock_guard<mutex> lock(PoolMutex);
+    Generation++;
+  }
+  StartCond.notify_all();
+
+  ProcessTasks(0);
+
+  {
+    unique_lock<mutex> lock(PoolMutex);
+    while (Pending != 0) DoneCond.wait(lock);
+  }
+
+  bool result = true;
+  for (unsigned int i=0; i<Status.size(); i++)
+    if (!Status[i]) result = false;
+
+  for (unsigned int i=0; i<Errors.size(); i++) {
+    if (!Errors[i].empty()) {
+      ostringstream buf;
+      buf << "FDM #" << i << ": " << Errors[i];
+      throw(buf.str());
+    }
+  }
+
+  return result;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExecPool::WorkerLoop(unsigned int id)
+{
+  unsigned int generation = 0;
+
+  while (true) {
+    {
+      unique_lock<mutex> lock(PoolMutex);
+      while (!Quit && generation == Generation) StartCond.wait(lock);
+      if (Quit) return;
+      generation = Generation;
+    }
+
+    ProcessTasks(id);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExecPool::ProcessTasks(unsigned int id)
+{
+  unsigned int task;
+
+  while (NextTask(id, task)) {
+    RunTask(task);
+
+    if (--Pending == 0) {
+      // The lock guarantees that StepAll() is either not yet waiting or
+      // already waiting for the notification: it cannot be missed.
+      lock_guard<mutex> lock(PoolMutex);
+      DoneCond.notify_all();
+    }
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGFDMExecPool::NextTask(unsigned int id, unsigned int& task)
+{
+  unsigned int nQueues = Queues.size();
+
+  // Own queue first, then steal from the others starting with the neighbour.
+  for (unsigned int i=0; i<nQueues; i++) {
+    WorkQueue* queue = Queues[(id + i) % nQueues];
+    lock_guard<mutex> lock(queue->Mutex);
+
+    if (queue->Tasks.empty()) continue;
+
+    if (i == 0) {
+      task = queue->Tasks.front();
+      queue->Tasks.pop_front();
+    } else {
+      task = queue->Tasks.back();
+      queue->Tasks.pop_back();
+    }
+    return true;
+  }
+
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFDMExecPool::RunTask(unsigned int idx)
+{
+  FGFDMExec* fdm = FDMs[idx];
+  bool success = true;
+
+  Errors[idx].clear();
+
+  // An exception must not escape from a worker thread: it is stored and
+  // thrown again by StepAll() from the calling thread.
+  try {
+    for (unsigned int j=0; j<nInputs; j++)
+      InputNodes[idx*nInputs+j]->setDoubleValue(Inputs[idx*nInputs+j]);
+
+    for (unsigned int i=0; i<StepsPerTask && success; i++)
+      success = fdm->Run();
+  } catch (const string& msg) {
+    Errors[idx] = msg;
+  } catch (const char* msg) {
+    Errors[idx] = msg;
+  } catch (const exception& e) {
+    Errors[idx] = e.what();
+  } catch (...) {
+    Errors[idx] = "Unknown exception";
+  }
+
+  if (!Errors[idx].empty()) success = false;
+  if (StepsPerTask > 0 || !success) Status[idx] = success;
+
+  for (unsigned int j=0; j<nOutputs; j++)
+    Outputs[idx*nOutputs+j] = OutputNodes[idx*nOutputs+j]->getDoubleValue();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//    The bitmasked value choices are as follows:
+//    unset: In this case (the default) JSBSim would only print
+//       out the normally expected messages, essentially echoing
+//       the config files as they are read. If the environment
+//       variable is not set, debug_lvl is set to 1 internally
+//    0: This requests JSBSim not to output any messages
+//       whatsoever.
+//    1: This value explicity requests the normal JSBSim
+//       startup messages
+//    2: This value asks for a message to be printed out when
+//       a class is instantiated
+//    4: When this value is set, a message is displayed when a
+//       FGModel object executes its Run() method
+//    8: When this value is set, various runtime state variables
+//       are printed out periodically
+//    16: When set various parameters are sanity checked and
+//       a message is printed out when they go out of bounds
+
+void FGFDMExecPool::Debug(int from)
+{
+  if (debug_lvl <= 0) return;
+
+  if (debug_lvl & 1) { // Standard console startup message output
+    if (from == 0) { // Constructor
+      cout << "Pool of " << FDMs.size() << " FDMs stepped by " << Queues.size()
+           << " threads" << endl;
+    }
+  }
+  if (debug_lvl & 2 ) { // Instantiation/Destruction notification
+    if (from == 0) cout << "Instantiated: FGFDMExecPool" << endl;
+    if (from == 1) cout << "Destroyed:    FGFDMExecPool" << endl;
+  }
+  if (debug_lvl & 4 ) { // Run() method entry print for FGModel-derived objects
+  }
+  if (debug_lvl & 8 ) { // Runtime state variables
+  }
+  if (debug_lvl & 16) { // Sanity checking
+  }
+  if (debug_lvl & 64) {
+    if (from == 0) { // Constructor
+      cout << IdSrc << endl;
+      cout << IdHdr << endl;
+    }
+  }
+}
+}
@@ -0,0 +1,202 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+ Header:       FGFDMExecPool.h
+ Date started: 10/17/26
+ file The header file for the pool of JSBSim executives.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGFDMEXECPOOL_HEADER_H
+#define FGFDMEXECPOOL_HEADER_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FGJSBBase.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_FDMEXECPOOL "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+class FGFDMExec;
+class FGPropertyNode;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Pool of FGFDMExec instances stepped concurrently.
+
+    The pool owns a number of independent FGFDMExec instances (each one with
+    its own property tree) and a fixed set of worker threads. StepAll() runs
+    each instance a given number of time steps: the instances are dealt to the
+    threads in a round robin fashion and a thread that has completed its share
+    steals the instances that are still waiting in the queues of the other
+    threads. That way the load remains balanced even when the cost of an
+    instance varies (ground contact, number of engines, etc.). The thread that
+    calls StepAll() takes part in the work.
+
+    The instances are loaded and initialized by the user, from a single thread,
+    through the pointers returned by GetFDM():
+
+    @code
+    FGFDMExecPool pool(64);
+
+    for (unsigned int i=0; i<pool.GetNumFDMs(); i++) {
+      FGFDMExec* fdm = pool.GetFDM(i);
+      fdm->LoadModel("c172x");
+      fdm->RunIC();
+    }
+
+    std::vector<std::string> inputs, outputs;
+    inputs.push_back("fcs/elevator-cmd-norm");
+    outputs.push_back("position/h-sl-ft");
+    pool.SetInputProperties(inputs);
+    pool.SetOutputProperties(outputs);
+
+    double* u = pool.GetInputBuffer();
+    const double* y = pool.GetOutputBuffer();
+    u[i*pool.GetNumInputs()+j] = ...; // input j of instance i
+    pool.StepAll(10);
+    ... = y[i*pool.GetNumOutputs()+j]; // output j of instance i
+    @endcode
+
+    Before the instances are stepped, the input buffer is copied to the input
+    properties and once they have been stepped, the output properties are
+    copied to the output buffer. Both buffers are contiguous arrays of doubles
+    stored by instance (one row per instance).
+  */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGFDMExecPool : public FGJSBBase
+{
+public:
+  /** Constructor.
+      @param nFDMs the number of FGFDMExec instances to create.
+      @param nThreads the number of threads that step the instances, including
+                      the calling thread. If zero, the number of hardware
+                      threads is used. It is never larger than nFDMs. */
+  FGFDMExecPool(unsigned int nFDMs, unsigned int nThreads=0);
+
+  /// Destructor. Stops the threads and deletes the instances.
+  ~FGFDMExecPool();
+
+  /// Returns the number of FGFDMExec instances.
+  unsigned int GetNumFDMs(void) const {return FDMs.size();}
+  /// Returns the number of threads stepping the instances.
+  unsigned int GetNumThreads(void) const {return Queues.size();}
+  /// Returns a pointer to the instance number idx.
+  FGFDMExec* GetFDM(unsigned int idx) {return FDMs[idx];}
+
+  /** Sets the properties that are fed from the input buffer. The properties
+      are created if they do not exist yet.
+      @param names the property names. */
+  void SetInputProperties(const std::vector<std::string>& names);
+  /** Sets the properties that are copied to the output buffer. An exception
+      is thrown if a property does not exist in one of the instances.
+      @param names the property names. */
+  void SetOutputProperties(const std::vector<std::string>& names);
+
+  /// Returns the number of inputs per instance.
+  unsigned int GetNumInputs(void) const {return nInputs;}
+  /// Returns the number of outputs per instance.
+  unsigned int GetNumOutputs(void) const {return nOutputs;}
+  /// Returns the input buffer (GetNumFDMs() x GetNumInputs() doubles).
+  double* GetInputBuffer(void) {return Inputs.empty() ? 0 : &Inputs[0];}
+  /// Returns the output buffer (GetNumFDMs() x GetNumOutputs() doubles).
+  const double* GetOutputBuffer(void) const
+    {return Outputs.empty() ? 0 : &Outputs[0];}
+
+  /** Runs each instance nSteps times. The inputs are applied before the first
+      step and the outputs are collected after the last step so StepAll(0) can
+      be used to read the outputs after the initialization. An instance whose
+      Run() method returns false is not stepped any further during this call.
+      The exceptions thrown by the instances are caught in the threads that
+      step them: once all the instances have been stepped, the message of the
+      first one is thrown again as a string from the calling thread.
+      @param nSteps the number of time steps.
+      @return false if Run() has returned false for at least one instance. */
+  bool StepAll(unsigned int nSteps=1);
+
+  /** Returns the result of the last call to Run() for an instance.
+      @param idx the instance number. */
+  bool GetStatus(unsigned int idx) const {return Status[idx] != 0;}
+
+  /** Returns the message of the exception thrown by an instance during the
+      last call to StepAll() or an empty string if none was thrown.
+      @param idx the instance number. */
+  const std::string& GetError(unsigned int idx) const {return Errors[idx];}
+
+private:
+  struct WorkQueue {
+    std::mutex Mutex;
+    std::deque<unsigned int> Tasks;
+  };
+
+  std::vector<FGFDMExec*> FDMs;
+  std::vector<WorkQueue*> Queues;
+  std::vector<std::thread> Workers;
+
+  unsigned int nInputs;
+  unsigned int nOutputs;
+  std::vector<double> Inputs;
+  std::vector<double> Outputs;
+  std::vector<FGPropertyNode*> InputNodes;
+  std::vector<FGPropertyNode*> OutputNodes;
+  std::vector<char> Status;
+  std::vector<std::string> Errors;
+
+  std::mutex PoolMutex;
+  std::condition_variable StartCond;
+  std::condition_variable DoneCond;
+  unsigned int Generation;
+  unsigned int StepsPerTask;
+  std::atomic<unsigned int> Pending;
+  bool Quit;
+
+  void WorkerLoop(unsigned int id);
+  void ProcessTasks(unsigned int id);
+  bool NextTask(unsigned int id, unsigned int& task);
+  void RunTask(unsigned int idx);
+  void Debug(int from);
+};
+}
+#endif
@@ -39,7 +39,6 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include <float.h>
-#include <queue>
 #include <string>
 #include <cmath>
 
@@ -62,6 +61,9 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGRandom;
+class FGStateArchive;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -117,6 +119,8 @@ public:
       prev_out = out;
       return out;
     }
+    /// Saves or restores the last input and output of the filter.
+    public: void SerializeState(FGStateArchive& ar);
   };
 
   ///@name JSBSim console output highlighting terms.
@@ -145,42 +149,6 @@ public:
   static char fgdef[6];
   //@}
 
-  ///@name JSBSim Messaging functions
-  //@{
-  /** Places a Message structure on the Message queue.
-      @param msg pointer to a Message structure
-      @return pointer to a Message structure */
-  void PutMessage(const Message& msg);
-  /** Creates a message with the given text and places it on the queue.
-      @param text message text
-      @return pointer to a Message structure */
-  void PutMessage(const std::string& text);
-  /** Creates a message with the given text and boolean value and places it on the queue.
-      @param text message text
-      @param bVal boolean value associated with the message
-      @return pointer to a Message structure */
-  void PutMessage(const std::string& text, bool bVal);
-  /** Creates a message with the given text and integer value and places it on the queue.
-      @param text message text
-      @param iVal integer value associated with the message
-      @return pointer to a Message structure */
-  void PutMessage(const std::string& text, int iVal);
-  /** Creates a message with the given text and double value and places it on the queue.
-      @param text message text
-      @param dVal double value associated with the message
-      @return pointer to a Message structure */
-  void PutMessage(const std::string& text, double dVal);
-  /** Reads the message on the queue (but does not delete it).
-      @return 1 if some messages */
-  int SomeMessages(void) { return !Messages.empty(); }
-  /** Reads the message on the queue and removes it from the queue.
-      This function also prints out the message.*/
-  void ProcessMessage(void);
-  /** Reads the next message on the queue and removes it from the queue.
-      This function also prints out the message.
-      @return a pointer to the message, or NULL if there are no messages.*/
-  Message* ProcessNextMessage(void);
-  //@}
 
   /** Returns the version number of JSBSim.
   *   @return The version number of JSBSim. */
@@ -335,17 +303,20 @@ public:
   
   static double sign(double num) {return num>=0.0?1.0:-1.0;}
 
+  /** Returns a random number with a standard normal distribution drawn from
+      the stream of the calling thread.
+      @see GetThreadRandomStream */
   static double GaussianRandomNumber(void);
 
-protected:
-  static Message localMsg;
-
-  static std::queue <Message> Messages;
+  /** Returns the random number stream of the calling thread. This stream is
+      used by the dispersions applied while the XML files are read. The
+      simulation components must use the streams of their FGFDMExec instance
+      instead (see FGFDMExec::GetRandomStream). */
+  static FGRandom& GetThreadRandomStream(void);
 
+protected:
   void Debug(int) {};
 
-  static unsigned int messageId;
-
   static const double radtodeg;
   static const double degtorad;
   static const double hptoftlbssec;
@@ -371,8 +342,6 @@ protected:
 
   static std::string CreateIndexedPropertyName(const std::string& Property, int index);
 
-  static int gaussian_random_number_phase;
-
 public:
 /// Moments L, M, N
 enum {eL     = 1, eM,     eN    };
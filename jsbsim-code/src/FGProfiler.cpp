@@ -0,0 +1,281 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGProfiler.cpp
+ Date started: 10/17/26
+ Purpose:      Accumulates the time spent in the sections of a frame
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+The durations are accumulated in a histogram of nanoseconds with a logarithmic
+scale: the bin b holds the durations between 2^(b/8) and 2^((b+1)/8) ns.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cctype>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include "FGProfiler.h"
+#include "input_output/FGPropertyManager.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_PROFILER);
+
+static const int BinsPerOctave = 8;
+static const int NumBins = 40*BinsPerOctave; // Up to 2^40 ns (about 18 min.)
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGProfiler::FGProfiler(FGPropertyManager* pm)
+  : PropertyManager(pm), enabled(false)
+{
+  typedef int (FGProfiler::*iPMF)(void) const;
+  PropertyManager->Tie("simulation/profile/enabled", this,
+                       &FGProfiler::GetEnabledProperty,
+                       &FGProfiler::SetEnabledProperty);
+  PropertyManager->Tie("simulation/profile/reset", this, (iPMF)0,
+                       &FGProfiler::ResetStatisticsProperty, false);
+
+  Debug(0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGProfiler::~FGProfiler()
+{
+  Debug(1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+string FGProfiler::MakePropertyName(const string& name)
+{
+  string result;
+  bool first = true; // First character of a node name
+
+  for (string::const_iterator it=name.begin(); it != name.end(); ++it) {
+    char c = tolower(*it);
+
+    if (c == '/') {
+      if (first) continue; // Skip empty node names
+      result += c;
+      first = true;
+      continue;
+    }
+
+    if (!isalnum(c) && c != '_' && c != '-' && c != '.') c = '-';
+    if (first && !isalpha(c) && c != '_') result += '_';
+    result += c;
+    first = false;
+  }
+
+  if (result.empty() || first) result += '_';
+
+  return result;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int FGProfiler::AddSection(const string& name)
+{
+  string property = MakePropertyName(name);
+  map<string, unsigned int>::const_iterator it = SectionIndex.find(property);
+
+  if (it != SectionIndex.end()) return it->second;
+
+  unsigned int idx = Sections.size();
+  Section section;
+  section.Name = property;
+  section.Count = 0;
+  section.Sum = 0.0;
+  section.Min = HUGE_VAL;
+  section.Max = 0.0;
+  section.Histogram.resize(NumBins, 0);
+  Sections.push_back(section);
+  SectionIndex[property] = idx;
+
+  string base = "simulation/profile/" + property;
+  PropertyManager->Tie(base + "/count", this, idx, &FGProfiler::GetCount);
+  PropertyManager->Tie(base + "/min-us", this, idx, &FGProfiler::GetMinimum);
+  PropertyManager->Tie(base + "/mean-us", this, idx, &FGProfiler::GetMean);
+  PropertyManager->Tie(base + "/p99-us", this, idx,
+                       &FGProfiler::GetPercentile99);
+  PropertyManager->Tie(base + "/max-us", this, idx, &FGProfiler::GetMaximum);
+
+  return idx;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGProfiler::Record(unsigned int idx, Clock::duration elapsed)
+{
+  Section& section = Sections[idx];
+  double ns = chrono::duration<double, nano>(elapsed).count();
+  double seconds = 1E-9*ns;
+
+  section.Count++;
+  section.Sum += seconds;
+  if (seconds < section.Min) section.Min = seconds;
+  if (seconds > section.Max) section.Max = seconds;
+
+  int bin = 0;
+  if (ns > 1.0) {
+    bin = (int)(log2(ns)*BinsPerOctave);
+    if (bin >= NumBins) bin = NumBins-1;
+  }
+  section.Histogram[bin]++;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGProfiler::ResetStatistics(void)
+{
+  for (unsigned int i=0; i<Sections.size(); i++) {
+    Section& section = Sections[i];
+    section.Count = 0;
+    section.Sum = 0.0;
+    section.Min = HUGE_VAL;
+    section.Max = 0.0;
+    section.Histogram.assign(NumBins, 0);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGProfiler::GetMinimum(int idx) const
+{
+  const Section& section = Sections[idx];
+  return section.Count ? 1E6*section.Min : 0.0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGProfiler::GetMean(int idx) const
+{
+  const Section& section = Sections[idx];
+  return section.Count ? 1E6*section.Sum/section.Count : 0.0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGProfiler::GetPercentile99(int idx) const
+{
+  const Section& section = Sections[idx];
+  if (section.Count == 0) return 0.0;
+
+  // The rank of the 99th percentile, rounded up.
+  unsigned long rank = (unsigned long)ceil(0.99*section.Count);
+  unsigned long total = 0;
+  int bin = 0;
+
+  for (; bin < NumBins-1; bin++) {
+    total += section.Histogram[bin];
+    if (total >= rank) break;
+  }
+
+  // Returns the upper bound of the bin, which can not exceed the maximum.
+  double upper = 1E-3*exp2((double)(bin+1)/BinsPerOctave);
+  return min(upper, 1E6*section.Max);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGProfiler::GetMaximum(int idx) const
+{
+  return 1E6*Sections[idx].Max;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGProfiler::Print(ostream& out) const
+{
+  ios::fmtflags flags = out.flags();
+  streamsize precision = out.precision();
+
+  size_t width = 20;
+  for (unsigned int i=0; i<Sections.size(); i++)
+    width = max(width, Sections[i].Name.size() + 2);
+
+  out << endl << "JSBSim frame profile (durations in microseconds)" << endl;
+  out << left << setw(width) << "Section" << right << setw(10) << "Count"
+      << setw(11) << "Min" << setw(11) << "Mean" << setw(11) << "P99"
+      << setw(11) << "Max" << setw(13) << "Total (ms)" << endl;
+  out << string(width+67, '-') << endl;
+
+  out << fixed << setprecision(2);
+  for (unsigned int i=0; i<Sections.size(); i++) {
+    const Section& section = Sections[i];
+    if (section.Count == 0) continue;
+
+    out << left << setw(width) << section.Name << right << setw(10)
+        << section.Count << setw(11) << GetMinimum(i) << setw(11) << GetMean(i)
+        << setw(11) << GetPercentile99(i) << setw(11) << GetMaximum(i)
+        << setw(13) << 1E3*section.Sum << endl;
+  }
+
+  out.flags(flags);
+  out.precision(precision);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//    The bitmasked value choices are as follows:
+//    unset: In this case (the default) JSBSim would only print
+//       out the normally expected messages, essentially echoing
+//       the config files as they are read. If the environment
+//       variable is not set, debug_lvl is set to 1 internally
+//    0: This requests JSBSim not to output any messages
+//       whatsoever.
+//    1: This value explicity requests the normal JSBSim
+//       startup messages
+//    2: This value asks for a message to be printed out when
+//       a class is instantiated
+//    4: When this value is set, a message is displayed when a
+//       FGModel object executes its Run() method
+//    8: When this value is set, various runtime state variables
+//       are printed out periodically
+//    16: When set various parameters are sanity checked and
+//       a message is printed out when they go out of bounds
+
+void FGProfiler::Debug(int from)
+{
+  if (debug_lvl <= 0) return;
+
+  if (debug_lvl & 2 ) { // Instantiation/Destruction notification
+    if (from == 0) cout << "Instantiated: FGProfiler" << endl;
+    if (from == 1) cout << "Destroyed:    FGProfiler" << endl;
+  }
+  if (debug_lvl & 64) {
+    if (from == 0) { // Constructor
+      cout << IdSrc << endl;
+      cout << IdHdr << endl;
+    }
+  }
+}
+}
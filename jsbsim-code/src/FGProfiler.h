@@ -0,0 +1,168 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+ Header:       FGProfiler.h
+ Date started: 10/17/26
+ file The header file for the frame timing profiler.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGPROFILER_HEADER_H
+#define FGPROFILER_HEADER_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <chrono>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "FGJSBBase.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_PROFILER "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+class FGPropertyManager;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Accumulates the time spent in the sections of a simulation frame.
+
+    A section is a piece of code that is executed at each frame: a model, a
+    system channel or an output. Each section is registered once with
+    AddSection() and timed with a Timer. The statistics of a section named
+    <tt>name</tt> are exposed in the property tree:
+
+    - <tt>simulation/profile/name/count</tt> (number of executions)
+    - <tt>simulation/profile/name/min-us</tt>
+    - <tt>simulation/profile/name/mean-us</tt>
+    - <tt>simulation/profile/name/p99-us</tt>
+    - <tt>simulation/profile/name/max-us</tt>
+
+    The durations are expressed in microseconds. The 99th percentile is
+    estimated from a logarithmic histogram with 8 bins per octave so its
+    relative accuracy is about 9%.
+
+    Profiling is disabled by default. It is enabled either by setting the
+    property <tt>simulation/profile/enabled</tt> to 1 or by setting the
+    environment variable <tt>JSBSIM_PROFILE</tt> to a non zero value. In the
+    latter case, the summary table is also printed when the FDM is destroyed.
+    Setting the property <tt>simulation/profile/reset</tt> clears the
+    statistics. When profiling is disabled, the cost of a Timer reduces to a
+    test.
+  */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGProfiler : public FGJSBBase
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  /** Measures the time spent in a section during the lifetime of the timer.
+      Nothing is measured when the profiler is disabled. */
+  class Timer {
+  public:
+    Timer(FGProfiler* profiler, unsigned int section)
+      : Profiler(profiler->enabled ? profiler : 0L), Section(section)
+    { if (Profiler) Start = Clock::now(); }
+    ~Timer() { if (Profiler) Profiler->Record(Section, Clock::now() - Start); }
+
+  private:
+    FGProfiler* Profiler;
+    unsigned int Section;
+    Clock::time_point Start;
+  };
+
+  /** Constructor.
+      @param pm the property manager in which the statistics are exposed */
+  explicit FGProfiler(FGPropertyManager* pm);
+  ~FGProfiler();
+
+  /** Registers a section.
+      The name is converted to a valid property name. A section that has
+      already been registered keeps its index (and its statistics) so a model
+      can register its sections each time it is loaded.
+      @param name the name of the section, which may contain slashes
+      @return the index of the section */
+  unsigned int AddSection(const std::string& name);
+
+  /// Records a measurement for a section.
+  void Record(unsigned int section, Clock::duration elapsed);
+
+  void SetEnabled(bool flag) { enabled = flag; }
+  bool GetEnabled(void) const { return enabled; }
+
+  /// Clears the statistics of all the sections.
+  void ResetStatistics(void);
+
+  unsigned int GetNumSections(void) const { return Sections.size(); }
+  const std::string& GetSectionName(int section) const
+  { return Sections[section].Name; }
+  double GetCount(int section) const { return Sections[section].Count; }
+  double GetMinimum(int section) const;
+  double GetMean(int section) const;
+  double GetPercentile99(int section) const;
+  double GetMaximum(int section) const;
+
+  /** Prints a table summarizing the statistics of the sections that have been
+      executed at least once. */
+  void Print(std::ostream& out) const;
+
+  /// Converts a name to a string that can be used in a property path.
+  static std::string MakePropertyName(const std::string& name);
+
+private:
+  struct Section {
+    std::string Name;
+    unsigned long Count;
+    double Sum, Min, Max; // in seconds
+    std::vector<unsigned long> Histogram;
+  };
+
+  FGPropertyManager* PropertyManager;
+  std::vector<Section> Sections;
+  std::map<std::string, unsigned int> SectionIndex;
+  bool enabled;
+
+  int GetEnabledProperty(void) const { return enabled ? 1 : 0; }
+  void SetEnabledProperty(int flag) { enabled = flag != 0; }
+  void ResetStatisticsProperty(int) { ResetStatistics(); }
+  void Debug(int from);
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
@@ -124,6 +124,32 @@ void FGInitialCondition::ResetIC(double u0, double v0, double w0,
 
 //******************************************************************************
 
+void FGInitialCondition::CopyFrom(const FGInitialCondition& ic)
+{
+  vUVW_NED = ic.vUVW_NED;
+  vPQR_body = ic.vPQR_body;
+  position = ic.position;
+  orientation = ic.orientation;
+  vt = ic.vt;
+  targetNlfIC = ic.targetNlfIC;
+  Tw2b = ic.Tw2b;
+  Tb2w = ic.Tb2w;
+  alpha = ic.alpha;
+  beta = ic.beta;
+  a = ic.a;
+  e2 = ic.e2;
+  lastSpeedSet = ic.lastSpeedSet;
+  lastAltitudeSet = ic.lastAltitudeSet;
+  lastLatitudeSet = ic.lastLatitudeSet;
+  enginesRunning = ic.enginesRunning;
+  needTrim = ic.needTrim;
+
+  // The location must use the terrain of this FDM.
+  position.SetGroundCallback(fdmex->GetGroundCallback());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGInitialCondition::InitializeIC(void)
 {
   alpha=beta=0;
@@ -133,6 +159,7 @@ void FGInitialCondition::InitializeIC(void)
   e2 = 1.0 - ec*ec;
 
   position.SetEllipse(a, b);
+  position.SetGroundCallback(fdmex->GetGroundCallback());
 
   position.SetPositionGeodetic(0.0, 0.0, 0.0);
   position.SetEarthPositionAngle(fdmex->GetPropagate()->GetEarthPositionAngle());
@@ -275,6 +275,12 @@ public:
                double latitudeRad0, double longitudeRad0, double altitudeAGL0,
                double gamma0);
 
+  /** Copies the initial conditions of another instance. Both instances must
+      belong to FDMs that have loaded the same aircraft.
+      @param ic the initial conditions to copy.
+      @see FGFDMExec::Clone */
+  void CopyFrom(const FGInitialCondition& ic);
+
   /** Sets the roll angle initial condition in degrees.
       @param phi roll angle in degrees */
   void SetPhiDegIC(double phi)  { SetPhiRadIC(phi*degtorad);}
@@ -619,6 +625,10 @@ public:
       @param nlf Normal load factor*/
   void SetTargetNlfIC(double nlf) { targetNlfIC=nlf; }
 
+  /** Sets the ground callback used to compute the initial altitudes.
+      @param gc A pointer to the ground callback object owned by FGFDMExec */
+  void SetGroundCallback(FGGroundCallback* gc) { position.SetGroundCallback(gc); }
+
   /** Gets the initial flight path angle.
       If total velocity is zero, this function returns zero.
       @return Initial flight path angle in radians */
@@ -40,10 +40,12 @@ INCLUDES
 
 #include <cstring>
 #include <cstdlib>
+#include <cstddef>
 #include <sstream>
 #include <iomanip>
 
 #include "FGInputSocket.h"
+#include "binary_utilities.h"
 #include "FGFDMExec.h"
 #include "models/FGAircraft.h"
 #include "input_output/FGXMLElement.h"
@@ -55,6 +57,20 @@ namespace JSBSim {
 IDENT(IdSrc,"$Id");
 IDENT(IdHdr,ID_INPUTSOCKET);
 
+namespace {
+
+// The type and the size of a message.
+const size_t MessageHeaderSize = 2*sizeof(uint32_t);
+// The ID and the value of a property in a set message.
+const size_t SetValueSize = sizeof(uint32_t) + sizeof(double);
+// A larger size is assumed to be a corrupted header.
+const uint32_t MaxMessageSize = 1 << 24;
+// The replies are dropped when the client does not read them and more than
+// this size is waiting to be sent.
+const size_t MaxUnsentSize = 1 << 24;
+
+}
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -62,7 +78,8 @@ CLASS IMPLEMENTATION
 FGInputSocket::FGInputSocket(FGFDMExec* fdmex) :
   FGInputType(fdmex),
   socket(0),
-  SockProtocol(FGfdmSocket::ptTCP)
+  SockProtocol(FGfdmSocket::ptTCP),
+  BinaryFormat(false)
 {
 }
 
@@ -87,6 +104,14 @@ bool FGInputSocket::Load(Element* el)
     return false;
   }
 
+  string format = el->GetAttributeValue("format");
+  if (format == "binary")
+    BinaryFormat = true;
+  else if (!format.empty() && format != "text") {
+    cerr << el->ReadFrom() << fgred << "Unknown format " << format
+         << ". The text commands will be expected." << reset << endl;
+  }
+
   return true;
 }
 
@@ -101,6 +126,12 @@ bool FGInputSocket::InitModel(void)
     if (socket == 0) return false;
     if (!socket->GetConnectStatus()) return false;
 
+    socket->SetInteractive(!BinaryFormat);
+    RegisteredNodes.clear();
+    Commands.clear();
+    data.clear();
+    Unsent.clear();
+
     return true;
   }
 
@@ -119,6 +150,11 @@ void FGInputSocket::Read(bool Holding)
   if (socket == 0) return;
   if (!socket->GetConnectStatus()) return;
 
+  if (BinaryFormat) {
+    ReadBinary();
+    return;
+  }
+
   data = socket->Receive(); // get socket transmission if present
 
   if (data.size() > 0) {
@@ -264,4 +300,215 @@ void FGInputSocket::Read(bool Holding)
 
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGInputSocket::ReadBinary(void)
+{
+  // The replies that could not be sent at the previous time steps go first.
+  SendUnsent();
+
+  // A message may be received in several pieces: the data that follows the
+  // last complete message is kept until the rest of the message is received.
+  data += socket->Receive();
+
+  size_t pos = 0;
+
+  while (data.size() - pos >= MessageHeaderSize) {
+    const char* message = data.data() + pos;
+    uint32_t type, size;
+    UnpackValue(UnpackValue(message, type), size);
+
+    if (size < MessageHeaderSize || size > MaxMessageSize) {
+      // The beginning of the next message can not be found.
+      ReplyError("Invalid message size. The data received is discarded.");
+      data.clear();
+      pos = 0;
+      break;
+    }
+    if (data.size() - pos < size) break;
+
+    const char* body = message + MessageHeaderSize;
+    const char* end = message + size;
+
+    switch (type) {
+    case msgRegister:
+      Register(body, end);
+      break;
+    case msgSet:
+    case msgVector:
+      QueueValues(type, body, end);
+      break;
+    default:
+      ReplyError("Unknown message type.");
+    }
+
+    pos += size;
+  }
+
+  data.erase(0, pos);
+
+  // The values of all the messages received are applied at the same time step.
+  vector<pair<FGPropertyNode*, double> >::const_iterator it;
+  for (it = Commands.begin(); it != Commands.end(); ++it)
+    it->first->setDoubleValue(it->second);
+
+  Commands.clear();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGInputSocket::Register(const char* body, const char* end)
+{
+  vector<string> paths;
+  uint32_t count;
+
+  if (end - body < (ptrdiff_t)sizeof(uint32_t)) {
+    ReplyError("Malformed register message.");
+    return;
+  }
+  body = UnpackValue(body, count);
+
+  for (unsigned int i=0; i<count; i++) {
+    uint16_t length;
+    if (end - body < (ptrdiff_t)sizeof(uint16_t)) break;
+    body = UnpackValue(body, length);
+    if (end - body < length) break;
+    paths.push_back(string(body, length));
+    body += length;
+  }
+
+  if (paths.size() != count || body != end) {
+    ReplyError("Malformed register message.");
+    return;
+  }
+
+  vector<char> reply;
+  AppendValue(reply, static_cast<uint32_t>(msgRegister));
+  AppendValue(reply, static_cast<uint32_t>(0)); // The size is set below
+  AppendValue(reply, count);
+
+  for (unsigned int i=0; i<count; i++) {
+    FGPropertyNode* node = 0;
+    int32_t id = -1;
+
+    try {
+      node = PropertyManager->GetNode(paths[i]);
+    } catch(...) {
+      node = 0;
+    }
+
+    if (node && node->hasValue()) {
+      id = RegisteredNodes.size();
+      RegisteredNodes.push_back(node);
+    }
+    AppendValue(reply, id);
+  }
+
+  PackValue(&reply[sizeof(uint32_t)], static_cast<uint32_t>(reply.size()));
+  SendReply(reply);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGInputSocket::QueueValues(uint32_t type, const char* body,
+                                const char* end)
+{
+  size_t numNodes = RegisteredNodes.size();
+  size_t numQueued = Commands.size();
+  size_t length = end - body;
+  uint32_t id, count;
+  double value;
+
+  if (type == msgSet) {
+    if (length < sizeof(uint32_t)) {
+      ReplyError("Malformed set message.");
+      return;
+    }
+    body = UnpackValue(body, count);
+    length -= sizeof(uint32_t);
+
+    if (length % SetValueSize != 0 || length / SetValueSize != count) {
+      ReplyError("Malformed set message.");
+      return;
+    }
+
+    for (unsigned int i=0; i<count; i++) {
+      body = UnpackValue(UnpackValue(body, id), value);
+      if (id >= numNodes) {
+        Commands.resize(numQueued);
+        ReplyError("Unknown property ID. The set message is ignored.");
+        return;
+      }
+      Commands.push_back(make_pair(RegisteredNodes[id], value));
+    }
+  } else {
+    if (length < 2*sizeof(uint32_t)) {
+      ReplyError("Malformed vector message.");
+      return;
+    }
+    body = UnpackValue(UnpackValue(body, id), count);
+    length -= 2*sizeof(uint32_t);
+
+    if (length % sizeof(double) != 0 || length / sizeof(double) != count) {
+      ReplyError("Malformed vector message.");
+      return;
+    }
+    if (id > numNodes || count > numNodes - id) {
+      ReplyError("Unknown property ID. The vector message is ignored.");
+      return;
+    }
+
+    for (unsigned int i=0; i<count; i++) {
+      body = UnpackValue(body, value);
+      Commands.push_back(make_pair(RegisteredNodes[id+i], value));
+    }
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGInputSocket::ReplyError(const string& text)
+{
+  vector<char> reply;
+
+  AppendValue(reply, static_cast<uint32_t>(msgError));
+  AppendValue(reply, static_cast<uint32_t>(MessageHeaderSize + text.size()));
+  reply.insert(reply.end(), text.begin(), text.end());
+  SendReply(reply);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGInputSocket::SendReply(const vector<char>& reply)
+{
+  // The replies are queued behind the end of a reply that the socket has
+  // partially accepted otherwise the client would lose track of the messages.
+  if (!SendUnsent()) {
+    if (Unsent.size() + reply.size() > MaxUnsentSize) {
+      cerr << "The client of the input socket on port " << SockPort
+           << " does not read its replies. A reply is dropped." << endl;
+      return;
+    }
+    Unsent.insert(Unsent.end(), reply.begin(), reply.end());
+    return;
+  }
+
+  int sent = socket->Reply(&reply[0], reply.size());
+  if (sent < 0) return;
+
+  if (static_cast<size_t>(sent) < reply.size())
+    Unsent.assign(reply.begin() + sent, reply.end());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGInputSocket::SendUnsent(void)
+{
+  if (Unsent.empty()) return true;
+
+  int sent = socket->Reply(&Unsent[0], Unsent.size());
+  if (sent > 0) Unsent.erase(Unsent.begin(), Unsent.begin() + sent);
+
+  return Unsent.empty();
+}
 }
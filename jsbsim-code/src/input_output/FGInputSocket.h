@@ -38,6 +38,11 @@ SENTRY
 INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+#include <string>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
 #include "FGInputType.h"
 #include "input_output/FGfdmSocket.h"
 
@@ -53,12 +58,49 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGPropertyNode;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 /** Implements the input from a socket. This class inputs data from a telnet
     session. This is a leaf class.
+
+    With the attribute <tt>format="binary"</tt>, the socket expects binary
+    messages instead of text commands. They set the values of properties
+    without resolving their path at each command:
+
+@code
+<input port="5137" format="binary"/>
+@endcode
+
+    All the numbers are little-endian. Each message starts with its type
+    (uint32) and its size in bytes including these 8 bytes (uint32):
+    - A register message (type 1) holds a number of property paths (uint32)
+      followed by the paths, each of them being its length (uint16) followed
+      by its characters. The socket replies with a register message that holds
+      the number of paths (uint32) followed by their IDs (int32). The IDs are
+      numbered from 0 in the order of the registrations of the connection. An
+      ID of -1 means that the path is not the path of an existing leaf
+      property.
+    - A set message (type 2) holds a number of values (uint32) followed by
+      the values, each of them being the ID of a property (uint32) followed by
+      its value (float64).
+    - A vector message (type 3) holds the ID of a first property (uint32) and
+      a number of values (uint32), followed by the values (float64) of the
+      properties with consecutive IDs from the first one.
+    - An error message (type 4) is sent by the socket when a message is
+      rejected. It holds the text of the error.
+
+    The set and vector messages that are received before a time step are
+    applied at the beginning of this time step, in the order they have been
+    sent. A message is applied as a whole: it is not applied until it is
+    completely received and it is rejected if one of its IDs is unknown.
+
+    The replies that the socket can not send at once, such as the reply to
+    the registration of many properties, are sent in the next time steps
+    before any other reply so that the client always receives whole messages.
  */
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -88,12 +130,35 @@ public:
   /// Generates the input.
   void Read(bool Holding);
 
+  /// The types of the messages of the binary protocol.
+  enum eMessageType {msgRegister = 1, msgSet = 2, msgVector = 3, msgError = 4};
+
 protected:
+  /// Reads the messages of the binary protocol and applies their values.
+  void ReadBinary(void);
+  /// Registers the property paths of a message and replies with their IDs.
+  void Register(const char* body, const char* end);
+  /** Checks the values of a set or vector message and queues them. The values
+      of a message are queued only if the whole message is valid. */
+  void QueueValues(uint32_t type, const char* body, const char* end);
+  /// Replies with an error message.
+  void ReplyError(const std::string& text);
+  /** Sends a reply of the binary protocol after the end of the replies that
+      the socket has not accepted yet. */
+  void SendReply(const std::vector<char>& reply);
+  /** Sends the end of the replies that the socket has not accepted yet.
+      @return true if there is nothing left to send. */
+  bool SendUnsent(void);
 
   unsigned int SockPort;
   FGfdmSocket* socket;
   FGfdmSocket::ProtocolType SockProtocol;
   std::string data;
+  bool BinaryFormat;
+  std::vector<FGPropertyNode*> RegisteredNodes;
+  std::vector<std::pair<FGPropertyNode*, double> > Commands;
+  // The replies or the end of a reply that the socket has not accepted yet.
+  std::vector<char> Unsent;
 };
 }
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
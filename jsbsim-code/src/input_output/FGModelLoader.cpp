@@ -38,6 +38,7 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include "FGJSBBase.h"
+#include "FGFDMExec.h"
 #include "FGModelLoader.h"
 #include "FGXMLFileRead.h"
 #include "models/FGModel.h"
@@ -59,27 +60,27 @@ Element_ptr FGModelLoader::Open(Element *el)
   string fname = el->GetAttributeValue("file");
 
   if (!fname.empty()) {
-    FGXMLFileRead XMLFileRead;
     SGPath path(SGPath::fromLocal8Bit(fname.c_str()));
 
     if (path.isRelative())
       path = model->FindFullPathName(path);
 
-    if (CachedFiles.find(path.utf8Str()) != CachedFiles.end())
-      document = CachedFiles[path.utf8Str()];
-    else {
-      document = XMLFileRead.LoadXMLDocument(path);
-      if (document == 0L) {
-        cerr << endl << el->ReadFrom()
-             << "Could not open file: " << fname << endl;
-        return NULL;
-      }
-      CachedFiles[path.utf8Str()] = document;
+    // The documents are cached by the executive so that the files that are
+    // referenced several times (by the engines for instance) or by the clones
+    // of the executive are only read once.
+    document = model->GetExec()->GetXMLCache()->LoadXMLDocument(path);
+    if (document == 0L) {
+      cerr << endl << el->ReadFrom()
+           << "Could not open file: " << fname << endl;
+      return NULL;
     }
 
+    // A cached document may already have been attached to this element. Its
+    // parent is set again since the document may be shared by several
+    // elements (several engines for instance).
     if (document->GetName() != el->GetName()) {
       document->SetParent(el);
-      el->AddChildElement(document);
+      if (!el->HasChildElement(document)) el->AddChildElement(document);
     }
   }
 
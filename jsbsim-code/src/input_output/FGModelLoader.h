@@ -73,7 +73,6 @@ public:
 
 private:
   const FGModel* model;
-  std::map<std::string, Element_ptr> CachedFiles;
 };
 
 SGPath CheckPathName(const SGPath& path, const SGPath& filename);
@@ -0,0 +1,179 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGOutputBinaryFile.cpp
+ Date started: 10/17/26
+ Purpose:      Manage output of sim parameters to a binary file
+ Called by:    FGOutput
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+The header is built once when the file is opened. Each output then packs the
+values into a record buffer which is written to the file in one call. The bytes
+of the values are only reordered on big-endian platforms.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <stdint.h>
+
+#include "FGOutputBinaryFile.h"
+#include "binary_utilities.h"
+#include "FGFDMExec.h"
+#include "input_output/FGXMLElement.h"
+#include "math/FGFunction.h"
+#include "math/FGPropertyValue.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_OUTPUTBINARYFILE);
+
+namespace {
+
+const char Signature[8] = {'J', 'S', 'B', 'S', 'B', 'I', 'N', '\0'};
+const streamoff RateOffset = 24;
+
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+bool FGOutputBinaryFile::Load(Element* el)
+{
+  if(!FGOutputFile::Load(el))
+    return false;
+
+  string precision = el->GetAttributeValue("precision");
+  if (precision == "single")
+    SetSinglePrecision(true);
+  else if (precision.empty() || precision == "double")
+    SetSinglePrecision(false);
+  else {
+    cerr << el->ReadFrom() << fgred << "Unknown precision " << precision
+         << ". The values will be written in double precision." << reset
+         << endl;
+    SetSinglePrecision(false);
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGOutputBinaryFile::OpenFile(void)
+{
+  datafile.clear();
+  datafile.open(Filename);
+  if (!datafile) {
+    cerr << endl << fgred << highint << "ERROR: unable to open the file "
+         << reset << Filename.c_str() << endl
+         << fgred << highint << "       => Output to this file is disabled."
+         << reset << endl << endl;
+    Disable();
+    return false;
+  }
+
+  if (SubSystems)
+    cerr << fgred << "The subsystems groups are not written to the binary file "
+         << reset << Filename.c_str() << endl;
+
+  size_t numColumns = 1 + OutputParameters.size() + PreFunctions.size();
+  vector<char> columns;
+
+  DescribeColumns(columns, SinglePrecision);
+
+  Record.resize(GetSampleSize());
+
+  vector<char> header(Signature, Signature + sizeof(Signature));
+  size_t headerSize = header.size() + 4*sizeof(uint32_t) + sizeof(double)
+                    + columns.size();
+  headerSize = (headerSize + 7) & ~size_t(7);
+
+  AppendValue(header, static_cast<uint32_t>(Version));
+  AppendValue(header, static_cast<uint32_t>(headerSize));
+  AppendValue(header, static_cast<uint32_t>(Record.size()));
+  AppendValue(header, static_cast<uint32_t>(numColumns));
+  // The integration is suspended while RunIC() opens the file so the rate is
+  // only known once the simulation runs.
+  RatePending = FDMExec->IntegrationSuspended();
+  RateReady = false;
+  AppendValue(header, RatePending ? 0.0 : GetRateHz());
+  header.insert(header.end(), columns.begin(), columns.end());
+  header.resize(headerSize, '\0');
+
+  datafile.write(&header[0], header.size());
+  datafile.flush();
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputBinaryFile::Print(void)
+{
+  // The output can be run before the file is opened by InitModel().
+  if (!datafile.is_open()) return;
+
+  Sample(&Record[0]);
+  PrintSample(&Record[0]);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+size_t FGOutputBinaryFile::GetSampleSize(void) const
+{
+  return GetRecordSize(SinglePrecision);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputBinaryFile::Sample(char* sample)
+{
+  if (RatePending && !FDMExec->IntegrationSuspended()) {
+    RateHz = GetRateHz();
+    RateReady.store(true, memory_order_release);
+    RatePending = false;
+  }
+
+  PackRecord(sample, SinglePrecision);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputBinaryFile::PrintSample(const char* sample)
+{
+  if (!datafile.is_open()) return;
+
+  if (RateReady.exchange(false, memory_order_acquire)) {
+    streampos end = datafile.tellp();
+    char rate[sizeof(double)];
+    PackValue(rate, RateHz);
+    datafile.seekp(RateOffset);
+    datafile.write(rate, sizeof(rate));
+    datafile.seekp(end);
+  }
+
+  datafile.write(sample, GetSampleSize());
+}
+}
@@ -0,0 +1,161 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGOutputBinaryFile.h
+ Date started: 10/17/26
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGOUTPUTBINARYFILE_H
+#define FGOUTPUTBINARYFILE_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <atomic>
+#include <vector>
+
+#include "FGOutputFile.h"
+#include "simgear/io/iostreams/sgstream.hxx"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_OUTPUTBINARYFILE "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Implements the output to a binary file of fixed size records.
+
+    The file starts with a header which describes the columns of the records
+    and is followed by one record per output. A record holds the raw values of
+    its columns, without any separator nor padding. All the numbers of the
+    file, in the header as well as in the records, are little-endian whatever
+    the platform. The header is made of:
+
+<pre>
+    Offset  Size  Content
+    0       8     The signature "JSBSBIN" followed by a null character
+    8       4     The version of the format (uint32, currently 1)
+    12      4     The size of the header i.e. the offset of the first record
+                  (uint32, a multiple of 8)
+    16      4     The size of a record (uint32)
+    20      4     The number of columns (uint32)
+    24      8     The output rate in Hz (float64, 0 until a record is
+                  written with the integration running)
+    32            The description of each column:
+                    1 byte: the type of the values, 'd' for float64 or 'f' for
+                            float32,
+                    uint16 + bytes: the length and the characters of the name,
+                    uint16 + bytes: the length and the characters of the unit.
+                  The descriptions are followed by null bytes up to the end of
+                  the header.
+</pre>
+
+    The first column is always the simulation time, in seconds and stored as
+    a float64. It is followed by the properties and by the functions of the
+    output directive. A column is named after the caption of its property if
+    any, after the fully qualified name of the property otherwise. Its unit is
+    the suffix of the property name, as in "ft" for
+    <tt>position/h-sl-ft</tt>, and is empty when the name has no suffix.
+
+    The values of the properties are stored as float64 unless the attribute
+    <tt>precision="single"</tt> is specified:
+
+@code
+<output name="datalog.bin" type="BINARY" rate="120" precision="single">
+  <property> velocities/vc-kts </property>
+  <property caption="Altitude (ft)"> position/h-sl-ft </property>
+</output>
+@endcode
+
+    Only the properties and the functions are written: the subsystems groups
+    (<tt>\<velocities> ON \</velocities></tt> and so on) are only supported by
+    the text outputs.
+
+    The file can be loaded with the script
+    <tt>src/utilities/read_binary_output.py</tt>, which maps the records
+    in memory with NumPy.
+ */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGOutputBinaryFile : public FGOutputFile
+{
+public:
+  /// Constructor
+  FGOutputBinaryFile(FGFDMExec* fdmex)
+    : FGOutputFile(fdmex), SinglePrecision(false), RatePending(false),
+      RateHz(0.0), RateReady(false) {}
+  /// Destructor
+  ~FGOutputBinaryFile() { StopWriter(); }
+
+  /** Set the precision of the values of the properties.
+      @param flag true to store the values as float32, false to store them as
+                  float64. */
+  void SetSinglePrecision(bool flag) { SinglePrecision = flag; }
+
+  /** Init the output directives from an XML file.
+      @param element XML Element that is pointing to the output directives
+  */
+  virtual bool Load(Element* el);
+
+  /// Writes a record to the binary file.
+  virtual void Print(void);
+
+  /// Returns the size of a record.
+  virtual size_t GetSampleSize(void) const;
+  /// Packs the values into a record.
+  virtual void Sample(char* sample);
+  /// Writes a record packed by Sample() to the binary file.
+  virtual void PrintSample(const char* sample);
+
+  /// The version of the file format.
+  static const unsigned int Version = 1;
+
+protected:
+  bool SinglePrecision;
+  bool RatePending;
+  // The rate is computed by the simulation thread and written to the header
+  // by the thread that writes the records.
+  double RateHz;
+  std::atomic<bool> RateReady;
+  sg_ofstream datafile;
+  std::vector<char> Record;
+
+  virtual bool OpenFile(void);
+  virtual void CloseFile(void) { if (datafile.is_open()) datafile.close(); }
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
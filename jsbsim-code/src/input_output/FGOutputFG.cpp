@@ -349,4 +349,21 @@ void FGOutputFG::Print(void)
   SocketDataFill(&fgSockBuf);
   socket->Send((char *)&fgSockBuf, length);
 }
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputFG::Sample(char* sample)
+{
+  SocketDataFill(reinterpret_cast<FGNetFDM*>(sample));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputFG::PrintSample(const char* sample)
+{
+  if (socket == 0) return;
+  if (!socket->GetConnectStatus()) return;
+
+  socket->Send(sample, sizeof(FGNetFDM));
+}
 }
@@ -71,9 +71,18 @@ class FGOutputFG : public FGOutputSocket
 public:
   /// Constructor
   FGOutputFG(FGFDMExec* fdmex);
+  /// Destructor
+  ~FGOutputFG() { StopWriter(); }
 
   virtual void Print(void);
 
+  /// Returns the size of the FGNetFDM structure.
+  virtual size_t GetSampleSize(void) const { return sizeof(FGNetFDM); }
+  /// Fills a FGNetFDM structure.
+  virtual void Sample(char* sample);
+  /// Sends the FGNetFDM structure filled by Sample() to the socket.
+  virtual void PrintSample(const char* sample);
+
 protected:
   virtual void PrintHeaders(void) {};
 
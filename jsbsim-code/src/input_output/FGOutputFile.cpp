@@ -79,6 +79,9 @@ bool FGOutputFile::InitModel(void)
 
 void FGOutputFile::SetStartNewOutput(void)
 {
+  // The queued outputs belong to the current file.
+  Flush();
+
   if (runID_postfix >= 0) {
     ostringstream buf;
     string::size_type dot = Name.find_last_of('.');
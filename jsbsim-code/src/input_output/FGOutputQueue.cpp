@@ -0,0 +1,167 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGOutputQueue.cpp
+ Date started: 10/17/26
+ Purpose:      Queue the outputs to a writer thread
+ Called by:    FGOutputType
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+Head and Tail count the samples pushed and printed since the queue has been
+created, the slot of a sample being its count modulo the number of slots. The
+ring is empty when Head == Tail and full when Head - Tail == NumSlots. A slot is
+released (Tail is incremented) once its sample has been printed so the
+simulation thread never overwrites a sample that the writer thread is reading.
+
+The writer thread goes to sleep only once it has emptied the ring and wakes up
+on its own after WritePeriod. Before going to sleep, it sets Sleeping and checks
+Head again. The simulation thread increments Head before it checks Sleeping:
+when the sample brings the ring to WakeThreshold, either the writer thread sees
+it or the simulation thread sees that it must wake the writer thread up. The
+samples below the threshold wait at most WritePeriod.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <chrono>
+
+#include "FGOutputQueue.h"
+#include "FGOutputType.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_OUTPUTQUEUE);
+
+namespace {
+// The period at which the writer thread polls the ring when it is asleep.
+const chrono::milliseconds WritePeriod(10);
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGOutputQueue::FGOutputQueue(FGOutputType* output, size_t sampleSize,
+                             unsigned int numSlots)
+  : Output(output), NumSlots(numSlots > 0 ? numSlots : 1),
+    WakeThreshold((NumSlots + 1) / 2),
+    SlotSize((sampleSize + sizeof(double) - 1) / sizeof(double)),
+    Head(0), Tail(0), Written(0), Dropped(0), Overflows(0), WakeUps(0),
+    Full(false), Sleeping(false), Quit(false)
+{
+  if (SlotSize == 0) SlotSize = 1;
+  Buffer.resize(NumSlots * SlotSize);
+  Writer = thread(&FGOutputQueue::WriterLoop, this);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGOutputQueue::~FGOutputQueue()
+{
+  Quit = true;
+  WakeWriter();
+  Writer.join();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGOutputQueue::Push(void)
+{
+  unsigned long head = Head.load(memory_order_relaxed);
+
+  if (head - Tail.load(memory_order_acquire) >= NumSlots) {
+    if (!Full) {
+      Overflows++;
+      Full = true;
+    }
+    Dropped++;
+    return false;
+  }
+
+  Full = false;
+  Output->Sample(GetSlot(head));
+  Head.store(head + 1);
+
+  // The writer thread polls the ring by itself: it is only woken up when the
+  // samples are piling up.
+  if (head + 1 - Tail.load(memory_order_relaxed) >= WakeThreshold && Sleeping)
+    WakeWriter();
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputQueue::Flush(void)
+{
+  if (Tail.load(memory_order_acquire) != Head.load(memory_order_relaxed))
+    WakeWriter();
+
+  while (Tail.load(memory_order_acquire) != Head.load(memory_order_relaxed))
+    this_thread::sleep_for(chrono::microseconds(100));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputQueue::WakeWriter(void)
+{
+  // Taking the mutex guarantees that the writer thread is either waiting or
+  // has not checked Head yet.
+  lock_guard<mutex> lock(Mutex);
+  WakeUp.notify_one();
+  WakeUps++;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputQueue::WriterLoop(void)
+{
+  unsigned long tail = Tail.load(memory_order_relaxed);
+
+  while (true) {
+    unsigned long head = Head.load(memory_order_acquire);
+
+    if (head == tail) {
+      // The pending samples are all printed before the thread quits.
+      if (Quit) {
+        if (Head.load(memory_order_acquire) == tail) break;
+        continue;
+      }
+
+      unique_lock<mutex> lock(Mutex);
+      Sleeping = true;
+      if (Head.load() == tail && !Quit)
+        WakeUp.wait_for(lock, WritePeriod);
+      Sleeping = false;
+      continue;
+    }
+
+    for (; tail != head; ++tail) {
+      Output->PrintSample(GetSlot(tail));
+      Written.fetch_add(1, memory_order_relaxed);
+      Tail.store(tail + 1, memory_order_release);
+    }
+  }
+}
+}
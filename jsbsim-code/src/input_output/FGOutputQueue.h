@@ -0,0 +1,153 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGOutputQueue.h
+ Date started: 10/17/26
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGOUTPUTQUEUE_H
+#define FGOUTPUTQUEUE_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_OUTPUTQUEUE "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+class FGOutputType;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Queue of the samples of an asynchronous output and its writer thread.
+
+    The queue is a ring buffer of fixed size slots which is allocated once and
+    for all. It has a single producer, the simulation thread, and a single
+    consumer, the writer thread:
+    - Push() asks the output to copy its values into the next free slot
+      (FGOutputType::Sample()) and then publishes the slot. It never blocks nor
+      allocates: when the ring is full, the sample is dropped.
+    - the writer thread hands the published slots over to the output
+      (FGOutputType::PrintSample()) which formats and writes them. Once the
+      ring is empty, it sleeps for a few milliseconds before it polls the ring
+      again.
+
+    The slots are only handed over through the atomic indices of the head and
+    the tail of the ring. The simulation thread takes the mutex of the queue
+    only to wake the writer thread up when the ring gets half full while the
+    writer thread is asleep so most of the calls to Push() make no system call.
+    Flush() and the destructor also wake the writer thread up.
+
+    The destructor writes all the published samples before it stops the thread.
+ */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGOutputQueue
+{
+public:
+  /** Constructor. Allocates the ring and starts the writer thread.
+      @param output the output which samples and prints the data
+      @param sampleSize the size in bytes of a sample
+      @param numSlots the number of samples the ring can hold */
+  FGOutputQueue(FGOutputType* output, size_t sampleSize, unsigned int numSlots);
+
+  /// Destructor. Writes the pending samples and stops the writer thread.
+  ~FGOutputQueue();
+
+  /** Samples the output into the next free slot of the ring.
+      @result false if the ring was full and the sample has been dropped. */
+  bool Push(void);
+
+  /** Waits until the writer thread has printed all the pending samples. The
+      samples are then all counted by GetNumWritten(). */
+  void Flush(void);
+
+  /// Returns the number of samples printed by the writer thread.
+  unsigned long GetNumWritten(void) const
+  { return Written.load(std::memory_order_relaxed); }
+  /// Returns the number of samples dropped because the ring was full.
+  unsigned long GetNumDropped(void) const { return Dropped; }
+  /** Returns the number of times the ring has been found full, a run of
+      consecutive drops counting once. */
+  unsigned long GetNumOverflows(void) const { return Overflows; }
+  /// Returns the number of times the writer thread has been woken up.
+  unsigned long GetNumWakeUps(void) const { return WakeUps; }
+  /// Returns the number of samples waiting to be printed.
+  unsigned long GetNumPending(void) const
+  { return Head.load(std::memory_order_relaxed)
+      - Tail.load(std::memory_order_relaxed); }
+  /// Returns the number of samples the ring can hold.
+  unsigned int GetNumSlots(void) const { return NumSlots; }
+
+private:
+  FGOutputType* Output;
+  unsigned int NumSlots;
+  // The number of pending samples from which the writer thread is woken up.
+  unsigned int WakeThreshold;
+  // The slots are stored in doubles so that they are aligned for any value.
+  // SlotSize is thus the size of a slot in doubles.
+  size_t SlotSize;
+  std::vector<double> Buffer;
+
+  // Head is written by the simulation thread and Tail by the writer thread.
+  std::atomic<unsigned long> Head;
+  std::atomic<unsigned long> Tail;
+  std::atomic<unsigned long> Written;
+  unsigned long Dropped;
+  unsigned long Overflows;
+  unsigned long WakeUps;
+  bool Full;
+
+  std::atomic<bool> Sleeping;
+  std::atomic<bool> Quit;
+  std::mutex Mutex;
+  std::condition_variable WakeUp;
+  std::thread Writer;
+
+  char* GetSlot(unsigned long index)
+  { return reinterpret_cast<char*>(&Buffer[(index % NumSlots) * SlotSize]); }
+  void WakeWriter(void);
+  void WriterLoop(void);
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
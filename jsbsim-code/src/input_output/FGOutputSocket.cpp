@@ -42,6 +42,7 @@ INCLUDES
 #include <cstdlib>
 
 #include "FGOutputSocket.h"
+#include "binary_utilities.h"
 #include "FGFDMExec.h"
 #include "models/FGAerodynamics.h"
 #include "models/FGAccelerations.h"
@@ -55,6 +56,7 @@ INCLUDES
 #include "models/FGFCS.h"
 #include "models/atmosphere/FGWinds.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGPropertyManager.h"
 #include "math/FGPropertyValue.h"
 
 using namespace std;
@@ -64,13 +66,43 @@ namespace JSBSim {
 IDENT(IdSrc,"$Id: FGOutputSocket.cpp,v 1.9 2014/02/17 05:01:22 jberndt Exp $");
 IDENT(IdHdr,ID_OUTPUTSOCKET);
 
+namespace {
+
+const char Signature[8] = {'J', 'S', 'B', 'S', 'S', 'C', 'K', '\0'};
+// The type and the size of a message.
+const size_t MessageHeaderSize = 2*sizeof(uint32_t);
+// The message header followed by the number of frames and a null uint32.
+const size_t FramesHeaderSize = MessageHeaderSize + 2*sizeof(uint32_t);
+// The largest payload of an UDP datagram.
+const size_t MaxDatagramSize = 65507;
+// The largest number of frames sent per message.
+const unsigned int MaxFramesPerPacket = 4096;
+
+// Fills the type and the size of a message.
+void SetMessageHeader(vector<char>& message, uint32_t type)
+{
+  char* data = PackValue(&message[0], type);
+  PackValue(data, static_cast<uint32_t>(message.size()));
+}
+
+}
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 FGOutputSocket::FGOutputSocket(FGFDMExec* fdmex) :
   FGOutputType(fdmex),
-  socket(0)
+  socket(0),
+  BinaryFormat(false),
+  SinglePrecision(false),
+  NonBlocking(false),
+  FramesPerPacket(1),
+  Sequence(0),
+  NumFrames(0),
+  FramesSent(0),
+  FramesDropped(0),
+  PacketsSent(0)
 {
 }
 
@@ -78,6 +110,8 @@ FGOutputSocket::FGOutputSocket(FGFDMExec* fdmex) :
 
 FGOutputSocket::~FGOutputSocket()
 {
+  StopWriter();
+  CloseConnection();
   delete socket;
 }
 
@@ -124,6 +158,44 @@ bool FGOutputSocket::Load(Element* el)
                 el->GetAttributeValue("protocol") + "/" +
                 el->GetAttributeValue("port"));
 
+  string format = el->GetAttributeValue("format");
+  if (format == "binary")
+    BinaryFormat = true;
+  else if (!format.empty() && format != "text") {
+    cerr << el->ReadFrom() << fgred << "Unknown format " << format
+         << ". The values will be sent as text." << reset << endl;
+  }
+
+  if (!BinaryFormat) return true;
+
+  string precision = el->GetAttributeValue("precision");
+  if (precision == "single")
+    SinglePrecision = true;
+  else if (!precision.empty() && precision != "double") {
+    cerr << el->ReadFrom() << fgred << "Unknown precision " << precision
+         << ". The values will be sent in double precision." << reset << endl;
+  }
+
+  if (el->HasAttribute("batch")) {
+    double batch = el->GetAttributeValueAsNumber("batch");
+    if (batch >= 1.0 && batch <= MaxFramesPerPacket)
+      FramesPerPacket = static_cast<unsigned int>(batch);
+    else {
+      FramesPerPacket = batch > MaxFramesPerPacket ? MaxFramesPerPacket : 1;
+      cerr << el->ReadFrom() << fgred << "The batch size must be between 1 "
+           << "and " << MaxFramesPerPacket << ". " << FramesPerPacket
+           << " frames will be sent per message." << reset << endl;
+    }
+  }
+
+  NonBlocking = el->GetAttributeValue("nonblocking") == "true";
+
+  string outputProp = CreateIndexedPropertyName("simulation/output", OutputIdx);
+
+  PropertyManager->Tie(outputProp + "/socket/frames-sent", this, &FGOutputSocket::GetFramesSent);
+  PropertyManager->Tie(outputProp + "/socket/frames-dropped", this, &FGOutputSocket::GetFramesDropped);
+  PropertyManager->Tie(outputProp + "/socket/packets-sent", this, &FGOutputSocket::GetPacketsSent);
+
   return true;
 }
 
@@ -132,6 +204,7 @@ bool FGOutputSocket::Load(Element* el)
 bool FGOutputSocket::InitModel(void)
 {
   if (FGOutputType::InitModel()) {
+    CloseConnection();
     delete socket;
     socket = new FGfdmSocket(SockName, SockPort, SockProtocol);
 
@@ -152,6 +225,11 @@ void FGOutputSocket::PrintHeaders(void)
 {
   string scratch;
 
+  if (BinaryFormat) {
+    SendSchema();
+    return;
+  }
+
   socket->Clear();
   socket->Clear("<LABELS>");
   socket->Append("Time");
@@ -280,6 +358,12 @@ void FGOutputSocket::Print(void)
   if (socket == 0) return;
   if (!socket->GetConnectStatus()) return;
 
+  if (BinaryFormat) {
+    Sample(&Frame[0]);
+    PrintSample(&Frame[0]);
+    return;
+  }
+
   socket->Clear();
   socket->Append(FDMExec->GetSimTime());
 
@@ -386,15 +470,181 @@ void FGOutputSocket::Print(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+size_t FGOutputSocket::GetSampleSize(void) const
+{
+  if (BinaryFormat) return sizeof(uint64_t) + GetRecordSize(SinglePrecision);
+  if (SubSystems) return 0;
+
+  return (1 + OutputParameters.size()) * sizeof(double);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputSocket::Sample(char* sample)
+{
+  if (BinaryFormat) {
+    PackRecord(PackValue(sample, Sequence++), SinglePrecision);
+    return;
+  }
+
+  double* values = reinterpret_cast<double*>(sample);
+
+  *values++ = FDMExec->GetSimTime();
+  for (unsigned int i=0;i<OutputParameters.size();++i)
+    *values++ = OutputParameters[i]->GetValue();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputSocket::PrintSample(const char* sample)
+{
+  const double* values = reinterpret_cast<const double*>(sample);
+
+  if (socket == 0) return;
+  if (!socket->GetConnectStatus()) return;
+
+  if (BinaryFormat) {
+    if (NumFrames == 0) Packet.resize(FramesHeaderSize);
+    Packet.insert(Packet.end(), sample, sample + GetSampleSize());
+    if (++NumFrames >= FramesPerPacket) SendFrames();
+    return;
+  }
+
+  socket->Clear();
+  for (unsigned int i=0;i<=OutputParameters.size();++i)
+    socket->Append(values[i]);
+
+  socket->Send();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGOutputSocket::SocketStatusOutput(const string& out_str)
 {
   string asciiData;
 
   if (socket == 0) return;
 
+  // The status must not be interleaved with the data of a queued output.
+  Flush();
+
+  if (BinaryFormat) {
+    SendFrames();
+
+    vector<char> message;
+    AppendValue(message, static_cast<uint32_t>(msgStatus));
+    AppendValue(message, static_cast<uint32_t>(MessageHeaderSize + out_str.size()));
+    message.insert(message.end(), out_str.begin(), out_str.end());
+    SendMessage(message);
+    return;
+  }
+
   socket->Clear();
   asciiData = string("<STATUS>") + out_str;
   socket->Append(asciiData.c_str());
   socket->Send();
 }
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputSocket::SendSchema(void)
+{
+  if (SubSystems)
+    cerr << fgred << "The subsystems groups are not sent in the binary format to "
+         << reset << Name << endl;
+
+  size_t frameSize = GetSampleSize();
+
+  if (SockProtocol == FGfdmSocket::ptUDP
+      && FramesHeaderSize + FramesPerPacket*frameSize > MaxDatagramSize) {
+    FramesPerPacket = (MaxDatagramSize - FramesHeaderSize) / frameSize;
+    if (FramesPerPacket == 0) FramesPerPacket = 1;
+    cerr << fgred << "The batches of " << Name << " are limited to "
+         << FramesPerPacket << " frames to fit in a datagram." << reset << endl;
+  }
+
+  vector<char> columns;
+  DescribeColumns(columns, SinglePrecision);
+
+  vector<char> message(MessageHeaderSize);
+  message.insert(message.end(), Signature, Signature + sizeof(Signature));
+  AppendValue(message, static_cast<uint32_t>(Version));
+  AppendValue(message, static_cast<uint32_t>(frameSize));
+  AppendValue(message, static_cast<uint32_t>(1 + OutputParameters.size()
+                                             + PreFunctions.size()));
+  AppendValue(message, static_cast<uint32_t>(FramesPerPacket));
+  message.insert(message.end(), columns.begin(), columns.end());
+  message.resize((message.size() + 7) & ~size_t(7), '\0');
+  SetMessageHeader(message, msgSchema);
+
+  // The schema is always sent in full: the socket only becomes non-blocking
+  // for the frames.
+  socket->SetBlocking(true);
+  SendMessage(message);
+  socket->SetBlocking(!NonBlocking);
+
+  Frame.resize(frameSize);
+  Packet.reserve(FramesHeaderSize + FramesPerPacket*frameSize);
+  Packet.clear();
+  NumFrames = 0;
+  Sequence = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputSocket::SendFrames(void)
+{
+  if (NumFrames == 0 || socket == 0) return;
+
+  SetMessageHeader(Packet, msgFrames);
+  PackValue(&Packet[MessageHeaderSize], static_cast<uint32_t>(NumFrames));
+  PackValue(&Packet[MessageHeaderSize + sizeof(uint32_t)], uint32_t(0));
+
+  if (SendMessage(Packet)) {
+    FramesSent += NumFrames;
+    PacketsSent++;
+  } else
+    FramesDropped += NumFrames;
+
+  Packet.clear();
+  NumFrames = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputSocket::CloseConnection(void)
+{
+  if (socket == 0 || !BinaryFormat) return;
+
+  // The client must receive whole messages so the socket waits for the end of
+  // a partially sent message and for the frames of the current batch.
+  socket->SetBlocking(true);
+  SendFrames();
+  if (!Unsent.empty()) {
+    socket->Send(&Unsent[0], Unsent.size());
+    Unsent.clear();
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGOutputSocket::SendMessage(const vector<char>& message)
+{
+  // The end of a message that a TCP socket has partially accepted must be
+  // sent first otherwise the client would lose track of the messages.
+  if (!Unsent.empty()) {
+    int sent = socket->Send(&Unsent[0], Unsent.size());
+    if (sent > 0) Unsent.erase(Unsent.begin(), Unsent.begin() + sent);
+    if (!Unsent.empty()) return false;
+  }
+
+  int sent = socket->Send(&message[0], message.size());
+
+  if (sent <= 0) return false;
+
+  if (static_cast<size_t>(sent) < message.size())
+    Unsent.assign(message.begin() + sent, message.end());
+
+  return true;
+}
 }
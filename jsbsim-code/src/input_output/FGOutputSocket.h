@@ -38,6 +38,10 @@ SENTRY
 INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+
 #include "FGOutputType.h"
 #include "input_output/net_fdm.hxx"
 #include "input_output/FGfdmSocket.h"
@@ -63,6 +67,45 @@ CLASS DOCUMENTATION
     provides services for socket outputs. For instance FGOutputFG inherits
     FGOutputSocket for the socket management but outputs data with a format
     different than FGOutputSocket.
+
+    By default the values are sent as lines of comma separated text. With the
+    attribute <tt>format="binary"</tt>, the properties and the functions of the
+    output are sent as binary frames instead:
+
+@code
+<output name="localhost" type="SOCKET" protocol="UDP" port="5138" rate="120"
+        format="binary" batch="10" precision="single" nonblocking="true">
+  <property> velocities/vc-kts </property>
+  <property caption="Altitude (ft)"> position/h-sl-ft </property>
+</output>
+@endcode
+
+    All the numbers are little-endian. Each message starts with its type
+    (uint32) and its size in bytes including these 8 bytes (uint32):
+    - A schema message (type 1) is sent once the socket is connected. It holds
+      the signature "JSBSSCK" followed by a null character, the version of the
+      protocol (uint32, currently 1), the size of a frame (uint32), the number
+      of columns (uint32), the maximum number of frames per message (uint32)
+      and the description of the columns in the format of the header of
+      FGOutputBinaryFile, followed by null bytes up to a multiple of 8 bytes.
+    - A frames message (type 2) holds the number of frames it carries (uint32)
+      and a null uint32, followed by the frames. A frame is made of a sequence
+      number (uint64, incremented at each frame) followed by a record: the
+      simulation time (float64) and the values, as float32 if
+      <tt>precision="single"</tt> is specified or float64 otherwise.
+    - A status message (type 3) holds the text of a status sent by
+      SocketStatusOutput().
+
+    The attribute <tt>batch</tt> sets the number of frames sent per message
+    (1 by default, at most 4096). A partial batch is sent when the output is
+    closed or a status is sent. With <tt>nonblocking="true"</tt> the frames are
+    dropped instead of waiting for the socket to be ready, except when the
+    output is closed: its last messages are then sent in full. The frames sent
+    and dropped are counted by the properties
+    <tt>simulation/output[n]/socket/frames-sent</tt>,
+    <tt>simulation/output[n]/socket/frames-dropped</tt> and
+    <tt>simulation/output[n]/socket/packets-sent</tt>. The subsystems groups
+    are only sent in the text format.
  */
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -101,19 +144,63 @@ public:
   /// Generates the output.
   void Print(void);
 
+  /** Returns the size of the values to output. The outputs of subsystems
+      groups can not be asynchronous. */
+  virtual size_t GetSampleSize(void) const;
+  /// Copies the simulation time and the values of the properties.
+  virtual void Sample(char* sample);
+  /// Sends the values copied by Sample() to the socket.
+  virtual void PrintSample(const char* sample);
+
   /** Outputs a status thru the socket. This method issues a message prepended
       by the string "<STATUS>" to the socket.
       @param out_str status message
    */
   void SocketStatusOutput(const std::string& out_str);
 
+  /// The version of the binary protocol.
+  static const unsigned int Version = 1;
+
+  /// The types of the messages of the binary protocol.
+  enum eMessageType {msgSchema = 1, msgFrames = 2, msgStatus = 3};
+
 protected:
   virtual void PrintHeaders(void);
+  /// Sends the schema of the binary frames.
+  void SendSchema(void);
+  /// Sends the frames of the current batch, if any.
+  void SendFrames(void);
+  /** Sends a message of the binary protocol. In non-blocking mode the
+      message is dropped if the socket is not ready. A message which is
+      partially sent is completed before the next one is sent.
+      @return true if the message has been sent. */
+  bool SendMessage(const std::vector<char>& message);
+  /** Sends the frames of the current batch and the end of a partially sent
+      message, waiting for the socket if needed, before it is closed. */
+  void CloseConnection(void);
+
+  double GetFramesSent(void) const { return FramesSent; }
+  double GetFramesDropped(void) const { return FramesDropped; }
+  double GetPacketsSent(void) const { return PacketsSent; }
 
   std::string SockName;
   unsigned int SockPort;
   FGfdmSocket::ProtocolType SockProtocol;
   FGfdmSocket* socket;
+
+  bool BinaryFormat;
+  bool SinglePrecision;
+  bool NonBlocking;
+  unsigned int FramesPerPacket;
+  uint64_t Sequence;
+  std::vector<char> Frame;
+  // The frames message being filled, with the number of frames it holds.
+  std::vector<char> Packet;
+  unsigned int NumFrames;
+  // The bytes of a message that the socket has not yet accepted.
+  std::vector<char> Unsent;
+  // The counters are updated by the writer thread of asynchronous outputs.
+  std::atomic<unsigned long> FramesSent, FramesDropped, PacketsSent;
 };
 }
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -105,7 +105,9 @@ bool FGOutputTextFile::OpenFile(void)
     return false;
   }
 
-  string scratch = "";
+  string scratch = Filename.utf8Str();
+  DataStream = to_upper(scratch) == "COUT" ? &cout : &datafile;
+
   streambuf* buffer = datafile.rdbuf();
   ostream outstream(buffer);
 
@@ -257,149 +259,190 @@ bool FGOutputTextFile::OpenFile(void)
 
 void FGOutputTextFile::Print(void)
 {
-  streambuf* buffer;
-  string scratch = Filename.utf8Str();
+  string scratch;
 
-  if (to_upper(scratch) == "COUT") {
-    buffer = cout.rdbuf();
-  } else {
-    buffer = datafile.rdbuf();
-  }
-
-  ostream outstream(buffer);
+  Buffer.Clear();
+  Buffer.SetPrecision(10);
 
-  outstream.precision(10);
-
-  outstream << FDMExec->GetSimTime();
+  Buffer << FDMExec->GetSimTime();
   if (SubSystems & ssSimulation) {
   }
   if (SubSystems & ssAerosurfaces) {
-    outstream << delimeter;
-    outstream << FCS->GetDaCmd() << delimeter;
-    outstream << FCS->GetDeCmd() << delimeter;
-    outstream << FCS->GetDrCmd() << delimeter;
-    outstream << FCS->GetDfCmd() << delimeter;
-    outstream << FCS->GetDaLPos(ofDeg) << delimeter;
-    outstream << FCS->GetDaRPos(ofDeg) << delimeter;
-    outstream << FCS->GetDePos(ofDeg) << delimeter;
-    outstream << FCS->GetDrPos(ofDeg) << delimeter;
-    outstream << FCS->GetDfPos(ofDeg);
+    Buffer << delimeter;
+    Buffer << FCS->GetDaCmd() << delimeter;
+    Buffer << FCS->GetDeCmd() << delimeter;
+    Buffer << FCS->GetDrCmd() << delimeter;
+    Buffer << FCS->GetDfCmd() << delimeter;
+    Buffer << FCS->GetDaLPos(ofDeg) << delimeter;
+    Buffer << FCS->GetDaRPos(ofDeg) << delimeter;
+    Buffer << FCS->GetDePos(ofDeg) << delimeter;
+    Buffer << FCS->GetDrPos(ofDeg) << delimeter;
+    Buffer << FCS->GetDfPos(ofDeg);
   }
   if (SubSystems & ssRates) {
-    outstream << delimeter;
-    outstream << (radtodeg*Propagate->GetPQR()).Dump(delimeter) << delimeter;
-    outstream << (radtodeg*Accelerations->GetPQRdot()).Dump(delimeter) << delimeter;
-    outstream << (radtodeg*Propagate->GetPQRi()).Dump(delimeter);
+    Buffer << delimeter;
+    Buffer.Append(radtodeg*Propagate->GetPQR(), delimeter) << delimeter;
+    Buffer.Append(radtodeg*Accelerations->GetPQRdot(), delimeter) << delimeter;
+    Buffer.Append(radtodeg*Propagate->GetPQRi(), delimeter);
   }
   if (SubSystems & ssVelocities) {
-    outstream << delimeter;
-    outstream << Auxiliary->Getqbar() << delimeter;
-    outstream << Auxiliary->GetReynoldsNumber() << delimeter;
-    outstream << setprecision(12) << Auxiliary->GetVt() << delimeter;
-    outstream << Propagate->GetInertialVelocityMagnitude() << delimeter;
-    outstream << setprecision(12) << Propagate->GetUVW().Dump(delimeter) << delimeter;
-    outstream << setprecision(12) << Accelerations->GetUVWdot().Dump(delimeter) << delimeter;
-    outstream << setprecision(12) << Accelerations->GetUVWidot().Dump(delimeter) << delimeter;
-    outstream << setprecision(12) << Accelerations->GetBodyAccel().Dump(delimeter) << delimeter;
-    outstream << Auxiliary->GetAeroUVW().Dump(delimeter) << delimeter;
-    outstream << Propagate->GetInertialVelocity().Dump(delimeter) << delimeter;
-    outstream << Propagate->GetECEFVelocity().Dump(delimeter) << delimeter;
-    outstream << Propagate->GetVel().Dump(delimeter);
-    outstream.precision(10);
+    Buffer << delimeter;
+    Buffer << Auxiliary->Getqbar() << delimeter;
+    Buffer << Auxiliary->GetReynoldsNumber() << delimeter;
+    Buffer.SetPrecision(12);
+    Buffer << Auxiliary->GetVt() << delimeter;
+    Buffer << Propagate->GetInertialVelocityMagnitude() << delimeter;
+    Buffer.Append(Propagate->GetUVW(), delimeter) << delimeter;
+    Buffer.Append(Accelerations->GetUVWdot(), delimeter) << delimeter;
+    Buffer.Append(Accelerations->GetUVWidot(), delimeter) << delimeter;
+    Buffer.Append(Accelerations->GetBodyAccel(), delimeter) << delimeter;
+    Buffer.Append(Auxiliary->GetAeroUVW(), delimeter) << delimeter;
+    Buffer.Append(Propagate->GetInertialVelocity(), delimeter) << delimeter;
+    Buffer.Append(Propagate->GetECEFVelocity(), delimeter) << delimeter;
+    Buffer.Append(Propagate->GetVel(), delimeter);
+    Buffer.SetPrecision(10);
   }
   if (SubSystems & ssForces) {
-    outstream << delimeter;
-    outstream << Aerodynamics->GetvFw().Dump(delimeter) << delimeter;
-    outstream << Aerodynamics->GetLoD() << delimeter;
-    outstream << Aerodynamics->GetForces().Dump(delimeter) << delimeter;
-    outstream << Propulsion->GetForces().Dump(delimeter) << delimeter;
-    outstream << Accelerations->GetGroundForces().Dump(delimeter) << delimeter;
-    outstream << ExternalReactions->GetForces().Dump(delimeter) << delimeter;
-    outstream << BuoyantForces->GetForces().Dump(delimeter) << delimeter;
-    outstream << Accelerations->GetWeight().Dump(delimeter) << delimeter;
-    outstream << Accelerations->GetForces().Dump(delimeter);
+    Buffer << delimeter;
+    Buffer.Append(Aerodynamics->GetvFw(), delimeter) << delimeter;
+    Buffer << Aerodynamics->GetLoD() << delimeter;
+    Buffer.Append(Aerodynamics->GetForces(), delimeter) << delimeter;
+    Buffer.Append(Propulsion->GetForces(), delimeter) << delimeter;
+    Buffer.Append(Accelerations->GetGroundForces(), delimeter) << delimeter;
+    Buffer.Append(ExternalReactions->GetForces(), delimeter) << delimeter;
+    Buffer.Append(BuoyantForces->GetForces(), delimeter) << delimeter;
+    Buffer.Append(Accelerations->GetWeight(), delimeter) << delimeter;
+    Buffer.Append(Accelerations->GetForces(), delimeter);
   }
   if (SubSystems & ssMoments) {
-    outstream << delimeter;
-    outstream << Aerodynamics->GetMoments().Dump(delimeter) << delimeter;
-    outstream << Aerodynamics->GetMomentsMRC().Dump(delimeter) << delimeter;
-    outstream << Propulsion->GetMoments().Dump(delimeter) << delimeter;
-    outstream << Accelerations->GetGroundMoments().Dump(delimeter) << delimeter;
-    outstream << ExternalReactions->GetMoments().Dump(delimeter) << delimeter;
-    outstream << BuoyantForces->GetMoments().Dump(delimeter) << delimeter;
-    outstream << Accelerations->GetMoments().Dump(delimeter);
+    Buffer << delimeter;
+    Buffer.Append(Aerodynamics->GetMoments(), delimeter) << delimeter;
+    Buffer.Append(Aerodynamics->GetMomentsMRC(), delimeter) << delimeter;
+    Buffer.Append(Propulsion->GetMoments(), delimeter) << delimeter;
+    Buffer.Append(Accelerations->GetGroundMoments(), delimeter) << delimeter;
+    Buffer.Append(ExternalReactions->GetMoments(), delimeter) << delimeter;
+    Buffer.Append(BuoyantForces->GetMoments(), delimeter) << delimeter;
+    Buffer.Append(Accelerations->GetMoments(), delimeter);
   }
   if (SubSystems & ssAtmosphere) {
-    outstream << delimeter;
-    outstream << Atmosphere->GetDensity() << delimeter;
-    outstream << Atmosphere->GetAbsoluteViscosity() << delimeter;
-    outstream << Atmosphere->GetKinematicViscosity() << delimeter;
-    outstream << Atmosphere->GetTemperature() << delimeter;
-    outstream << Atmosphere->GetPressureSL() << delimeter;
-    outstream << Atmosphere->GetPressure() << delimeter;
-    outstream << Winds->GetTurbMagnitude() << delimeter;
-    outstream << Winds->GetTurbDirection() << delimeter;
-    outstream << Winds->GetTotalWindNED().Dump(delimeter) << delimeter;
-    outstream << (Winds->GetTurbPQR()*radtodeg).Dump(delimeter);
+    Buffer << delimeter;
+    Buffer << Atmosphere->GetDensity() << delimeter;
+    Buffer << Atmosphere->GetAbsoluteViscosity() << delimeter;
+    Buffer << Atmosphere->GetKinematicViscosity() << delimeter;
+    Buffer << Atmosphere->GetTemperature() << delimeter;
+    Buffer << Atmosphere->GetPressureSL() << delimeter;
+    Buffer << Atmosphere->GetPressure() << delimeter;
+    Buffer << Winds->GetTurbMagnitude() << delimeter;
+    Buffer << Winds->GetTurbDirection() << delimeter;
+    Buffer.Append(Winds->GetTotalWindNED(), delimeter) << delimeter;
+    Buffer.Append(Winds->GetTurbPQR()*radtodeg, delimeter);
   }
   if (SubSystems & ssMassProps) {
-    outstream << delimeter;
-    outstream << MassBalance->GetJ().Dump(delimeter) << delimeter;
-    outstream << MassBalance->GetMass() << delimeter;
-    outstream << MassBalance->GetWeight() << delimeter;
-    outstream << MassBalance->GetXYZcg().Dump(delimeter);
+    Buffer << delimeter;
+    Buffer.Append(MassBalance->GetJ(), delimeter) << delimeter;
+    Buffer << MassBalance->GetMass() << delimeter;
+    Buffer << MassBalance->GetWeight() << delimeter;
+    Buffer.Append(MassBalance->GetXYZcg(), delimeter);
   }
   if (SubSystems & ssPropagate) {
-    outstream.precision(14);
-    outstream << delimeter;
-    outstream << Propagate->GetAltitudeASL() << delimeter;
-    outstream << Propagate->GetDistanceAGL() << delimeter;
-    outstream << (radtodeg*Propagate->GetEuler()).Dump(delimeter) << delimeter;
-    outstream << Propagate->GetQuaternion().Dump(delimeter) << delimeter;
+    Buffer.SetPrecision(14);
+    Buffer << delimeter;
+    Buffer << Propagate->GetAltitudeASL() << delimeter;
+    Buffer << Propagate->GetDistanceAGL() << delimeter;
+    Buffer.Append(radtodeg*Propagate->GetEuler(), delimeter) << delimeter;
+    Buffer.Append(Propagate->GetQuaternion(), delimeter) << delimeter;
     FGQuaternion Qec = Propagate->GetQuaternionECEF();
-    outstream << Qec.Dump(delimeter) << delimeter;
-    outstream << Propagate->GetQuaternionECI().Dump(delimeter) << delimeter;
-    outstream << Auxiliary->Getalpha(inDegrees) << delimeter;
-    outstream << Auxiliary->Getbeta(inDegrees) << delimeter;
-    outstream << Propagate->GetLocation().GetLatitudeDeg() << delimeter;
-    outstream << Propagate->GetLocation().GetGeodLatitudeDeg() << delimeter;
-    outstream << Propagate->GetLocation().GetLongitudeDeg() << delimeter;
-    outstream.precision(18);
-    outstream << ((FGColumnVector3)Propagate->GetInertialPosition()).Dump(delimeter) << delimeter;
-    outstream << ((FGColumnVector3)Propagate->GetLocation()).Dump(delimeter) << delimeter;
-    outstream.precision(14);
-    outstream << Propagate->GetEarthPositionAngleDeg() << delimeter;
-    outstream << Propagate->GetDistanceAGL() << delimeter;
-    outstream << Propagate->GetTerrainElevation();
-    outstream.precision(10);
+    Buffer.Append(Qec, delimeter) << delimeter;
+    Buffer.Append(Propagate->GetQuaternionECI(), delimeter) << delimeter;
+    Buffer << Auxiliary->Getalpha(inDegrees) << delimeter;
+    Buffer << Auxiliary->Getbeta(inDegrees) << delimeter;
+    Buffer << Propagate->GetLocation().GetLatitudeDeg() << delimeter;
+    Buffer << Propagate->GetLocation().GetGeodLatitudeDeg() << delimeter;
+    Buffer << Propagate->GetLocation().GetLongitudeDeg() << delimeter;
+    Buffer.Append((FGColumnVector3)Propagate->GetInertialPosition(), delimeter) << delimeter;
+    Buffer.Append((FGColumnVector3)Propagate->GetLocation(), delimeter) << delimeter;
+    Buffer << Propagate->GetEarthPositionAngleDeg() << delimeter;
+    Buffer << Propagate->GetDistanceAGL() << delimeter;
+    Buffer << Propagate->GetTerrainElevation();
+    Buffer.SetPrecision(10);
   }
   if (SubSystems & ssAeroFunctions) {
     scratch = Aerodynamics->GetAeroFunctionValues(delimeter);
-    if (scratch.length() != 0) outstream << delimeter << scratch;
+    if (scratch.length() != 0) Buffer << delimeter << scratch;
   }
   if (SubSystems & ssFCS) {
     scratch = FCS->GetComponentValues(delimeter);
-    if (scratch.length() != 0) outstream << delimeter << scratch;
+    if (scratch.length() != 0) Buffer << delimeter << scratch;
   }
   if (SubSystems & ssGroundReactions) {
-    outstream << delimeter;
-    outstream << GroundReactions->GetGroundReactionValues(delimeter);
+    Buffer << delimeter;
+    Buffer << GroundReactions->GetGroundReactionValues(delimeter);
   }
   if (SubSystems & ssPropulsion && Propulsion->GetNumEngines() > 0) {
-    outstream << delimeter;
-    outstream << Propulsion->GetPropulsionValues(delimeter);
+    Buffer << delimeter;
+    Buffer << Propulsion->GetPropulsionValues(delimeter);
   }
 
-  outstream.precision(18);
+  Buffer.SetPrecision(18);
   for (unsigned int i=0;i<OutputParameters.size();++i) {
-    outstream << delimeter << OutputParameters[i]->GetValue();
+    Buffer << delimeter << OutputParameters[i]->GetValue();
   }
   for (unsigned int i=0;i<PreFunctions.size();i++) {
-    outstream << delimeter << PreFunctions[i]->getDoubleValue();
+    Buffer << delimeter << PreFunctions[i]->getDoubleValue();
   }
-  outstream.precision(10);
+  Buffer << '\n';
 
-  outstream << endl;
-  outstream.flush();
+  WriteBuffer();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+size_t FGOutputTextFile::GetSampleSize(void) const
+{
+  if (SubSystems) return 0;
+
+  return (1 + OutputParameters.size() + PreFunctions.size()) * sizeof(double);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputTextFile::Sample(char* sample)
+{
+  double* values = reinterpret_cast<double*>(sample);
+
+  *values++ = FDMExec->GetSimTime();
+  for (unsigned int i=0;i<OutputParameters.size();++i)
+    *values++ = OutputParameters[i]->GetValue();
+  for (unsigned int i=0;i<PreFunctions.size();i++)
+    *values++ = PreFunctions[i]->getDoubleValue();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputTextFile::PrintSample(const char* sample)
+{
+  const double* values = reinterpret_cast<const double*>(sample);
+  size_t numValues = OutputParameters.size() + PreFunctions.size();
+
+  // The values are formatted as Print() does.
+  Buffer.Clear();
+  Buffer.SetPrecision(10);
+  Buffer << values[0];
+
+  Buffer.SetPrecision(18);
+  for (unsigned int i=1;i<=numValues;++i) {
+    Buffer << delimeter << values[i];
+  }
+  Buffer << '\n';
+
+  WriteBuffer();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputTextFile::WriteBuffer(void)
+{
+  DataStream->write(Buffer.GetData(), Buffer.GetSize());
+  DataStream->flush();
 }
 }
@@ -41,6 +41,7 @@ INCLUDES
 #include <fstream>
 
 #include "FGOutputFile.h"
+#include "FGTextBuffer.h"
 #include "simgear/io/iostreams/sgstream.hxx"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -72,7 +73,10 @@ class FGOutputTextFile : public FGOutputFile
 {
 public:
   /// Constructor
-  FGOutputTextFile(FGFDMExec* fdmex) : FGOutputFile(fdmex), delimeter(",") {}
+  FGOutputTextFile(FGFDMExec* fdmex)
+    : FGOutputFile(fdmex), delimeter(","), DataStream(&datafile) {}
+  /// Destructor
+  ~FGOutputTextFile() { StopWriter(); }
 
   /** Set the delimiter.
       @param delim delimiter of the output values (most likely a comma or a
@@ -88,12 +92,26 @@ public:
   /// Generates the output to the text file.
   virtual void Print(void);
 
+  /** Returns the size of the values to output. The outputs of subsystems
+      groups can not be asynchronous. */
+  virtual size_t GetSampleSize(void) const;
+  /// Copies the simulation time and the values of the properties.
+  virtual void Sample(char* sample);
+  /// Writes the values copied by Sample() to the text file.
+  virtual void PrintSample(const char* sample);
+
 protected:
   std::string delimeter;
   sg_ofstream datafile;
+  /// The stream to which the data is written: the file or the console.
+  std::ostream* DataStream;
+  /// The line being formatted. It is reused from one output to the next.
+  FGTextBuffer Buffer;
 
   virtual bool OpenFile(void);
   virtual void CloseFile(void) { if (datafile.is_open()) datafile.close(); }
+  /// Writes the formatted line to the file or to the console in one call.
+  void WriteBuffer(void);
 };
 }
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -41,6 +41,8 @@ INCLUDES
 
 #include "FGFDMExec.h"
 #include "FGOutputType.h"
+#include "FGOutputQueue.h"
+#include "binary_utilities.h"
 #include "input_output/FGXMLElement.h"
 #include "input_output/FGPropertyManager.h"
 #include "math/FGTemplateFunc.h"
@@ -53,6 +55,25 @@ IDENT(IdHdr,ID_OUTPUTTYPE);
 
 using namespace std;
 
+namespace {
+
+// The largest number of outputs that can be queued by an asynchronous output.
+const unsigned int MaxQueueSize = 65536;
+
+// Returns the unit of a property from the suffix of its name.
+string GetUnit(const string& name)
+{
+  string::size_type slash = name.find_last_of('/');
+  string::size_type dash = name.find_last_of('-');
+
+  if (dash == string::npos || (slash != string::npos && dash < slash))
+    return string();
+
+  return name.substr(dash + 1);
+}
+
+}
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -60,7 +81,14 @@ CLASS IMPLEMENTATION
 FGOutputType::FGOutputType(FGFDMExec* fdmex) :
   FGModel(fdmex),
   SubSystems(0),
-  enabled(true)
+  enabled(true),
+  Asynchronous(false),
+  QueueSize(256),
+  Queue(0),
+  NumWritten(0),
+  NumDropped(0),
+  NumOverflows(0),
+  NumWakeUps(0)
 {
   Aerodynamics = FDMExec->GetAerodynamics();
   Auxiliary = FDMExec->GetAuxiliary();
@@ -83,6 +111,8 @@ FGOutputType::FGOutputType(FGFDMExec* fdmex) :
 
 FGOutputType::~FGOutputType()
 {
+  StopWriter();
+
   vector<FGPropertyValue*>::iterator it;
   for (it=OutputParameters.begin(); it != OutputParameters.end(); ++it)
     delete *it;
@@ -98,6 +128,11 @@ void FGOutputType::SetIdx(unsigned int idx)
 
   PropertyManager->Tie(outputProp + "/log_rate_hz", this, &FGOutputType::GetRateHz, &FGOutputType::SetRateHz, false);
   PropertyManager->Tie(outputProp + "/enabled", &enabled);
+  PropertyManager->Tie(outputProp + "/queue/pending", this, &FGOutputType::GetQueuePending);
+  PropertyManager->Tie(outputProp + "/queue/written", this, &FGOutputType::GetQueueWritten);
+  PropertyManager->Tie(outputProp + "/queue/dropped", this, &FGOutputType::GetQueueDropped);
+  PropertyManager->Tie(outputProp + "/queue/overflows", this, &FGOutputType::GetQueueOverflows);
+  PropertyManager->Tie(outputProp + "/queue/wakeups", this, &FGOutputType::GetQueueWakeUps);
   OutputIdx = idx;
 }
 
@@ -175,6 +210,22 @@ bool FGOutputType::Load(Element* element)
 
   SetRateHz(outRate);
 
+  if (element->GetAttributeValue("async") == "true") {
+    unsigned int queueSize = 256;
+    if (element->HasAttribute("queue_size")) {
+      double size = element->GetAttributeValueAsNumber("queue_size");
+      if (size >= 1.0 && size <= MaxQueueSize)
+        queueSize = static_cast<unsigned int>(size);
+      else {
+        queueSize = size > MaxQueueSize ? MaxQueueSize : 1;
+        cerr << element->ReadFrom() << fgred << "The queue size must be "
+             << "between 1 and " << MaxQueueSize << ". The queue will hold "
+             << queueSize << " outputs." << reset << endl;
+      }
+    }
+    SetAsynchronous(true, queueSize);
+  }
+
   return true;
 }
 
@@ -182,6 +233,9 @@ bool FGOutputType::Load(Element* element)
 
 bool FGOutputType::InitModel(void)
 {
+  // The output may be reopened so the queued outputs are written first.
+  StopWriter();
+
   bool ret = FGModel::InitModel();
 
   Debug(2);
@@ -196,7 +250,7 @@ bool FGOutputType::Run(void)
   if (!enabled) return true;
 
   RunPreFunctions();
-  Print();
+  Generate();
   RunPostFunctions();
 
   Debug(4);
@@ -206,6 +260,150 @@ bool FGOutputType::Run(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGOutputType::Generate(void)
+{
+  if (Asynchronous && !Queue) {
+    size_t size = GetSampleSize();
+
+    if (size > 0)
+      Queue = new FGOutputQueue(this, size, QueueSize);
+    else {
+      cerr << fgred << "The output " << GetOutputName()
+           << " can not be asynchronous. It will be generated synchronously."
+           << reset << endl;
+      Asynchronous = false;
+    }
+  }
+
+  if (Queue)
+    Queue->Push();
+  else
+    Print();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputType::SetAsynchronous(bool flag, unsigned int queueSize)
+{
+  StopWriter();
+  Asynchronous = flag;
+  QueueSize = queueSize > 0 ? queueSize : 1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputType::Flush(void)
+{
+  if (Queue) Queue->Flush();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputType::StopWriter(void)
+{
+  if (!Queue) return;
+
+  Queue->Flush();
+  NumWritten += Queue->GetNumWritten();
+  NumDropped += Queue->GetNumDropped();
+  NumOverflows += Queue->GetNumOverflows();
+  NumWakeUps += Queue->GetNumWakeUps();
+  delete Queue;
+  Queue = 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGOutputType::GetQueuePending(void) const
+{
+  return Queue ? Queue->GetNumPending() : 0.0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGOutputType::GetQueueWritten(void) const
+{
+  return NumWritten + (Queue ? Queue->GetNumWritten() : 0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGOutputType::GetQueueDropped(void) const
+{
+  return NumDropped + (Queue ? Queue->GetNumDropped() : 0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGOutputType::GetQueueOverflows(void) const
+{
+  return NumOverflows + (Queue ? Queue->GetNumOverflows() : 0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGOutputType::GetQueueWakeUps(void) const
+{
+  return NumWakeUps + (Queue ? Queue->GetNumWakeUps() : 0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputType::DescribeColumns(vector<char>& columns,
+                                   bool singlePrecision) const
+{
+  const char type = singlePrecision ? 'f' : 'd';
+
+  columns.push_back('d');
+  AppendString(columns, "Time");
+  AppendString(columns, "sec");
+
+  for (unsigned int i=0; i<OutputParameters.size(); ++i) {
+    columns.push_back(type);
+    if (!OutputCaptions[i].empty())
+      AppendString(columns, OutputCaptions[i]);
+    else
+      AppendString(columns, OutputParameters[i]->GetFullyQualifiedName());
+    AppendString(columns, GetUnit(OutputParameters[i]->GetName()));
+  }
+
+  for (unsigned int i=0; i<PreFunctions.size(); ++i) {
+    columns.push_back(type);
+    AppendString(columns, PreFunctions[i]->GetName());
+    AppendString(columns, GetUnit(PreFunctions[i]->GetName()));
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+size_t FGOutputType::GetRecordSize(bool singlePrecision) const
+{
+  const size_t size = singlePrecision ? sizeof(float) : sizeof(double);
+
+  return sizeof(double) + (OutputParameters.size() + PreFunctions.size())*size;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGOutputType::PackRecord(char* record, bool singlePrecision) const
+{
+  char* data = PackValue(record, FDMExec->GetSimTime());
+
+  if (singlePrecision) {
+    for (unsigned int i=0; i<OutputParameters.size(); ++i)
+      data = PackValue(data, static_cast<float>(OutputParameters[i]->GetValue()));
+    for (unsigned int i=0; i<PreFunctions.size(); ++i)
+      data = PackValue(data, static_cast<float>(PreFunctions[i]->getDoubleValue()));
+  } else {
+    for (unsigned int i=0; i<OutputParameters.size(); ++i)
+      data = PackValue(data, OutputParameters[i]->GetValue());
+    for (unsigned int i=0; i<PreFunctions.size(); ++i)
+      data = PackValue(data, PreFunctions[i]->getDoubleValue());
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGOutputType::SetRateHz(double rtHz)
 {
   rtHz = rtHz>1000?1000:(rtHz<0?0:rtHz);
@@ -68,6 +68,7 @@ class FGGroundReactions;
 class FGExternalReactions;
 class FGBuoyantForces;
 class FGPropertyValue;
+class FGOutputQueue;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -87,6 +88,40 @@ CLASS DOCUMENTATION
     The class mimics some functionalities of FGModel (methods InitModel(),
     Run() and SetRate()). However it does not inherit from FGModel since it is
     conceptually different from the model paradigm.
+
+    An output can be generated asynchronously by specifying the attribute
+    <tt>async="true"</tt>:
+
+@code
+<output name="datalog.csv" type="CSV" rate="120" async="true" queue_size="1024">
+  <property> velocities/vc-kts </property>
+</output>
+@endcode
+
+    The simulation thread then only copies the values to output into a slot of
+    a preallocated ring buffer (see FGOutputQueue) and a writer thread owned by
+    the output formats and writes them. When the writer thread lags behind by
+    more than <tt>queue_size</tt> outputs (256 by default, at most 65536), the
+    new outputs are dropped until a slot is freed. The following properties
+    report the state of the queue of the output number <tt>n</tt>:
+    - <tt>simulation/output[n]/queue/pending</tt>: the number of outputs
+      waiting to be written,
+    - <tt>simulation/output[n]/queue/written</tt>: the number of outputs
+      written by the writer thread,
+    - <tt>simulation/output[n]/queue/dropped</tt>: the number of outputs
+      dropped because the queue was full,
+    - <tt>simulation/output[n]/queue/overflows</tt>: the number of times the
+      queue has been found full,
+    - <tt>simulation/output[n]/queue/wakeups</tt>: the number of times the
+      writer thread has been woken up. The writer thread polls the queue on
+      its own so it is only woken up when the queue gets half full, flushed or
+      stopped.
+
+    The queued outputs are all written before the output is restarted
+    (SetStartNewOutput()), reinitialized (InitModel()) or destroyed. Only the
+    outputs which implement Sample() and PrintSample() can be asynchronous;
+    the other ones, as well as the outputs of subsystems groups, are generated
+    by the simulation thread.
  */
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -160,6 +195,39 @@ public:
    */
   virtual void Print(void) = 0;
 
+  /** Generates the output: the output is either printed or, if it is
+      asynchronous, sampled and queued to the writer thread. */
+  void Generate(void);
+
+  /** Sets whether the output is generated by a writer thread.
+      @param flag true to generate the output asynchronously.
+      @param queueSize the number of outputs that can wait to be written. */
+  void SetAsynchronous(bool flag, unsigned int queueSize = 256);
+  /// Returns true if the output has been requested to be asynchronous.
+  bool GetAsynchronous(void) const { return Asynchronous; }
+
+  /// Waits until the queued outputs have been written.
+  void Flush(void);
+
+  /** Writes the queued outputs and stops the writer thread. The thread is
+      restarted by the next output. */
+  void StopWriter(void);
+
+  /** Returns the size in bytes of the data that Sample() copies. An output
+      which returns 0 (the default) can not be asynchronous. */
+  virtual size_t GetSampleSize(void) const { return 0; }
+
+  /** Copies the values to output. This method is called by the simulation
+      thread when the output is asynchronous.
+      @param sample the buffer of GetSampleSize() bytes to fill. */
+  virtual void Sample(char* /*sample*/) {}
+
+  /** Formats and writes the values copied by Sample(). This method is called
+      by the writer thread so it must not access the FDM. The classes which
+      implement it must call StopWriter() from their destructor.
+      @param sample the buffer filled by Sample(). */
+  virtual void PrintSample(const char* /*sample*/) {}
+
   /** Reset the output prior to a restart of the simulation. This method should
       be called when the simulation is restarted with, for example, new initial
       conditions. When this method is executed the output instance can take
@@ -200,6 +268,11 @@ protected:
   std::vector <FGPropertyValue*> OutputParameters;
   std::vector <std::string> OutputCaptions;
   bool enabled;
+  bool Asynchronous;
+  unsigned int QueueSize;
+  FGOutputQueue* Queue;
+  // The counters of the previous queues of the output.
+  unsigned long NumWritten, NumDropped, NumOverflows, NumWakeUps;
 
   FGAerodynamics* Aerodynamics;
   FGAuxiliary* Auxiliary;
@@ -215,6 +288,26 @@ protected:
   FGExternalReactions* ExternalReactions;
   FGBuoyantForces* BuoyantForces;
 
+  /** Appends the description of the columns of the binary records to a
+      buffer: the simulation time followed by the properties and the
+      functions. The format is described in FGOutputBinaryFile.
+      @param columns the buffer to which the descriptions are appended
+      @param singlePrecision true if the values are stored as float32 */
+  void DescribeColumns(std::vector<char>& columns, bool singlePrecision) const;
+  /** Returns the size of a binary record.
+      @param singlePrecision true if the values are stored as float32 */
+  size_t GetRecordSize(bool singlePrecision) const;
+  /** Packs the simulation time and the values into a binary record.
+      @param record the buffer of GetRecordSize() bytes to fill
+      @param singlePrecision true if the values are stored as float32 */
+  void PackRecord(char* record, bool singlePrecision) const;
+
+  double GetQueuePending(void) const;
+  double GetQueueWritten(void) const;
+  double GetQueueDropped(void) const;
+  double GetQueueOverflows(void) const;
+  double GetQueueWakeUps(void) const;
+
   void Debug(int from);
 };
 }
@@ -29,6 +29,7 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include "FGPropertyManager.h"
+#include "math/FGPropertyValue.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
@@ -50,6 +51,97 @@ namespace JSBSim {
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+FGPropertyManager::~FGPropertyManager(void)
+{
+  Unbind();
+
+  // The late bound values that outlive the manager must no longer refer to it.
+  set<const FGPropertyValue*>::iterator it;
+  for (it = LateBoundValues.begin(); it != LateBoundValues.end(); ++it)
+    (*it)->PropertyManager = 0L;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+vector<string> FGPropertyManager::ResolveLateBoundValues(void)
+{
+  set<string> undefined;
+  // FindNode() unregisters the values that find their node so the set is
+  // copied before it is iterated.
+  set<const FGPropertyValue*> values = LateBoundValues;
+  set<const FGPropertyValue*>::iterator it;
+
+  for (it = values.begin(); it != values.end(); ++it) {
+    if (!(*it)->FindNode()) undefined.insert((*it)->PropertyName);
+  }
+
+  return vector<string>(undefined.begin(), undefined.end());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGPropertyNode* FGPropertyManager::FindCachedNode(const string& path) const
+{
+  // A removed node may still be referenced by the cache.
+  unsigned long changes = root->getStructureChanges();
+  if (changes != StructureChanges) {
+    PathCache.clear();
+    StructureChanges = changes;
+    return 0L;
+  }
+
+  unordered_map<string, FGPropertyNode*>::const_iterator it = PathCache.find(path);
+  if (it == PathCache.end()) return 0L;
+
+  SGPropertyTracer* tracer = SGPropertyNode::getTracer();
+  if (tracer) tracer->lookup(it->second);
+
+  return it->second;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGPropertyNode* FGPropertyManager::GetNode(const string& path, bool create)
+{
+  if (!PathCacheEnabled) return root->GetNode(path, create);
+
+  FGPropertyNode* node = FindCachedNode(path);
+
+  if (!node) {
+    node = root->GetNode(path, create);
+    if (node) PathCache[path] = node;
+  }
+
+  return node;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool FGPropertyManager::HasNode(const string& path) const
+{
+  string newPath = path;
+  if (newPath[0] == '-') newPath.erase(0,1);
+
+  if (!PathCacheEnabled) return root->HasNode(newPath);
+
+  if (FindCachedNode(newPath)) return true;
+
+  FGPropertyNode* node = static_cast<FGPropertyNode*>(root->getNode(newPath.c_str(), false));
+  if (node) PathCache[newPath] = node;
+
+  return node != 0L;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropertyManager::SetPathCache(bool enabled)
+{
+  PathCacheEnabled = enabled;
+  PathCache.clear();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGPropertyManager::Unbind(void)
 {
     vector<SGPropertyNode_ptr>::iterator it;
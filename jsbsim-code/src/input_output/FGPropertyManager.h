@@ -41,7 +41,10 @@ INCLUDES
 # include <config.h>
 #endif
 
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "simgear/props/propertyObject.hxx"
 #if !PROPS_STANDALONE
 # include "simgear/math/SGMath.hxx"
@@ -61,6 +64,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGPropertyValue;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -376,29 +381,101 @@ class FGPropertyNode : public SGPropertyNode
 typedef SGSharedPtr<FGPropertyNode> FGPropertyNode_ptr;
 typedef SGSharedPtr<const FGPropertyNode> FGConstPropertyNode_ptr;
 
+/** Reads the value of a property directly from the variable where it is
+    stored. The properties that are tied to a double variable or that hold
+    their own double value (such as the outputs of the FCS components) are
+    read without any call, the others through FGPropertyNode::getDoubleValue().
+
+    The storage is located at the first read rather than when the node is
+    given since the type of a property that is not yet set is unknown. It is
+    located again when a read finds that the property has been tied or untied
+    since the previous read (see SGPropertyNode::getTieGeneration()), even if
+    it has been untied and then tied to another variable in between.
+  */
+class FGPropertySlot
+{
+  public:
+    FGPropertySlot(void)
+      : Node(0L), Address(0L), Resolved(false), TieGeneration(0) {}
+    explicit FGPropertySlot(FGPropertyNode* node)
+      : Node(node), Address(0L), Resolved(false), TieGeneration(0) {}
+
+    void SetNode(FGPropertyNode* node)
+    {
+      Node = node;
+      Address = 0L;
+      Resolved = false;
+    }
+    FGPropertyNode* GetNode(void) const { return Node; }
+
+    /// Returns the value of the property.
+    double getDoubleValue(void) const
+    {
+      if (Address && Node->getTieGeneration() == TieGeneration)
+        return *Address;
+      if (!Resolved || Address) {
+        Resolve();
+        if (Address) return *Address;
+      }
+      return Node->getDoubleValue();
+    }
+
+    /// Returns true if the value is read directly from its variable.
+    bool IsDirect(void) const
+    {
+      if (!Resolved || (Address && Node->getTieGeneration() != TieGeneration))
+        Resolve();
+      return Address != 0L;
+    }
+
+  private:
+    FGPropertyNode* Node;
+    mutable const double* Address;
+    mutable bool Resolved;
+    // The tie generation of the node when the property was located. The
+    // address is looked up again once the node has been tied or untied.
+    mutable unsigned int TieGeneration;
+
+    void Resolve(void) const
+    {
+      Address = Node->getDoubleAddress();
+      TieGeneration = Node->getTieGeneration();
+      // The storage of a property that has never been set is not yet known.
+      Resolved = Address || Node->getType() != simgear::props::NONE;
+    }
+};
+
 class FGPropertyManager
 {
   public:
     /// Default constructor
-    FGPropertyManager(void) { root = new FGPropertyNode; }
+    FGPropertyManager(void)
+      : root(new FGPropertyNode), PathCacheEnabled(true), StructureChanges(0) {}
 
     /// Constructor
-    explicit FGPropertyManager(FGPropertyNode* _root) : root(_root) {};
+    explicit FGPropertyManager(FGPropertyNode* _root)
+      : root(_root), PathCacheEnabled(true), StructureChanges(0) {}
 
     /// Destructor
-    virtual ~FGPropertyManager(void) { Unbind(); }
+    virtual ~FGPropertyManager(void);
 
     FGPropertyNode* GetNode(void) const { return root; }
-    FGPropertyNode* GetNode(const std::string &path, bool create = false)
-    { return root->GetNode(path, create); }
+
+    /** Get a node from its path relative to the root.
+        The nodes that are found are kept in a cache so that looking up the
+        same path again does not walk down the tree. The cache is emptied
+        each time a node is removed from the tree.
+        @param path the path of the node
+        @param create true to create the node if it does not exist
+        @return the node or 0 if it does not exist and is not created. */
+    FGPropertyNode* GetNode(const std::string &path, bool create = false);
     FGPropertyNode* GetNode(const std::string &relpath, int index, bool create = false)
     { return root->GetNode(relpath, index, create); }
-    bool HasNode(const std::string& path) const
-    {
-      std::string newPath = path;
-      if (newPath[0] == '-') newPath.erase(0,1);
-      return root->HasNode(newPath);
-    }
+    bool HasNode(const std::string& path) const;
+
+    /** Enable or disable the cache of the paths looked up with GetNode.
+        The cache is enabled by default. */
+    void SetPathCache(bool enabled);
 
     /** Property-ify a name
      *  replaces spaces with '-' and, optionally, makes name all lower case
@@ -648,6 +725,44 @@ class FGPropertyManager
       }
     }
 
+    /**
+     * Tie a property to a member variable of an object.
+     *
+     * This is the form to use in place of a getter which merely returns a
+     * member: the property value is read directly from the member, without
+     * calling any method, and so are the values of the slots and of the
+     * functions which read the property. The property is modified through
+     * the setter (if any) so that the object keeps control over its member.
+     * The getters which compute the value must keep on using the form above.
+     *
+     * @param name The property name to tie (full path).
+     * @param obj The object owning the member.
+     * @param member The member holding the value.
+     * @param setter The object's setter method, or 0 if the value is
+     *        unmodifiable.
+     * @param useDefault true if the setter should be invoked with any existing
+     *        property value should there be one; false if the old value should be
+     *        discarded; defaults to true.
+     */
+    template <class T, class V> inline void
+    Tie (const std::string &name, T * obj, V T::*member,
+           void (T::*setter)(V) = 0, bool useDefault = true)
+    {
+      SGPropertyNode* property = root->getNode(name.c_str(), true);
+      if (!property) {
+        std::cerr << "Could not get or create property " << name << std::endl;
+        return;
+      }
+
+      if (!property->tie(SGRawValueMember<T,V>(*obj, member, setter), useDefault))
+        std::cerr << "Failed to tie property " << name << " to object member" << std::endl;
+      else {
+        if (setter == 0) property->setAttribute(SGPropertyNode::WRITE, false);
+        tied_properties.push_back(property);
+        if (FGJSBBase::debug_lvl & 0x20) std::cout << name << std::endl;
+      }
+    }
+
     /**
      * Tie a property to a pair of indexed object methods.
      *
@@ -691,9 +806,31 @@ class FGPropertyManager
     CreatePropertyObject(const std::string &path)
     { return simgear::PropertyObject<T>(root->GetNode(path, true)); }
 
+    /** Registers a property value which property is not yet defined. The
+        value is unregistered when it finds its node or when it is destroyed.
+        @param value the late bound property value */
+    void AddLateBoundValue(const FGPropertyValue* value)
+    { LateBoundValues.insert(value); }
+
+    /// Unregisters a late bound property value.
+    void RemoveLateBoundValue(const FGPropertyValue* value)
+    { LateBoundValues.erase(value); }
+
+    /** Binds the late bound property values to their node if their property
+        has been defined since they were created, so that its path is no
+        longer searched each time they are evaluated.
+        @return the sorted list of the properties that are still undefined. */
+    std::vector<std::string> ResolveLateBoundValues(void);
+
   private:
     std::vector<SGPropertyNode_ptr> tied_properties;
     FGPropertyNode_ptr root;
+    std::set<const FGPropertyValue*> LateBoundValues;
+    bool PathCacheEnabled;
+    mutable unsigned long StructureChanges;
+    mutable std::unordered_map<std::string, FGPropertyNode*> PathCache;
+
+    FGPropertyNode* FindCachedNode(const std::string& path) const;
 };
 }
 #endif // FGPROPERTYMANAGER_H
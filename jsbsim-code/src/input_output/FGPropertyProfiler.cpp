@@ -0,0 +1,370 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGPropertyProfiler.cpp
+ Date started: 10/17/26
+ Purpose:      Counts the accesses to the properties of an FDM
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+The tracer of the property tree is shared by all the profilers: it is installed
+when the first profiler is enabled and removed when the last one is disabled.
+It counts the accesses to any traced node, whatever its tree, and each profiler
+only reports the nodes located under its own root. The tracer keeps a
+reference to the nodes it has counted so that the address of a node which has
+been removed from its tree is not reused by another node.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "FGPropertyProfiler.h"
+#include "FGPropertyManager.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_PROPERTYPROFILER);
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGPropertyTracer : public SGPropertyTracer
+{
+public:
+  struct Entry {
+    SGConstPropertyNode_ptr Node;
+    FGPropertyProfiler::Counters Counters;
+  };
+
+  ~FGPropertyTracer() { SGPropertyNode::setTracer(0); }
+
+  void read(const SGPropertyNode* node)
+  {
+    lock_guard<mutex> lock(Mutex);
+    Find(node).Reads[FGPropertyProfiler::Current]++;
+  }
+
+  void write(const SGPropertyNode* node)
+  {
+    lock_guard<mutex> lock(Mutex);
+    Find(node).Writes[FGPropertyProfiler::Current]++;
+  }
+
+  void lookup(const SGPropertyNode* node)
+  {
+    // The nodes of the trees that are not profiled are found as well.
+    if (!node->getAttribute(SGPropertyNode::TRACE_READ)) return;
+
+    lock_guard<mutex> lock(Mutex);
+    Find(node).Lookups[FGPropertyProfiler::Current]++;
+  }
+
+  mutex Mutex;
+  unordered_map<const SGPropertyNode*, Entry> Entries;
+
+private:
+  FGPropertyProfiler::Counters& Find(const SGPropertyNode* node)
+  {
+    Entry& entry = Entries[node];
+    if (!entry.Node) {
+      entry.Node = node;
+      memset(&entry.Counters, 0, sizeof(FGPropertyProfiler::Counters));
+    }
+    return entry.Counters;
+  }
+};
+
+static FGPropertyTracer Tracer;
+
+std::atomic<int> FGPropertyProfiler::NumEnabled(0);
+thread_local FGPropertyProfiler::eCaller FGPropertyProfiler::Current
+  = FGPropertyProfiler::ecOther;
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+static unsigned long Sum(const unsigned long counts[])
+{
+  unsigned long total = 0;
+  for (int i=0; i<FGPropertyProfiler::ecNumCallers; i++) total += counts[i];
+  return total;
+}
+
+unsigned long FGPropertyProfiler::Counters::GetReads(void) const
+{ return Sum(Reads); }
+
+unsigned long FGPropertyProfiler::Counters::GetWrites(void) const
+{ return Sum(Writes); }
+
+unsigned long FGPropertyProfiler::Counters::GetLookups(void) const
+{ return Sum(Lookups); }
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+static bool IsUnder(const SGPropertyNode* node, const SGPropertyNode* root)
+{
+  for (; node; node = node->getParent())
+    if (node == root) return true;
+
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+static void SetTraced(SGPropertyNode* node, bool flag)
+{
+  node->setAttribute(SGPropertyNode::TRACE_READ, flag);
+  node->setAttribute(SGPropertyNode::TRACE_WRITE, flag);
+
+  for (int i=0; i<node->nChildren(); i++)
+    SetTraced(node->getChild(i), flag);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGPropertyProfiler::FGPropertyProfiler(FGPropertyManager* pm)
+  : PropertyManager(pm), enabled(false)
+{
+  typedef int (FGPropertyProfiler::*iPMF)(void) const;
+  PropertyManager->Tie("simulation/property-profile/enabled", this,
+                       &FGPropertyProfiler::GetEnabledProperty,
+                       &FGPropertyProfiler::SetEnabledProperty);
+  PropertyManager->Tie("simulation/property-profile/reset", this, (iPMF)0,
+                       &FGPropertyProfiler::ResetStatisticsProperty, false);
+  PropertyManager->Tie("simulation/property-profile/print", this, (iPMF)0,
+                       &FGPropertyProfiler::PrintProperty, false);
+
+  Debug(0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGPropertyProfiler::~FGPropertyProfiler()
+{
+  SetEnabled(false);
+  ResetStatistics();
+  Debug(1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropertyProfiler::SetEnabled(bool flag)
+{
+  if (flag == enabled) return;
+
+  enabled = flag;
+
+  if (enabled) {
+    if (NumEnabled++ == 0) SGPropertyNode::setTracer(&Tracer);
+    SetTraced(PropertyManager->GetNode(), true);
+  }
+  else {
+    SetTraced(PropertyManager->GetNode(), false);
+    if (--NumEnabled == 0) SGPropertyNode::setTracer(0);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropertyProfiler::ResetStatistics(void)
+{
+  const SGPropertyNode* root = PropertyManager->GetNode();
+  lock_guard<mutex> lock(Tracer.Mutex);
+
+  unordered_map<const SGPropertyNode*, FGPropertyTracer::Entry>::iterator it;
+  for (it = Tracer.Entries.begin(); it != Tracer.Entries.end();) {
+    if (IsUnder(it->first, root))
+      it = Tracer.Entries.erase(it);
+    else
+      ++it;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGPropertyProfiler::Counters
+FGPropertyProfiler::GetCounters(const SGPropertyNode* node) const
+{
+  Counters counters;
+  memset(&counters, 0, sizeof(Counters));
+
+  lock_guard<mutex> lock(Tracer.Mutex);
+  unordered_map<const SGPropertyNode*, FGPropertyTracer::Entry>::const_iterator it;
+  it = Tracer.Entries.find(node);
+  if (it != Tracer.Entries.end()) counters = it->second.Counters;
+
+  return counters;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+const char* FGPropertyProfiler::GetCallerName(eCaller caller)
+{
+  static const char* names[ecNumCallers] = {
+    "other", "function", "table", "fcs-component", "output", "script"
+  };
+
+  return names[caller];
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+struct ProfileLine {
+  string Path;
+  FGPropertyProfiler::Counters Counters;
+  unsigned long Total;
+};
+
+static bool ByTotal(const ProfileLine& a, const ProfileLine& b)
+{
+  if (a.Total != b.Total) return a.Total > b.Total;
+  return a.Path < b.Path;
+}
+
+static bool ByWrites(const ProfileLine& a, const ProfileLine& b)
+{
+  unsigned long writesA = a.Counters.GetWrites();
+  unsigned long writesB = b.Counters.GetWrites();
+  if (writesA != writesB) return writesA > writesB;
+  return a.Path < b.Path;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropertyProfiler::Print(ostream& out, unsigned int max) const
+{
+  const SGPropertyNode* root = PropertyManager->GetNode();
+  string rootPath = root->getPath(true);
+  vector<ProfileLine> lines, unread;
+
+  {
+    lock_guard<mutex> lock(Tracer.Mutex);
+    unordered_map<const SGPropertyNode*, FGPropertyTracer::Entry>::const_iterator it;
+
+    for (it = Tracer.Entries.begin(); it != Tracer.Entries.end(); ++it) {
+      if (!IsUnder(it->first, root)) continue;
+
+      ProfileLine line;
+      line.Path = it->first->getPath(true).substr(rootPath.size());
+      if (!line.Path.empty() && line.Path[0] == '/') line.Path.erase(0, 1);
+      line.Counters = it->second.Counters;
+      line.Total = line.Counters.GetReads() + line.Counters.GetWrites()
+                 + line.Counters.GetLookups();
+      lines.push_back(line);
+      if (line.Counters.GetReads() == 0 && line.Counters.GetWrites() != 0)
+        unread.push_back(line);
+    }
+  }
+
+  sort(lines.begin(), lines.end(), ByTotal);
+  sort(unread.begin(), unread.end(), ByWrites);
+
+  size_t width = 20;
+  for (unsigned int i=0; i<lines.size() && i<max; i++)
+    width = std::max(width, lines[i].Path.size() + 2);
+
+  static const char* headers[ecNumCallers] = {
+    "Other", "Function", "Table", "FCS", "Output", "Script"
+  };
+
+  out << endl << "JSBSim property access profile (" << lines.size()
+      << " properties accessed)" << endl;
+  out << left << setw(width) << "Property" << right << setw(12) << "Reads"
+      << setw(12) << "Writes" << setw(10) << "Lookups";
+  for (int c=ecFunction; c<ecNumCallers; c++) out << setw(10) << headers[c];
+  out << setw(10) << headers[ecOther] << endl;
+  out << string(width+94, '-') << endl;
+
+  for (unsigned int i=0; i<lines.size() && i<max; i++) {
+    const Counters& counters = lines[i].Counters;
+    out << left << setw(width) << lines[i].Path << right
+        << setw(12) << counters.GetReads() << setw(12) << counters.GetWrites()
+        << setw(10) << counters.GetLookups();
+    for (int c=1; c<=ecNumCallers; c++) {
+      int caller = c % ecNumCallers; // "Other" is printed last
+      out << setw(10) << counters.Reads[caller] + counters.Writes[caller]
+                         + counters.Lookups[caller];
+    }
+    out << endl;
+  }
+
+  if (unread.empty()) return;
+
+  out << endl << "Properties written but never read (" << unread.size() << ")"
+      << endl;
+  for (unsigned int i=0; i<unread.size() && i<max; i++)
+    out << "  " << left << setw(width) << unread[i].Path << right << setw(12)
+        << unread[i].Counters.GetWrites() << endl;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropertyProfiler::PrintProperty(int)
+{
+  Print(cout);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+//    The bitmasked value choices are as follows:
+//    unset: In this case (the default) JSBSim would only print
+//       out the normally expected messages, essentially echoing
+//       the config files as they are read. If the environment
+//       variable is not set, debug_lvl is set to 1 internally
+//    0: This requests JSBSim not to output any messages
+//       whatsoever.
+//    1: This value explicity requests the normal JSBSim
+//       startup messages
+//    2: This value asks for a message to be printed out when
+//       a class is instantiated
+//    4: When this value is set, a message is displayed when a
+//       FGModel object executes its Run() method
+//    8: When this value is set, various runtime state variables
+//       are printed out periodically
+//    16: When set various parameters are sanity checked and
+//       a message is printed out when they go out of bounds
+
+void FGPropertyProfiler::Debug(int from)
+{
+  if (debug_lvl <= 0) return;
+
+  if (debug_lvl & 2 ) { // Instantiation/Destruction notification
+    if (from == 0) cout << "Instantiated: FGPropertyProfiler" << endl;
+    if (from == 1) cout << "Destroyed:    FGPropertyProfiler" << endl;
+  }
+  if (debug_lvl & 64) {
+    if (from == 0) { // Constructor
+      cout << IdSrc << endl;
+      cout << IdHdr << endl;
+    }
+  }
+}
+}
@@ -0,0 +1,177 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+ Header:       FGPropertyProfiler.h
+ Date started: 10/17/26
+ file The header file for the property access profiler.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGPROPERTYPROFILER_H
+#define FGPROPERTYPROFILER_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <atomic>
+#include <iosfwd>
+
+#include "FGJSBBase.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_PROPERTYPROFILER "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class SGPropertyNode;
+
+namespace JSBSim {
+
+class FGPropertyManager;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Counts the accesses to the properties of an FDM.
+
+    For each property, the profiler counts the reads and the writes of its
+    value made through the property tree as well as the number of times it has
+    been found from its path (by FGPropertyManager::GetNode,
+    FGFDMExec::GetPropertyValue, and so on). Each access is attributed to the
+    class of its caller: a function, a table, an FCS component, an output or
+    a script. The accesses made from anywhere else are attributed to "other".
+
+    The properties tied to a variable are read and written by their owner
+    without going through the property tree so these accesses are not
+    counted: a property which is written but never read is thus a property
+    whose value is set from the property tree and never used from it.
+
+    The report printed by Print() ranks the properties by their number of
+    accesses and then lists the properties which are written but never read.
+
+    Profiling is disabled by default. It is enabled either by setting the
+    property <tt>simulation/property-profile/enabled</tt> to 1 or by setting
+    the environment variable <tt>JSBSIM_PROPERTY_PROFILE</tt> to a non zero
+    value. In the latter case, the report is also printed when the FDM is
+    destroyed. Setting the property <tt>simulation/property-profile/print</tt>
+    prints the report and setting <tt>simulation/property-profile/reset</tt>
+    clears the counters.
+
+    The properties are profiled through the TRACE_READ and TRACE_WRITE
+    attributes of their node. These attributes prevent the value of a property
+    from being read directly from its storage so profiling should be enabled
+    before the model is loaded: the values which are already read directly
+    when profiling is enabled are not counted. When no profiler is enabled,
+    the cost of a Scope reduces to a test.
+  */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGPropertyProfiler : public FGJSBBase
+{
+public:
+  /// The classes of callers to which the accesses are attributed.
+  enum eCaller {ecOther=0, ecFunction, ecTable, ecFCSComponent, ecOutput,
+                ecScript, ecNumCallers};
+
+  /** Attributes the accesses made during the lifetime of the scope to a class
+      of callers. When scopes are nested, the accesses are attributed to the
+      innermost one. */
+  class Scope {
+  public:
+    explicit Scope(eCaller caller)
+      : Active(NumEnabled.load(std::memory_order_relaxed) != 0),
+        Previous(ecOther)
+    {
+      if (Active) {
+        Previous = Current;
+        Current = caller;
+      }
+    }
+    ~Scope() { if (Active) Current = Previous; }
+
+  private:
+    bool Active;
+    eCaller Previous;
+  };
+
+  /// The numbers of accesses to a property, by class of callers.
+  struct Counters {
+    unsigned long Reads[ecNumCallers];
+    unsigned long Writes[ecNumCallers];
+    unsigned long Lookups[ecNumCallers];
+
+    unsigned long GetReads(void) const;
+    unsigned long GetWrites(void) const;
+    unsigned long GetLookups(void) const;
+  };
+
+  /** Constructor.
+      @param pm the property manager of the properties to profile */
+  explicit FGPropertyProfiler(FGPropertyManager* pm);
+  ~FGPropertyProfiler();
+
+  /** Enables or disables profiling.
+      The properties of the FDM are marked to be traced when the profiling is
+      enabled and unmarked when it is disabled. The counters are kept. */
+  void SetEnabled(bool flag);
+  bool GetEnabled(void) const { return enabled; }
+
+  /// Clears the counters of the properties of the FDM.
+  void ResetStatistics(void);
+
+  /** Returns the counters of a property.
+      The counters are all zero if the property has not been accessed. */
+  Counters GetCounters(const SGPropertyNode* node) const;
+
+  /** Prints the properties ranked by their number of accesses.
+      @param out the stream to print to
+      @param max the maximum number of properties printed in each table */
+  void Print(std::ostream& out, unsigned int max = 50) const;
+
+  static const char* GetCallerName(eCaller caller);
+
+private:
+  FGPropertyManager* PropertyManager;
+  bool enabled;
+
+  static std::atomic<int> NumEnabled;
+  static thread_local eCaller Current;
+
+  friend class FGPropertyTracer;
+
+  int GetEnabledProperty(void) const { return enabled ? 1 : 0; }
+  void SetEnabledProperty(int flag) { SetEnabled(flag != 0); }
+  void ResetStatisticsProperty(int) { ResetStatistics(); }
+  void PrintProperty(int);
+  void Debug(int from);
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
@@ -54,6 +54,8 @@ INCLUDES
 #include "math/FGCondition.h"
 #include "math/FGFunction.h"
 #include "math/FGFunctionValue.h"
+#include "input_output/FGPropertyProfiler.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -335,7 +337,7 @@ bool FGScript::LoadScript(const SGPath& script, double default_dT,
         newEvent->Functions.push_back((FGFunction*)0L);
       } else if (set_element->FindElement("function")) {
         value = 0.0;
-        newEvent->Functions.push_back(new FGFunction(PropertyManager, set_element->FindElement("function")));
+        newEvent->Functions.push_back(new FGFunction(FDMExec, set_element->FindElement("function")));
       }
       newEvent->SetValue.push_back(value);
       newEvent->OriginalValue.push_back(0.0);
@@ -395,6 +397,8 @@ bool FGScript::RunScript(void)
 
   if (currentTime > EndTime) return false;
 
+  FGPropertyProfiler::Scope scope(FGPropertyProfiler::ecScript);
+
   // Iterate over all events.
   for (unsigned int ev_ctr=0; ev_ctr < Events.size(); ev_ctr++) {
 
@@ -536,6 +540,19 @@ bool FGScript::RunScript(void)
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGScript::SerializeState(FGStateArchive& ar)
+{
+  ar & StartTime & EndTime;
+
+  for (unsigned int i=0; i<Events.size(); i++) {
+    struct event& ev = Events[i];
+    ar & ev.Triggered & ev.Notified & ev.StartTime & ev.TimeSpan;
+    ar & ev.newValue & ev.OriginalValue & ev.ValueSpan & ev.Transiting;
+  }
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -61,6 +61,7 @@ class FGFDMExec;
 class FGCondition;
 class FGFunction;
 class FGPropertyValue;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -200,6 +201,9 @@ public:
 
   void ResetEvents(void);
 
+  /// Saves or restores the state of the events.
+  void SerializeState(FGStateArchive& ar);
+
 private:
   enum eAction {
     FG_RAMP  = 1,
@@ -0,0 +1,239 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGStateArchive.h
+ Date started: 10/17/26
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGSTATEARCHIVE_H
+#define FGSTATEARCHIVE_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "math/FGColumnVector3.h"
+#include "math/FGMatrix33.h"
+#include "math/FGQuaternion.h"
+#include "math/FGLocation.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_STATEARCHIVE "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Reads or writes the state of a simulation from/to an array of doubles.
+
+    The same method is used to save and to restore the state of an object: the
+    members are passed to the archive with operator& and the archive either
+    copies them to the array (save mode) or overwrites them with the content of
+    the array (restore mode).
+
+    @code
+    void FGFoo::SerializeState(FGStateArchive& ar)
+    {
+      FGModel::SerializeState(ar);
+      ar & vForces & PreviousInput & Initialized;
+    }
+    @endcode
+
+    Since the members are not tagged, the layout of the array is determined by
+    the order in which they are passed to the archive. An array can therefore
+    only be restored in an instance of the same model.
+
+    The array only grows the first time a state is saved in it: once it has
+    reached its final size, saving or restoring a state does not allocate any
+    memory.
+
+    Integers and booleans are stored as doubles, the 64 bits integers are
+    split in two halves of 32 bits so that all the values are restored
+    exactly.
+  */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGStateArchive
+{
+public:
+  /** Constructor for the save mode.
+      @param buffer the array in which the state is written. Its content is
+                    overwritten and its size is adjusted to the size of the
+                    state. */
+  explicit FGStateArchive(std::vector<double>& buffer)
+    : Output(&buffer), Input(0L), Cursor(0), Valid(true) {}
+
+  /** Constructor for the restore mode.
+      @param buffer the array from which the state is read. */
+  explicit FGStateArchive(const std::vector<double>& buffer)
+    : Output(0L), Input(&buffer), Cursor(0), Valid(true) {}
+
+  /// Returns true if the archive is saving a state.
+  bool IsSaving(void) const { return Output != 0L; }
+
+  /** Returns false if the archive has attempted to read past the end of the
+      array. */
+  bool IsValid(void) const { return Valid; }
+
+  /// Returns the number of doubles that have been read or written so far.
+  size_t GetSize(void) const { return Cursor; }
+
+  /** Terminates the archive. In save mode the array is truncated to the size
+      of the state, in restore mode the archive is invalidated if the state
+      does not fill the array.
+      @return true if the archive is valid. */
+  bool Close(void) {
+    if (Output) {
+      if (Output->size() > Cursor) Output->resize(Cursor);
+    } else if (Input->size() != Cursor)
+      Valid = false;
+
+    return Valid;
+  }
+
+  FGStateArchive& operator&(double& x) {
+    if (Output) {
+      if (Cursor < Output->size()) (*Output)[Cursor] = x;
+      else Output->push_back(x);
+    } else if (Cursor < Input->size())
+      x = (*Input)[Cursor];
+    else
+      Valid = false;
+
+    ++Cursor;
+    return *this;
+  }
+
+  FGStateArchive& operator&(bool& x) {
+    double v = x ? 1.0 : 0.0;
+    *this & v;
+    x = v != 0.0;
+    return *this;
+  }
+
+  FGStateArchive& operator&(int& x) {
+    double v = x;
+    *this & v;
+    x = static_cast<int>(v);
+    return *this;
+  }
+
+  FGStateArchive& operator&(unsigned int& x) {
+    double v = x;
+    *this & v;
+    x = static_cast<unsigned int>(v);
+    return *this;
+  }
+
+  FGStateArchive& operator&(uint64_t& x) {
+    double hi = static_cast<double>(x >> 32);
+    double lo = static_cast<double>(x & 0xffffffffULL);
+    *this & hi & lo;
+    x = (static_cast<uint64_t>(hi) << 32) | static_cast<uint64_t>(lo);
+    return *this;
+  }
+
+  FGStateArchive& operator&(FGColumnVector3& v) {
+    for (unsigned int i=1; i<=3; i++) *this & v(i);
+    return *this;
+  }
+
+  FGStateArchive& operator&(FGQuaternion& q) {
+    // The non const accessor invalidates the cached matrices of q.
+    for (unsigned int i=1; i<=4; i++) *this & q(i);
+    return *this;
+  }
+
+  FGStateArchive& operator&(FGMatrix33& m) {
+    for (unsigned int i=1; i<=3; i++)
+      for (unsigned int j=1; j<=3; j++)
+        *this & m(i,j);
+    return *this;
+  }
+
+  FGStateArchive& operator&(FGLocation& l) {
+    // Only the position and the Earth position angle are stored, the derived
+    // quantities are recomputed on demand.
+    for (unsigned int i=1; i<=3; i++) *this & l.Entry(i);
+    double epa = l.GetEPA();
+    *this & epa;
+    if (!Output) l.SetEarthPositionAngle(epa);
+    return *this;
+  }
+
+  /** The size of containers is not stored: they must have the same size when
+      the state is saved and when it is restored. */
+  template <typename T>
+  FGStateArchive& operator&(std::vector<T>& v) {
+    for (typename std::vector<T>::iterator it=v.begin(); it!=v.end(); ++it)
+      *this & *it;
+    return *this;
+  }
+
+  FGStateArchive& operator&(std::vector<bool>& v) {
+    for (size_t i=0; i<v.size(); i++) {
+      bool b = v[i];
+      *this & b;
+      v[i] = b;
+    }
+    return *this;
+  }
+
+  template <typename T>
+  FGStateArchive& operator&(std::deque<T>& d) {
+    for (typename std::deque<T>::iterator it=d.begin(); it!=d.end(); ++it)
+      *this & *it;
+    return *this;
+  }
+
+  /** Stores the array x of n elements.
+      @param x the array.
+      @param n the number of elements of the array. */
+  template <typename T>
+  void Array(T* x, size_t n) {
+    for (size_t i=0; i<n; i++) *this & x[i];
+  }
+
+private:
+  std::vector<double>* Output;
+  const std::vector<double>* Input;
+  size_t Cursor;
+  bool Valid;
+};
+}
+#endif
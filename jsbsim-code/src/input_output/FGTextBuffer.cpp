@@ -0,0 +1,194 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       FGTextBuffer.cpp
+ Date started: 10/17/26
+ Purpose:      Format text and numbers into a reusable buffer
+ Called by:    FGOutputTextFile, FGfdmSocket and the models
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+The streams format the numbers with printf's "%.*g" once they have checked
+their state, looked up the facets of their locale and built the format string.
+The numbers are formatted here with snprintf directly into a small array. The
+integers, which are frequent in the outputs (zero forces, flags, and so on),
+are formatted without snprintf when "%.*g" would print all their digits.
+
+snprintf writes the decimal point of the C locale (LC_NUMERIC) while the streams
+use the classic locale whatever the C locale. A host application which calls
+setlocale(LC_ALL, "") would get "1,5" instead of "1.5" in a German locale, for
+instance, so the decimal point written by snprintf is replaced by '.'.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "FGTextBuffer.h"
+#include "FGJSBBase.h"
+#include "math/FGMatrix33.h"
+#include "math/FGColumnVector3.h"
+#include "math/FGQuaternion.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_TEXTBUFFER);
+
+namespace {
+
+// Formats an integral value with at most maxDigits digits as "%.*g" does.
+// Returns the number of characters written to str or 0 if the value is not
+// such an integer.
+int FormatInteger(double value, int maxDigits, char* str)
+{
+  if (!(fabs(value) < 1E15)) return 0; // Also rejects NaN
+
+  long long integer = static_cast<long long>(value);
+  if (static_cast<double>(integer) != value) return 0;
+
+  char digits[16];
+  int numDigits = 0;
+  unsigned long long magnitude = integer < 0 ? -integer : integer;
+
+  do {
+    digits[numDigits++] = '0' + magnitude % 10;
+    magnitude /= 10;
+  } while (magnitude > 0);
+
+  if (numDigits > maxDigits) return 0;
+
+  int length = 0;
+  if (signbit(value)) str[length++] = '-'; // Also prints -0 as "-0"
+  while (numDigits > 0) str[length++] = digits[--numDigits];
+
+  return length;
+}
+
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+// Replaces the decimal point written by snprintf for a finite value, whatever
+// the C locale, by '.'. The decimal point follows the sign and the first digits
+// and is followed by a digit or by the exponent. It may be made of several
+// bytes in some locales. Returns the new length of str.
+int FixDecimalPoint(char* str, int length)
+{
+  int begin = 0;
+  if (str[begin] == '-') begin++;
+  while (begin < length && IsDigit(str[begin])) begin++;
+  if (begin == length || str[begin] == 'e') return length;
+
+  int end = begin + 1;
+  while (end < length && !IsDigit(str[end]) && str[end] != 'e') end++;
+
+  str[begin] = '.';
+  if (end > begin + 1) {
+    memmove(str + begin + 1, str + end, length - end);
+    length -= end - begin - 1;
+  }
+
+  return length;
+}
+
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+void FGTextBuffer::Append(double value, int precision, int width)
+{
+  char str[64];
+
+  // printf replaces a precision of 0 by 1 and a negative precision by 6.
+  if (precision < 0) precision = 6;
+  int length = FormatInteger(value, precision > 0 ? precision : 1, str);
+
+  if (length == 0) {
+    length = snprintf(str, sizeof(str), "%.*g", precision, value);
+    if (isfinite(value)) length = FixDecimalPoint(str, length);
+  }
+
+  Pad(length, width);
+  Text.append(str, length);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTextBuffer::Append(long value, int width)
+{
+  char str[32];
+  int length = snprintf(str, sizeof(str), "%ld", value);
+
+  Pad(length, width);
+  Text.append(str, length);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGTextBuffer& FGTextBuffer::Append(const FGColumnVector3& v, const string& delimiter)
+{
+  for (unsigned int i=1; i<=3; i++) {
+    if (i > 1) Text.append(delimiter);
+    Append(v(i), 16);
+  }
+
+  return *this;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGTextBuffer& FGTextBuffer::Append(const FGQuaternion& q, const string& delimiter)
+{
+  for (unsigned int i=1; i<=4; i++) {
+    if (i > 1) Text.append(delimiter);
+    Append(q(i), 16);
+  }
+
+  return *this;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGTextBuffer& FGTextBuffer::Append(const FGMatrix33& m, const string& delimiter)
+{
+  // The matrix is dumped row by row.
+  for (unsigned int r=1; r<=3; r++) {
+    for (unsigned int c=1; c<=3; c++) {
+      if (r > 1 || c > 1) Text.append(delimiter);
+      Append(m(r, c), 10, 12);
+    }
+  }
+
+  return *this;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTextBuffer::Pad(size_t length, int width)
+{
+  if (width > 0 && length < static_cast<size_t>(width))
+    Text.append(width - length, ' ');
+}
+}
@@ -0,0 +1,144 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       FGTextBuffer.h
+ Date started: 10/17/26
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGTEXTBUFFER_H
+#define FGTEXTBUFFER_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <string>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_TEXTBUFFER "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+class FGColumnVector3;
+class FGQuaternion;
+class FGMatrix33;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Formats text and numbers into a reusable buffer.
+
+    The buffer is a lightweight replacement of std::ostringstream for the text
+    outputs: its storage is kept when it is cleared so once it has grown to the
+    size of a line, formatting a line does not allocate memory. The numbers are
+    formatted exactly as a std::ostream in the default floating point notation
+    formats them with the same precision (that is as printf's "%.*g" does in
+    the "C" locale) so the text is identical to the text formerly produced with
+    the streams. The decimal point is always '.', whatever the locale set by
+    the application with setlocale():
+
+@code
+    FGTextBuffer buffer;
+
+    buffer.SetPrecision(10);
+    buffer << time << ',' << altitude;
+    write(fd, buffer.GetData(), buffer.GetSize());
+    buffer.Clear();
+@endcode
+
+    The vectors, quaternions and matrices are appended as their Dump() method
+    formats them, whatever the precision of the buffer. Their Append() methods
+    return the buffer so that they can be followed by the << operators.
+ */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGTextBuffer
+{
+public:
+  /// Constructor. The precision is 6 digits, as for the streams.
+  FGTextBuffer(void) : Precision(6) {}
+
+  /// Empties the buffer. Its storage is kept for the next text.
+  void Clear(void) { Text.clear(); }
+  bool Empty(void) const { return Text.empty(); }
+  size_t GetSize(void) const { return Text.size(); }
+  const char* GetData(void) const { return Text.data(); }
+  const std::string& GetString(void) const { return Text; }
+
+  /// Sets the number of significant digits of the numbers appended by <<.
+  void SetPrecision(int precision) { Precision = precision; }
+  int GetPrecision(void) const { return Precision; }
+
+  FGTextBuffer& operator<<(double value) {
+    Append(value, Precision);
+    return *this;
+  }
+  FGTextBuffer& operator<<(const std::string& str) {
+    Text.append(str);
+    return *this;
+  }
+  FGTextBuffer& operator<<(const char* str) {
+    Text.append(str);
+    return *this;
+  }
+  FGTextBuffer& operator<<(char c) {
+    Text.push_back(c);
+    return *this;
+  }
+
+  /** Appends a number as printf's "%*.*g" does.
+      @param value the number
+      @param precision the number of significant digits
+      @param width the minimum number of characters, the number being padded
+                   with spaces on its left. */
+  void Append(double value, int precision, int width = 0);
+
+  /// Appends an integer as printf's "%*ld" does.
+  void Append(long value, int width = 0);
+
+  /// Appends a vector as FGColumnVector3::Dump() does.
+  FGTextBuffer& Append(const FGColumnVector3& v, const std::string& delimiter);
+  /// Appends a quaternion as FGQuaternion::Dump() does.
+  FGTextBuffer& Append(const FGQuaternion& q, const std::string& delimiter);
+  /// Appends a matrix as FGMatrix33::Dump() does.
+  FGTextBuffer& Append(const FGMatrix33& m, const std::string& delimiter);
+
+private:
+  std::string Text;
+  int Precision;
+
+  void Pad(size_t length, int width);
+};
+}
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+#endif
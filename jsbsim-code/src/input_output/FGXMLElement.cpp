@@ -36,6 +36,7 @@ INCLUDES
 #include "FGXMLElement.h"
 #include "string_utilities.h"
 #include "FGJSBBase.h"
+#include "math/FGRandom.h"
 
 using namespace std;
 
@@ -356,6 +357,16 @@ double Element::GetDataAsNumber(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+bool Element::HasChildElement(const Element* el) const
+{
+  for (unsigned int i=0; i<children.size(); i++)
+    if (children[i].ptr() == el) return true;
+
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 unsigned int Element::GetNumElements(const string& element_name)
 {
   unsigned int number_of_elements=0;
@@ -622,7 +633,7 @@ double Element::DisperseValue(Element *e, double val, const std::string& supplie
         value = (val + disp*grn)*(fabs(grn)/grn);
       }
     } else if (attType == "uniform" || attType == "uniformsigned") {
-      double urn = ((((double)rand()/RAND_MAX)-0.5)*2.0);
+      double urn = FGJSBBase::GetThreadRandomStream().GetUniformSigned();
       if (attType == "uniform") {
       value = val + disp * urn;
       } else { // Assume uniformsigned
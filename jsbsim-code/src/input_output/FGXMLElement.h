@@ -36,6 +36,7 @@ INCLUDES
 
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 
 #include "simgear/structure/SGSharedPtr.hxx"
@@ -340,6 +341,22 @@ public:
   *   @param el Child element to add. */
   void AddChildElement(Element* el) {children.push_back(el);}
 
+  /** Checks if an element is one of the children of this element.
+  *   @param el the element to look for.
+  *   @return true if el is a child of this element. */
+  bool HasChildElement(const Element* el) const;
+
+  /** Stores data built from the content of this element so that it can be
+  *   shared by all the objects that are loaded from this element (for
+  *   instance by the FDMs cloned with FGFDMExec::Clone()). The data must not
+  *   be modified once it has been stored.
+  *   @param data the shared data. */
+  void SetCachedData(const std::shared_ptr<void>& data) {cached_data = data;}
+
+  /** Returns the data stored by SetCachedData().
+  *   @return the shared data or an empty pointer if no data has been stored.*/
+  const std::shared_ptr<void>& GetCachedData(void) const {return cached_data;}
+
   /** Stores an attribute belonging to this element.
   *   @param name The string name of the attribute.
   *   @param value The string value of the attribute. */
@@ -389,6 +406,7 @@ private:
   unsigned int element_index;
   std::string file_name;
   int line_number;
+  std::shared_ptr<void> cached_data;
   typedef std::map <std::string, std::map <std::string, double> > tMapConvert;
   static tMapConvert convert;
   static bool converterIsInitialized;
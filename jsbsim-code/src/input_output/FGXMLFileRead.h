@@ -37,6 +37,8 @@ INCLUDES
 
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <string>
 
 #include "input_output/FGXMLParse.h"
 #include "simgear/misc/sg_path.hxx"
@@ -95,5 +97,35 @@ public:
 private:
   FGXMLParse file_parser;
 };
+
+/** Keeps the XML documents that have been read so that each file is parsed
+    only once. The cache is shared by an FGFDMExec instance and by the
+    instances that are cloned from it.
+    @see FGFDMExec::Clone */
+class FGXMLDocumentCache {
+public:
+  /** Returns the document of an XML file. The file is only read the first
+      time it is requested.
+      @param XML_filename the name of the XML file.
+      @param verbose if true, an error message is issued when the file can not
+                     be opened.
+      @return the document or 0L if the file can not be read. */
+  Element* LoadXMLDocument(const SGPath& XML_filename, bool verbose=true)
+  {
+    std::string key = XML_filename.utf8Str();
+    std::map<std::string, Element_ptr>::iterator it = Documents.find(key);
+
+    if (it != Documents.end()) return it->second;
+
+    FGXMLFileRead XMLFileRead;
+    Element* document = XMLFileRead.LoadXMLDocument(XML_filename, verbose);
+    if (document) Documents[key] = document;
+
+    return document;
+  }
+
+private:
+  std::map<std::string, Element_ptr> Documents;
+};
 }
 #endif
@@ -44,7 +44,6 @@ INCLUDES
 #include <fcntl.h>
 #endif
 #include <iostream>
-#include <iomanip>
 #include <cstring>
 #include <cstdio>
 #include "FGfdmSocket.h"
@@ -83,6 +82,7 @@ FGfdmSocket::FGfdmSocket(const string& address, int port, int protocol)
   sckt = sckt_in = 0;
   Protocol = (ProtocolType)protocol;
   connected = false;
+  Interactive = true;
 
   #if defined(_MSC_VER) || defined(__MINGW32__)
   if (!LoadWinSockDLL()) return;
@@ -136,6 +136,7 @@ FGfdmSocket::FGfdmSocket(int port, int protocol)
 {
   sckt = -1;
   connected = false;
+  Interactive = true;
   Protocol = (ProtocolType)protocol;
   string ProtocolName;
  
@@ -203,6 +204,7 @@ FGfdmSocket::FGfdmSocket(const string& address, int port) // assumes TCP
 {
   sckt = sckt_in = 0;
   connected = false;
+  Interactive = true;
   Protocol = ptTCP;
 
   #if defined(_MSC_VER) || defined(__MINGW32__)
@@ -278,7 +280,8 @@ string FGfdmSocket::Receive(void)
       #else
          ioctl(sckt_in, FIONBIO, &NoBlock);
       #endif
-      send(sckt_in, "Connected to JSBSim server\nJSBSim> ", 35, 0);
+      if (Interactive)
+        send(sckt_in, "Connected to JSBSim server\nJSBSim> ", 35, 0);
     }
   }
 
@@ -320,7 +323,7 @@ int FGfdmSocket::Reply(const string& text)
 
   if (sckt_in >= 0) {
     num_chars_sent = send(sckt_in, text.c_str(), text.size(), 0);
-    send(sckt_in, "JSBSim> ", 8, 0);
+    if (Interactive) send(sckt_in, "JSBSim> ", 8, 0);
   } else {
     cerr << "Socket reply must be to a valid socket" << endl;
     return -1;
@@ -330,6 +333,29 @@ int FGfdmSocket::Reply(const string& text)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+int FGfdmSocket::Reply(const char *data, int length)
+{
+  if (sckt_in < 0) {
+    cerr << "Socket reply must be to a valid socket" << endl;
+    return -1;
+  }
+
+  int num_chars_sent = send(sckt_in, data, length, 0);
+
+  if (num_chars_sent < 0) {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    if (WSAGetLastError() == WSAEWOULDBLOCK) return 0;
+#else
+    if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+#endif
+    perror("send");
+  }
+
+  return num_chars_sent;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGfdmSocket::Close(void)
 {
   close(sckt_in);
@@ -339,7 +365,7 @@ void FGfdmSocket::Close(void)
 
 void FGfdmSocket::Clear(void)
 {
-  buffer.str(string());
+  buffer.Clear();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -354,7 +380,7 @@ void FGfdmSocket::Clear(const string& s)
 
 void FGfdmSocket::Append(const char* item)
 {
-  if (buffer.tellp() > 0) buffer << ',';
+  if (!buffer.Empty()) buffer << ',';
   buffer << item;
 }
 
@@ -362,16 +388,16 @@ void FGfdmSocket::Append(const char* item)
 
 void FGfdmSocket::Append(double item)
 {
-  if (buffer.tellp() > 0) buffer << ',';
-  buffer << std::setw(12) << std::setprecision(7) << item;
+  if (!buffer.Empty()) buffer << ',';
+  buffer.Append(item, 7, 12);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 void FGfdmSocket::Append(long item)
 {
-  if (buffer.tellp() > 0) buffer << ',';
-  buffer << std::setw(12) << item;
+  if (!buffer.Empty()) buffer << ',';
+  buffer.Append(item, 12);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -379,19 +405,42 @@ void FGfdmSocket::Append(long item)
 void FGfdmSocket::Send(void)
 {
   buffer << '\n';
-  string str = buffer.str();
-  if ((send(sckt,str.c_str(),str.size(),0)) <= 0) {
+  if ((send(sckt,buffer.GetData(),buffer.GetSize(),0)) <= 0) {
     perror("send");
   }
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-void FGfdmSocket::Send(const char *data, int length)
+int FGfdmSocket::Send(const char *data, int length)
 {
-  if ((send(sckt,data,length,0)) <= 0) {
+  int num_chars_sent = send(sckt,data,length,0);
+
+  if (num_chars_sent < 0) {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    if (WSAGetLastError() == WSAEWOULDBLOCK) return 0;
+#else
+    if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+#endif
+    perror("send");
+  } else if (num_chars_sent == 0) {
     perror("send");
   }
+
+  return num_chars_sent;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGfdmSocket::SetBlocking(bool blocking)
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+  u_long NonBlock = blocking ? 0 : 1;
+  ioctlsocket(sckt, FIONBIO, &NonBlock);
+#else
+  int flags = fcntl(sckt, F_GETFL, 0);
+  fcntl(sckt, F_SETFL, blocking ? flags & ~O_NONBLOCK : flags | O_NONBLOCK);
+#endif
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -40,9 +40,9 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include <string>
-#include <sstream>
 #include <sys/types.h>
 #include "FGJSBBase.h"
+#include "FGTextBuffer.h"
 
 #if defined(_MSC_VER) || defined(__MINGW32__)
   #include <winsock.h>
@@ -94,10 +94,24 @@ public:
   FGfdmSocket(int, int);
   ~FGfdmSocket();
   void Send(void);
-  void Send(const char *data, int length);
+  /** Sends raw data.
+      @return the number of bytes sent, 0 if a non-blocking socket is not
+              ready to send the data and -1 if an error occurred. */
+  int Send(const char *data, int length);
+  /** Sets the blocking mode of the socket. In non-blocking mode, Send() does
+      not wait for the socket to be ready and sends what it can. */
+  void SetBlocking(bool blocking);
+  /** Sets whether the clients of an input socket are telnet sessions (the
+      default). If not, the connection banner and the prompts are not sent so
+      that the replies only contain the data passed to Reply(). */
+  void SetInteractive(bool interactive) { Interactive = interactive; }
 
   std::string Receive(void);
   int Reply(const std::string& text);
+  /** Sends raw data to the client of an input socket, without any prompt.
+      @return the number of bytes sent, 0 if the socket is not ready to send
+              the data and -1 if an error occurred. */
+  int Reply(const char *data, int length);
   void Append(const std::string& s) {Append(s.c_str());}
   void Append(const char*);
   void Append(double);
@@ -115,8 +129,9 @@ private:
   ProtocolType Protocol;
   struct sockaddr_in scktName;
   struct hostent *host;
-  std::ostringstream buffer;
+  FGTextBuffer buffer;
   bool connected;
+  bool Interactive;
   void Debug(int from);
 };
 }
@@ -0,0 +1,96 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       binary_utilities.h
+ Date started: 10/17/26
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef BINARYUTILS_H
+#define BINARYUTILS_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_BINARYUTILS "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DECLARATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+// The binary outputs and inputs store their numbers in little-endian order
+// whatever the platform. The bytes are only reordered on big-endian platforms.
+
+namespace JSBSim {
+
+inline bool IsLittleEndian(void)
+{
+  const unsigned short one = 1;
+  return *reinterpret_cast<const unsigned char*>(&one) == 1;
+}
+
+// Copies a value at dest in little-endian order and returns the address that
+// follows it.
+template <typename T> char* PackValue(char* dest, T value)
+{
+  memcpy(dest, &value, sizeof(T));
+  if (!IsLittleEndian()) std::reverse(dest, dest + sizeof(T));
+  return dest + sizeof(T);
+}
+
+// Reads a little-endian value at src and returns the address that follows it.
+template <typename T> const char* UnpackValue(const char* src, T& value)
+{
+  char bytes[sizeof(T)];
+  memcpy(bytes, src, sizeof(T));
+  if (!IsLittleEndian()) std::reverse(bytes, bytes + sizeof(T));
+  memcpy(&value, bytes, sizeof(T));
+  return src + sizeof(T);
+}
+
+template <typename T> void AppendValue(std::vector<char>& buffer, T value)
+{
+  size_t size = buffer.size();
+  buffer.resize(size + sizeof(T));
+  PackValue(&buffer[size], value);
+}
+
+// Appends a string as its length (uint16) followed by its characters.
+inline void AppendString(std::vector<char>& buffer, const std::string& str)
+{
+  AppendValue(buffer, static_cast<uint16_t>(str.size()));
+  buffer.insert(buffer.end(), str.begin(), str.end());
+}
+
+}
+
+#endif
@@ -0,0 +1,716 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       jsbsim_bench.cpp
+ Date started: 10/17/26
+ Purpose:      Measures the execution speed of the aircraft and the scripts
+               of the JSBSim tree.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+Each aircraft found under the aircraft/ directory is flown in 3 regimes:
+
+- ground: the aircraft rests on its gear with its engines running,
+- cruise: the aircraft flies 5000 ft above the ground at the first speed among
+  120, 250, 60 and 400 kts for which the trim succeeds,
+- turbulence: same as cruise in a moderate MIL-spec turbulence.
+
+The aircraft is trimmed (when the trim succeeds) then a fixed number of frames
+are executed and timed. When the option --scripts is given, each script found
+under the scripts/ directory is also executed for the same number of frames.
+
+The results are written in CSV format, one line per aircraft and regime:
+
+  case,regime,frames,trimmed,steps_per_sec,ns_per_frame,allocs_per_frame,peak_rss_kb,status
+
+allocs_per_frame is the number of calls to operator new per frame and
+peak_rss_kb is the peak resident set size of the process when the run
+completes. On POSIX systems each run is executed in a child process: an
+aircraft that crashes is reported with the status "crashed" and the peak RSS
+is measured for each run separately.
+
+A file produced by a previous run can be given as a baseline with the option
+--baseline. The time and the allocations per frame are then compared to the
+baseline and the program returns a non zero value if one of them has increased
+by more than the tolerance (10% by default).
+
+Usage:
+
+  jsbsim_bench [--root=<dir>] [--aircraft=<name>]... [--scripts]
+               [--frames=<n>] [--output=<file>] [--baseline=<file>]
+               [--tolerance=<percent>]
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#  include <psapi.h>
+#else
+#  include <dirent.h>
+#  include <unistd.h>
+#  include <sys/resource.h>
+#  include <sys/wait.h>
+#endif
+
+#include "FGFDMExec.h"
+#include "initialization/FGInitialCondition.h"
+#include "initialization/FGTrim.h"
+#include "models/FGGroundReactions.h"
+#include "models/FGOutput.h"
+
+using namespace std;
+using namespace JSBSim;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+ALLOCATION COUNTER
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+static atomic<unsigned long> nAllocations(0);
+
+void* operator new(size_t size)
+{
+  nAllocations.fetch_add(1, memory_order_relaxed);
+  void* p = malloc(size ? size : 1);
+  if (!p) throw bad_alloc();
+  return p;
+}
+
+void* operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+GLOBAL DATA
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+struct Options {
+  string root;
+  vector<string> aircraft;
+  bool scripts;
+  unsigned int frames;
+  string output;
+  string baseline;
+  double tolerance;
+};
+
+struct Result {
+  string name;
+  string regime;
+  unsigned int frames;
+  bool trimmed;
+  double ns_per_frame;
+  double allocs_per_frame;
+  long peak_rss_kb;
+  string status;
+  string message;
+};
+
+enum Regime { eGround=0, eCruise, eTurbulence, eNumRegimes };
+const char* RegimeNames[eNumRegimes] = {"ground", "cruise", "turbulence"};
+
+// Frames executed before the timing starts.
+const unsigned int nWarmUpFrames = 10;
+
+// Discards the messages sent to cout and cerr during its lifetime.
+class Silencer {
+public:
+  Silencer(void) : coutbuf(cout.rdbuf(sink.rdbuf())),
+                   cerrbuf(cerr.rdbuf(sink.rdbuf())) {}
+  ~Silencer() { cout.rdbuf(coutbuf); cerr.rdbuf(cerrbuf); }
+
+private:
+  ostringstream sink;
+  streambuf* coutbuf;
+  streambuf* cerrbuf;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FUNCTIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+// Returns the peak resident set size of the process in kilobytes.
+long GetPeakRSS(void)
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS info;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &info, sizeof(info)))
+    return (long)(info.PeakWorkingSetSize / 1024);
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#  if defined(__APPLE__)
+  return usage.ru_maxrss / 1024; // Bytes on Mac OS X
+#  else
+  return usage.ru_maxrss;
+#  endif
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns the sorted list of the entries of a directory.
+
+vector<string> ListDirectory(const SGPath& dir)
+{
+  vector<string> entries;
+
+#if defined(_WIN32)
+  WIN32_FIND_DATAA data;
+  HANDLE h = FindFirstFileA((dir/"*").c_str(), &data);
+  if (h != INVALID_HANDLE_VALUE) {
+    do {
+      string name = data.cFileName;
+      if (name != "." && name != "..") entries.push_back(name);
+    } while (FindNextFileA(h, &data));
+    FindClose(h);
+  }
+#else
+  DIR* d = opendir(dir.c_str());
+  if (d) {
+    struct dirent* entry;
+    while ((entry = readdir(d))) {
+      string name = entry->d_name;
+      if (name != "." && name != "..") entries.push_back(name);
+    }
+    closedir(d);
+  }
+#endif
+
+  sort(entries.begin(), entries.end());
+  return entries;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGFDMExec* CreateFDM(const Options& options)
+{
+  FGFDMExec* fdm = new FGFDMExec();
+  fdm->SetDebugLevel(0);
+  fdm->SetRootDir(SGPath::fromLocal8Bit(options.root.c_str()));
+  fdm->SetAircraftPath(SGPath("aircraft"));
+  fdm->SetEnginePath(SGPath("engine"));
+  fdm->SetSystemsPath(SGPath("systems"));
+  return fdm;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Executes and times the frames. The simulation may end before all the frames
+// have been executed.
+
+void TimeFrames(FGFDMExec* fdm, unsigned int frames, Result& result)
+{
+  for (unsigned int i=0; i<nWarmUpFrames; i++)
+    if (!fdm->Run()) break;
+
+  unsigned long allocations = nAllocations.load();
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+  unsigned int i = 0;
+  while (i < frames) {
+    i++;
+    if (!fdm->Run()) break;
+  }
+
+  chrono::steady_clock::time_point stop = chrono::steady_clock::now();
+  allocations = nAllocations.load() - allocations;
+
+  result.frames = i;
+  if (i > 0) {
+    result.ns_per_frame = chrono::duration<double, nano>(stop-start).count() / i;
+    result.allocs_per_frame = (double)allocations / i;
+  }
+  result.peak_rss_kb = GetPeakRSS();
+  if (i < frames) result.status = "terminated";
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Result BenchAircraft(const Options& options, const string& model,
+                     Regime regime)
+{
+  Result result;
+  result.name = model;
+  result.regime = RegimeNames[regime];
+  result.frames = 0;
+  result.trimmed = false;
+  result.ns_per_frame = 0.0;
+  result.allocs_per_frame = 0.0;
+  result.peak_rss_kb = 0;
+  result.status = "ok";
+
+  FGFDMExec* fdm = CreateFDM(options);
+
+  try {
+    if (!fdm->LoadModel(model)) {
+      result.status = "load-error";
+      delete fdm;
+      return result;
+    }
+
+    fdm->GetOutput()->Disable();
+
+    FGInitialCondition* ic = fdm->GetIC();
+    ic->SetTerrainElevationFtIC(0.0);
+    ic->SetLatitudeDegIC(45.0);
+    ic->SetLongitudeDegIC(0.0);
+    ic->SetPsiDegIC(90.0);
+
+    // The cruise speed is not known so the speeds are tried in turn until the
+    // trim succeeds. The aircraft is flown untrimmed at the first speed when
+    // they all fail.
+    const double GroundSpeeds[] = {0.0};
+    const double CruiseSpeeds[] = {120.0, 250.0, 60.0, 400.0, 120.0};
+    const double* speeds = regime == eGround ? GroundSpeeds : CruiseSpeeds;
+    unsigned int nSpeeds = regime == eGround ? 1 : 5;
+
+    for (unsigned int i=0; i<nSpeeds && !result.trimmed; i++) {
+      ic->SetAltitudeAGLFtIC(regime == eGround ? 0.0 : 5000.0);
+      ic->SetVcalibratedKtsIC(speeds[i]);
+
+      if (!fdm->RunIC()) {
+        result.status = "ic-error";
+        delete fdm;
+        return result;
+      }
+
+      fdm->SetPropertyValue("propulsion/set-running", -1);
+
+      // The last attempt only restores the initial conditions.
+      if (i == nSpeeds-1 && nSpeeds > 1) break;
+
+      // The ground trim needs contact points.
+      if (regime == eGround && fdm->GetGroundReactions()->GetNumGearUnits() == 0)
+        break;
+
+      try {
+        fdm->DoTrim(regime == eGround ? tGround : tFull);
+        result.trimmed = true;
+      } catch (...) {
+      }
+    }
+
+    if (regime == eTurbulence) {
+      fdm->SetPropertyValue("atmosphere/turb-type", 3); // MIL-spec
+      fdm->SetPropertyValue("atmosphere/turbulence/milspec/windspeed_at_20ft_AGL-fps", 25.0);
+      fdm->SetPropertyValue("atmosphere/turbulence/milspec/severity", 4);
+    }
+
+    TimeFrames(fdm, options.frames, result);
+  }
+  catch (const string& msg) {
+    result.status = "exception";
+    result.message = msg;
+  }
+  catch (const char* msg) {
+    result.status = "exception";
+    result.message = msg;
+  }
+  catch (...) {
+    result.status = "exception";
+  }
+
+  delete fdm;
+  return result;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Result BenchScript(const Options& options, const string& script)
+{
+  Result result;
+  result.name = "scripts/" + script;
+  result.regime = "script";
+  result.frames = 0;
+  result.trimmed = false;
+  result.ns_per_frame = 0.0;
+  result.allocs_per_frame = 0.0;
+  result.peak_rss_kb = 0;
+  result.status = "ok";
+
+  FGFDMExec* fdm = CreateFDM(options);
+
+  try {
+    if (!fdm->LoadScript(SGPath("scripts")/script)) {
+      result.status = "load-error";
+      delete fdm;
+      return result;
+    }
+
+    fdm->GetOutput()->Disable();
+
+    if (!fdm->RunIC()) {
+      result.status = "ic-error";
+      delete fdm;
+      return result;
+    }
+
+    result.trimmed = fdm->GetPropertyValue("simulation/trim-completed") != 0.0;
+    TimeFrames(fdm, options.frames, result);
+  }
+  catch (const string& msg) {
+    result.status = "exception";
+    result.message = msg;
+  }
+  catch (const char* msg) {
+    result.status = "exception";
+    result.message = msg;
+  }
+  catch (...) {
+    result.status = "exception";
+  }
+
+  delete fdm;
+  return result;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void PrintHeader(ostream& out)
+{
+  out << "case,regime,frames,trimmed,steps_per_sec,ns_per_frame,"
+      << "allocs_per_frame,peak_rss_kb,status" << endl;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void PrintResult(ostream& out, const Result& r)
+{
+  double steps = r.ns_per_frame > 0.0 ? 1E9/r.ns_per_frame : 0.0;
+
+  out << r.name << ',' << r.regime << ',' << r.frames << ','
+      << (r.trimmed ? 1 : 0) << ',' << fixed << setprecision(1) << steps << ','
+      << r.ns_per_frame << ',' << setprecision(3) << r.allocs_per_frame << ','
+      << r.peak_rss_kb << ',' << r.status << endl;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Reads a file produced by PrintResult(). The results are indexed by
+// "case,regime".
+
+bool ParseResult(const string& line, Result& r)
+{
+  vector<string> fields;
+  istringstream sline(line);
+  string field;
+  while (getline(sline, field, ',')) fields.push_back(field);
+  if (fields.size() < 9) return false;
+
+  r.name = fields[0];
+  r.regime = fields[1];
+  r.frames = atoi(fields[2].c_str());
+  r.trimmed = atoi(fields[3].c_str()) != 0;
+  r.ns_per_frame = atof(fields[5].c_str());
+  r.allocs_per_frame = atof(fields[6].c_str());
+  r.peak_rss_kb = atol(fields[7].c_str());
+  r.status = fields[8];
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool ReadBaseline(const string& fname, map<string, Result>& baseline)
+{
+  ifstream in(fname.c_str());
+  if (!in) return false;
+
+  string line;
+  getline(in, line); // Skip the header
+
+  while (getline(in, line)) {
+    Result r;
+    if (ParseResult(line, r)) baseline[r.name + "," + r.regime] = r;
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Runs a case with its messages discarded. On POSIX systems, the case is run in
+// a child process so that an aircraft which crashes JSBSim does not stop the
+// benchmark and so that the peak RSS is measured for each case separately.
+
+Result RunCase(const function<Result(void)>& bench, const string& name,
+               const string& regime)
+{
+#if defined(_WIN32)
+  Silencer silencer;
+  return bench();
+#else
+  int fd[2];
+  if (pipe(fd) != 0) {
+    Silencer silencer;
+    return bench();
+  }
+
+  cout.flush();
+  cerr.flush();
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fd[0]);
+    Result r;
+    {
+      Silencer silencer;
+      r = bench();
+    }
+    ostringstream os;
+    PrintResult(os, r);
+    os << r.message;
+    string buffer = os.str();
+    const char* data = buffer.c_str();
+    size_t size = buffer.size();
+    while (size > 0) {
+      ssize_t n = write(fd[1], data, size);
+      if (n <= 0) break;
+      data += n;
+      size -= n;
+    }
+    close(fd[1]);
+    _exit(0);
+  }
+
+  close(fd[1]);
+  string buffer;
+  char chunk[1024];
+  ssize_t n;
+  while ((n = read(fd[0], chunk, sizeof(chunk))) > 0) buffer.append(chunk, n);
+  close(fd[0]);
+
+  int status = 0;
+  if (pid > 0) waitpid(pid, &status, 0);
+
+  Result r;
+  r.name = name;
+  r.regime = regime;
+  r.frames = 0;
+  r.trimmed = false;
+  r.ns_per_frame = 0.0;
+  r.allocs_per_frame = 0.0;
+  r.peak_rss_kb = 0;
+
+  size_t eol = buffer.find('\n');
+  if (pid < 0)
+    r.status = "fork-error";
+  else if (eol == string::npos || !ParseResult(buffer.substr(0, eol), r)) {
+    r.status = "crashed";
+    if (WIFSIGNALED(status)) {
+      ostringstream msg;
+      msg << "terminated by signal " << WTERMSIG(status);
+      r.message = msg.str();
+    }
+  } else
+    r.message = buffer.substr(eol+1);
+
+  return r;
+#endif
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Compares a result to the baseline and returns false if it has regressed.
+
+bool CompareResult(const Result& r, const map<string, Result>& baseline,
+                   double tolerance)
+{
+  map<string, Result>::const_iterator it = baseline.find(r.name + "," + r.regime);
+  if (it == baseline.end() || r.status != "ok" || it->second.status != "ok")
+    return true;
+
+  const Result& base = it->second;
+  double factor = 1.0 + 0.01*tolerance;
+  bool success = true;
+
+  if (r.ns_per_frame > factor*base.ns_per_frame) {
+    cerr << "REGRESSION " << r.name << " (" << r.regime << "): "
+         << fixed << setprecision(1) << r.ns_per_frame << " ns/frame vs "
+         << base.ns_per_frame << " ns/frame ("
+         << showpos << 100.0*(r.ns_per_frame/base.ns_per_frame - 1.0)
+         << noshowpos << "%)" << endl;
+    success = false;
+  }
+
+  // Allocation counts are deterministic: small variations are flagged as well.
+  if (r.allocs_per_frame > factor*base.allocs_per_frame
+      && r.allocs_per_frame - base.allocs_per_frame >= 0.5) {
+    cerr << "REGRESSION " << r.name << " (" << r.regime << "): "
+         << fixed << setprecision(3) << r.allocs_per_frame
+         << " allocations/frame vs " << base.allocs_per_frame << endl;
+    success = false;
+  }
+
+  return success;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Writes a result and checks it against the baseline.
+
+bool ReportResult(ostream& out, const Result& r,
+                  const map<string, Result>& baseline, double tolerance)
+{
+  PrintResult(out, r);
+  if (!r.message.empty())
+    cerr << r.name << " (" << r.regime << "): " << r.message << endl;
+  return CompareResult(r, baseline, tolerance);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void PrintUsage(const char* name)
+{
+  cerr << "Usage: " << name << " [options]" << endl
+       << "  --root=<dir>          JSBSim root directory (default: current directory)" << endl
+       << "  --aircraft=<name>     only benchmark this aircraft (can be repeated)" << endl
+       << "  --scripts             also run the scripts of the scripts/ directory" << endl
+       << "  --frames=<n>          number of timed frames per run (default: 2000)" << endl
+       << "  --output=<file>       write the results to a file (default: stdout)" << endl
+       << "  --baseline=<file>     compare the results with a previous run" << endl
+       << "  --tolerance=<percent> regression threshold (default: 10)" << endl;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool ParseOptions(int argc, char* argv[], Options& options)
+{
+  options.root = ".";
+  options.scripts = false;
+  options.frames = 2000;
+  options.tolerance = 10.0;
+
+  for (int i=1; i<argc; i++) {
+    string arg = argv[i];
+    string value;
+    size_t eq = arg.find('=');
+    if (eq != string::npos) {
+      value = arg.substr(eq+1);
+      arg = arg.substr(0, eq);
+    }
+
+    if (arg == "--root") options.root = value;
+    else if (arg == "--aircraft") options.aircraft.push_back(value);
+    else if (arg == "--scripts") options.scripts = true;
+    else if (arg == "--frames") options.frames = atoi(value.c_str());
+    else if (arg == "--output") options.output = value;
+    else if (arg == "--baseline") options.baseline = value;
+    else if (arg == "--tolerance") options.tolerance = atof(value.c_str());
+    else {
+      cerr << "Unknown option " << argv[i] << endl;
+      return false;
+    }
+  }
+
+  if (options.frames == 0) {
+    cerr << "The number of frames must be positive" << endl;
+    return false;
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  map<string, Result> baseline;
+  if (!options.baseline.empty() && !ReadBaseline(options.baseline, baseline)) {
+    cerr << "Could not read the baseline file " << options.baseline << endl;
+    return 1;
+  }
+
+  SGPath root = SGPath::fromLocal8Bit(options.root.c_str());
+
+  if (options.aircraft.empty()) {
+    vector<string> entries = ListDirectory(root/"aircraft");
+    for (unsigned int i=0; i<entries.size(); i++) {
+      SGPath config = root/"aircraft"/entries[i]/(entries[i] + ".xml");
+      if (config.isFile()) options.aircraft.push_back(entries[i]);
+    }
+  }
+
+  vector<string> scripts;
+  if (options.scripts) {
+    vector<string> entries = ListDirectory(root/"scripts");
+    for (unsigned int i=0; i<entries.size(); i++) {
+      SGPath script = root/"scripts"/entries[i];
+      if (script.extension() == "xml" && script.isFile())
+        scripts.push_back(entries[i]);
+    }
+  }
+
+  // The CSV goes to a file or to the standard output. JSBSim messages (trim
+  // reports, warnings, etc.) are discarded while the cases are run.
+  ofstream file;
+  ostream out(cout.rdbuf());
+  if (!options.output.empty()) {
+    file.open(options.output.c_str());
+    if (!file) {
+      cerr << "Could not open " << options.output << endl;
+      return 1;
+    }
+    out.rdbuf(file.rdbuf());
+  }
+
+  bool success = true;
+
+  PrintHeader(out);
+
+  for (unsigned int i=0; i<options.aircraft.size(); i++) {
+    for (unsigned int regime=0; regime<eNumRegimes; regime++) {
+      Result r = RunCase(bind(BenchAircraft, cref(options),
+                              cref(options.aircraft[i]), (Regime)regime),
+                         options.aircraft[i], RegimeNames[regime]);
+      if (!ReportResult(out, r, baseline, options.tolerance)) success = false;
+    }
+  }
+
+  for (unsigned int i=0; i<scripts.size(); i++) {
+    Result r = RunCase(bind(BenchScript, cref(options), cref(scripts[i])),
+                       "scripts/" + scripts[i], "script");
+    if (!ReportResult(out, r, baseline, options.tolerance)) success = false;
+  }
+
+  return success ? 0 : 1;
+}
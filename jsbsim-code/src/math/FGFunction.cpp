@@ -30,8 +30,11 @@ INCLUDES
 
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <cmath>
+#include <typeinfo>
 
 #include "simgear/misc/strutils.hxx"
 #include "FGFunction.h"
@@ -39,6 +42,9 @@ INCLUDES
 #include "FGPropertyValue.h"
 #include "FGRealValue.h"
 #include "input_output/FGXMLElement.h"
+#include "FGFDMExec.h"
+#include "input_output/FGPropertyProfiler.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -52,6 +58,10 @@ CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 const double FGFunction::invlog2val = 1.0/log10(2.0);
+std::atomic<bool> FGFunction::compilation_enabled(true);
+std::atomic<bool> FGFunction::memoization_enabled(true);
+// Number of points evaluated together by GetValues().
+static const unsigned int BlockSize = 64;
 
 const std::string FGFunction::property_string = "property";
 const std::string FGFunction::value_string = "value";
@@ -111,16 +121,28 @@ const std::string FGFunction::ifthen_string = "ifthen";
 const std::string FGFunction::switch_string = "switch";
 const std::string FGFunction::interpolate1d_string = "interpolate1d";
 
-FGFunction::FGFunction(FGPropertyManager* PropertyManager, Element* el,
-                       const string& prefix, FGPropertyValue* var)
-  : Prefix(prefix), cached(false), cachedValue(-HUGE_VAL), pCopyTo(0L)
+FGFunction::FGFunction(FGFDMExec* fdmex, Element* el, const string& prefix,
+                       FGPropertyValue* var)
+  : Prefix(prefix), cached(false), cachedValue(-HUGE_VAL), pCopyTo(0L),
+    Compilation(eNotCompiled), FDMExec(0L), memoized(false),
+    memoValid(false), memoValue(0.0)
 {
-  Load(PropertyManager, el, var);
+  Load(fdmex, el, var);
 }
 
-void FGFunction::Load(FGPropertyManager* PropertyManager, Element* el,
-                      FGPropertyValue* var)
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGFunction::~FGFunction(void)
+{
+  if (FDMExec) FDMExec->RemoveUncompiledFunction(this);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFunction::Load(FGFDMExec* fdmex, Element* el, FGPropertyValue* var)
 {
+  FGPropertyManager* PropertyManager = fdmex->GetPropertyManager();
+
   Name = el->GetAttributeValue("name");
   string operation = el->GetName();
 
@@ -193,8 +215,10 @@ void FGFunction::Load(FGPropertyManager* PropertyManager, Element* el,
     Type = eMod;
   } else if (operation == random_string) {
     Type = eRandom;
+    RandomStream = fdmex->GetRandomStream();
   } else if (operation == urandom_string) {
     Type = eUrandom;
+    RandomStream = fdmex->GetRandomStream();
   } else if (operation == pi_string) {
     Type = ePi;
   } else if (operation == rotation_alpha_local_string) {
@@ -329,13 +353,24 @@ void FGFunction::Load(FGPropertyManager* PropertyManager, Element* el,
                operation == switch_string ||
                operation == interpolate1d_string)
       {
-        Parameters.push_back(new FGFunction(PropertyManager, element, Prefix, var));
+        Parameters.push_back(new FGFunction(fdmex, element, Prefix, var));
       } else if (operation != description_string) {
       cerr << "Bad operation " << operation << " detected in configuration file" << endl;
     }
     element = el->GetNextElement();
   }
 
+  // The node of a template function variable changes at each call so it can
+  // not be compiled in the program.
+  if (var) Compilation = eInterpreted;
+
+  // The top level functions are compiled by the executive once the model is
+  // loaded. The operations they contain are compiled along with them.
+  if (Type == eTopLevel && Compilation == eNotCompiled) {
+    FDMExec = fdmex;
+    FDMExec->AddUncompiledFunction(this);
+  }
+
   bind(el, PropertyManager); // Allow any function to save its value
 
   Debug(0);
@@ -355,6 +390,13 @@ void FGFunction::cacheValue(bool cache)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGFunction::SerializeState(FGStateArchive& ar)
+{
+  ar & cached & cachedValue;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 unsigned int FGFunction::GetBinary(double val) const
 {
   val = fabs(val);
@@ -368,13 +410,30 @@ unsigned int FGFunction::GetBinary(double val) const
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 double FGFunction::GetValue(void) const
+{
+  if (cached) return cachedValue;
+
+  FGPropertyProfiler::Scope scope(FGPropertyProfiler::ecFunction);
+
+  if (Compilation == eNotCompiled) Compile();
+
+  if (Compilation == eCompiled) {
+    double temp = memoized ? ExecuteIfChanged() : Execute();
+    if (pCopyTo) pCopyTo->setDoubleValue(temp);
+    return temp;
+  }
+
+  return Interpret();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGFunction::Interpret(void) const
 {
   unsigned int i;
   double scratch;
   double temp=0;
 
-  if (cached) return cachedValue;
-
   if (   Type != eRandom
       && Type != eUrandom
       && Type != ePi      ) temp = Parameters[0]->GetValue();
@@ -485,10 +544,10 @@ double FGFunction::GetValue(void) const
     temp = scratch;
     break;
   case eRandom:
-    temp = GaussianRandomNumber();
+    temp = RandomStream->GetNormal();
     break;
   case eUrandom:
-    temp = -1.0 + (((double)rand()/double(RAND_MAX))*2.0);
+    temp = RandomStream->GetUniformSigned();
     break;
   case ePi:
     temp = M_PI;
@@ -780,6 +839,974 @@ double FGFunction::GetValue(void) const
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGFunction::Compile(void) const
+{
+  if (FDMExec) {
+    FDMExec->RemoveUncompiledFunction(this);
+    FDMExec = 0L;
+  }
+
+  if (Compilation == eNotCompiled) CompileProgram();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFunction::CompileProgram(void) const
+{
+  Compilation = eInterpreted;
+
+  if (!compilation_enabled) return;
+
+  Program program;
+
+  if (Type == eTopLevel) {
+    if (Parameters.empty()) return;
+    CompileParameter(program, Parameters[0], 0);
+  }
+  else if (!CompileOperation(program, 0))
+    return;
+
+  Compiled.Code.swap(program.Code);
+  Compiled.JumpTable.swap(program.JumpTable);
+  Compiled.Registers.swap(program.Registers);
+  Compiled.Slots.swap(program.Slots);
+  Compilation = eCompiled;
+
+  FindDependencies();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// Lists the properties read by the compiled program. Its value can only be
+// reused if they are all known and if it does not draw random numbers.
+
+void FGFunction::FindDependencies(void) const
+{
+  vector<FGPropertyNode*> nodes;
+
+  memoized = false;
+  memoValid = false;
+
+  if (!memoization_enabled) return;
+
+  for (unsigned int pc=0; pc<Compiled.Code.size(); pc++) {
+    const Instruction& ins = Compiled.Code[pc];
+
+    switch (ins.Op) {
+    case opProperty:
+    case opNegProperty:
+    case opAddProperty:
+    case opSubtractProperty:
+    case opMultiplyProperty:
+      nodes.push_back(ins.Node);
+      break;
+    case opTable:
+    case opAddTable:
+    case opSubtractTable:
+    case opMultiplyTable:
+      ins.Table->GetInputs(nodes);
+      break;
+    case opCall:
+    case opRandom:
+    case opUrandom:
+      return;
+    default:
+      break;
+    }
+  }
+
+  sort(nodes.begin(), nodes.end());
+  nodes.erase(unique(nodes.begin(), nodes.end()), nodes.end());
+
+  Dependencies.clear();
+  for (unsigned int i=0; i<nodes.size(); i++)
+    Dependencies.push_back(FGPropertySlot(nodes[i]));
+  DependencyValues.assign(Dependencies.size(), 0.0);
+  memoized = true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+unsigned int FGFunction::Emit(Program& program, OpCode op, unsigned int a,
+                              unsigned int b)
+{
+  Instruction instruction;
+
+  instruction.Op = op;
+  instruction.A = a;
+  instruction.B = b;
+  instruction.Value = 0.0;
+  program.Code.push_back(instruction);
+
+  if (a >= program.Registers.size()) program.Registers.resize(a+1, 0.0);
+
+  return program.Code.size()-1;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns 1 + the index of the slot of the program from which the property is
+// read directly, or 0 if its value is not stored in a variable and must be
+// read by its node.
+
+unsigned int FGFunction::AddSlot(Program& program, FGPropertyNode* node)
+{
+  FGPropertySlot slot(node);
+
+  if (!slot.IsDirect()) return 0;
+
+  program.Slots.push_back(slot);
+  return program.Slots.size();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Emits the code that stores the value of the parameter p in the register reg.
+// The registers above reg can be used as temporaries.
+
+void FGFunction::CompileParameter(Program& program, const FGParameter* p,
+                                  unsigned int reg)
+{
+  const type_info& type = typeid(*p);
+  unsigned int i;
+
+  if (type == typeid(FGRealValue)) {
+    i = Emit(program, opConstant, reg);
+    program.Code[i].Value = p->GetValue();
+    return;
+  }
+  else if (type == typeid(FGPropertyValue)) {
+    const FGPropertyValue* value = static_cast<const FGPropertyValue*>(p);
+    FGPropertyNode* node = value->FindNode();
+
+    // A property which is not yet defined is resolved at each evaluation.
+    if (node) {
+      i = Emit(program, value->GetSign() < 0 ? opNegProperty : opProperty,
+               reg);
+      program.Code[i].Node = node;
+      program.Code[i].B = AddSlot(program, node);
+      return;
+    }
+  }
+  else if (type == typeid(FGTable)) {
+    i = Emit(program, opTable, reg);
+    program.Code[i].Table = static_cast<const FGTable*>(p);
+    return;
+  }
+  else if (type == typeid(FGFunction)) {
+    const FGFunction* f = static_cast<const FGFunction*>(p);
+    if (f->Compilation != eInterpreted && f->CompileOperation(program, reg))
+      return;
+  }
+
+  // Fall back to the evaluation of the parameter.
+  i = Emit(program, opCall, reg);
+  program.Code[i].Parameter = p;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Emits a single instruction that applies the operation op (an addition, a
+// subtraction or a product) to the register reg and to a constant, a property
+// or a table. Most of the aerodynamic coefficients are products of properties
+// and tables so this halves the number of instructions to execute.
+// Returns false (and emits nothing) if p is not such a parameter.
+
+bool FGFunction::CompileOperand(Program& program, OpCode op,
+                                const FGParameter* p, unsigned int reg)
+{
+  const type_info& type = typeid(*p);
+  unsigned int i;
+
+  if (op != opAdd && op != opSubtract && op != opMultiply) return false;
+
+  if (type == typeid(FGRealValue)) {
+    i = Emit(program, OpCode(op+1), reg);
+    program.Code[i].Value = p->GetValue();
+    return true;
+  }
+  else if (type == typeid(FGPropertyValue)) {
+    const FGPropertyValue* value = static_cast<const FGPropertyValue*>(p);
+    FGPropertyNode* node = value->FindNode();
+    if (!node || value->GetSign() < 0) return false;
+    i = Emit(program, OpCode(op+2), reg);
+    program.Code[i].Node = node;
+    program.Code[i].B = AddSlot(program, node);
+    return true;
+  }
+  else if (type == typeid(FGTable)) {
+    i = Emit(program, OpCode(op+3), reg);
+    program.Code[i].Table = static_cast<const FGTable*>(p);
+    return true;
+  }
+
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Emits the code that stores the result of the operation in the register reg.
+// Returns false (and emits nothing) if the operation can not be compiled.
+
+bool FGFunction::CompileOperation(Program& program, unsigned int reg) const
+{
+  enum {eList, eBinary, eUnary, eOther} form = eOther;
+  OpCode op = opCall;
+  size_t n = Parameters.size();
+  unsigned int i;
+
+  switch (Type) {
+  case eProduct:    form = eList;   op = opMultiply;  break;
+  case eDifference: form = eList;   op = opSubtract;  break;
+  case eSum:        form = eList;   op = opAdd;       break;
+  case eAvg:        form = eList;   op = opAdd;       break;
+  case eMin:        form = eList;   op = opMin;       break;
+  case eMax:        form = eList;   op = opMax;       break;
+  case eQuotient:   form = eBinary; op = opDivide;    break;
+  case ePow:        form = eBinary; op = opPow;       break;
+  case eATan2:      form = eBinary; op = opATan2;     break;
+  case eMod:        form = eBinary; op = opMod;       break;
+  case eLT:         form = eBinary; op = opLT;        break;
+  case eLE:         form = eBinary; op = opLE;        break;
+  case eGT:         form = eBinary; op = opGT;        break;
+  case eGE:         form = eBinary; op = opGE;        break;
+  case eEQ:         form = eBinary; op = opEQ;        break;
+  case eNE:         form = eBinary; op = opNE;        break;
+  case eSqrt:       form = eUnary;  op = opSqrt;      break;
+  case eToRadians:  form = eUnary;  op = opToRadians; break;
+  case eToDegrees:  form = eUnary;  op = opToDegrees; break;
+  case eExp:        form = eUnary;  op = opExp;       break;
+  case eLog2:       form = eUnary;  op = opLog2;      break;
+  case eLn:         form = eUnary;  op = opLn;        break;
+  case eLog10:      form = eUnary;  op = opLog10;     break;
+  case eAbs:        form = eUnary;  op = opAbs;       break;
+  case eSign:       form = eUnary;  op = opSign;      break;
+  case eSin:        form = eUnary;  op = opSin;       break;
+  case eCos:        form = eUnary;  op = opCos;       break;
+  case eTan:        form = eUnary;  op = opTan;       break;
+  case eASin:       form = eUnary;  op = opASin;      break;
+  case eACos:       form = eUnary;  op = opACos;      break;
+  case eATan:       form = eUnary;  op = opATan;      break;
+  case eFrac:       form = eUnary;  op = opFrac;      break;
+  case eInteger:    form = eUnary;  op = opInteger;   break;
+  case eNOT:        form = eUnary;  op = opNot;       break;
+  default:
+    break;
+  }
+
+  switch (form) {
+  case eList:
+    if (n == 0) return false;
+    // The tree evaluates the arguments of min and max twice so they must
+    // return the same value each time.
+    if (Type == eMin || Type == eMax) {
+      for (i=1; i<n; i++)
+        if (!IsPure(Parameters[i])) return false;
+    }
+    CompileParameter(program, Parameters[0], reg);
+    for (i=1; i<n; i++) {
+      if (CompileOperand(program, op, Parameters[i], reg)) continue;
+      CompileParameter(program, Parameters[i], reg+1);
+      Emit(program, op, reg, reg+1);
+    }
+    if (Type == eAvg) {
+      i = Emit(program, opDivideBy, reg);
+      program.Code[i].Value = n;
+    }
+    return true;
+  case eBinary:
+    if (n < 2) return false;
+    // The denominator is evaluated twice by the tree.
+    if (Type == eQuotient && !IsPure(Parameters[1])) return false;
+    CompileParameter(program, Parameters[0], reg);
+    CompileParameter(program, Parameters[1], reg+1);
+    Emit(program, op, reg, reg+1);
+    return true;
+  case eUnary:
+    if (n == 0) return false;
+    CompileParameter(program, Parameters[0], reg);
+    Emit(program, op, reg);
+    return true;
+  default:
+    break;
+  }
+
+  switch (Type) {
+  case eRandom:
+  case eUrandom:
+    i = Emit(program, Type == eRandom ? opRandom : opUrandom, reg);
+    program.Code[i].Random = RandomStream;
+    return true;
+  case ePi:
+    i = Emit(program, opConstant, reg);
+    program.Code[i].Value = M_PI;
+    return true;
+  case eAND:
+  case eOR:
+    {
+      if (n == 0) return false;
+      vector<unsigned int> jumps;
+      CompileParameter(program, Parameters[0], reg);
+      Emit(program, opBinary, reg);
+      for (i=1; i<n; i++) {
+        jumps.push_back(Emit(program, Type == eAND ? opJumpIfZero
+                                                   : opJumpIfNotZero, reg));
+        CompileParameter(program, Parameters[i], reg);
+        Emit(program, opBinary, reg);
+      }
+      for (i=0; i<jumps.size(); i++)
+        program.Code[jumps[i]].Target = program.Code.size();
+    }
+    return true;
+  case eIfThen:
+    {
+      if (n != 3) return false;
+      CompileParameter(program, Parameters[0], reg);
+      Emit(program, opBinary, reg);
+      unsigned int jumpElse = Emit(program, opJumpIfZero, reg);
+      CompileParameter(program, Parameters[1], reg);
+      unsigned int jumpEnd = Emit(program, opJump, reg);
+      program.Code[jumpElse].Target = program.Code.size();
+      CompileParameter(program, Parameters[2], reg);
+      program.Code[jumpEnd].Target = program.Code.size();
+    }
+    return true;
+  case eSwitch:
+    {
+      if (n == 0) return false;
+      vector<unsigned int> jumps;
+      CompileParameter(program, Parameters[0], reg);
+      unsigned int table = program.JumpTable.size();
+      i = Emit(program, opSwitch, reg, n-1);
+      program.Code[i].Target = table;
+      program.JumpTable.resize(table+n-1);
+      for (i=1; i<n; i++) {
+        program.JumpTable[table+i-1] = program.Code.size();
+        CompileParameter(program, Parameters[i], reg);
+        jumps.push_back(Emit(program, opJump, reg));
+      }
+      for (i=0; i<jumps.size(); i++)
+        program.Code[jumps[i]].Target = program.Code.size();
+    }
+    return true;
+  case eInterpolate1D:
+    if (n < 3) return false;
+    // The tree only evaluates the breakpoints it needs: they are all
+    // evaluated by the program which is only acceptable for constants.
+    for (i=1; i<n; i++)
+      if (typeid(*Parameters[i]) != typeid(FGRealValue)) return false;
+    for (i=0; i<n; i++)
+      CompileParameter(program, Parameters[i], reg+i);
+    Emit(program, opInterpolate1D, reg, n);
+    return true;
+  default:
+    // The rotations are not compiled.
+    return false;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Checks that a parameter returns the same value each time it is evaluated
+// during a frame.
+
+bool FGFunction::IsPure(const FGParameter* p)
+{
+  const type_info& type = typeid(*p);
+
+  if (type == typeid(FGRealValue) || type == typeid(FGPropertyValue)
+      || type == typeid(FGTable))
+    return true;
+
+  if (type == typeid(FGFunction)) {
+    const FGFunction* f = static_cast<const FGFunction*>(p);
+    if (f->Type == eRandom || f->Type == eUrandom) return false;
+    for (unsigned int i=0; i<f->Parameters.size(); i++)
+      if (!IsPure(f->Parameters[i])) return false;
+    return true;
+  }
+
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Executes the program only if the value of one of the properties it reads has
+// changed since its previous execution. The values are compared bit for bit so
+// that 0.0 and -0.0 are told apart and a NaN is equal to itself.
+
+double FGFunction::ExecuteIfChanged(void) const
+{
+  bool changed = !memoValid;
+
+  for (unsigned int i=0; i<Dependencies.size(); i++) {
+    double value = Dependencies[i].getDoubleValue();
+    if (memcmp(&value, &DependencyValues[i], sizeof(double)) != 0) {
+      DependencyValues[i] = value;
+      changed = true;
+    }
+  }
+
+  if (changed) {
+    memoValue = Execute();
+    memoValid = true;
+  }
+
+  return memoValue;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+inline double FGFunction::ReadProperty(const Instruction& ins,
+                                       const FGPropertySlot* slots)
+{
+  return ins.B ? slots[ins.B-1].getDoubleValue() : ins.Node->getDoubleValue();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The operations must be computed exactly as in Interpret() so that both
+// return the same value to the last bit.
+
+double FGFunction::Execute(void) const
+{
+  const Instruction* code = &Compiled.Code[0];
+  const unsigned int* jumpTable = Compiled.JumpTable.empty() ? 0L
+                                                             : &Compiled.JumpTable[0];
+  double* R = &Compiled.Registers[0];
+  const FGPropertySlot* slots = Compiled.Slots.empty() ? 0L
+                                                       : &Compiled.Slots[0];
+  unsigned int size = Compiled.Code.size();
+  unsigned int pc = 0;
+  double scratch;
+
+  while (pc < size) {
+    const Instruction& ins = code[pc++];
+    double& a = R[ins.A];
+
+    switch (ins.Op) {
+    case opConstant:
+      a = ins.Value;
+      break;
+    case opProperty:
+      a = ReadProperty(ins, slots);
+      break;
+    case opNegProperty:
+      a = ReadProperty(ins, slots)*-1.0;
+      break;
+    case opTable:
+      a = ins.Table->FGTable::GetValue();
+      break;
+    case opCall:
+      a = ins.Parameter->GetValue();
+      break;
+    case opAdd:
+      a += R[ins.B];
+      break;
+    case opAddConstant:
+      a += ins.Value;
+      break;
+    case opAddProperty:
+      a += ReadProperty(ins, slots);
+      break;
+    case opAddTable:
+      a += ins.Table->FGTable::GetValue();
+      break;
+    case opSubtract:
+      a -= R[ins.B];
+      break;
+    case opSubtractConstant:
+      a -= ins.Value;
+      break;
+    case opSubtractProperty:
+      a -= ReadProperty(ins, slots);
+      break;
+    case opSubtractTable:
+      a -= ins.Table->FGTable::GetValue();
+      break;
+    case opMultiply:
+      a *= R[ins.B];
+      break;
+    case opMultiplyConstant:
+      a *= ins.Value;
+      break;
+    case opMultiplyProperty:
+      a *= ReadProperty(ins, slots);
+      break;
+    case opMultiplyTable:
+      a *= ins.Table->FGTable::GetValue();
+      break;
+    case opDivide:
+      if (R[ins.B] != 0.0)
+        a /= R[ins.B];
+      else
+        a = HUGE_VAL;
+      break;
+    case opDivideBy:
+      a /= ins.Value;
+      break;
+    case opPow:
+      a = pow(a, R[ins.B]);
+      break;
+    case opATan2:
+      a = atan2(a, R[ins.B]);
+      break;
+    case opMod:
+      a = ((int)a) % ((int)R[ins.B]);
+      break;
+    case opMin:
+      if (R[ins.B] < a) a = R[ins.B];
+      break;
+    case opMax:
+      if (R[ins.B] > a) a = R[ins.B];
+      break;
+    case opSqrt:
+      a = sqrt(a);
+      break;
+    case opToRadians:
+      a *= M_PI/180.0;
+      break;
+    case opToDegrees:
+      a *= 180.0/M_PI;
+      break;
+    case opExp:
+      a = exp(a);
+      break;
+    case opLog2:
+      if (a > 0.00) a = log10(a)*invlog2val;
+      else a = -HUGE_VAL;
+      break;
+    case opLn:
+      if (a > 0.00) a = log(a);
+      else a = -HUGE_VAL;
+      break;
+    case opLog10:
+      if (a > 0.00) a = log10(a);
+      else a = -HUGE_VAL;
+      break;
+    case opAbs:
+      a = fabs(a);
+      break;
+    case opSign:
+      a = a < 0 ? -1:1; // 0.0 counts as positive.
+      break;
+    case opSin:
+      a = sin(a);
+      break;
+    case opCos:
+      a = cos(a);
+      break;
+    case opTan:
+      a = tan(a);
+      break;
+    case opASin:
+      a = asin(a);
+      break;
+    case opACos:
+      a = acos(a);
+      break;
+    case opATan:
+      a = atan(a);
+      break;
+    case opFrac:
+      a = modf(a, &scratch);
+      break;
+    case opInteger:
+      modf(a, &scratch);
+      a = scratch;
+      break;
+    case opRandom:
+      a = ins.Random->GetNormal();
+      break;
+    case opUrandom:
+      a = ins.Random->GetUniformSigned();
+      break;
+    case opLT:
+      a = (a < R[ins.B])?1:0;
+      break;
+    case opLE:
+      a = (a <= R[ins.B])?1:0;
+      break;
+    case opGT:
+      a = (a > R[ins.B])?1:0;
+      break;
+    case opGE:
+      a = (a >= R[ins.B])?1:0;
+      break;
+    case opEQ:
+      a = (a == R[ins.B])?1:0;
+      break;
+    case opNE:
+      a = (a != R[ins.B])?1:0;
+      break;
+    case opBinary:
+      a = GetBinary(a);
+      break;
+    case opNot:
+      a = (GetBinary(a) != 0) ? 0 : 1;
+      break;
+    case opJump:
+      pc = ins.Target;
+      break;
+    case opJumpIfZero:
+      if (a == 0.0) pc = ins.Target;
+      break;
+    case opJumpIfNotZero:
+      if (a != 0.0) pc = ins.Target;
+      break;
+    case opSwitch:
+      {
+        unsigned int i = int(a+0.5);
+        if (i < ins.B) {
+          pc = jumpTable[ins.Target+i];
+        } else {
+          throw(string("The switch function index selected a value above the range of supplied values"
+                       " - not enough values were supplied."));
+        }
+      }
+      break;
+    case opInterpolate1D:
+      {
+        // The argument and the breakpoints are stored in consecutive registers
+        const double* p = &a;
+        unsigned int sz = ins.B;
+        double temp = p[0];
+        if (temp <= p[1]) {
+          a = p[2];
+        } else if (temp >= p[sz-2]) {
+          a = p[sz-1];
+        } else {
+          for (unsigned int i=1; i+3<sz; i+=2) {
+            if (temp < p[i+2]) {
+              double factor = (temp - p[i]) / (p[i+2] - p[i]);
+              double span = p[i+3] - p[i+1];
+              double val = factor*span;
+              a = p[i+1] + val;
+              break;
+            }
+          }
+        }
+      }
+      break;
+    }
+  }
+
+  return R[0];
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFunction::GetValues(size_t n, const vector<FGPropertyNode*>& inputs,
+                           const vector<const double*>& columns,
+                           double* values) const
+{
+  if (inputs.size() != columns.size())
+    throw(string("The number of inputs and of columns of a function evaluation"
+                 " do not match"));
+
+  if (Compilation == eNotCompiled) Compile();
+
+  if (Compilation == eCompiled && IsVectorizable()) {
+    ExecuteBlocks(n, inputs, columns, values);
+    return;
+  }
+
+  // Evaluates the points one by one through the property tree.
+  vector<double> saved(inputs.size());
+  double savedCopy = pCopyTo ? pCopyTo->getDoubleValue() : 0.0;
+  size_t i;
+  unsigned int j;
+
+  for (j=0; j<inputs.size(); j++) saved[j] = inputs[j]->getDoubleValue();
+
+  try {
+    for (i=0; i<n; i++) {
+      for (j=0; j<inputs.size(); j++) inputs[j]->setDoubleValue(columns[j][i]);
+      values[i] = Compilation == eCompiled ? Execute() : Interpret();
+    }
+  }
+  catch (...) {
+    for (j=0; j<inputs.size(); j++) inputs[j]->setDoubleValue(saved[j]);
+    if (pCopyTo) pCopyTo->setDoubleValue(savedCopy);
+    throw;
+  }
+
+  for (j=0; j<inputs.size(); j++) inputs[j]->setDoubleValue(saved[j]);
+  if (pCopyTo) pCopyTo->setDoubleValue(savedCopy);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Checks that the compiled program can be executed by ExecuteBlocks(): all the
+// points of a block must follow the same path through the program and the
+// operations must not depend on the order in which the points are evaluated.
+
+bool FGFunction::IsVectorizable(void) const
+{
+  for (unsigned int pc=0; pc<Compiled.Code.size(); pc++) {
+    switch (Compiled.Code[pc].Op) {
+    case opCall:
+    case opRandom:
+    case opUrandom:
+    case opJump:
+    case opJumpIfZero:
+    case opJumpIfNotZero:
+    case opSwitch:
+      return false;
+    default:
+      break;
+    }
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Executes the compiled program over blocks of points: each register holds the
+// values of the BlockSize points of a block and each instruction is applied to
+// the whole block before the next one is executed. The operations must be
+// computed exactly as in Execute() so that both return the same value to the
+// last bit.
+
+void FGFunction::ExecuteBlocks(size_t n, const vector<FGPropertyNode*>& inputs,
+                               const vector<const double*>& columns,
+                               double* values) const
+{
+  const vector<Instruction>& code = Compiled.Code;
+  unsigned int size = code.size();
+  vector<const double*> sources(size, (const double*)0L);
+  vector<double> constants(size, 0.0);
+  vector<const double*> blockColumns(columns.size());
+  vector<double> registers(Compiled.Registers.size()*BlockSize);
+  double* R = &registers[0];
+  double operand[BlockSize];
+  unsigned int pc, j, k;
+  double scratch;
+
+  // The properties are either read from a column or constant for all the
+  // points.
+  for (pc=0; pc<size; pc++) {
+    const Instruction& ins = code[pc];
+    switch (ins.Op) {
+    case opProperty:
+    case opNegProperty:
+    case opAddProperty:
+    case opSubtractProperty:
+    case opMultiplyProperty:
+      for (j=0; j<inputs.size(); j++) {
+        if (ins.Node == inputs[j]) {
+          sources[pc] = columns[j];
+          break;
+        }
+      }
+      if (!sources[pc]) constants[pc] = ins.Node->getDoubleValue();
+      break;
+    default:
+      break;
+    }
+  }
+
+  for (size_t start=0; start<n; start+=BlockSize) {
+    unsigned int m = min<size_t>(BlockSize, n-start);
+
+    for (j=0; j<columns.size(); j++) blockColumns[j] = columns[j]+start;
+
+    for (pc=0; pc<size; pc++) {
+      const Instruction& ins = code[pc];
+      double* a = R + ins.A*BlockSize;
+      const double* b = R + ins.B*BlockSize;
+      const double* x = operand; // Property or table operand
+
+      switch (ins.Op) {
+      case opProperty:
+      case opNegProperty:
+      case opAddProperty:
+      case opSubtractProperty:
+      case opMultiplyProperty:
+        if (sources[pc])
+          x = sources[pc]+start;
+        else
+          for (k=0; k<m; k++) operand[k] = constants[pc];
+        break;
+      case opTable:
+      case opAddTable:
+      case opSubtractTable:
+      case opMultiplyTable:
+        ins.Table->FGTable::GetValues(m, inputs, blockColumns, operand);
+        break;
+      default:
+        break;
+      }
+
+      switch (ins.Op) {
+      case opConstant:
+        for (k=0; k<m; k++) a[k] = ins.Value;
+        break;
+      case opProperty:
+      case opTable:
+        for (k=0; k<m; k++) a[k] = x[k];
+        break;
+      case opNegProperty:
+        for (k=0; k<m; k++) a[k] = x[k]*-1.0;
+        break;
+      case opAdd:
+        for (k=0; k<m; k++) a[k] += b[k];
+        break;
+      case opAddConstant:
+        for (k=0; k<m; k++) a[k] += ins.Value;
+        break;
+      case opAddProperty:
+      case opAddTable:
+        for (k=0; k<m; k++) a[k] += x[k];
+        break;
+      case opSubtract:
+        for (k=0; k<m; k++) a[k] -= b[k];
+        break;
+      case opSubtractConstant:
+        for (k=0; k<m; k++) a[k] -= ins.Value;
+        break;
+      case opSubtractProperty:
+      case opSubtractTable:
+        for (k=0; k<m; k++) a[k] -= x[k];
+        break;
+      case opMultiply:
+        for (k=0; k<m; k++) a[k] *= b[k];
+        break;
+      case opMultiplyConstant:
+        for (k=0; k<m; k++) a[k] *= ins.Value;
+        break;
+      case opMultiplyProperty:
+      case opMultiplyTable:
+        for (k=0; k<m; k++) a[k] *= x[k];
+        break;
+      case opDivide:
+        for (k=0; k<m; k++) a[k] = b[k] != 0.0 ? a[k] / b[k] : HUGE_VAL;
+        break;
+      case opDivideBy:
+        for (k=0; k<m; k++) a[k] /= ins.Value;
+        break;
+      case opPow:
+        for (k=0; k<m; k++) a[k] = pow(a[k], b[k]);
+        break;
+      case opATan2:
+        for (k=0; k<m; k++) a[k] = atan2(a[k], b[k]);
+        break;
+      case opMod:
+        for (k=0; k<m; k++) a[k] = ((int)a[k]) % ((int)b[k]);
+        break;
+      case opMin:
+        for (k=0; k<m; k++) a[k] = b[k] < a[k] ? b[k] : a[k];
+        break;
+      case opMax:
+        for (k=0; k<m; k++) a[k] = b[k] > a[k] ? b[k] : a[k];
+        break;
+      case opSqrt:
+        for (k=0; k<m; k++) a[k] = sqrt(a[k]);
+        break;
+      case opToRadians:
+        for (k=0; k<m; k++) a[k] *= M_PI/180.0;
+        break;
+      case opToDegrees:
+        for (k=0; k<m; k++) a[k] *= 180.0/M_PI;
+        break;
+      case opExp:
+        for (k=0; k<m; k++) a[k] = exp(a[k]);
+        break;
+      case opLog2:
+        for (k=0; k<m; k++) a[k] = a[k] > 0.00 ? log10(a[k])*invlog2val : -HUGE_VAL;
+        break;
+      case opLn:
+        for (k=0; k<m; k++) a[k] = a[k] > 0.00 ? log(a[k]) : -HUGE_VAL;
+        break;
+      case opLog10:
+        for (k=0; k<m; k++) a[k] = a[k] > 0.00 ? log10(a[k]) : -HUGE_VAL;
+        break;
+      case opAbs:
+        for (k=0; k<m; k++) a[k] = fabs(a[k]);
+        break;
+      case opSign:
+        for (k=0; k<m; k++) a[k] = a[k] < 0 ? -1:1; // 0.0 counts as positive.
+        break;
+      case opSin:
+        for (k=0; k<m; k++) a[k] = sin(a[k]);
+        break;
+      case opCos:
+        for (k=0; k<m; k++) a[k] = cos(a[k]);
+        break;
+      case opTan:
+        for (k=0; k<m; k++) a[k] = tan(a[k]);
+        break;
+      case opASin:
+        for (k=0; k<m; k++) a[k] = asin(a[k]);
+        break;
+      case opACos:
+        for (k=0; k<m; k++) a[k] = acos(a[k]);
+        break;
+      case opATan:
+        for (k=0; k<m; k++) a[k] = atan(a[k]);
+        break;
+      case opFrac:
+        for (k=0; k<m; k++) a[k] = modf(a[k], &scratch);
+        break;
+      case opInteger:
+        for (k=0; k<m; k++) {
+          modf(a[k], &scratch);
+          a[k] = scratch;
+        }
+        break;
+      case opLT:
+        for (k=0; k<m; k++) a[k] = (a[k] < b[k])?1:0;
+        break;
+      case opLE:
+        for (k=0; k<m; k++) a[k] = (a[k] <= b[k])?1:0;
+        break;
+      case opGT:
+        for (k=0; k<m; k++) a[k] = (a[k] > b[k])?1:0;
+        break;
+      case opGE:
+        for (k=0; k<m; k++) a[k] = (a[k] >= b[k])?1:0;
+        break;
+      case opEQ:
+        for (k=0; k<m; k++) a[k] = (a[k] == b[k])?1:0;
+        break;
+      case opNE:
+        for (k=0; k<m; k++) a[k] = (a[k] != b[k])?1:0;
+        break;
+      case opBinary:
+        for (k=0; k<m; k++) a[k] = GetBinary(a[k]);
+        break;
+      case opNot:
+        for (k=0; k<m; k++) a[k] = (GetBinary(a[k]) != 0) ? 0 : 1;
+        break;
+      case opInterpolate1D:
+        // The argument and the breakpoints are stored in consecutive
+        // registers.
+        for (k=0; k<m; k++) {
+          const double* p = a+k;
+          unsigned int sz = ins.B;
+          double temp = p[0];
+          if (temp <= p[BlockSize]) {
+            a[k] = p[2*BlockSize];
+          } else if (temp >= p[(sz-2)*BlockSize]) {
+            a[k] = p[(sz-1)*BlockSize];
+          } else {
+            for (unsigned int i=1; i+3<sz; i+=2) {
+              if (temp < p[(i+2)*BlockSize]) {
+                double factor = (temp - p[i*BlockSize])
+                              / (p[(i+2)*BlockSize] - p[i*BlockSize]);
+                double span = p[(i+3)*BlockSize] - p[(i+1)*BlockSize];
+                double val = factor*span;
+                a[k] = p[(i+1)*BlockSize] + val;
+                break;
+              }
+            }
+          }
+        }
+        break;
+      default:
+        // The other operations are rejected by IsVectorizable().
+        break;
+      }
+    }
+
+    for (k=0; k<m; k++) values[start+k] = R[k];
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 string FGFunction::GetValueAsString(void) const
 {
   ostringstream buffer;
@@ -34,10 +34,12 @@ SENTRY
 INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+#include <atomic>
 #include <vector>
 #include <string>
 #include "FGParameter.h"
 #include "input_output/FGPropertyManager.h"
+#include "FGRandom.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
@@ -53,6 +55,9 @@ namespace JSBSim {
 
 class Element;
 class FGPropertyValue;
+class FGFDMExec;
+class FGStateArchive;
+class FGTable;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -688,6 +693,29 @@ of the three words refers to one or more instances of a property, value, or tabl
        <v> 0.90 </v>  <v> 0.60 </v>
      </interpolate1d>
      @endcode
+
+<h3>Compilation</h3>
+
+Once the model is loaded, the tree of operations of each function is compiled
+into a linear program executed over an array of registers: the properties are read
+directly from their node, the tables are looked up without any virtual call and
+the conditional operations are translated into jumps. The program returns
+exactly the same value as the tree would. The operations that are not
+compiled (the rotations, the operations that have too few arguments, the
+arguments evaluated several times by the tree that might not return the same
+value twice, etc.) are still evaluated by walking the tree. The functions
+that are defined in a template function are never compiled since the property
+they refer to changes at each call.
+
+The compiled program also lists the properties read by the function, either
+directly or through its tables. Their values are recorded each time the
+function is evaluated and as long as none of them changes, the function returns
+its previous value without executing its program. Gear positions, flap settings
+or mass properties are constant during most of a flight so the functions that
+only depend on them are not recomputed at each frame. The functions that call
+random numbers or that refer to properties which were not defined when they
+were compiled are always executed.
+
 @author Jon Berndt
 */
 
@@ -702,7 +730,9 @@ class FGFunction : public FGParameter, public FGJSBBase
 public:
   /// Default constructor.
   FGFunction()
-    : cached(false), cachedValue(-HUGE_VAL), pCopyTo(0L) {}
+    : cached(false), cachedValue(-HUGE_VAL), pCopyTo(0L),
+      Compilation(eNotCompiled), FDMExec(0L), memoized(false),
+      memoValid(false), memoValue(0.0) {}
 
   /** Constructor.
     When this constructor is called, the XML element pointed to in memory by the
@@ -715,19 +745,39 @@ public:
     so on. At runtime, each object evaluates its child parameters, which each
     may have its own child parameters to evaluate.
 
-    @param PropertyManager a pointer to the property manager instance.
+    @param fdmex a pointer to the FDM executive instance.
     @param element a pointer to the Element object containing the function
                    definition.
     @param prefix an optional prefix to prepend to the name given to the
                   property that represents this function (if given).
 */
-  FGFunction(FGPropertyManager* PropertyManager, Element* element,
+  FGFunction(FGFDMExec* fdmex, Element* element,
              const std::string& prefix="", FGPropertyValue* var=0L);
 
+  /// Destructor.
+  ~FGFunction(void);
+
 /** Retrieves the value of the function object.
     @return the total value of the function. */
   double GetValue(void) const;
 
+/** Evaluates the function at n points. At the point i, the property inputs[j]
+    takes the value columns[j][i]; the other properties keep their current
+    value for all the points. values[i] receives the value that GetValue()
+    would return at the point i, ignoring the cached value.
+    A function made of arithmetic operations, properties and tables is
+    evaluated by blocks of points, each operation being applied to the whole
+    block. The other functions (conditions, random numbers, ...) are evaluated
+    point by point after writing the inputs to the properties, which must
+    therefore be writable; their former values are restored afterwards.
+    @param n the number of points
+    @param inputs the properties which values are read from the columns
+    @param columns the arrays of n values of each input
+    @param values the array where the n results are stored */
+  void GetValues(size_t n, const std::vector<FGPropertyNode*>& inputs,
+                 const std::vector<const double*>& columns,
+                 double* values) const;
+
 /** The value that the function evaluates to, as a string.
   @return the value of the function as a string. */
   std::string GetValueAsString(void) const;
@@ -743,9 +793,38 @@ public:
     @param shouldCache specifies whether the function should cache the computed value. */
   void cacheValue(bool shouldCache);
 
+  /** Saves or restores the cached value of the function.
+      @param ar the archive from/to which the state is read/written. */
+  void SerializeState(FGStateArchive& ar);
+
+  /** Compiles the function into a program. The top level functions are
+      compiled by FGFDMExec once the model is loaded and before the initial
+      conditions are run. The other functions are compiled the first time they
+      are evaluated. Calling this method on a function which has already been
+      compiled (or which can only be interpreted) has no effect. */
+  void Compile(void) const;
+
+  /** Returns true once the function has been compiled, including when its
+      operations could not be compiled and are interpreted instead. */
+  bool IsCompiled(void) const { return Compilation != eNotCompiled; }
+
+  /** Enables or disables the compilation of the functions. This only affects
+      the functions that have not yet been compiled and is meant to compare
+      the compiled programs with the evaluation of the trees. The flag is
+      read by all the FDM instances: it should be set before the models are
+      loaded.
+      @param enable true (the default) if the functions should be compiled. */
+  static void SetCompilation(bool enable) { compilation_enabled = enable; }
+
+  /** Enables or disables the reuse of the value of the compiled functions
+      which properties are unchanged since their previous evaluation. Like
+      SetCompilation(), this only affects the functions that have not yet been
+      compiled.
+      @param enable true (the default) if the values should be reused. */
+  static void SetMemoization(bool enable) { memoization_enabled = enable; }
+
 protected:
-  void Load(FGPropertyManager* PropertyManager, Element* element,
-            FGPropertyValue* var);
+  void Load(FGFDMExec* fdmex, Element* element, FGPropertyValue* var);
   virtual void bind(Element*, FGPropertyManager*);
 
 private:
@@ -819,7 +898,81 @@ private:
   std::string Name;
   std::vector <FGParameter_ptr> Parameters;
   FGPropertyNode_ptr pCopyTo; // Property node for CopyTo property string
-
+  FGRandom_ptr RandomStream; // Random numbers of the random/urandom operations
+
+  // opAdd, opSubtract and opMultiply must be followed by their variants with a
+  // constant, a property and a table as the second operand, in that order.
+  enum OpCode {opConstant, opProperty, opNegProperty, opTable, opCall, opAdd,
+               opAddConstant, opAddProperty, opAddTable, opSubtract,
+               opSubtractConstant, opSubtractProperty, opSubtractTable,
+               opMultiply, opMultiplyConstant, opMultiplyProperty,
+               opMultiplyTable, opDivide, opDivideBy, opPow, opATan2,
+               opMod, opMin, opMax, opSqrt, opToRadians, opToDegrees, opExp,
+               opLog2, opLn, opLog10, opAbs, opSign, opSin, opCos, opTan,
+               opASin, opACos, opATan, opFrac, opInteger, opRandom, opUrandom,
+               opLT, opLE, opGT, opGE, opEQ, opNE, opBinary, opNot, opJump,
+               opJumpIfZero, opJumpIfNotZero, opSwitch, opInterpolate1D};
+
+  /** An instruction of a compiled function. The result is stored in the
+      register A. Depending on the operation, B is the register of the second
+      operand or a number of arguments. For the operations on a property, B
+      is 1 + the index of the slot from which it is read directly or 0 if it
+      is read from its node. */
+  struct Instruction {
+    OpCode Op;
+    unsigned int A, B;
+    union {
+      double Value;
+      FGPropertyNode* Node;
+      const FGTable* Table;
+      const FGParameter* Parameter;
+      FGRandom* Random;
+      unsigned int Target; // Index of an instruction or of the jump table
+    };
+  };
+
+  struct Program {
+    std::vector<Instruction> Code;
+    std::vector<unsigned int> JumpTable; // Targets of the switch operations
+    std::vector<double> Registers;
+    std::vector<FGPropertySlot> Slots;
+  };
+
+  enum eCompilation {eNotCompiled, eCompiled, eInterpreted};
+  mutable eCompilation Compilation;
+  mutable Program Compiled;
+  // The executive to which the function is registered until it is compiled.
+  mutable FGFDMExec* FDMExec;
+  static std::atomic<bool> compilation_enabled;
+
+  // The properties read by the compiled program and their values at its last
+  // execution, which returned memoValue.
+  mutable std::vector<FGPropertySlot> Dependencies;
+  mutable std::vector<double> DependencyValues;
+  mutable bool memoized, memoValid;
+  mutable double memoValue;
+  static std::atomic<bool> memoization_enabled;
+
+  void CompileProgram(void) const;
+  bool CompileOperation(Program& program, unsigned int reg) const;
+  static void CompileParameter(Program& program, const FGParameter* p,
+                               unsigned int reg);
+  static bool CompileOperand(Program& program, OpCode op, const FGParameter* p,
+                             unsigned int reg);
+  static unsigned int Emit(Program& program, OpCode op, unsigned int a,
+                           unsigned int b=0);
+  static unsigned int AddSlot(Program& program, FGPropertyNode* node);
+  static bool IsPure(const FGParameter* p);
+  void FindDependencies(void) const;
+  static double ReadProperty(const Instruction& ins,
+                             const FGPropertySlot* slots);
+  double Execute(void) const;
+  double ExecuteIfChanged(void) const;
+  bool IsVectorizable(void) const;
+  void ExecuteBlocks(size_t n, const std::vector<FGPropertyNode*>& inputs,
+                     const std::vector<const double*>& columns,
+                     double* values) const;
+  double Interpret(void) const;
   unsigned int GetBinary(double) const;
   void Debug(int from);
 };
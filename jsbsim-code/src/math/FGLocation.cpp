@@ -50,15 +50,12 @@ namespace JSBSim {
 IDENT(IdSrc,"$Id: FGLocation.cpp,v 1.34 2015/09/20 20:53:13 bcoconni Exp $");
 IDENT(IdHdr,ID_LOCATION);
 
-// Set up the default ground callback object.
-FGGroundCallback_ptr FGLocation::GroundCallback = NULL;
-
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 FGLocation::FGLocation(void)
-  : mECLoc(1.0, 0.0, 0.0), mCacheValid(false)
+  : mECLoc(1.0, 0.0, 0.0), mCacheValid(false), GroundCallback(0)
 {
   e2 = c = 0.0;
   a = ec = ec2 = 1.0;
@@ -78,7 +75,7 @@ FGLocation::FGLocation(void)
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 FGLocation::FGLocation(double lon, double lat, double radius)
-  : mCacheValid(false)
+  : mCacheValid(false), GroundCallback(0)
 {
   e2 = c = 0.0;
   a = ec = ec2 = 1.0;
@@ -106,7 +103,7 @@ FGLocation::FGLocation(double lon, double lat, double radius)
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 FGLocation::FGLocation(const FGColumnVector3& lv)
-  : mECLoc(lv), mCacheValid(false)
+  : mECLoc(lv), mCacheValid(false), GroundCallback(0)
 {
   e2 = c = 0.0;
   a = ec = ec2 = 1.0;
@@ -126,7 +123,8 @@ FGLocation::FGLocation(const FGColumnVector3& lv)
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 FGLocation::FGLocation(const FGLocation& l)
-  : mECLoc(l.mECLoc), mCacheValid(l.mCacheValid)
+  : mECLoc(l.mECLoc), mCacheValid(l.mCacheValid),
+    GroundCallback(l.GroundCallback)
 {
   a = l.a;
   e2 = l.e2;
@@ -164,6 +162,7 @@ const FGLocation& FGLocation::operator=(const FGLocation& l)
 {
   mECLoc = l.mECLoc;
   mCacheValid = l.mCacheValid;
+  GroundCallback = l.GroundCallback;
 
   a = l.a;
   e2 = l.e2;
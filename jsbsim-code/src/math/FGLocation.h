@@ -327,7 +327,9 @@ public:
       the sea or the ground. The sea and the ground levels are obtained by
       interrogating an FGGroundCallback instance. A ground callback must
       therefore be set with SetGroundCallback() before calling any of these
-      functions. */
+      functions. The ground callback is attached to each location rather than
+      shared by all of them so that several FGFDMExec instances, each with its
+      own terrain, can coexist in the same process. */
   ///@{
   /** Set the altitude above sea level.
       @param altitudeASL altitude above Sea Level in feet.
@@ -381,27 +383,23 @@ public:
   ///@}
 
   /** Sets the ground callback pointer. The FGGroundCallback instance will be
-      interrogated by FGLocation each time some terrain informations are needed.
-      This will mainly occur when altitudes above the sea level or above the
-      ground level are needed. A 'smart pointer' is used internally to prevent
-      the FGGroundCallback instance against accidental deletion. This can only
-      work if the calling application also make use of FGGroundCallback_ptr
-      'smart pointers' to manage their copy of the ground callback.
+      interrogated by this location each time some terrain informations are
+      needed. This will mainly occur when altitudes above the sea level or above
+      the ground level are needed. The location does not own the ground
+      callback: its lifetime is managed by the FGFDMExec instance which the
+      location belongs to. The ground callback is copied along with the
+      location and is inherited by the locations computed by LocalToLocation().
       @param gc A pointer to a ground callback object
       @see FGGroundCallback
+      @see FGFDMExec::SetGroundCallback
    */
-  static void SetGroundCallback(FGGroundCallback* gc) { GroundCallback = gc; }
-
-  /** Get a pointer to the ground callback currently used. Since the
-      FGGroundcallback instance might have been created outside JSBSim, it is
-      recommanded to store the returned pointer in a 'smart pointer'
-      FGGroundCallback_ptr. This pointer maintains a reference counter and
-      protects the returned pointer against an accidental deletion of the object
-      it is pointing to.
-      @return A pointer to the current ground callback object.
+  void SetGroundCallback(FGGroundCallback* gc) { GroundCallback = gc; }
+
+  /** Get a pointer to the ground callback used by this location.
+      @return A pointer to the ground callback object.
       @see FGGroundCallback
    */
-  static FGGroundCallback* GetGroundCallback(void) { return GroundCallback; }
+  FGGroundCallback* GetGroundCallback(void) const { return GroundCallback; }
 
   /** Transform matrix from local horizontal to earth centered frame.
       @return a const reference to the rotation matrix of the transform from
@@ -465,7 +463,10 @@ public:
       @param lvec Vector in the local horizontal coordinate frame
       @return The location in the earth centered and fixed frame */
   FGLocation LocalToLocation(const FGColumnVector3& lvec) const {
-    ComputeDerived(); return mTl2ec*lvec + mECLoc;
+    ComputeDerived();
+    FGLocation l(mTl2ec*lvec + mECLoc);
+    l.GroundCallback = GroundCallback;
+    return l;
   }
 
   /** Conversion from a location in the earth centered and fixed frame
@@ -671,7 +672,7 @@ private:
   mutable bool mCacheValid;
 
   /** The ground callback object pointer */
-  static FGGroundCallback_ptr GroundCallback;
+  FGGroundCallback* GroundCallback;
 };
 
 /** Scalar multiplication.
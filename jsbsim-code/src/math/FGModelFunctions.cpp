@@ -38,12 +38,14 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include <iostream>
-#include <sstream>
 #include <string>
 
 #include "FGModelFunctions.h"
 #include "FGFunction.h"
 #include "input_output/FGXMLElement.h"
+#include "FGFDMExec.h"
+#include "input_output/FGStateArchive.h"
+#include "input_output/FGTextBuffer.h"
 
 using namespace std;
 
@@ -75,17 +77,17 @@ bool FGModelFunctions::InitModel(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-bool FGModelFunctions::Load(Element* el, FGPropertyManager* PM, string prefix)
+bool FGModelFunctions::Load(Element* el, FGFDMExec* fdmex, string prefix)
 {
-  LocalProperties.Load(el, PM, false);
-  PreLoad(el, PM, prefix);
+  LocalProperties.Load(el, fdmex->GetPropertyManager(), false);
+  PreLoad(el, fdmex, prefix);
 
   return true; // TODO: Need to make this value mean something.
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-void FGModelFunctions::PreLoad(Element* el, FGPropertyManager* PM, string prefix)
+void FGModelFunctions::PreLoad(Element* el, FGFDMExec* fdmex, string prefix)
 {
   // Load model post-functions, if any
 
@@ -94,7 +96,7 @@ void FGModelFunctions::PreLoad(Element* el, FGPropertyManager* PM, string prefix
   while (function) {
     string fType = function->GetAttributeValue("type");
     if (fType.empty() || fType == "pre")
-      PreFunctions.push_back(new FGFunction(PM, function, prefix));
+      PreFunctions.push_back(new FGFunction(fdmex, function, prefix));
 
     function = el->FindNextElement("function");
   }
@@ -102,14 +104,14 @@ void FGModelFunctions::PreLoad(Element* el, FGPropertyManager* PM, string prefix
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-void FGModelFunctions::PostLoad(Element* el, FGPropertyManager* PM, string prefix)
+void FGModelFunctions::PostLoad(Element* el, FGFDMExec* fdmex, string prefix)
 {
   // Load model post-functions, if any
 
   Element *function = el->FindElement("function");
   while (function) {
     if (function->GetAttributeValue("type") == "post") {
-      PostFunctions.push_back(new FGFunction(PM, function, prefix));
+      PostFunctions.push_back(new FGFunction(fdmex, function, prefix));
     }
     function = el->FindNextElement("function");
   }
@@ -161,6 +163,17 @@ FGFunction* FGModelFunctions::GetPreFunction(const std::string& name)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGModelFunctions::SerializeState(FGStateArchive& ar)
+{
+  for (unsigned int i=0; i<PreFunctions.size(); i++)
+    PreFunctions[i]->SerializeState(ar);
+
+  for (unsigned int i=0; i<PostFunctions.size(); i++)
+    PostFunctions[i]->SerializeState(ar);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 string FGModelFunctions::GetFunctionStrings(const string& delimeter) const
 {
   string FunctionStrings = "";
@@ -192,19 +205,19 @@ string FGModelFunctions::GetFunctionStrings(const string& delimeter) const
 
 string FGModelFunctions::GetFunctionValues(const string& delimeter) const
 {
-  ostringstream buf;
+  FGTextBuffer buf;
 
   for (unsigned int sd = 0; sd < PreFunctions.size(); sd++) {
-    if (buf.tellp() > 0) buf << delimeter;
+    if (!buf.Empty()) buf << delimeter;
     buf << PreFunctions[sd]->GetValue();
   }
 
   for (unsigned int sd = 0; sd < PostFunctions.size(); sd++) {
-    if (buf.tellp() > 0) buf << delimeter;
+    if (!buf.Empty()) buf << delimeter;
     buf << PostFunctions[sd]->GetValue();
   }
 
-  return buf.str();
+  return buf.GetString();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
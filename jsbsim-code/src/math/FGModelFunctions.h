@@ -55,7 +55,8 @@ namespace JSBSim {
 
 class FGFunction;
 class Element;
-class FGPropertyManager;
+class FGFDMExec;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -84,9 +85,9 @@ public:
   virtual ~FGModelFunctions();
   void RunPreFunctions(void);
   void RunPostFunctions(void);
-  bool Load(Element* el, FGPropertyManager* PropertyManager, std::string prefix="");
-  void PreLoad(Element* el, FGPropertyManager* PropertyManager, std::string prefix="");
-  void PostLoad(Element* el, FGPropertyManager* PropertyManager, std::string prefix="");
+  bool Load(Element* el, FGFDMExec* fdmex, std::string prefix="");
+  void PreLoad(Element* el, FGFDMExec* fdmex, std::string prefix="");
+  void PostLoad(Element* el, FGFDMExec* fdmex, std::string prefix="");
 
   /** Gets the strings for the current set of functions.
       @param delimeter either a tab or comma string depending on output type
@@ -105,6 +106,13 @@ public:
    */
   FGFunction* GetPreFunction(const std::string& name);
 
+  /** Saves or restores the state of the model.
+      The derived classes which hold some state (integrators, filters, values
+      computed during the previous time step, etc.) must override this method
+      and call the method of their parent class.
+      @param ar the archive from/to which the state is read/written. */
+  virtual void SerializeState(FGStateArchive& ar);
+
 protected:
   std::vector <FGFunction*> PreFunctions;
   std::vector <FGFunction*> PostFunctions;
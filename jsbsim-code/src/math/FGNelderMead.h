@@ -22,6 +22,7 @@
 #include <vector>
 #include <limits>
 #include <cstddef>
+#include "FGRandom.h"
 
 namespace JSBSim
 {
@@ -52,7 +53,8 @@ public:
                  double randomization=0.1,
                  bool showConvergeStatus=true,bool showSimplex=false,
                  bool pause=false,
-                 Callback * callback=NULL);
+                 Callback * callback=NULL,
+                 FGRandom * random=NULL);
     std::vector<double> getSolution();
 
     void update();
@@ -62,6 +64,7 @@ private:
     // attributes
     Function * m_f;
     Callback * m_callback;
+    FGRandom_ptr m_random;
     double m_randomization;
     const std::vector<double> & m_lowerBound;
     const std::vector<double> & m_upperBound;
@@ -42,7 +42,7 @@ CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 FGPropertyValue::FGPropertyValue(FGPropertyNode* propNode)
-  : PropertyManager(0L), PropertyNode(propNode)
+  : PropertyManager(0L), PropertyNode(propNode), Slot(propNode)
 {
   Sign = 1;
 }
@@ -58,22 +58,25 @@ FGPropertyValue::FGPropertyValue(std::string propName, FGPropertyManager* proper
     Sign = -1;
   }
   PropertyName = propName;
+  PropertyManager->AddLateBoundValue(this);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGPropertyValue::~FGPropertyValue()
+{
+  if (PropertyManager) PropertyManager->RemoveLateBoundValue(this);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 FGPropertyNode* FGPropertyValue::GetNode(void) const
 {
-  FGPropertyNode* node = PropertyNode;
-
-  if (!PropertyNode) {
-    // The node cannot be cached since this is a const method.
-    node = PropertyManager->GetNode(PropertyName);
-    
-    if (!node) {
-      throw(std::string("FGPropertyValue::GetValue() The property " +
-                        PropertyName + " does not exist."));
-    }
+  FGPropertyNode* node = FindNode();
+
+  if (!node) {
+    throw(std::string("FGPropertyValue::GetValue() The property " +
+                      PropertyName + " does not exist."));
   }
 
   return node;
@@ -81,17 +84,36 @@ FGPropertyNode* FGPropertyValue::GetNode(void) const
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+FGPropertyNode* FGPropertyValue::FindNode(void) const
+{
+  if (!PropertyNode && PropertyManager && PropertyManager->HasNode(PropertyName)) {
+    // The property is now defined: its path no longer needs to be searched.
+    PropertyNode = PropertyManager->GetNode(PropertyName);
+    Slot.SetNode(PropertyNode);
+    PropertyManager->RemoveLateBoundValue(this);
+    PropertyManager = 0L;
+  }
+
+  return PropertyNode;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 double FGPropertyValue::GetValue(void) const
 {
+  if (!PropertyNode) GetNode();
 
-  return GetNode()->getDoubleValue()*Sign;
+  return Slot.getDoubleValue()*Sign;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+// The name of a late bound property is reported as it was given, even once its
+// node has been found.
+
 std::string FGPropertyValue::GetName(void) const
 {
-  if (PropertyNode)
+  if (PropertyNode && PropertyName.empty())
     return PropertyNode->GetName();
   else
     return PropertyName;
@@ -101,7 +123,7 @@ std::string FGPropertyValue::GetName(void) const
 
 std::string FGPropertyValue::GetFullyQualifiedName(void) const
 {
-  if (PropertyNode)
+  if (PropertyNode && PropertyName.empty())
     return PropertyNode->GetFullyQualifiedName();
   else
     return PropertyName;
@@ -111,7 +133,7 @@ std::string FGPropertyValue::GetFullyQualifiedName(void) const
 
 std::string FGPropertyValue::GetPrintableName(void) const
 {
-  if (PropertyNode)
+  if (PropertyNode && PropertyName.empty())
     return PropertyNode->GetPrintableName();
  else
    return PropertyName;
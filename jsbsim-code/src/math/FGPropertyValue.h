@@ -68,9 +68,20 @@ public:
 
   FGPropertyValue(FGPropertyNode* propNode);
   FGPropertyValue(std::string propName, FGPropertyManager* propertyManager);
+  ~FGPropertyValue();
 
   virtual double GetValue(void) const;
-  void SetNode(FGPropertyNode* node) {PropertyNode = node;}
+  void SetNode(FGPropertyNode* node) {PropertyNode = node; Slot.SetNode(node);}
+
+  /** Returns the property node, or 0L if a late bound property is not yet
+      defined. Unlike GetNode(), no exception is thrown. The node of a late
+      bound property is kept once it has been found. */
+  FGPropertyNode* FindNode(void) const;
+  /** Returns the slot from which the value of the property is read. The
+      property must have been found by FindNode(). */
+  const FGPropertySlot* GetSlot(void) const {return &Slot;}
+  /// Returns -1 if the property value is negated, 1 otherwise.
+  int GetSign(void) const {return Sign;}
 
   virtual std::string GetName(void) const;
   virtual std::string GetFullyQualifiedName(void) const;
@@ -80,8 +91,12 @@ protected:
   FGPropertyNode* GetNode(void) const;
 
 private:
-  FGPropertyManager* PropertyManager; // Property root used to do late binding.
-  FGPropertyNode_ptr PropertyNode;
+  friend class FGPropertyManager;
+
+  // Property root used to do late binding. It is reset once the node is found.
+  mutable FGPropertyManager* PropertyManager;
+  mutable FGPropertyNode_ptr PropertyNode;
+  mutable FGPropertySlot Slot;
   std::string PropertyName;
   int Sign;
 };
@@ -0,0 +1,127 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Module: FGRandom.cpp
+Date started: 10/17/2026
+Purpose: Random number streams
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cmath>
+
+#include "FGRandom.h"
+#include "FGJSBBase.h"
+#include "input_output/FGStateArchive.h"
+
+using namespace std;
+
+namespace JSBSim {
+
+IDENT(IdSrc,"$Id$");
+IDENT(IdHdr,ID_RANDOM);
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS IMPLEMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+FGRandom::FGRandom(unsigned int seed, unsigned int stream)
+  : Stream(stream)
+{
+  Seed(seed);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGRandom::Seed(unsigned int seed)
+{
+  // The seed and the stream number are packed in a single 64 bits word which
+  // is expanded to the 256 bits of the xoshiro state by splitmix64.
+  uint64_t x = (uint64_t(seed) << 32) | Stream;
+
+  for (int i=0; i<4; ++i) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    s[i] = z ^ (z >> 31);
+  }
+
+  Spare = 0.0;
+  HasSpare = false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Marsaglia polar method: the numbers are generated by pairs and the second
+// one is kept for the next call.
+
+double FGRandom::GetNormal(void)
+{
+  if (HasSpare) {
+    HasSpare = false;
+    return Spare;
+  }
+
+  double V1, V2, S;
+
+  do {
+    V1 = GetUniformSigned();
+    V2 = GetUniformSigned();
+    S = V1 * V1 + V2 * V2;
+  } while (S >= 1.0 || S == 0.0);
+
+  double factor = sqrt(-2.0 * log(S) / S);
+  Spare = V2 * factor;
+  HasSpare = true;
+
+  return V1 * factor;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The uniform numbers are drawn first so that the Box-Muller loop only
+// contains arithmetic and can be vectorized by the compiler.
+
+void FGRandom::GetNormal(double* v, size_t n)
+{
+  const double two_pi = 2.0 * M_PI;
+  size_t npairs = n / 2;
+
+  for (size_t i=0; i<2*npairs; ++i)
+    v[i] = GetUniform();
+
+  for (size_t i=0; i<npairs; ++i) {
+    // 1-u is in (0, 1] so that its logarithm is always defined.
+    double r = sqrt(-2.0 * log(1.0 - v[2*i]));
+    double theta = two_pi * v[2*i+1];
+    v[2*i] = r * cos(theta);
+    v[2*i+1] = r * sin(theta);
+  }
+
+  if (n % 2) v[n-1] = GetNormal();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGRandom::SerializeState(FGStateArchive& ar)
+{
+  ar.Array(s, 4);
+  ar & Spare & HasSpare;
+}
+
+} // namespace JSBSim
@@ -0,0 +1,142 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Header: FGRandom.h
+Date started: October 17 2026
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+SENTRY
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef FGRANDOM_H
+#define FGRANDOM_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cstddef>
+#include <cstdint>
+#include "simgear/structure/SGSharedPtr.hxx"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DEFINITIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#define ID_RANDOM "$Id$"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FORWARD DECLARATIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+namespace JSBSim {
+
+class FGStateArchive;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+CLASS DOCUMENTATION
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Random number stream.
+    Implements the xoshiro256** generator of Blackman and Vigna. The state of
+    the generator is initialized from a seed and a stream number through the
+    splitmix64 generator so that streams sharing the same seed but with
+    different stream numbers produce independent sequences.
+
+    Each FGFDMExec instance hands one stream to each of its random components
+    (see FGFDMExec::GetRandomStream) so that instances running in different
+    threads do not share any state and the results of a simulation only depend
+    on the value of the property simulation/randomseed.
+
+    The class is not thread safe: a stream must not be shared between threads.
+  */
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+DECLARATION: FGRandom
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+class FGRandom : public SGReferenced
+{
+public:
+  /** Constructor.
+      @param seed the seed of the stream.
+      @param stream the stream number. */
+  explicit FGRandom(unsigned int seed = 0, unsigned int stream = 0);
+
+  /** Restarts the stream from a new seed. The stream number is kept.
+      @param seed the new seed. */
+  void Seed(unsigned int seed);
+
+  /// Returns the stream number.
+  unsigned int GetStream(void) const { return Stream; }
+
+  /// Returns the next 64 bits integer of the sequence.
+  uint64_t GetRaw(void) {
+    const uint64_t result = rotl(s[1] * 5, 7) * 9;
+    const uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+
+    return result;
+  }
+
+  /// Returns a random number uniformly distributed in [0, 1).
+  double GetUniform(void) {
+    return (GetRaw() >> 11) * (1.0 / 9007199254740992.0); // 2^-53
+  }
+
+  /// Returns a random number uniformly distributed in [-1, 1).
+  double GetUniformSigned(void) { return 2.0 * GetUniform() - 1.0; }
+
+  /// Returns a random number with a standard normal distribution.
+  double GetNormal(void);
+
+  /** Fills an array with random numbers having a standard normal
+      distribution. The numbers are generated by pairs with the Box-Muller
+      transform whose loop does not contain any branch, which makes it
+      cheaper than repeated calls to GetNormal(void) for large arrays.
+      @param v the array to fill.
+      @param n the size of the array. */
+  void GetNormal(double* v, size_t n);
+
+  /** Saves or restores the position of the stream in its sequence.
+      @param ar the archive from/to which the state is read/written. */
+  void SerializeState(FGStateArchive& ar);
+
+private:
+  uint64_t s[4];
+  unsigned int Stream;
+  double Spare;
+  bool HasSpare;
+
+  static uint64_t rotl(const uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+};
+
+typedef SGSharedPtr<FGRandom> FGRandom_ptr;
+
+} // namespace JSBSim
+
+#endif
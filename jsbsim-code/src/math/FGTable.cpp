@@ -39,6 +39,10 @@ INCLUDES
 #include "FGTable.h"
 #include "input_output/FGXMLElement.h"
 #include "input_output/FGPropertyManager.h"
+#include "input_output/FGPropertyProfiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <sstream>
 #include <cstdlib>
@@ -50,6 +54,29 @@ namespace JSBSim {
 IDENT(IdSrc,"$Id: FGTable.cpp,v 1.33 2017/03/11 19:31:48 bcoconni Exp $");
 IDENT(IdHdr,ID_TABLE);
 
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+LOCAL FUNCTIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+// Throws an exception if the breakpoints of an axis are not increasing.
+
+static void CheckMonotonic(const double* keys, unsigned int n,
+                           const string& axis, Element* nameel)
+{
+  for (unsigned int i=2; i<=n; ++i) {
+    if (keys[i-1] <= keys[i-2]) {
+      stringstream errormsg;
+      errormsg << FGJSBBase::fgred << FGJSBBase::highint << endl
+               << "  FGTable: " << axis << " lookup is not monotonically increasing" << endl
+               << "  in " << axis << " " << i;
+      if (nameel != 0) errormsg << " of table in " << nameel->GetAttributeValue("name");
+      errormsg << ":" << FGJSBBase::reset << endl
+               << "  " << keys[i-1] << "<=" << keys[i-2] << endl;
+      throw(errormsg.str());
+    }
+  }
+}
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS IMPLEMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -61,7 +88,7 @@ FGTable::FGTable(int NRows) : nRows(NRows), nCols(1), PropertyManager(0)
   rowCounter = 1;
   nTables = 0;
 
-  Data = Allocate();
+  Allocate(nRows + nCols + nRows*nCols);
   Debug(0);
   lastRowIndex=lastColumnIndex=2;
 }
@@ -75,7 +102,7 @@ FGTable::FGTable(int NRows, int NCols) : nRows(NRows), nCols(NCols), PropertyMan
   rowCounter = 0;
   nTables = 0;
 
-  Data = Allocate();
+  Allocate(nRows + nCols + nRows*nCols);
   Debug(0);
   lastRowIndex=lastColumnIndex=2;
 }
@@ -94,17 +121,13 @@ FGTable::FGTable(const FGTable& t) : PropertyManager(t.PropertyManager)
   dimension = t.dimension;
   internal = t.internal;
   Name = t.Name;
-  lookupProperty[0] = t.lookupProperty[0];
-  lookupProperty[1] = t.lookupProperty[1];
-  lookupProperty[2] = t.lookupProperty[2];
-
-  Tables = t.Tables;
-  Data = Allocate();
-  for (unsigned int r=0; r<=nRows; r++) {
-    for (unsigned int c=0; c<=nCols; c++) {
-      Data[r][c] = t.Data[r][c];
-    }
-  }
+  for (unsigned int i=0; i<3; i++)
+    SetLookupProperty((axis)i, t.lookupProperty[i]);
+
+  Layers = t.Layers;
+  Allocate(t.DataSize);
+  copy(t.DataStorage.get(), t.DataStorage.get()+DataSize, DataStorage.get());
+  UpdateSpacings();
   lastRowIndex = t.lastRowIndex;
   lastColumnIndex = t.lastColumnIndex;
   lastTableIndex = t.lastTableIndex;
@@ -118,7 +141,6 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
 {
   unsigned int i;
 
-  stringstream buf;
   string property_string;
   string lookup_axis;
   string call_type;
@@ -172,7 +194,7 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
       internal = false;
     }
 
-    for (i=0; i<3; i++) lookupProperty[i] = 0;
+    for (i=0; i<3; i++) SetLookupProperty((axis)i, 0L);
 
     while (axisElement) {
       property_string = axisElement->GetDataLine();
@@ -191,15 +213,15 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
 
       lookup_axis = axisElement->GetAttributeValue("lookup");
       if (lookup_axis == string("row")) {
-        lookupProperty[eRow] = node;
+        SetLookupProperty(eRow, node);
       } else if (lookup_axis == string("column")) {
-        lookupProperty[eColumn] = node;
+        SetLookupProperty(eColumn, node);
       } else if (lookup_axis == string("table")) {
-        lookupProperty[eTable] = node;
+        SetLookupProperty(eTable, node);
       } else if (!lookup_axis.empty()) {
         throw("Lookup table axis specification not understood: " + lookup_axis);
       } else { // assumed single dimension table; row lookup
-        lookupProperty[eRow] = node;
+        SetLookupProperty(eRow, node);
       }
       dimension++;
       axisElement = el->FindNextElement("independentVar");
@@ -237,9 +259,12 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
     dimension = 2;                             // Currently, infers 2D table
   }
 
-  for (i=0; i<tableData->GetNumDataLines(); i++) {
-    buf << tableData->GetDataLine(i) << string(" ");
-  }
+  // find next xml element containing a name attribute
+  // to indicate where the error occured
+  Element* nameel = el;
+  while (nameel != 0 && nameel->GetAttributeValue("name") == "")
+    nameel=nameel->GetParent();
+
   switch (dimension) {
   case 1:
     nRows = tableData->GetNumDataLines();
@@ -247,10 +272,9 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
     Type = tt1D;
     colCounter = 0;
     rowCounter = 1;
-    Data = Allocate();
+    LoadData(tableData);
     Debug(0);
     lastRowIndex = lastColumnIndex = 2;
-    *this << buf;
     break;
   case 2:
     nRows = tableData->GetNumDataLines()-1;
@@ -265,32 +289,76 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
     Type = tt2D;
     colCounter = 1;
     rowCounter = 0;
-
-    Data = Allocate();
+    LoadData(tableData);
     lastRowIndex = lastColumnIndex = 2;
-    *this << buf;
     break;
   case 3:
-    nTables = el->GetNumElements("tableData");
-    nRows = nTables;
-    nCols = 1;
-    Type = tt3D;
-    colCounter = 1;
-    rowCounter = 1;
-    lastRowIndex = lastColumnIndex = 2;
+    {
+      nTables = el->GetNumElements("tableData");
+      nRows = nTables;
+      nCols = 1;
+      Type = tt3D;
+      colCounter = 1;
+      rowCounter = 1;
+      lastRowIndex = lastColumnIndex = 2;
+
+      // The table breakpoints are followed by the 2D tables (the layers).
+      size_t size = nTables;
+      Layers.resize(nTables);
+      tableData = el->FindElement("tableData");
+      for (i=0; i<nTables; i++) {
+        Layer& layer = Layers[i];
+        layer.nRows = tableData->GetNumDataLines()-1;
+        if (layer.nRows >= 2) {
+          layer.nCols = FindNumColumns(tableData->GetDataLine(0));
+          if (layer.nCols < 2) throw(string("Not enough columns in table data."));
+        } else {
+          throw(string("Not enough rows in the table data."));
+        }
+        layer.lastRowIndex = layer.lastColumnIndex = 2;
+        size += layer.nRows + layer.nCols + layer.nRows*layer.nCols;
+        tableData = el->FindNextElement("tableData");
+      }
 
-    Data = Allocate(); // this data array will contain the keys for the associated tables
-    Tables.reserve(nTables); // necessary?
-    tableData = el->FindElement("tableData");
-    for (i=0; i<nTables; i++) {
-      Tables.push_back(new FGTable(PropertyManager, tableData));
-      Data[i+1][1] = tableData->GetAttributeValueAsNumber("breakPoint");
-      Tables[i]->SetRowIndexProperty(lookupProperty[eRow]);
-      Tables[i]->SetColumnIndexProperty(lookupProperty[eColumn]);
-      tableData = el->FindNextElement("tableData");
-    }
+      // The data read from an element are shared by all the tables that are
+      // loaded from it (by the clones of an FDM for instance).
+      shared_ptr<void> cachedData = el->GetCachedData();
 
-    Debug(0);
+      if (cachedData) {
+        DataStorage = static_pointer_cast<double>(cachedData);
+        DataSize = size;
+        SetLayout(DataStorage.get());
+      } else {
+        Allocate(size);
+        tableData = el->FindElement("tableData");
+        for (i=0; i<nTables; i++) {
+          Layer& layer = Layers[i];
+          stringstream layerbuf;
+          for (unsigned int l=0; l<tableData->GetNumDataLines(); l++)
+            layerbuf << tableData->GetDataLine(l) << string(" ");
+          for (unsigned int c=0; c<layer.nCols; c++)
+            layerbuf >> layer.ColumnKeys[c];
+          for (unsigned int r=0; r<layer.nRows; r++) {
+            layerbuf >> layer.RowKeys[r];
+            for (unsigned int c=0; c<layer.nCols; c++)
+              layerbuf >> layer.Values[r*layer.nCols+c];
+          }
+          RowKeys[i] = tableData->GetAttributeValueAsNumber("breakPoint");
+
+          // Sanity checks: lookup indices must be increasing monotonically
+          CheckMonotonic(layer.ColumnKeys, layer.nCols, "column", nameel);
+          CheckMonotonic(layer.RowKeys, layer.nRows, "row", nameel);
+          tableData = el->FindNextElement("tableData");
+        }
+        el->SetCachedData(DataStorage);
+      }
+
+      if (debug_lvl & 1) {
+        for (i=0; i<nTables; i++) PrintLayer(Layers[i]);
+      }
+
+      Debug(0);
+    }
     break;
   default:
     cout << "No dimension given" << endl;
@@ -298,62 +366,15 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
   }
 
   // Sanity checks: lookup indices must be increasing monotonically
-  unsigned int r,c,b;
-
-  // find next xml element containing a name attribute
-  // to indicate where the error occured
-  Element* nameel = el;
-  while (nameel != 0 && nameel->GetAttributeValue("name") == "")
-    nameel=nameel->GetParent();
-
-  // check breakpoints, if applicable
   if (dimension > 2) {
-    for (b=2; b<=nTables; ++b) {
-      if (Data[b][1] <= Data[b-1][1]) {
-        stringstream errormsg;
-        errormsg << fgred << highint << endl
-             << "  FGTable: breakpoint lookup is not monotonically increasing" << endl
-             << "  in breakpoint " << b;
-        if (nameel != 0) errormsg << " of table in " << nameel->GetAttributeValue("name");
-        errormsg << ":" << reset << endl
-                 << "  " << Data[b][1] << "<=" << Data[b-1][1] << endl;
-        throw(errormsg.str());
-      }
-    }
-  }
-
-  // check columns, if applicable
-  if (dimension > 1) {
-    for (c=2; c<=nCols; ++c) {
-      if (Data[0][c] <= Data[0][c-1]) {
-        stringstream errormsg;
-        errormsg << fgred << highint << endl
-             << "  FGTable: column lookup is not monotonically increasing" << endl
-             << "  in column " << c;
-        if (nameel != 0) errormsg << " of table in " << nameel->GetAttributeValue("name");
-        errormsg << ":" << reset << endl
-                 << "  " << Data[0][c] << "<=" << Data[0][c-1] << endl;
-        throw(errormsg.str());
-      }
-    }
-  }
-
-  // check rows
-  if (dimension < 3) { // in 3D tables, check only rows of subtables
-    for (r=2; r<=nRows; ++r) {
-      if (Data[r][0]<=Data[r-1][0]) {
-        stringstream errormsg;
-        errormsg << fgred << highint << endl
-             << "  FGTable: row lookup is not monotonically increasing" << endl
-             << "  in row " << r;
-        if (nameel != 0) errormsg << " of table in " << nameel->GetAttributeValue("name");
-        errormsg << ":" << reset << endl
-                 << "  " << Data[r][0] << "<=" << Data[r-1][0] << endl;
-        throw(errormsg.str());
-      }
-    }
+    CheckMonotonic(RowKeys, nTables, "breakpoint", nameel);
+  } else if (dimension > 0) {
+    // check columns, if applicable
+    if (dimension > 1) CheckMonotonic(ColumnKeys, nCols, "column", nameel);
+    CheckMonotonic(RowKeys, nRows, "row", nameel);
   }
 
+  UpdateSpacings();
   bind(el);
 
   if (debug_lvl & 1) Print();
@@ -361,29 +382,70 @@ FGTable::FGTable(FGPropertyManager* propMan, Element* el,
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-double** FGTable::Allocate(void)
+void FGTable::Allocate(size_t size)
 {
-  Data = new double*[nRows+1];
-  for (unsigned int r=0; r<=nRows; r++) {
-    Data[r] = new double[nCols+1];
-    for (unsigned int c=0; c<=nCols; c++) {
-      Data[r][c] = 0.0;
+  // Over-allocate the buffer in order to align the data on a cache line.
+  double* buffer = new double[size+7];
+  uintptr_t address = reinterpret_cast<uintptr_t>(buffer);
+  double* data = buffer + ((64 - address % 64) % 64) / sizeof(double);
+  fill(data, data+size, 0.0);
+
+  // The data are released along with the last table that uses them.
+  DataStorage.reset(data, [buffer](double*) { delete[] buffer; });
+  DataSize = size;
+  SetLayout(data);
+  UpdateSpacings();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTable::SetLayout(double* data)
+{
+  RowKeys = data;
+
+  if (Type == tt3D) {
+    ColumnKeys = Values = 0;
+    data += nRows;
+    for (unsigned int i=0; i<Layers.size(); i++) {
+      Layer& layer = Layers[i];
+      layer.RowKeys = data;
+      layer.ColumnKeys = layer.RowKeys + layer.nRows;
+      layer.Values = layer.ColumnKeys + layer.nCols;
+      data = layer.Values + layer.nRows*layer.nCols;
     }
+  } else {
+    ColumnKeys = RowKeys + nRows;
+    Values = ColumnKeys + nCols;
   }
-  return Data;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-FGTable::~FGTable()
+void FGTable::LoadData(Element* tableData)
 {
-  if (nTables > 0) {
-    for (unsigned int i=0; i<nTables; i++) delete Tables[i];
-    Tables.clear();
+  // The data read from an element are shared by all the tables that are
+  // loaded from it (by the clones of an FDM for instance).
+  shared_ptr<void> cachedData = tableData->GetCachedData();
+
+  if (cachedData) {
+    DataStorage = static_pointer_cast<double>(cachedData);
+    DataSize = nRows + nCols + nRows*nCols;
+    SetLayout(DataStorage.get());
+  } else {
+    stringstream buf;
+    for (unsigned int i=0; i<tableData->GetNumDataLines(); i++)
+      buf << tableData->GetDataLine(i) << string(" ");
+
+    Allocate(nRows + nCols + nRows*nCols);
+    *this << buf;
+    tableData->SetCachedData(DataStorage);
   }
-  for (unsigned int r=0; r<=nRows; r++) delete[] Data[r];
-  delete[] Data;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+FGTable::~FGTable()
+{
   Debug(1);
 }
 
@@ -401,25 +463,221 @@ unsigned int FGTable::FindNumColumns(const string& test_line)
   return nCols;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The spacing only speeds up the search of the intervals: the interval found
+// by the arithmetic estimate is always corrected by comparing the key to the
+// breakpoints. The tolerance of 10% of the step accepts the breakpoints that
+// have been rounded (such as angles converted to radians). The breakpoints of
+// short tables are walked one by one which is faster.
+
+FGTable::Spacing FGTable::FindSpacing(const double* keys, unsigned int n)
+{
+  Spacing spacing;
+  spacing.Uniform = false;
+  spacing.InvStep = 0.0;
+
+  if (n < 8) return spacing;
+
+  double step = (keys[n-1] - keys[0]) / (n-1);
+  if (!(step > 0.0)) return spacing;
+
+  for (unsigned int i=1; i<n-1; i++) {
+    if (fabs(keys[i] - (keys[0] + i*step)) > 0.1*step) return spacing;
+  }
+
+  spacing.Uniform = true;
+  spacing.InvStep = 1.0 / step;
+  return spacing;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTable::UpdateSpacings(void)
+{
+  RowSpacing = FindSpacing(RowKeys, nRows);
+
+  if (Type == tt3D) {
+    ColumnSpacing = RowSpacing;
+    for (unsigned int i=0; i<Layers.size(); i++) {
+      Layer& layer = Layers[i];
+      layer.RowSpacing = FindSpacing(layer.RowKeys, layer.nRows);
+      layer.ColumnSpacing = FindSpacing(layer.ColumnKeys, layer.nCols);
+    }
+  } else
+    ColumnSpacing = FindSpacing(ColumnKeys, nCols);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns the index of the first breakpoint that is not lower than the key (n
+// if there is none). The breakpoints must be increasing.
+
+unsigned int FGTable::LowerBound(double key, const double* keys, unsigned int n,
+                                 const Spacing& spacing)
+{
+  if (spacing.Uniform) {
+    // The key is usually between keys[i-1] and keys[i].
+    double x = (key - keys[0]) * spacing.InvStep;
+    unsigned int i = 0;
+    if (x >= n-1) i = n;
+    else if (x >= 0.0) i = (unsigned int)x + 1;
+
+    while (i > 0 && keys[i-1] >= key) i--;
+    while (i < n && keys[i] < key) i++;
+    return i;
+  }
+
+  // Binary search without branches in the loop (compiled to conditional
+  // moves).
+  const double* base = keys;
+  while (n > 1) {
+    unsigned int half = n / 2;
+    base = base[half-1] < key ? base + half : base;
+    n -= half;
+  }
+  return (unsigned int)(base - keys) + (*base < key ? 1 : 0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns the index of the first breakpoint that is greater than the key (n if
+// there is none). The breakpoints must be increasing.
+
+unsigned int FGTable::UpperBound(double key, const double* keys, unsigned int n,
+                                 const Spacing& spacing)
+{
+  if (spacing.Uniform) {
+    // The key is usually between keys[i-1] and keys[i].
+    double x = (key - keys[0]) * spacing.InvStep;
+    unsigned int i = 0;
+    if (x >= n-1) i = n;
+    else if (x >= 0.0) i = (unsigned int)x + 1;
+
+    while (i > 0 && keys[i-1] > key) i--;
+    while (i < n && keys[i] <= key) i++;
+    return i;
+  }
+
+  const double* base = keys;
+  while (n > 1) {
+    unsigned int half = n / 2;
+    base = base[half-1] <= key ? base + half : base;
+    n -= half;
+  }
+  return (unsigned int)(base - keys) + (*base <= key ? 1 : 0);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Searches the interval of a key that is not in the interval r of the previous
+// lookup. The result is the same as walking the breakpoints one by one from the
+// previous interval (which matters when the key is equal to a breakpoint) but
+// when the key has moved by more than a few intervals, the breakpoints are
+// searched arithmetically or by bisection.
+
+unsigned int FGTable::SearchInterval(double key, const double* keys,
+                                     unsigned int n, const Spacing& spacing,
+                                     unsigned int r)
+{
+  const unsigned int nSteps = spacing.Uniform ? 0 : 4;
+
+  // As the walk, a key that is not a number leaves the interval unchanged.
+  if (std::isnan(key)) return r;
+
+  if (r > 2 && keys[r-2] > key) {
+    for (unsigned int i=0; i<nSteps; i++) {
+      r--;
+      if (r == 2 || keys[r-2] <= key) return r;
+    }
+    // The last breakpoint lower than or equal to the key is keys[r-2].
+    r = UpperBound(key, keys, n, spacing) + 1;
+    return r < 2 ? 2 : r;
+  }
+
+  for (unsigned int i=0; i<nSteps; i++) {
+    r++;
+    if (r == n || keys[r-1] >= key) return r;
+  }
+
+  // The first breakpoint greater than or equal to the key is keys[r-1].
+  r = LowerBound(key, keys, n, spacing) + 1;
+  return r > n ? n : r;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Interpolates a 2D table. The rows and the columns are numbered from 1 as in
+// the XML data: the row r has the breakpoint rowKeys[r-1] and its values start
+// at values[(r-1)*nCols].
+
+double FGTable::Interpolate2D(double rowKey, double colKey,
+                              unsigned int nRows, unsigned int nCols,
+                              const double* rowKeys, const double* colKeys,
+                              const double* values, const Spacing& rowSpacing,
+                              const Spacing& colSpacing, int& lastRowIndex,
+                              int& lastColumnIndex)
+{
+  double rFactor, cFactor, col1temp, col2temp, Value;
+  size_t r = FindInterval(rowKey, rowKeys, nRows, rowSpacing, lastRowIndex);
+  size_t c = FindInterval(colKey, colKeys, nCols, colSpacing, lastColumnIndex);
+
+  lastRowIndex=r;
+  lastColumnIndex=c;
+
+  rFactor = (rowKey - rowKeys[r-2]) / (rowKeys[r-1] - rowKeys[r-2]);
+  cFactor = (colKey - colKeys[c-2]) / (colKeys[c-1] - colKeys[c-2]);
+
+  if (rFactor > 1.0) rFactor = 1.0;
+  else if (rFactor < 0.0) rFactor = 0.0;
+
+  if (cFactor > 1.0) cFactor = 1.0;
+  else if (cFactor < 0.0) cFactor = 0.0;
+
+  const double* row0 = values + (r-2)*nCols; // Row r-1
+  const double* row1 = row0 + nCols;         // Row r
+
+  col1temp = rFactor*(row1[c-2] - row0[c-2]) + row0[c-2];
+  col2temp = rFactor*(row1[c-1] - row0[c-1]) + row0[c-1];
+
+  Value = col1temp + cFactor*(col2temp - col1temp);
+
+  return Value;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double FGTable::Interpolate2D(double rowKey, double colKey, const Layer& layer)
+{
+  return Interpolate2D(rowKey, colKey, layer.nRows, layer.nCols, layer.RowKeys,
+                       layer.ColumnKeys, layer.Values, layer.RowSpacing,
+                       layer.ColumnSpacing, layer.lastRowIndex,
+                       layer.lastColumnIndex);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTable::GetInputs(vector<FGPropertyNode*>& nodes) const
+{
+  for (unsigned int i=0; i<=(unsigned int)Type; i++)
+    nodes.push_back(lookupProperty[i]);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 double FGTable::GetValue(void) const
 {
+  FGPropertyProfiler::Scope scope(FGPropertyProfiler::ecTable);
   double temp = 0;
   double temp2 = 0;
 
   switch (Type) {
   case tt1D:
-    temp = lookupProperty[eRow]->getDoubleValue();
+    temp = lookupSlot[eRow].getDoubleValue();
     temp2 = GetValue(temp);
     return temp2;
   case tt2D:
-    return GetValue(lookupProperty[eRow]->getDoubleValue(),
-                    lookupProperty[eColumn]->getDoubleValue());
+    return GetValue(lookupSlot[eRow].getDoubleValue(),
+                    lookupSlot[eColumn].getDoubleValue());
   case tt3D:
-    return GetValue(lookupProperty[eRow]->getDoubleValue(),
-                    lookupProperty[eColumn]->getDoubleValue(),
-                    lookupProperty[eTable]->getDoubleValue());
+    return GetValue(lookupSlot[eRow].getDoubleValue(),
+                    lookupSlot[eColumn].getDoubleValue(),
+                    lookupSlot[eTable].getDoubleValue());
   default:
     cerr << "Attempted to GetValue() for invalid/unknown table type" << endl;
     throw(string("Attempted to GetValue() for invalid/unknown table type"));
@@ -435,14 +693,14 @@ double FGTable::GetValue(double key) const
 
   //if the key is off the end of the table, just return the
   //end-of-table value, do not extrapolate
-  if( key <= Data[1][0] ) {
+  if( key <= RowKeys[0] ) {
     lastRowIndex=2;
     //cout << "Key underneath table: " << key << endl;
-    return Data[1][1];
-  } else if ( key >= Data[nRows][0] ) {
+    return Values[0];
+  } else if ( key >= RowKeys[nRows-1] ) {
     lastRowIndex=nRows;
     //cout << "Key over table: " << key << endl;
-    return Data[nRows][1];
+    return Values[nRows-1];
   }
 
   // the key is somewhere in the middle, search for the right breakpoint
@@ -450,21 +708,20 @@ double FGTable::GetValue(double key) const
   // the correct breakpoint has not changed since last frame or
   // has only changed very little
 
-  while (r > 2     && Data[r-1][0] > key) { r--; }
-  while (r < nRows && Data[r][0]   < key) { r++; }
+  r = FindInterval(key, RowKeys, nRows, RowSpacing, r);
 
   lastRowIndex=r;
   // make sure denominator below does not go to zero.
 
-  Span = Data[r][0] - Data[r-1][0];
+  Span = RowKeys[r-1] - RowKeys[r-2];
   if (Span != 0.0) {
-    Factor = (key - Data[r-1][0]) / Span;
+    Factor = (key - RowKeys[r-2]) / Span;
     if (Factor > 1.0) Factor = 1.0;
   } else {
     Factor = 1.0;
   }
 
-  Value = Factor*(Data[r][1] - Data[r-1][1]) + Data[r-1][1];
+  Value = Factor*(Values[r-1] - Values[r-2]) + Values[r-2];
 
   return Value;
 }
@@ -473,34 +730,9 @@ double FGTable::GetValue(double key) const
 
 double FGTable::GetValue(double rowKey, double colKey) const
 {
-  double rFactor, cFactor, col1temp, col2temp, Value;
-  unsigned int r = lastRowIndex;
-  unsigned int c = lastColumnIndex;
-
-  while(r > 2     && Data[r-1][0] > rowKey) { r--; }
-  while(r < nRows && Data[r]  [0] < rowKey) { r++; }
-
-  while(c > 2     && Data[0][c-1] > colKey) { c--; }
-  while(c < nCols && Data[0][c]   < colKey) { c++; }
-
-  lastRowIndex=r;
-  lastColumnIndex=c;
-
-  rFactor = (rowKey - Data[r-1][0]) / (Data[r][0] - Data[r-1][0]);
-  cFactor = (colKey - Data[0][c-1]) / (Data[0][c] - Data[0][c-1]);
-
-  if (rFactor > 1.0) rFactor = 1.0;
-  else if (rFactor < 0.0) rFactor = 0.0;
-
-  if (cFactor > 1.0) cFactor = 1.0;
-  else if (cFactor < 0.0) cFactor = 0.0;
-
-  col1temp = rFactor*(Data[r][c-1] - Data[r-1][c-1]) + Data[r-1][c-1];
-  col2temp = rFactor*(Data[r][c] - Data[r-1][c]) + Data[r-1][c];
-
-  Value = col1temp + cFactor*(col2temp - col1temp);
-
-  return Value;
+  return Interpolate2D(rowKey, colKey, nRows, nCols, RowKeys, ColumnKeys,
+                       Values, RowSpacing, ColumnSpacing, lastRowIndex,
+                       lastColumnIndex);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -513,12 +745,12 @@ double FGTable::GetValue(double rowKey, double colKey, double tableKey) const
   //if the key is off the end  (or before the beginning) of the table,
   // just return the boundary-table value, do not extrapolate
 
-  if( tableKey <= Data[1][1] ) {
+  if( tableKey <= RowKeys[0] ) {
     lastRowIndex=2;
-    return Tables[0]->GetValue(rowKey, colKey);
-  } else if ( tableKey >= Data[nRows][1] ) {
+    return Interpolate2D(rowKey, colKey, Layers[0]);
+  } else if ( tableKey >= RowKeys[nRows-1] ) {
     lastRowIndex=nRows;
-    return Tables[nRows-1]->GetValue(rowKey, colKey);
+    return Interpolate2D(rowKey, colKey, Layers[nRows-1]);
   }
 
   // the key is somewhere in the middle, search for the right breakpoint
@@ -526,26 +758,210 @@ double FGTable::GetValue(double rowKey, double colKey, double tableKey) const
   // the correct breakpoint has not changed since last frame or
   // has only changed very little
 
-  while(r > 2     && Data[r-1][1] > tableKey) { r--; }
-  while(r < nRows && Data[r]  [1] < tableKey) { r++; }
+  r = FindInterval(tableKey, RowKeys, nRows, RowSpacing, r);
 
   lastRowIndex=r;
   // make sure denominator below does not go to zero.
 
-  Span = Data[r][1] - Data[r-1][1];
+  Span = RowKeys[r-1] - RowKeys[r-2];
   if (Span != 0.0) {
-    Factor = (tableKey - Data[r-1][1]) / Span;
+    Factor = (tableKey - RowKeys[r-2]) / Span;
     if (Factor > 1.0) Factor = 1.0;
   } else {
     Factor = 1.0;
   }
 
-  Value = Factor*(Tables[r-1]->GetValue(rowKey, colKey) - Tables[r-2]->GetValue(rowKey, colKey))
-                              + Tables[r-2]->GetValue(rowKey, colKey);
+  double Value0 = Interpolate2D(rowKey, colKey, Layers[r-2]);
+  double Value1 = Interpolate2D(rowKey, colKey, Layers[r-1]);
+
+  Value = Factor*(Value1 - Value0) + Value0;
 
   return Value;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Searches the interval of the key of the point i along the row breakpoints and
+// stores its bounds in the block. Returns the index of the value (or of the
+// layer) below the key; the value above has the next index unless the key is
+// out of the breakpoints.
+
+unsigned int FGTable::Gather1D(double key, Block& block, unsigned int i) const
+{
+  unsigned int r;
+
+  if (key <= RowKeys[0]) {
+    lastRowIndex = 2;
+    block.Clamped[i] = true;
+    block.Key0[i] = block.Key1[i] = RowKeys[0];
+    return 0;
+  } else if (key >= RowKeys[nRows-1]) {
+    lastRowIndex = nRows;
+    block.Clamped[i] = true;
+    block.Key0[i] = block.Key1[i] = RowKeys[nRows-1];
+    return nRows-1;
+  }
+
+  r = FindInterval(key, RowKeys, nRows, RowSpacing, lastRowIndex);
+  lastRowIndex = r;
+  block.Clamped[i] = false;
+  block.Key0[i] = RowKeys[r-2];
+  block.Key1[i] = RowKeys[r-1];
+  return r-2;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Interpolates the values V00 and V01 of the points of a block. The arithmetic
+// is the same as GetValue(double) so that the results are identical.
+
+void FGTable::Interpolate1D(unsigned int n, const double* keys,
+                            const Block& block, double* values)
+{
+  for (unsigned int i=0; i<n; i++) {
+    double Span = block.Key1[i] - block.Key0[i];
+    double Factor = Span != 0.0 ? (keys[i] - block.Key0[i]) / Span : 1.0;
+    Factor = Factor > 1.0 ? 1.0 : Factor;
+    double Value = Factor*(block.V01[i] - block.V00[i]) + block.V00[i];
+    values[i] = block.Clamped[i] ? block.V00[i] : Value;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Searches the cell of a 2D table that holds the point i and stores its
+// breakpoints and its 4 values in the block.
+
+void FGTable::Gather2D(double rowKey, double colKey, const Layer& layer,
+                       Block& block, unsigned int i)
+{
+  size_t r = FindInterval(rowKey, layer.RowKeys, layer.nRows,
+                          layer.RowSpacing, layer.lastRowIndex);
+  size_t c = FindInterval(colKey, layer.ColumnKeys, layer.nCols,
+                          layer.ColumnSpacing, layer.lastColumnIndex);
+
+  layer.lastRowIndex = r;
+  layer.lastColumnIndex = c;
+
+  const double* row0 = layer.Values + (r-2)*layer.nCols; // Row r-1
+  const double* row1 = row0 + layer.nCols;               // Row r
+
+  block.Key0[i] = layer.RowKeys[r-2];
+  block.Key1[i] = layer.RowKeys[r-1];
+  block.ColKey0[i] = layer.ColumnKeys[c-2];
+  block.ColKey1[i] = layer.ColumnKeys[c-1];
+  block.V00[i] = row0[c-2];
+  block.V01[i] = row0[c-1];
+  block.V10[i] = row1[c-2];
+  block.V11[i] = row1[c-1];
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Interpolates the cells gathered in a block with the same arithmetic as
+// Interpolate2D().
+
+void FGTable::Interpolate2D(unsigned int n, const double* rowKeys,
+                            const double* colKeys, const Block& block,
+                            double* values)
+{
+  for (unsigned int i=0; i<n; i++) {
+    double rFactor = (rowKeys[i] - block.Key0[i]) / (block.Key1[i] - block.Key0[i]);
+    double cFactor = (colKeys[i] - block.ColKey0[i]) / (block.ColKey1[i] - block.ColKey0[i]);
+
+    rFactor = rFactor > 1.0 ? 1.0 : (rFactor < 0.0 ? 0.0 : rFactor);
+    cFactor = cFactor > 1.0 ? 1.0 : (cFactor < 0.0 ? 0.0 : cFactor);
+
+    double col1temp = rFactor*(block.V10[i] - block.V00[i]) + block.V00[i];
+    double col2temp = rFactor*(block.V11[i] - block.V01[i]) + block.V01[i];
+
+    values[i] = col1temp + cFactor*(col2temp - col1temp);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTable::GetValues(size_t n, const double* rowKeys,
+                        const double* colKeys, const double* tableKeys,
+                        double* values) const
+{
+  Block block, lower, upper;
+  // A 2D table is interpolated as a layer which search hints are the table's.
+  Layer table = {nRows, nCols, RowKeys, ColumnKeys, Values, RowSpacing,
+                 ColumnSpacing, lastRowIndex, lastColumnIndex};
+
+  for (size_t start=0; start<n; start+=BlockSize) {
+    unsigned int m = min<size_t>(BlockSize, n-start);
+    unsigned int i, k;
+
+    switch (Type) {
+    case tt1D:
+      for (i=0; i<m; i++) {
+        k = Gather1D(rowKeys[start+i], block, i);
+        block.V00[i] = Values[k];
+        block.V01[i] = Values[block.Clamped[i] ? k : k+1];
+      }
+      Interpolate1D(m, rowKeys+start, block, values+start);
+      break;
+    case tt2D:
+      for (i=0; i<m; i++)
+        Gather2D(rowKeys[start+i], colKeys[start+i], table, block, i);
+      Interpolate2D(m, rowKeys+start, colKeys+start, block, values+start);
+      break;
+    case tt3D:
+      // The values of the layers below and above each point are interpolated
+      // in V00 and V01 then interpolated along the table breakpoints.
+      for (i=0; i<m; i++) {
+        k = Gather1D(tableKeys[start+i], block, i);
+        Gather2D(rowKeys[start+i], colKeys[start+i], Layers[k], lower, i);
+        Gather2D(rowKeys[start+i], colKeys[start+i],
+                 Layers[block.Clamped[i] ? k : k+1], upper, i);
+      }
+      Interpolate2D(m, rowKeys+start, colKeys+start, lower, block.V00);
+      Interpolate2D(m, rowKeys+start, colKeys+start, upper, block.V01);
+      Interpolate1D(m, tableKeys+start, block, values+start);
+      break;
+    default:
+      cerr << "Attempted to GetValues() for invalid/unknown table type" << endl;
+      throw(string("Attempted to GetValues() for invalid/unknown table type"));
+    }
+  }
+
+  if (Type == tt2D) {
+    lastRowIndex = table.lastRowIndex;
+    lastColumnIndex = table.lastColumnIndex;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTable::GetValues(size_t n, const vector<FGPropertyNode*>& inputs,
+                        const vector<const double*>& columns,
+                        double* values) const
+{
+  const double* keys[3] = {0L, 0L, 0L};
+  double constant[3][BlockSize];
+  unsigned int a, i, j;
+
+  for (a=0; a<=(unsigned int)Type; a++) {
+    for (j=0; j<inputs.size(); j++) {
+      if (lookupProperty[a] == inputs[j]) {
+        keys[a] = columns[j];
+        break;
+      }
+    }
+    if (!keys[a]) {
+      // The key is the same for all the points.
+      double key = lookupSlot[a].getDoubleValue();
+      for (i=0; i<BlockSize; i++) constant[a][i] = key;
+    }
+  }
+
+  for (size_t start=0; start<n; start+=BlockSize) {
+    const double* blockKeys[3];
+    for (a=0; a<3; a++)
+      blockKeys[a] = keys[a] ? keys[a]+start : constant[a];
+    GetValues(min<size_t>(BlockSize, n-start), blockKeys[eRow],
+              blockKeys[eColumn], blockKeys[eTable], values+start);
+  }
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 void FGTable::operator<<(istream& in_stream)
@@ -559,7 +975,7 @@ void FGTable::operator<<(istream& in_stream)
   for (unsigned int r=startRow; r<=nRows; r++) {
     for (unsigned int c=startCol; c<=nCols; c++) {
       if (r != 0 || c != 0) {
-        in_stream >> Data[r][c];
+        in_stream >> At(r, c);
       }
     }
   }
@@ -571,10 +987,11 @@ void FGTable::operator<<(istream& in_stream)
 
 FGTable& FGTable::operator<<(const double n)
 {
-  Data[rowCounter][colCounter] = n;
+  At(rowCounter, colCounter) = n;
   if (colCounter == (int)nCols) {
     colCounter = 0;
     rowCounter++;
+    if (rowCounter > (int)nRows) UpdateSpacings(); // The table is complete
   } else {
     colCounter++;
   }
@@ -625,10 +1042,10 @@ void FGTable::Print(void)
       if (r == 0 && c == 0) {
         cout << "	";
       } else {
-        cout << Data[r][c] << "	";
+        cout << At(r, c) << "	";
         if (Type == tt3D) {
           cout << endl;
-          Tables[r-1]->Print();
+          PrintLayer(Layers[r-1]);
         }
       }
     }
@@ -639,6 +1056,28 @@ void FGTable::Print(void)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGTable::PrintLayer(const Layer& layer)
+{
+  ios::fmtflags flags = cout.setf(ios::fixed); // set up output stream
+
+  cout << "    2 dimensional table with " << layer.nRows << " rows, "
+       << layer.nCols << " columns." << endl;
+  cout.precision(4);
+  cout << "	" << "	";
+  for (unsigned int c=0; c<layer.nCols; c++)
+    cout << layer.ColumnKeys[c] << "	";
+  cout << endl;
+  for (unsigned int r=0; r<layer.nRows; r++) {
+    cout << "	" << layer.RowKeys[r] << "	";
+    for (unsigned int c=0; c<layer.nCols; c++)
+      cout << layer.Values[r*layer.nCols+c] << "	";
+    cout << endl;
+  }
+  cout.setf(flags); // reset
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGTable::bind(Element* el)
 {
   typedef double (FGTable::*PMF)(void) const;
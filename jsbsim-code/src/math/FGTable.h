@@ -39,6 +39,7 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include <iosfwd>
+#include <memory>
 #include <vector>
 #include <string>
 #include "FGParameter.h"
@@ -258,6 +259,25 @@ public:
   double GetValue(double key) const;
   double GetValue(double rowKey, double colKey) const;
   double GetValue(double rowKey, double colKey, double TableKey) const;
+  /** Evaluates the table at n points. The point i is located by rowKeys[i]
+      and, depending on the dimension of the table, by colKeys[i] and
+      tableKeys[i]; the arrays of the keys that are not used can be null.
+      values[i] receives the value that GetValue() would return for these
+      keys. The breakpoints are searched point by point, then the
+      interpolations are computed by blocks of points in loops that the
+      compiler can vectorize. */
+  void GetValues(size_t n, const double* rowKeys, const double* colKeys,
+                 const double* tableKeys, double* values) const;
+  /** Appends the lookup properties of the table to the vector nodes.
+      @param nodes the vector to which the properties are appended */
+  void GetInputs(std::vector<FGPropertyNode*>& nodes) const;
+  /** Evaluates the table at n points where the lookup properties are read
+      from arrays: the lookup property of an axis takes the value columns[j][i]
+      at the point i if it is the property inputs[j]. Otherwise it keeps its
+      current value for all the points. */
+  void GetValues(size_t n, const std::vector<FGPropertyNode*>& inputs,
+                 const std::vector<const double*>& columns,
+                 double* values) const;
   /** Read the table in.
       Data in the config file should be in matrix format with the row
       independents as the first column and the column independents in
@@ -284,14 +304,14 @@ public:
   FGTable& operator<<(const double n);
   FGTable& operator<<(const int n);
 
-  inline double GetElement(int r, int c) const {return Data[r][c];}
+  inline double GetElement(int r, int c) const {return At(r, c);}
 //  inline double GetElement(int r, int c, int t);
 
   double operator()(unsigned int r, unsigned int c) const {return GetElement(r, c);}
 //  double operator()(unsigned int r, unsigned int c, unsigned int t) {GetElement(r, c, t);}
 
-  void SetRowIndexProperty(FGPropertyNode *node) {lookupProperty[eRow] = node;}
-  void SetColumnIndexProperty(FGPropertyNode *node) {lookupProperty[eColumn] = node;}
+  void SetRowIndexProperty(FGPropertyNode *node) {SetLookupProperty(eRow, node);}
+  void SetColumnIndexProperty(FGPropertyNode *node) {SetLookupProperty(eColumn, node);}
 
   unsigned int GetNumRows() const {return nRows;}
 
@@ -300,16 +320,105 @@ public:
   std::string GetName(void) const {return Name;}
 
 private:
+  /** The spacing of the breakpoints of an axis. When the breakpoints are
+      evenly spaced, the interval of a key is estimated arithmetically. */
+  struct Spacing {
+    bool Uniform;
+    double InvStep; // Inverse of the distance between 2 breakpoints
+  };
+
+  /// One of the 2D tables of a 3D table.
+  struct Layer {
+    unsigned int nRows, nCols;
+    double* RowKeys;
+    double* ColumnKeys;
+    double* Values;
+    Spacing RowSpacing, ColumnSpacing;
+    mutable int lastRowIndex, lastColumnIndex;
+  };
+
+  /// Number of points interpolated together by GetValues().
+  static const unsigned int BlockSize = 64;
+
+  /// The breakpoints and the values surrounding each point of a block.
+  struct Block {
+    double Key0[BlockSize], Key1[BlockSize];      // Row breakpoints
+    double ColKey0[BlockSize], ColKey1[BlockSize];
+    double V00[BlockSize], V01[BlockSize], V10[BlockSize], V11[BlockSize];
+    bool Clamped[BlockSize]; // The key is out of the breakpoints of a 1D axis
+  };
+
   enum type {tt1D, tt2D, tt3D} Type;
   enum axis {eRow=0, eColumn, eTable};
   bool internal;
   FGPropertyNode_ptr lookupProperty[3];
-  double** Data;
-  std::vector <FGTable*> Tables;
+  FGPropertySlot lookupSlot[3]; // The lookup properties are read from there
+  // The breakpoints and the values are stored in a single block of memory
+  // aligned on a cache line. The block is shared by the tables loaded from the
+  // same XML element. A 1D or 2D table stores its nRows row breakpoints, then
+  // its nCols column breakpoints, then its nRows x nCols values row by row. A
+  // 3D table stores its nRows table breakpoints then each of its layers.
+  std::shared_ptr<double> DataStorage;
+  size_t DataSize;
+  double* RowKeys;    // Row breakpoints (table breakpoints of a 3D table)
+  double* ColumnKeys; // Column breakpoints
+  double* Values;
+  Spacing RowSpacing, ColumnSpacing;
+  std::vector<Layer> Layers; // The 2D tables of a 3D table
   unsigned int nRows, nCols, nTables, dimension;
   int colCounter, rowCounter, tableCounter;
   mutable int lastRowIndex, lastColumnIndex, lastTableIndex;
-  double** Allocate(void);
+  void SetLookupProperty(axis a, FGPropertyNode* node)
+  {
+    lookupProperty[a] = node;
+    lookupSlot[a].SetNode(node);
+  }
+  void Allocate(size_t size);
+  void SetLayout(double* data);
+  void LoadData(Element* tableData);
+  void UpdateSpacings(void);
+  static void PrintLayer(const Layer& layer);
+  static Spacing FindSpacing(const double* keys, unsigned int n);
+  static unsigned int LowerBound(double key, const double* keys, unsigned int n,
+                                 const Spacing& spacing);
+  static unsigned int UpperBound(double key, const double* keys, unsigned int n,
+                                 const Spacing& spacing);
+  /** Returns the interval r such that keys[r-2] <= key <= keys[r-1], starting
+      from the interval r found by the previous lookup. The interval is
+      usually unchanged from a frame to the next so this test is inlined. */
+  static unsigned int FindInterval(double key, const double* keys,
+                                   unsigned int n, const Spacing& spacing,
+                                   unsigned int r) {
+    if ((r <= 2 || keys[r-2] <= key) && (r >= n || keys[r-1] >= key))
+      return r;
+    return SearchInterval(key, keys, n, spacing, r);
+  }
+  static unsigned int SearchInterval(double key, const double* keys,
+                                     unsigned int n, const Spacing& spacing,
+                                     unsigned int r);
+  static double Interpolate2D(double rowKey, double colKey,
+                              unsigned int nRows, unsigned int nCols,
+                              const double* rowKeys, const double* colKeys,
+                              const double* values, const Spacing& rowSpacing,
+                              const Spacing& colSpacing, int& lastRowIndex,
+                              int& lastColumnIndex);
+  static double Interpolate2D(double rowKey, double colKey, const Layer& layer);
+  static void Gather2D(double rowKey, double colKey, const Layer& layer,
+                       Block& block, unsigned int i);
+  static void Interpolate2D(unsigned int n, const double* rowKeys,
+                            const double* colKeys, const Block& block,
+                            double* values);
+  unsigned int Gather1D(double key, Block& block, unsigned int i) const;
+  static void Interpolate1D(unsigned int n, const double* keys,
+                            const Block& block, double* values);
+  /// Returns the element (r, c) of the table, using the indexing of the
+  /// operator<<: the row 0 holds the column breakpoints and the column 0 the
+  /// row breakpoints. The element (r, 1) of a 3D table is its breakpoint r.
+  double& At(unsigned int r, unsigned int c) const {
+    if (Type == tt3D || c == 0) return RowKeys[r-1];
+    if (r == 0) return ColumnKeys[c-1];
+    return Values[(r-1)*nCols+c-1];
+  }
   FGPropertyManager* const PropertyManager;
   std::string Prefix;
   std::string Name;
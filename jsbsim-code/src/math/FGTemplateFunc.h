@@ -55,10 +55,10 @@ class FGTemplateFunc : public FGFunction
 {
 public:
 
-  FGTemplateFunc(FGPropertyManager* PropertyManager, Element* element)
+  FGTemplateFunc(FGFDMExec* fdmex, Element* element)
     : var(0L)
   {
-    Load(PropertyManager, element, &var);
+    Load(fdmex, element, &var);
     // Since 'var' is a member of FGTemplateFunc, we don't want SGSharedPtr to
     // destroy 'var' when it would no longer be referenced by any shared
     // pointers. In order to avoid this, the reference counter is increased an
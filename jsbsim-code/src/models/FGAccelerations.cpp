@@ -55,6 +55,7 @@ INCLUDES
 #include "FGAccelerations.h"
 #include "FGFDMExec.h"
 #include "input_output/FGPropertyManager.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -386,6 +387,21 @@ void FGAccelerations::bind(void)
   PropertyManager->Tie("forces/fbz-gear-lbs", this, eZ, (PMF)&FGAccelerations::GetGroundForces);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGAccelerations::SerializeState(FGStateArchive& ar)
+{
+  FGModel::SerializeState(ar);
+
+  ar & vPQRdot & vPQRidot & vUVWdot & vUVWidot & vBodyAccel & vGravAccel
+     & vFrictionForces & vFrictionMoments;
+  ar & in.J & in.Jinv & in.Ti2b & in.Tb2i & in.Tec2b & in.Tec2i;
+  ar & in.Moment & in.GroundMoment & in.Force & in.GroundForce & in.J2Grav
+     & in.vPQRi & in.vPQR & in.vUVW & in.vInertialPosition & in.vOmegaPlanet
+     & in.TerrainVelocity & in.TerrainAngularVel;
+  ar & in.DeltaT & in.Mass & in.GAccel;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -37,14 +37,14 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include <iostream>
-#include <sstream>
-#include <iomanip>
 #include <cstdlib>
 
 #include "FGFDMExec.h"
 #include "FGAerodynamics.h"
 #include "input_output/FGPropertyManager.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
+#include "input_output/FGTextBuffer.h"
 
 using namespace std;
 
@@ -364,7 +364,7 @@ bool FGAerodynamics::Load(Element *document)
 
   if ((temp_element = document->FindElement("aero_ref_pt_shift_x"))) {
     function_element = temp_element->FindElement("function");
-    AeroRPShift = new FGFunction(PropertyManager, function_element);
+    AeroRPShift = new FGFunction(FDMExec, function_element);
   }
 
   axis_element = document->FindElement("axis");
@@ -381,7 +381,7 @@ bool FGAerodynamics::Load(Element *document)
       }
       if (!apply_at_cg) {
       try {
-        ca.push_back( new FGFunction(PropertyManager, function_element) );
+        ca.push_back( new FGFunction(FDMExec, function_element) );
       } catch (const string& str) {
         cerr << endl << axis_element->ReadFrom()
              << endl << fgred << "Error loading aerodynamic function in "
@@ -390,7 +390,7 @@ bool FGAerodynamics::Load(Element *document)
       }
       } else {
         try {
-          ca_atCG.push_back( new FGFunction(PropertyManager, function_element) );
+          ca_atCG.push_back( new FGFunction(FDMExec, function_element) );
         } catch (const string& str) {
           cerr << endl << axis_element->ReadFrom()
                << endl << fgred << "Error loading aerodynamic function in "
@@ -405,7 +405,7 @@ bool FGAerodynamics::Load(Element *document)
     axis_element = document->FindNextElement("axis");
   }
 
-  PostLoad(document, PropertyManager); // Perform base class Post-Load
+  PostLoad(document, FDMExec); // Perform base class Post-Load
 
   return true;
 }
@@ -546,11 +546,11 @@ string FGAerodynamics::GetAeroFunctionStrings(const string& delimeter) const
 
 string FGAerodynamics::GetAeroFunctionValues(const string& delimeter) const
 {
-  ostringstream buf;
+  FGTextBuffer buf;
 
   for (unsigned int axis = 0; axis < 6; axis++) {
     for (unsigned int sd = 0; sd < AeroFunctions[axis].size(); sd++) {
-      if (buf.tellp() > 0) buf << delimeter;
+      if (!buf.Empty()) buf << delimeter;
       buf << AeroFunctions[axis][sd]->GetValue();
     }
   }
@@ -558,14 +558,14 @@ string FGAerodynamics::GetAeroFunctionValues(const string& delimeter) const
   string FunctionValues = FGModelFunctions::GetFunctionValues(delimeter);
 
   if (FunctionValues.size() > 0) {
-    if (buf.str().size() > 0) {
+    if (!buf.Empty()) {
       buf << delimeter << FunctionValues;
     } else {
       buf << FunctionValues;
     }
   }
 
-  return buf.str();
+  return buf.GetString();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -592,16 +592,16 @@ void FGAerodynamics::bind(void)
   PropertyManager->Tie("moments/roll-wind-aero-lbsft", this, eRoll, (PMF)&FGAerodynamics::GetMomentsInWindAxes);
   PropertyManager->Tie("moments/pitch-wind-aero-lbsft", this, ePitch, (PMF)&FGAerodynamics::GetMomentsInWindAxes);
   PropertyManager->Tie("moments/yaw-wind-aero-lbsft", this, eYaw, (PMF)&FGAerodynamics::GetMomentsInWindAxes);
-  PropertyManager->Tie("forces/lod-norm",      this, &FGAerodynamics::GetLoD);
-  PropertyManager->Tie("aero/cl-squared",      this, &FGAerodynamics::GetClSquared);
+  PropertyManager->Tie("forces/lod-norm",      this, &FGAerodynamics::lod);
+  PropertyManager->Tie("aero/cl-squared",      this, &FGAerodynamics::clsq);
   PropertyManager->Tie("aero/qbar-area", &qbar_area);
-  PropertyManager->Tie("aero/alpha-max-rad",   this, &FGAerodynamics::GetAlphaCLMax, &FGAerodynamics::SetAlphaCLMax, true);
-  PropertyManager->Tie("aero/alpha-min-rad",   this, &FGAerodynamics::GetAlphaCLMin, &FGAerodynamics::SetAlphaCLMin, true);
-  PropertyManager->Tie("aero/bi2vel",          this, &FGAerodynamics::GetBI2Vel);
-  PropertyManager->Tie("aero/ci2vel",          this, &FGAerodynamics::GetCI2Vel);
-  PropertyManager->Tie("aero/alpha-wing-rad",  this, &FGAerodynamics::GetAlphaW);
-  PropertyManager->Tie("systems/stall-warn-norm", this, &FGAerodynamics::GetStallWarn);
-  PropertyManager->Tie("aero/stall-hyst-norm", this, &FGAerodynamics::GetHysteresisParm);
+  PropertyManager->Tie("aero/alpha-max-rad",   this, &FGAerodynamics::alphaclmax, &FGAerodynamics::SetAlphaCLMax, true);
+  PropertyManager->Tie("aero/alpha-min-rad",   this, &FGAerodynamics::alphaclmin, &FGAerodynamics::SetAlphaCLMin, true);
+  PropertyManager->Tie("aero/bi2vel",          this, &FGAerodynamics::bi2vel);
+  PropertyManager->Tie("aero/ci2vel",          this, &FGAerodynamics::ci2vel);
+  PropertyManager->Tie("aero/alpha-wing-rad",  this, &FGAerodynamics::alphaw);
+  PropertyManager->Tie("systems/stall-warn-norm", this, &FGAerodynamics::impending_stall);
+  PropertyManager->Tie("aero/stall-hyst-norm", this, &FGAerodynamics::stall_hyst);
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -642,6 +642,29 @@ void FGAerodynamics::BuildStabilityTransformMatrices(void)
   Tb2s = Ts2b.Transposed();
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGAerodynamics::SerializeState(FGStateArchive& ar)
+{
+  FGModel::SerializeState(ar);
+
+  for (unsigned int axis=0; axis<6; axis++) {
+    for (unsigned int i=0; i<AeroFunctions[axis].size(); i++)
+      AeroFunctions[axis][i]->SerializeState(ar);
+    for (unsigned int i=0; i<AeroFunctionsAtCG[axis].size(); i++)
+      AeroFunctionsAtCG[axis][i]->SerializeState(ar);
+  }
+
+  ar & Ts2b & Tb2s;
+  ar & vFnative & vFw & vForces & vFnativeAtCG & vForcesAtCG & vMoments
+     & vMomentsMRC & vMomentsMRCBodyXYZ & vDXYZcg & vDeltaRP;
+  ar & alphaclmax & alphaclmin & alphahystmax & alphahystmin
+     & impending_stall & stall_hyst & bi2vel & ci2vel & alphaw & clsq & lod
+     & qbar_area;
+  ar & in.Alpha & in.Beta & in.Vt & in.Qbar & in.Wingarea & in.Wingspan
+     & in.Wingchord & in.Wingincidence & in.RPBody & in.Tb2w & in.Tw2b;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -59,6 +59,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGStateArchive;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -126,6 +128,7 @@ public:
   ~FGAerodynamics();
 
   bool InitModel(void);
+  void SerializeState(FGStateArchive& ar);
 
   /** Runs the Aerodynamics model; called by the Executive
       Can pass in a value indicating if the executive is directing the simulation to Hold.
@@ -47,6 +47,7 @@ INCLUDES
 #include "FGFDMExec.h"
 #include "input_output/FGPropertyManager.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -179,7 +180,7 @@ bool FGAircraft::Load(Element* el)
     }
   }
 
-  PostLoad(el, PropertyManager);
+  PostLoad(el, FDMExec);
 
   Debug(2);
 
@@ -191,19 +192,19 @@ bool FGAircraft::Load(Element* el)
 void FGAircraft::bind(void)
 {
   typedef double (FGAircraft::*PMF)(int) const;
-  PropertyManager->Tie("metrics/Sw-sqft", this, &FGAircraft::GetWingArea, &FGAircraft::SetWingArea);
-  PropertyManager->Tie("metrics/bw-ft", this, &FGAircraft::GetWingSpan);
-  PropertyManager->Tie("metrics/cbarw-ft", this, &FGAircraft::Getcbar);
-  PropertyManager->Tie("metrics/iw-rad", this, &FGAircraft::GetWingIncidence);
+  PropertyManager->Tie("metrics/Sw-sqft", this, &FGAircraft::WingArea, &FGAircraft::SetWingArea);
+  PropertyManager->Tie("metrics/bw-ft", this, &FGAircraft::WingSpan);
+  PropertyManager->Tie("metrics/cbarw-ft", this, &FGAircraft::cbar);
+  PropertyManager->Tie("metrics/iw-rad", this, &FGAircraft::WingIncidence);
   PropertyManager->Tie("metrics/iw-deg", this, &FGAircraft::GetWingIncidenceDeg);
-  PropertyManager->Tie("metrics/Sh-sqft", this, &FGAircraft::GetHTailArea);
-  PropertyManager->Tie("metrics/lh-ft", this, &FGAircraft::GetHTailArm);
-  PropertyManager->Tie("metrics/Sv-sqft", this, &FGAircraft::GetVTailArea);
-  PropertyManager->Tie("metrics/lv-ft", this, &FGAircraft::GetVTailArm);
-  PropertyManager->Tie("metrics/lh-norm", this, &FGAircraft::Getlbarh);
-  PropertyManager->Tie("metrics/lv-norm", this, &FGAircraft::Getlbarv);
-  PropertyManager->Tie("metrics/vbarh-norm", this, &FGAircraft::Getvbarh);
-  PropertyManager->Tie("metrics/vbarv-norm", this, &FGAircraft::Getvbarv);
+  PropertyManager->Tie("metrics/Sh-sqft", this, &FGAircraft::HTailArea);
+  PropertyManager->Tie("metrics/lh-ft", this, &FGAircraft::HTailArm);
+  PropertyManager->Tie("metrics/Sv-sqft", this, &FGAircraft::VTailArea);
+  PropertyManager->Tie("metrics/lv-ft", this, &FGAircraft::VTailArm);
+  PropertyManager->Tie("metrics/lh-norm", this, &FGAircraft::lbarh);
+  PropertyManager->Tie("metrics/lv-norm", this, &FGAircraft::lbarv);
+  PropertyManager->Tie("metrics/vbarh-norm", this, &FGAircraft::vbarh);
+  PropertyManager->Tie("metrics/vbarv-norm", this, &FGAircraft::vbarv);
   PropertyManager->Tie("metrics/aero-rp-x-in", this, eX, (PMF)&FGAircraft::GetXYZrp, &FGAircraft::SetXYZrp);
   PropertyManager->Tie("metrics/aero-rp-y-in", this, eY, (PMF)&FGAircraft::GetXYZrp, &FGAircraft::SetXYZrp);
   PropertyManager->Tie("metrics/aero-rp-z-in", this, eZ, (PMF)&FGAircraft::GetXYZrp, &FGAircraft::SetXYZrp);
@@ -215,6 +216,18 @@ void FGAircraft::bind(void)
   PropertyManager->Tie("metrics/visualrefpoint-z-in", this, eZ, (PMF)&FGAircraft::GetXYZvrp);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGAircraft::SerializeState(FGStateArchive& ar)
+{
+  FGModel::SerializeState(ar);
+
+  ar & vMoments & vForces & vXYZrp & vXYZvrp & vXYZep & vDXYZcg;
+  ar & in.AeroForce & in.PropForce & in.GroundForce & in.ExternalForce
+     & in.BuoyantForce & in.AeroMoment & in.PropMoment & in.GroundMoment
+     & in.ExternalMoment & in.BuoyantMoment;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -55,6 +55,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGStateArchive;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -126,6 +128,7 @@ public:
   bool Run(bool Holding);
 
   bool InitModel(void);
+  void SerializeState(FGStateArchive& ar);
 
   /** Loads the aircraft.
       The executive calls this method to load the aircraft into JSBSim.
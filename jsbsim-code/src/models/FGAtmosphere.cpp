@@ -47,6 +47,7 @@ INCLUDES
 #include <cstdlib>
 #include "FGFDMExec.h"
 #include "FGAtmosphere.h"
+#include "input_output/FGStateArchive.h"
 
 namespace JSBSim {
 
@@ -266,6 +267,19 @@ void FGAtmosphere::bind(void)
   PropertyManager->Tie("atmosphere/pressure-altitude", this, &FGAtmosphere::GetPressureAltitude);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGAtmosphere::SerializeState(FGStateArchive& ar)
+{
+  FGModel::SerializeState(ar);
+
+  ar & SLtemperature & SLdensity & SLpressure & SLsoundspeed;
+  ar & Temperature & Density & Pressure & Soundspeed;
+  ar & rSLtemperature & rSLdensity & rSLpressure & rSLsoundspeed;
+  ar & PressureAltitude & DensityAltitude & Viscosity & KinematicViscosity;
+  ar & in.altitudeASL;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -46,6 +46,7 @@ INCLUDES
 #include "initialization/FGInitialCondition.h"
 #include "FGFDMExec.h"
 #include "input_output/FGPropertyManager.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -349,16 +350,16 @@ void FGAuxiliary::bind(void)
 {
   typedef double (FGAuxiliary::*PMF)(int) const;
   typedef double (FGAuxiliary::*PF)(void) const;
-  PropertyManager->Tie("propulsion/tat-r", this, &FGAuxiliary::GetTotalTemperature);
-  PropertyManager->Tie("propulsion/tat-c", this, &FGAuxiliary::GetTAT_C);
-  PropertyManager->Tie("propulsion/pt-lbs_sqft", this, &FGAuxiliary::GetTotalPressure);
-  PropertyManager->Tie("velocities/vc-fps", this, &FGAuxiliary::GetVcalibratedFPS);
+  PropertyManager->Tie("propulsion/tat-r", this, &FGAuxiliary::tat);
+  PropertyManager->Tie("propulsion/tat-c", this, &FGAuxiliary::tatc);
+  PropertyManager->Tie("propulsion/pt-lbs_sqft", this, &FGAuxiliary::pt);
+  PropertyManager->Tie("velocities/vc-fps", this, &FGAuxiliary::vcas);
   PropertyManager->Tie("velocities/vc-kts", this, &FGAuxiliary::GetVcalibratedKTS);
-  PropertyManager->Tie("velocities/ve-fps", this, &FGAuxiliary::GetVequivalentFPS);
+  PropertyManager->Tie("velocities/ve-fps", this, &FGAuxiliary::veas);
   PropertyManager->Tie("velocities/ve-kts", this, &FGAuxiliary::GetVequivalentKTS);
-  PropertyManager->Tie("velocities/vtrue-fps", this, &FGAuxiliary::GetVtrueFPS);
+  PropertyManager->Tie("velocities/vtrue-fps", this, &FGAuxiliary::vtrue);
   PropertyManager->Tie("velocities/vtrue-kts", this, &FGAuxiliary::GetVtrueKTS);
-  PropertyManager->Tie("velocities/machU", this, &FGAuxiliary::GetMachU);
+  PropertyManager->Tie("velocities/machU", this, &FGAuxiliary::MachU);
   PropertyManager->Tie("velocities/p-aero-rad_sec", this, eX, (PMF)&FGAuxiliary::GetAeroPQR);
   PropertyManager->Tie("velocities/q-aero-rad_sec", this, eY, (PMF)&FGAuxiliary::GetAeroPQR);
   PropertyManager->Tie("velocities/r-aero-rad_sec", this, eZ, (PMF)&FGAuxiliary::GetAeroPQR);
@@ -368,39 +369,39 @@ void FGAuxiliary::bind(void)
   PropertyManager->Tie("velocities/u-aero-fps", this, eU, (PMF)&FGAuxiliary::GetAeroUVW);
   PropertyManager->Tie("velocities/v-aero-fps", this, eV, (PMF)&FGAuxiliary::GetAeroUVW);
   PropertyManager->Tie("velocities/w-aero-fps", this, eW, (PMF)&FGAuxiliary::GetAeroUVW);
-  PropertyManager->Tie("velocities/vt-fps", this, &FGAuxiliary::GetVt);
-  PropertyManager->Tie("velocities/mach", this, &FGAuxiliary::GetMach);
-  PropertyManager->Tie("velocities/vg-fps", this, &FGAuxiliary::GetVground);
+  PropertyManager->Tie("velocities/vt-fps", this, &FGAuxiliary::Vt);
+  PropertyManager->Tie("velocities/mach", this, &FGAuxiliary::Mach);
+  PropertyManager->Tie("velocities/vg-fps", this, &FGAuxiliary::Vground);
   PropertyManager->Tie("accelerations/a-pilot-x-ft_sec2", this, eX, (PMF)&FGAuxiliary::GetPilotAccel);
   PropertyManager->Tie("accelerations/a-pilot-y-ft_sec2", this, eY, (PMF)&FGAuxiliary::GetPilotAccel);
   PropertyManager->Tie("accelerations/a-pilot-z-ft_sec2", this, eZ, (PMF)&FGAuxiliary::GetPilotAccel);
   PropertyManager->Tie("accelerations/n-pilot-x-norm", this, eX, (PMF)&FGAuxiliary::GetNpilot);
   PropertyManager->Tie("accelerations/n-pilot-y-norm", this, eY, (PMF)&FGAuxiliary::GetNpilot);
   PropertyManager->Tie("accelerations/n-pilot-z-norm", this, eZ, (PMF)&FGAuxiliary::GetNpilot);
-  PropertyManager->Tie("accelerations/Nz", this, &FGAuxiliary::GetNz);
-  PropertyManager->Tie("accelerations/Ny", this, &FGAuxiliary::GetNy);
+  PropertyManager->Tie("accelerations/Nz", this, &FGAuxiliary::Nz);
+  PropertyManager->Tie("accelerations/Ny", this, &FGAuxiliary::Ny);
   PropertyManager->Tie("forces/load-factor", this, &FGAuxiliary::GetNlf);
   /* PropertyManager->Tie("atmosphere/headwind-fps", this, &FGAuxiliary::GetHeadWind, true);
   PropertyManager->Tie("atmosphere/crosswind-fps", this, &FGAuxiliary::GetCrossWind, true); */
-  PropertyManager->Tie("aero/alpha-rad", this, (PF)&FGAuxiliary::Getalpha);
-  PropertyManager->Tie("aero/beta-rad", this, (PF)&FGAuxiliary::Getbeta);
+  PropertyManager->Tie("aero/alpha-rad", this, &FGAuxiliary::alpha);
+  PropertyManager->Tie("aero/beta-rad", this, &FGAuxiliary::beta);
   PropertyManager->Tie("aero/mag-beta-rad", this, (PF)&FGAuxiliary::GetMagBeta);
   PropertyManager->Tie("aero/alpha-deg", this, inDegrees, (PMF)&FGAuxiliary::Getalpha);
   PropertyManager->Tie("aero/beta-deg", this, inDegrees, (PMF)&FGAuxiliary::Getbeta);
   PropertyManager->Tie("aero/mag-beta-deg", this, inDegrees, (PMF)&FGAuxiliary::GetMagBeta);
-  PropertyManager->Tie("aero/Re", this, &FGAuxiliary::GetReynoldsNumber);
-  PropertyManager->Tie("aero/qbar-psf", this, &FGAuxiliary::Getqbar);
-  PropertyManager->Tie("aero/qbarUW-psf", this, &FGAuxiliary::GetqbarUW);
-  PropertyManager->Tie("aero/qbarUV-psf", this, &FGAuxiliary::GetqbarUV);
-  PropertyManager->Tie("aero/alphadot-rad_sec", this, (PF)&FGAuxiliary::Getadot);
-  PropertyManager->Tie("aero/betadot-rad_sec", this, (PF)&FGAuxiliary::Getbdot);
+  PropertyManager->Tie("aero/Re", this, &FGAuxiliary::Re);
+  PropertyManager->Tie("aero/qbar-psf", this, &FGAuxiliary::qbar);
+  PropertyManager->Tie("aero/qbarUW-psf", this, &FGAuxiliary::qbarUW);
+  PropertyManager->Tie("aero/qbarUV-psf", this, &FGAuxiliary::qbarUV);
+  PropertyManager->Tie("aero/alphadot-rad_sec", this, &FGAuxiliary::adot);
+  PropertyManager->Tie("aero/betadot-rad_sec", this, &FGAuxiliary::bdot);
   PropertyManager->Tie("aero/alphadot-deg_sec", this, inDegrees, (PMF)&FGAuxiliary::Getadot);
   PropertyManager->Tie("aero/betadot-deg_sec", this, inDegrees, (PMF)&FGAuxiliary::Getbdot);
-  PropertyManager->Tie("aero/h_b-cg-ft", this, &FGAuxiliary::GetHOverBCG);
-  PropertyManager->Tie("aero/h_b-mac-ft", this, &FGAuxiliary::GetHOverBMAC);
-  PropertyManager->Tie("flight-path/gamma-rad", this, &FGAuxiliary::GetGamma);
+  PropertyManager->Tie("aero/h_b-cg-ft", this, &FGAuxiliary::hoverbcg);
+  PropertyManager->Tie("aero/h_b-mac-ft", this, &FGAuxiliary::hoverbmac);
+  PropertyManager->Tie("flight-path/gamma-rad", this, &FGAuxiliary::gamma);
   PropertyManager->Tie("flight-path/gamma-deg", this, inDegrees, (PMF)&FGAuxiliary::GetGamma);
-  PropertyManager->Tie("flight-path/psi-gt-rad", this, &FGAuxiliary::GetGroundTrack);
+  PropertyManager->Tie("flight-path/psi-gt-rad", this, &FGAuxiliary::psigt);
 
   PropertyManager->Tie("position/distance-from-start-lon-mt", this, &FGAuxiliary::GetLongitudeRelativePosition);
   PropertyManager->Tie("position/distance-from-start-lat-mt", this, &FGAuxiliary::GetLatitudeRelativePosition);
@@ -417,6 +418,29 @@ double FGAuxiliary::BadUnits(void) const
   cerr << "Bad units" << endl; return 0.0;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGAuxiliary::SerializeState(FGStateArchive& ar)
+{
+  FGModel::SerializeState(ar);
+
+  ar & vcas & veas & vtrue & pt & tat & tatc;
+  ar & mTw2b & mTb2w;
+  ar & vPilotAccel & vPilotAccelN & vNcg & vNwcg & vAeroPQR & vAeroUVW
+     & vEuler & vEulerRates & vMachUVW & vLocationVRP;
+  ar & Vt & Vground & Mach & MachU & qbar & qbarUW & qbarUV & Re & alpha
+     & beta & adot & bdot & psigt & gamma & Nz & Ny & seconds_in_day
+     & day_of_year & hoverbcg & hoverbmac;
+  ar & in.Pressure & in.Density & in.DensitySL & in.PressureSL
+     & in.Temperature & in.SoundSpeed & in.KinematicViscosity
+     & in.DistanceAGL & in.Wingspan & in.Wingchord & in.SLGravity & in.Mass;
+  ar & in.Tl2b & in.Tb2l & in.vPQR & in.vPQRi & in.vPQRidot & in.vUVW
+     & in.vUVWdot & in.vVel & in.vBodyAccel & in.ToEyePt & in.RPBody
+     & in.VRPBody & in.vFw & in.vLocation;
+  ar & in.CosTht & in.SinTht & in.CosPhi & in.SinPhi & in.Psi
+     & in.TotalWindNED & in.TurbPQR & in.WindPsi & in.Vwind;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
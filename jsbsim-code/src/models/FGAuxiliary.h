@@ -56,6 +56,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGStateArchive;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -116,6 +118,7 @@ public:
   ~FGAuxiliary();
 
   bool InitModel(void);
+  void SerializeState(FGStateArchive& ar);
 
   /** Runs the Auxiliary routines; called by the Executive
       Can pass in a value indicating if the executive is directing the simulation to Hold.
@@ -42,6 +42,7 @@ INCLUDES
 #include "FGBuoyantForces.h"
 #include "FGMassBalance.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -133,7 +134,7 @@ bool FGBuoyantForces::Load(Element *document)
     gas_cell_element = document->FindNextElement("gas_cell");
   }
   
-  PostLoad(document, PropertyManager);
+  PostLoad(document, FDMExec);
 
   if (!NoneDefined) {
     bind();
@@ -263,6 +264,20 @@ void FGBuoyantForces::bind(void)
                        (PGF)&FGBuoyantForces::GetForces, (PSF)0, false);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGBuoyantForces::SerializeState(FGStateArchive& ar)
+{
+  FGModel::SerializeState(ar);
+
+  for (unsigned int i=0; i<Cells.size(); i++)
+    Cells[i]->SerializeState(ar);
+
+  ar & vTotalForces & vTotalMoments & gasCellJ & vGasCellXYZ
+     & vXYZgasCell_arm;
+  ar & in.Pressure & in.Temperature & in.Density & in.gravity;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
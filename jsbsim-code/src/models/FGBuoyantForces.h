@@ -58,6 +58,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGStateArchive;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -113,6 +115,7 @@ public:
   ~FGBuoyantForces();
 
   bool InitModel(void);
+  void SerializeState(FGStateArchive& ar);
 
   /** Runs the Buoyant forces model; called by the Executive
       Can pass in a value indicating if the executive is directing the simulation to Hold.
@@ -42,6 +42,7 @@ INCLUDES
 #include "FGExternalForce.h"
 #include "FGExternalReactions.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -95,7 +96,7 @@ bool FGExternalReactions::Load(Element* el)
     moment_element = el->FindNextElement("moment");
   }
 
-  PostLoad(el, PropertyManager);
+  PostLoad(el, FDMExec);
 
   if (!Forces.empty()) bind();
 
@@ -160,6 +161,18 @@ void FGExternalReactions::bind(void)
 }
 
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGExternalReactions::SerializeState(FGStateArchive& ar)
+{
+  FGModel::SerializeState(ar);
+
+  for (unsigned int i=0; i<Forces.size(); i++)
+    Forces[i]->SerializeState(ar);
+
+  ar & vTotalForces & vTotalMoments;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -56,6 +56,7 @@ namespace JSBSim {
 
 class Element;
 class FGExternalForce;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -139,6 +140,7 @@ public:
   ~FGExternalReactions(void);
 
   bool InitModel(void);
+  void SerializeState(FGStateArchive& ar);
 
   /** Sum all the constituent forces for this cycle.
       Can pass in a value indicating if the executive is directing the simulation to Hold.
@@ -38,11 +38,10 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include <fstream>
-#include <sstream>
-#include <iomanip>
 
 #include "FGFCS.h"
 #include "FGFDMExec.h"
+#include "FGProfiler.h"
 #include "FGGroundReactions.h"
 #include "input_output/FGXMLElement.h"
 #include "input_output/FGModelLoader.h"
@@ -65,6 +64,8 @@ INCLUDES
 #include "models/flight_control/FGDistributor.h"
 
 #include "FGFCSChannel.h"
+#include "input_output/FGStateArchive.h"
+#include "input_output/FGTextBuffer.h"
 
 using namespace std;
 
@@ -173,7 +174,9 @@ bool FGFCS::Run(bool Holding)
   for (i=0; i<PropFeather.size(); i++) PropFeather[i] = PropFeatherCmd[i];
 
   // Execute system channels in order
+  FGProfiler* Profiler = FDMExec->GetProfiler();
   for (i=0; i<SystemChannels.size(); i++) {
+    FGProfiler::Timer timer(Profiler, ChannelSections[i]);
     if (debug_lvl & 4) cout << "    Executing System Channel: " << SystemChannels[i]->GetName() << endl;
     ChannelRate = SystemChannels[i]->GetRate();
     SystemChannels[i]->Execute();
@@ -525,6 +528,9 @@ bool FGFCS::Load(Element* document)
       newChannel = new FGFCSChannel(this, sChannelName, Rate);
 
     SystemChannels.push_back(newChannel);
+    ChannelSections.push_back(FDMExec->GetProfiler()->AddSection("systems/"
+                              + document->GetAttributeValue("name") + "/"
+                              + sChannelName));
 
     if (debug_lvl > 0)
       cout << endl << highint << fgblue << "    Channel " 
@@ -588,7 +594,7 @@ bool FGFCS::Load(Element* document)
     channel_element = document->FindNextElement("channel");
   }
 
-  PostLoad(document, PropertyManager);
+  PostLoad(document, FDMExec);
 
   return true;
 }
@@ -640,7 +646,7 @@ string FGFCS::GetComponentStrings(const string& delimiter) const
 
 string FGFCS::GetComponentValues(const string& delimiter) const
 {
-  std::ostringstream buf;
+  FGTextBuffer buf;
 
   bool firstime = true;
   int total_count=0;
@@ -652,12 +658,12 @@ string FGFCS::GetComponentValues(const string& delimiter) const
       if (firstime) firstime = false;
       else          buf << delimiter;
 
-      buf << setprecision(9) << SystemChannels[i]->GetComponent(c)->GetOutput();
+      buf.Append(SystemChannels[i]->GetComponent(c)->GetOutput(), 9);
       total_count++;
     }
   }
 
-  return buf.str();
+  return buf.GetString();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -688,15 +694,15 @@ double FGFCS::GetDt(void) const
 
 void FGFCS::bind(void)
 {
-  PropertyManager->Tie("fcs/aileron-cmd-norm", this, &FGFCS::GetDaCmd, &FGFCS::SetDaCmd);
-  PropertyManager->Tie("fcs/elevator-cmd-norm", this, &FGFCS::GetDeCmd, &FGFCS::SetDeCmd);
-  PropertyManager->Tie("fcs/rudder-cmd-norm", this, &FGFCS::GetDrCmd, &FGFCS::SetDrCmd);
-  PropertyManager->Tie("fcs/flap-cmd-norm", this, &FGFCS::GetDfCmd, &FGFCS::SetDfCmd);
-  PropertyManager->Tie("fcs/speedbrake-cmd-norm", this, &FGFCS::GetDsbCmd, &FGFCS::SetDsbCmd);
-  PropertyManager->Tie("fcs/spoiler-cmd-norm", this, &FGFCS::GetDspCmd, &FGFCS::SetDspCmd);
-  PropertyManager->Tie("fcs/pitch-trim-cmd-norm", this, &FGFCS::GetPitchTrimCmd, &FGFCS::SetPitchTrimCmd);
-  PropertyManager->Tie("fcs/roll-trim-cmd-norm", this, &FGFCS::GetRollTrimCmd, &FGFCS::SetRollTrimCmd);
-  PropertyManager->Tie("fcs/yaw-trim-cmd-norm", this, &FGFCS::GetYawTrimCmd, &FGFCS::SetYawTrimCmd);
+  PropertyManager->Tie("fcs/aileron-cmd-norm", this, &FGFCS::DaCmd, &FGFCS::SetDaCmd);
+  PropertyManager->Tie("fcs/elevator-cmd-norm", this, &FGFCS::DeCmd, &FGFCS::SetDeCmd);
+  PropertyManager->Tie("fcs/rudder-cmd-norm", this, &FGFCS::DrCmd, &FGFCS::SetDrCmd);
+  PropertyManager->Tie("fcs/flap-cmd-norm", this, &FGFCS::DfCmd, &FGFCS::SetDfCmd);
+  PropertyManager->Tie("fcs/speedbrake-cmd-norm", this, &FGFCS::DsbCmd, &FGFCS::SetDsbCmd);
+  PropertyManager->Tie("fcs/spoiler-cmd-norm", this, &FGFCS::DspCmd, &FGFCS::SetDspCmd);
+  PropertyManager->Tie("fcs/pitch-trim-cmd-norm", this, &FGFCS::PTrimCmd, &FGFCS::SetPitchTrimCmd);
+  PropertyManager->Tie("fcs/roll-trim-cmd-norm", this, &FGFCS::RTrimCmd, &FGFCS::SetRollTrimCmd);
+  PropertyManager->Tie("fcs/yaw-trim-cmd-norm", this, &FGFCS::YTrimCmd, &FGFCS::SetYawTrimCmd);
 
   PropertyManager->Tie("fcs/left-aileron-pos-rad", this, ofRad, &FGFCS::GetDaLPos, &FGFCS::SetDaLPos);
   PropertyManager->Tie("fcs/left-aileron-pos-deg", this, ofDeg, &FGFCS::GetDaLPos, &FGFCS::SetDaLPos);
@@ -732,14 +738,14 @@ void FGFCS::bind(void)
   PropertyManager->Tie("fcs/spoiler-pos-norm", this, ofNorm, &FGFCS::GetDspPos, &FGFCS::SetDspPos);
   PropertyManager->Tie("fcs/mag-spoiler-pos-rad", this, ofMag, &FGFCS::GetDspPos);
 
-  PropertyManager->Tie("gear/gear-pos-norm", this, &FGFCS::GetGearPos, &FGFCS::SetGearPos);
-  PropertyManager->Tie("gear/gear-cmd-norm", this, &FGFCS::GetGearCmd, &FGFCS::SetGearCmd);
+  PropertyManager->Tie("gear/gear-pos-norm", this, &FGFCS::GearPos, &FGFCS::SetGearPos);
+  PropertyManager->Tie("gear/gear-cmd-norm", this, &FGFCS::GearCmd, &FGFCS::SetGearCmd);
   PropertyManager->Tie("fcs/left-brake-cmd-norm", this, &FGFCS::GetLBrake, &FGFCS::SetLBrake);
   PropertyManager->Tie("fcs/right-brake-cmd-norm", this, &FGFCS::GetRBrake, &FGFCS::SetRBrake);
   PropertyManager->Tie("fcs/center-brake-cmd-norm", this, &FGFCS::GetCBrake, &FGFCS::SetCBrake);
 
-  PropertyManager->Tie("gear/tailhook-pos-norm", this, &FGFCS::GetTailhookPos, &FGFCS::SetTailhookPos);
-  PropertyManager->Tie("fcs/wing-fold-pos-norm", this, &FGFCS::GetWingFoldPos, &FGFCS::SetWingFoldPos);
+  PropertyManager->Tie("gear/tailhook-pos-norm", this, &FGFCS::TailhookPos, &FGFCS::SetTailhookPos);
+  PropertyManager->Tie("fcs/wing-fold-pos-norm", this, &FGFCS::WingFoldPos, &FGFCS::SetWingFoldPos);
   PropertyManager->Tie("simulation/channel-dt", this, &FGFCS::GetChannelDeltaT);
 }
 
@@ -777,6 +783,29 @@ void FGFCS::bindThrottle(unsigned int num)
                                         &FGFCS::SetPropFeather);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFCS::SerializeState(FGStateArchive& ar)
+{
+  FGModel::SerializeState(ar);
+
+  ar & DaCmd & DeCmd & DrCmd & DfCmd & DsbCmd & DspCmd;
+  ar.Array(DePos, NForms);
+  ar.Array(DaLPos, NForms);
+  ar.Array(DaRPos, NForms);
+  ar.Array(DrPos, NForms);
+  ar.Array(DfPos, NForms);
+  ar.Array(DsbPos, NForms);
+  ar.Array(DspPos, NForms);
+  ar & PTrimCmd & YTrimCmd & RTrimCmd;
+  ar & ThrottleCmd & ThrottlePos & MixtureCmd & MixturePos & PropAdvanceCmd
+     & PropAdvance & PropFeatherCmd & PropFeather & BrakePos;
+  ar & GearCmd & GearPos & TailhookPos & WingFoldPos;
+
+  for (unsigned int i=0; i<SystemChannels.size(); i++)
+    SystemChannels[i]->SerializeState(ar);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -59,6 +59,7 @@ FORWARD DECLARATIONS
 namespace JSBSim {
 
 class FGFCSChannel;
+class FGStateArchive;
 typedef enum { ofRad=0, ofDeg, ofNorm, ofMag , NForms} OutputForm;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -201,6 +202,7 @@ public:
   ~FGFCS();
 
   bool InitModel(void);
+  void SerializeState(FGStateArchive& ar);
 
   /** Runs the Flight Controls model; called by the Executive
       Can pass in a value indicating if the executive is directing the simulation to Hold.
@@ -577,6 +579,7 @@ private:
 
   typedef std::vector <FGFCSChannel*> Channels;
   Channels SystemChannels;
+  std::vector<unsigned int> ChannelSections; // Profiler sections of the channels
   void bind(void);
   void bindThrottle(unsigned int);
   void Debug(int from);
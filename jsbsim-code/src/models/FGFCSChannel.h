@@ -40,6 +40,9 @@ INCLUDES
 
 #include <iostream>
 
+#include "input_output/FGPropertyProfiler.h"
+#include "input_output/FGStateArchive.h"
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -138,12 +141,19 @@ public:
     // channel will be run at rate 1 if trimming, or when the next execrate
     // frame is reached
     if (fcs->GetTrimStatus() || ExecFrameCountSinceLastRun >= ExecRate) {
+      FGPropertyProfiler::Scope scope(FGPropertyProfiler::ecFCSComponent);
       for (unsigned int i=0; i<FCSComponents.size(); i++) 
         FCSComponents[i]->Run();
     }
   }
   /// Get the channel rate
   int GetRate(void) const { return ExecRate; }
+  /// Saves or restores the frame counter and the state of the components.
+  void SerializeState(FGStateArchive& ar) {
+    ar & ExecFrameCountSinceLastRun;
+    for (unsigned int i=0; i<FCSComponents.size(); i++)
+      FCSComponents[i]->SerializeState(ar);
+  }
 
   private:
     FGFCS* fcs;
@@ -39,6 +39,7 @@ INCLUDES
 #include "models/FGMassBalance.h"
 #include "FGGasCell.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
 #include <iostream>
 #include <cstdlib>
 
@@ -223,7 +224,7 @@ FGGasCell::FGGasCell(FGFDMExec* exec, Element* el, unsigned int num,
   if (Element* heat = el->FindElement("heat")) {
     Element* function_element = heat->FindElement("function");
     while (function_element) {
-      HeatTransferCoeff.push_back(new FGFunction(PropertyManager,
+      HeatTransferCoeff.push_back(new FGFunction(exec,
                                                  function_element));
       function_element = heat->FindNextElement("function");
     }
@@ -430,6 +431,19 @@ void FGGasCell::Calculate(double dt)
   }
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGGasCell::SerializeState(FGStateArchive& ar)
+{
+  FGForce::SerializeState(ar);
+
+  ar & Pressure & Contents & Volume & dVolumeIdeal & Temperature & Buoyancy
+     & ValveOpen & Mass & gasCellJ & gasCellM;
+
+  for (unsigned int i=0; i<Ballonet.size(); i++)
+    Ballonet[i]->SerializeState(ar);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -659,7 +673,7 @@ FGBallonet::FGBallonet(FGFDMExec* exec, Element* el, unsigned int num,
   if (Element* heat = el->FindElement("heat")) {
     Element* function_element = heat->FindElement("function");
     while (function_element) {
-      HeatTransferCoeff.push_back(new FGFunction(PropertyManager,
+      HeatTransferCoeff.push_back(new FGFunction(exec,
                                                  function_element));
       function_element = heat->FindNextElement("function");
     }
@@ -667,7 +681,7 @@ FGBallonet::FGBallonet(FGFDMExec* exec, Element* el, unsigned int num,
   // Read blower input function
   if (Element* blower = el->FindElement("blower_input")) {
     Element* function_element = blower->FindElement("function");
-    BlowerInput = new FGFunction(PropertyManager,
+    BlowerInput = new FGFunction(exec,
                                  function_element);
   }
 }
@@ -784,6 +798,14 @@ void FGBallonet::Calculate(double dt)
   ballonetJ += MassBalance->GetPointmassInertia(GetMass(), GetXYZ());
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGBallonet::SerializeState(FGStateArchive& ar)
+{
+  ar & Pressure & Contents & Volume & dVolumeIdeal & dU & Temperature
+     & ValveOpen & ballonetJ;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -60,6 +60,7 @@ namespace JSBSim {
 
 class FGBallonet;
 class FGMassBalance;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -190,6 +191,8 @@ public:
   /** Runs the gas cell model; called by BuoyantForces
    */
   void Calculate(double dt);
+  /// Saves or restores the gas contents of the cell and of its ballonets.
+  void SerializeState(FGStateArchive& ar);
 
   /** Get the index of this gas cell
       @return gas cell index. */
@@ -316,6 +319,8 @@ public:
    */
   void Calculate(double dt);
 
+  /// Saves or restores the air contents of the ballonet.
+  void SerializeState(FGStateArchive& ar);
 
   /** Get the center of gravity location of the ballonet
       @return CoG location in the structural frame in inches. */
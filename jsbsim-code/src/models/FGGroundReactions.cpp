@@ -43,6 +43,8 @@ INCLUDES
 #include "FGAccelerations.h"
 #include "input_output/FGPropertyManager.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
+#include "input_output/FGTextBuffer.h"
 
 using namespace std;
 
@@ -171,7 +173,7 @@ bool FGGroundReactions::Load(Element* document)
 
   for (unsigned int i=0; i<lGear.size();i++) lGear[i]->bind();
 
-  PostLoad(document, PropertyManager);
+  PostLoad(document, FDMExec);
 
   return true;
 }
@@ -221,30 +223,28 @@ string FGGroundReactions::GetGroundReactionStrings(string delimeter) const
 
 string FGGroundReactions::GetGroundReactionValues(string delimeter) const
 {
-  std::ostringstream buf;
+  FGTextBuffer buf;
 
   for (unsigned int i=0;i<lGear.size();i++) {
-    if (lGear[i]->IsBogey()) {
-      FGLGear *gear = lGear[i];
-      buf << (gear->GetWOW() ? "1" : "0") << delimeter
-          << setprecision(5) << gear->GetCompLen() << delimeter
-          << setprecision(6) << gear->GetCompVel() << delimeter
-          << setprecision(10) << gear->GetCompForce() << delimeter
-          << gear->GetWheelSideForce() << delimeter
+    FGLGear *gear = lGear[i];
+    buf << (gear->GetWOW() ? "1" : "0") << delimeter;
+    buf.Append(gear->GetCompLen(), 5);
+    buf << delimeter;
+    buf.Append(gear->GetCompVel(), 6);
+    buf << delimeter;
+    buf.SetPrecision(10);
+    buf << gear->GetCompForce() << delimeter;
+    if (gear->IsBogey()) {
+      buf << gear->GetWheelSideForce() << delimeter
           << gear->GetWheelRollForce() << delimeter
           << gear->GetBodyXForce() << delimeter
-          << gear->GetBodyYForce() << delimeter
-          << setprecision(6) << gear->GetWheelVel(eX) << delimeter
+          << gear->GetBodyYForce() << delimeter;
+      buf.SetPrecision(6);
+      buf << gear->GetWheelVel(eX) << delimeter
           << gear->GetWheelVel(eY) << delimeter
           << gear->GetWheelRollVel() << delimeter
           << gear->GetWheelSideVel() << delimeter
           << gear->GetWheelSlipAngle() << delimeter;
-    } else {
-      FGLGear *gear = lGear[i];
-      buf << (gear->GetWOW() ? "1" : "0") << delimeter
-          << setprecision(5) << gear->GetCompLen() << delimeter
-          << setprecision(6) << gear->GetCompVel() << delimeter
-          << setprecision(10) << gear->GetCompForce() << delimeter;
     }
   }
 
@@ -257,7 +257,7 @@ string FGGroundReactions::GetGroundReactionValues(string delimeter) const
       << Accelerations->GetGroundMoments(eY) << delimeter
       << Accelerations->GetGroundMoments(eZ);
 
-  return buf.str();
+  return buf.GetString();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -269,10 +269,26 @@ void FGGroundReactions::bind(void)
 
   PropertyManager->Tie("gear/num-units", this, &FGGroundReactions::GetNumGearUnits);
   PropertyManager->Tie("gear/wow", this, &FGGroundReactions::GetWOW);
-  PropertyManager->Tie("fcs/steer-cmd-norm", this, &FGGroundReactions::GetDsCmd,
+  PropertyManager->Tie("fcs/steer-cmd-norm", this, &FGGroundReactions::DsCmd,
                        &FGGroundReactions::SetDsCmd);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGGroundReactions::SerializeState(FGStateArchive& ar)
+{
+  FGModel::SerializeState(ar);
+
+  for (unsigned int i=0; i<lGear.size(); i++)
+    lGear[i]->SerializeState(ar);
+
+  ar & vForces & vMoments & DsCmd;
+  ar & in.Vground & in.VcalibratedKts & in.Temperature & in.DistanceAGL
+     & in.DistanceASL & in.TotalDeltaT & in.TakeoffThrottle & in.WOW;
+  ar & in.Tb2l & in.Tec2l & in.Tec2b & in.PQR & in.UVW & in.vXYZcg
+     & in.Location & in.BrakePos & in.FCSGearPos & in.EmptyWeight;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
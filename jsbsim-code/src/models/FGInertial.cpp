@@ -37,6 +37,7 @@ INCLUDES
 
 #include "FGInertial.h"
 #include "FGFDMExec.h"
+#include "input_output/FGStateArchive.h"
 #include <iostream>
 
 using namespace std;
@@ -153,7 +154,17 @@ FGColumnVector3 FGInertial::GetGravityJ2(const FGColumnVector3& position) const
 
 void FGInertial::bind(void)
 {
-  PropertyManager->Tie("inertial/sea-level-radius_ft", this, &FGInertial::GetRefRadius);
+  PropertyManager->Tie("inertial/sea-level-radius_ft", this, &FGInertial::RadiusReference);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGInertial::SerializeState(FGStateArchive& ar)
+{
+  FGModel::SerializeState(ar);
+
+  ar & vOmegaPlanet & gAccel;
+  ar & in.Radius & in.Latitude;
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
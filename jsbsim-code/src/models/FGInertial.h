@@ -55,6 +55,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGStateArchive;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -74,6 +76,7 @@ public:
   ~FGInertial(void);
 
   bool InitModel(void);
+  void SerializeState(FGStateArchive& ar);
 
   /** Runs the Inertial model; called by the Executive
       Can pass in a value indicating if the executive is directing the simulation to Hold.
@@ -90,7 +90,7 @@ bool FGInput::Load(Element* el)
 
   if (!element) return false;
   
-  FGModel::PreLoad(element, PropertyManager);
+  FGModel::PreLoad(element, FDMExec);
 
   size_t idx = InputTypes.size();
   string type = element->GetAttributeValue("type");
@@ -113,7 +113,7 @@ bool FGInput::Load(Element* el)
 
   Input->SetIdx(idx);
   Input->Load(element);
-  PostLoad(element, PropertyManager);
+  PostLoad(element, FDMExec);
 
   InputTypes.push_back(Input);
 
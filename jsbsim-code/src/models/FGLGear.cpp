@@ -48,6 +48,7 @@ INCLUDES
 #include "models/FGGroundReactions.h"
 #include "math/FGTable.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -114,7 +115,7 @@ FGLGear::FGLGear(Element* el, FGFDMExec* fdmex, int number, const struct Inputs&
   Element* strutForce = el->FindElement("strut_force");
   if (strutForce) {
     Element* springFunc = strutForce->FindElement("function");
-    fStrutForce = new FGFunction(PropertyManager, springFunc);
+    fStrutForce = new FGFunction(fdmex, springFunc);
   }
   else {
     if (el->FindElement("spring_coeff"))
@@ -533,7 +534,7 @@ void FGLGear::ReportTakeoffOrLanding(void)
   {
     ostringstream buf;
     buf << "GEAR_CONTACT: " << fdmex->GetSimTime() << " seconds: " << name;
-    PutMessage(buf.str(), WOW);
+    fdmex->PutMessage(buf.str(), WOW);
   }
 }
 
@@ -549,7 +550,7 @@ void FGLGear::CrashDetect(void)
   {
     ostringstream buf;
     buf << "*CRASH DETECTED* " << fdmex->GetSimTime() << " seconds: " << name;
-    PutMessage(buf.str());
+    fdmex->PutMessage(buf.str());
     // fdmex->SuspendIntegration();
   }
 }
@@ -869,6 +870,27 @@ void FGLGear::Report(ReportType repType)
   }
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGLGear::SerializeState(FGStateArchive& ar)
+{
+  FGForce::SerializeState(ar);
+
+  ar & mTGear & vLocalGear & vWhlVelVec & vGroundWhlVel & vGroundNormal;
+  ar & SteerAngle & compressLength & compressSpeed & rollingFCoeff
+     & Stiffness & Shape & Peak & Curvature & BrakeFCoeff & maxCompLen
+     & SinkRate & GroundSpeed & TakeoffDistanceTraveled & TakeoffDistanceTraveled50ft
+     & LandingDistanceTraveled & MaximumStrutForce & StrutForce
+     & MaximumStrutTravel & FCoeff & WheelSlip & GearPos;
+  ar & WOW & lastWOW & FirstContact & StartedGroundRun & LandingReported
+     & TakeoffReported & ReportEnable & StaticFriction & useFCSGearPos;
+
+  for (unsigned int i=0; i<3; i++) {
+    LagrangeMultiplier& lm = LMultiplier[i];
+    ar & lm.ForceJacobian & lm.MomentJacobian & lm.Min & lm.Max & lm.value;
+  }
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -60,6 +60,7 @@ namespace JSBSim {
 class FGTable;
 class Element;
 class FGPropertyManager;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -324,6 +325,8 @@ public:
   const struct Inputs& in;
 
   void ResetToIC(void);
+  /// Saves or restores the strut compression and the contact state.
+  void SerializeState(FGStateArchive& ar);
   void bind(void);
 
 private:
@@ -46,6 +46,7 @@ INCLUDES
 #include "FGFDMExec.h"
 #include "input_output/FGPropertyManager.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -168,7 +169,7 @@ bool FGMassBalance::Load(Element* document)
 
   Mass = lbtoslug*Weight;
 
-  PostLoad(document, PropertyManager);
+  PostLoad(document, FDMExec);
 
   Debug(2);
   return true;
@@ -391,11 +392,11 @@ void FGMassBalance::bind(void)
 {
   typedef double (FGMassBalance::*PMF)(int) const;
   PropertyManager->Tie("inertia/mass-slugs", this,
-                       &FGMassBalance::GetMass);
+                       &FGMassBalance::Mass);
   PropertyManager->Tie("inertia/weight-lbs", this,
-                       &FGMassBalance::GetWeight);
+                       &FGMassBalance::Weight);
   PropertyManager->Tie("inertia/empty-weight-lbs", this,
-                       &FGMassBalance::GetEmptyWeight);
+                       &FGMassBalance::EmptyWeight);
   PropertyManager->Tie("inertia/cg-x-in", this,1,
                        (PMF)&FGMassBalance::GetXYZcg);
   PropertyManager->Tie("inertia/cg-y-in", this,2,
@@ -485,6 +486,25 @@ void FGMassBalance::GetMassPropertiesReport(int i)
   cout.setf(ios_base::fixed);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGMassBalance::SerializeState(FGStateArchive& ar)
+{
+  FGModel::SerializeState(ar);
+
+  ar & Weight & EmptyWeight & Mass;
+  ar & mJ & mJinv & pmJ & baseJ;
+  ar & vXYZcg & vLastXYZcg & vDeltaXYZcg & vDeltaXYZcgBody & vXYZtank
+     & vbaseXYZcg & vPMxyz & PointMassCG;
+
+  for (unsigned int i=0; i<PointMasses.size(); i++) {
+    PointMass* pm = PointMasses[i];
+    ar & pm->Location & pm->Weight & pm->mPMInertia;
+  }
+  ar & in.GasMass & in.TanksWeight & in.GasMoment & in.GasInertia
+     & in.TanksMoment & in.TankInertia;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
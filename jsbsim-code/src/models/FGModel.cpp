@@ -41,6 +41,7 @@ INCLUDES
 #include "FGModel.h"
 #include "FGFDMExec.h"
 #include "input_output/FGModelLoader.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -103,6 +104,14 @@ bool FGModel::Run(bool Holding)
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
+void FGModel::SerializeState(FGStateArchive& ar)
+{
+  FGModelFunctions::SerializeState(ar);
+  ar & exe_ctr;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 SGPath FGModel::FindFullPathName(const SGPath& path) const
 {
   return CheckPathName(FDMExec->GetFullAircraftPath(), path);
@@ -127,7 +136,7 @@ bool FGModel::Load(Element* el, bool preLoad)
   bool result = true;
 
   if (preLoad)
-    result = FGModelFunctions::Load(document, PropertyManager);
+    result = FGModelFunctions::Load(document, FDMExec);
 
   if (document != el) {
     el->MergeAttributes(document);
@@ -140,9 +149,11 @@ bool FGModel::Load(Element* el, bool preLoad)
       LocalProperties.Load(el, PropertyManager, true);
     }
 
+    // The children of a cached document may already have been merged in
+    // this element by a previous load.
     Element* element = document->FindElement();
     while (element) {
-      el->AddChildElement(element);
+      if (!el->HasChildElement(element)) el->AddChildElement(element);
       element->SetParent(el);
       element = document->FindNextElement();
     }
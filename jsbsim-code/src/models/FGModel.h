@@ -58,6 +58,7 @@ namespace JSBSim {
 class FGFDMExec;
 class Element;
 class FGPropertyManager;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -94,11 +95,17 @@ public:
   virtual bool Run(bool Holding);
 
   virtual bool InitModel(void);
+
+  /** Saves or restores the state of the model.
+      @param ar the archive from/to which the state is read/written.
+      @see FGFDMExec::SaveState */
+  virtual void SerializeState(FGStateArchive& ar);
+
   /// Set the ouput rate for the model in frames
   void SetRate(unsigned int tt) {rate = tt;}
   /// Get the output rate for the model in frames
   unsigned int GetRate(void)   {return rate;}
-  FGFDMExec* GetExec(void)     {return FDMExec;}
+  FGFDMExec* GetExec(void) const {return FDMExec;}
 
   void SetPropertyManager(FGPropertyManager *fgpm) { PropertyManager=fgpm;}
   virtual SGPath FindFullPathName(const SGPath& path) const;
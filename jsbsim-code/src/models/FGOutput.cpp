@@ -41,8 +41,11 @@ INCLUDES
 
 #include "FGOutput.h"
 #include "FGFDMExec.h"
+#include "FGProfiler.h"
+#include "input_output/FGPropertyProfiler.h"
 #include "input_output/FGOutputSocket.h"
 #include "input_output/FGOutputTextFile.h"
+#include "input_output/FGOutputBinaryFile.h"
 #include "input_output/FGOutputFG.h"
 #include "input_output/FGXMLFileRead.h"
 #include "input_output/FGXMLElement.h"
@@ -107,9 +110,20 @@ bool FGOutput::Run(bool Holding)
   if (Holding) return false;
   if (!enabled) return true;
 
-  vector<FGOutputType*>::iterator it;
-  for (it = OutputTypes.begin(); it != OutputTypes.end(); ++it)
-    (*it)->Run();
+  FGProfiler* Profiler = FDMExec->GetProfiler();
+
+  // The outputs can be added or renamed until the simulation starts so their
+  // sections are registered when they are first run.
+  for (size_t i = OutputSections.size(); i < OutputTypes.size(); i++)
+    OutputSections.push_back(Profiler->AddSection("output/"
+                                          + OutputTypes[i]->GetOutputName()));
+
+  FGPropertyProfiler::Scope scope(FGPropertyProfiler::ecOutput);
+
+  for (size_t i = 0; i < OutputTypes.size(); i++) {
+    FGProfiler::Timer timer(Profiler, OutputSections[i]);
+    OutputTypes[i]->Run();
+  }
 
   return false;
 }
@@ -120,7 +134,7 @@ void FGOutput::Print(void)
 {
   vector<FGOutputType*>::iterator it;
   for (it = OutputTypes.begin(); it != OutputTypes.end(); ++it)
-    (*it)->Print();
+    (*it)->Generate();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -156,7 +170,7 @@ void FGOutput::SetRateHz(double rate)
 void FGOutput::ForceOutput(int idx)
 {
   if (idx >= (int)0 && idx < (int)OutputTypes.size())
-    OutputTypes[idx]->Print();
+    OutputTypes[idx]->Generate();
 }
 
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -215,6 +229,8 @@ bool FGOutput::Load(int subSystems, std::string protocol, std::string type,
     FGOutputTextFile* OutputTextFile = new FGOutputTextFile(FDMExec);
     OutputTextFile->SetDelimiter("\t");
     Output = OutputTextFile;
+  } else if (type == "BINARY") {
+    Output = new FGOutputBinaryFile(FDMExec);
   } else if (type == "SOCKET") {
     Output = new FGOutputSocket(FDMExec);
     name += ":" + port + "/" + protocol;
@@ -259,7 +275,7 @@ bool FGOutput::Load(Element* document, const SGPath& dir)
 
     if (fType == "template") {
       string name = function->GetAttributeValue("name");
-      TemplateFunctions[name] = new FGTemplateFunc(PropertyManager, function);
+      TemplateFunctions[name] = new FGTemplateFunc(FDMExec, function);
     }
 
     function = document->FindNextElement("function");
@@ -277,6 +293,8 @@ bool FGOutput::Load(Element* document, const SGPath& dir)
     Output = new FGOutputTextFile(FDMExec);
   } else if (type == "TABULAR") {
     Output = new FGOutputTextFile(FDMExec);
+  } else if (type == "BINARY") {
+    Output = new FGOutputBinaryFile(FDMExec);
   } else if (type == "SOCKET") {
     Output = new FGOutputSocket(FDMExec);
   } else if (type == "FLIGHTGEAR") {
@@ -290,9 +308,9 @@ bool FGOutput::Load(Element* document, const SGPath& dir)
   if (!Output) return false;
 
   Output->SetIdx(idx);
-  Output->PreLoad(document, PropertyManager);
+  Output->PreLoad(document, FDMExec);
   Output->Load(document);
-  Output->PostLoad(document, PropertyManager);
+  Output->PostLoad(document, FDMExec);
 
   OutputTypes.push_back(Output);
 
@@ -79,6 +79,9 @@ CLASS DOCUMENTATION
                   an external instance of FlightGear for visuals.  Parameters
                   defining the socket are given on the \<output> line.
       TABULAR     Columnar data.
+      BINARY      Fixed size records of raw values preceded by a header which
+                  describes them. Only the properties and the functions are
+                  written. See FGOutputBinaryFile.
       TERMINAL    Output to terminal. NOT IMPLEMENTED YET!
       NONE        Specifies to do nothing. This setting makes it easy to turn on and
                   off the data output without having to mess with anything else.
@@ -235,6 +238,7 @@ public:
 
 private:
   std::vector<FGOutputType*> OutputTypes;
+  std::vector<unsigned int> OutputSections; // Profiler sections of the outputs
   std::map<std::string, FGTemplateFunc_ptr> TemplateFunctions;
   bool enabled;
   SGPath includePath;
@@ -74,6 +74,7 @@ INCLUDES
 #include "FGFDMExec.h"
 #include "input_output/FGPropertyManager.h"
 #include "simgear/io/iostreams/sgstream.hxx"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -124,6 +125,7 @@ bool FGPropagate::InitModel(void)
 
   // For initialization ONLY:
   VState.vLocation.SetEllipse(in.SemiMajor, in.SemiMinor);
+  VState.vLocation.SetGroundCallback(FDMExec->GetGroundCallback());
   VState.vLocation.SetAltitudeAGL(4.0);
 
   VState.dqPQRidot.resize(5, FGColumnVector3(0.0,0.0,0.0));
@@ -578,6 +580,9 @@ void FGPropagate::SetVState(const VehicleState& vstate)
 {
   //ToDo: Shouldn't all of these be set from the vstate vector passed in?
   VState.vLocation = vstate.vLocation;
+  // The state may come from another FDM (a child FDM for instance) in which
+  // case the location must still query the terrain of this FDM.
+  VState.vLocation.SetGroundCallback(FDMExec->GetGroundCallback());
   Ti2ec = VState.vLocation.GetTi2ec(); // useless ?
   Tec2i = Ti2ec.Transposed();
   UpdateLocationMatrices();
@@ -608,6 +613,7 @@ void FGPropagate::UpdateVehicleState(void)
 void FGPropagate::SetLocation(const FGLocation& l)
 {
   VState.vLocation = l;
+  VState.vLocation.SetGroundCallback(FDMExec->GetGroundCallback());
   Ti2ec = VState.vLocation.GetTi2ec(); // useless ?
   Tec2i = Ti2ec.Transposed();
   UpdateVehicleState();
@@ -815,6 +821,27 @@ void FGPropagate::bind(void)
   PropertyManager->Tie("simulation/write-state-file", this, (iPMF)0, &FGPropagate::WriteStateFile);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropagate::SerializeState(FGStateArchive& ar)
+{
+  FGModel::SerializeState(ar);
+
+  ar & VState.vLocation & VState.vUVW & VState.vPQR & VState.vPQRi
+     & VState.qAttitudeLocal & VState.qAttitudeECI & VState.vQtrndot
+     & VState.vInertialVelocity & VState.vInertialPosition;
+  ar & VState.dqPQRidot & VState.dqUVWidot & VState.dqInertialVelocity
+     & VState.dqQtrndot;
+
+  // The matrices are stored rather than recomputed so that they are restored
+  // bit for bit.
+  ar & vVel & Tec2b & Tb2ec & Tl2b & Tb2l & Tl2ec & Tec2l & Tec2i & Ti2ec
+     & Ti2b & Tb2i & Ti2l & Tl2i & Qec2b;
+  ar & LocalTerrainVelocity & LocalTerrainAngularVelocity;
+  ar & in.vPQRidot & in.vUVWidot & in.vOmegaPlanet & in.SemiMajor
+     & in.SemiMinor & in.DeltaT;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -58,6 +58,7 @@ FORWARD DECLARATIONS
 namespace JSBSim {
 
 class FGInitialCondition;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -166,6 +167,8 @@ public:
       The base class FGModel::InitModel is called first, initializing pointers to the
       other FGModel objects (and others).  */
   bool InitModel(void);
+  /// Saves or restores the state vector and the derivatives history.
+  void SerializeState(FGStateArchive& ar);
 
   void InitializeDerivatives();
 
@@ -602,6 +605,14 @@ public:
   */
   void SetHoldDown(bool hd);
 
+  /** Sets the ground callback that the vehicle location interrogates to get
+      its altitude above the sea level and above the terrain.
+      @param gc A pointer to the ground callback object owned by FGFDMExec */
+  void SetGroundCallback(FGGroundCallback* gc)
+  {
+    VState.vLocation.SetGroundCallback(gc);
+  }
+
   void DumpState(void);
 
   struct Inputs {
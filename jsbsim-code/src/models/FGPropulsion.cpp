@@ -60,6 +60,7 @@ INCLUDES
 #include "models/propulsion/FGTank.h"
 #include "input_output/FGModelLoader.h"
 #include "math/FGColumnVector3.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -456,7 +457,7 @@ bool FGPropulsion::Load(Element* el)
   }
 
 
-  PostLoad(el, PropertyManager);
+  PostLoad(el, FDMExec);
 
   return true;
 }
@@ -787,6 +788,29 @@ void FGPropulsion::bind(void)
   dump = PropertyManager->CreatePropertyObject<bool>("propulsion/fuel_dump");
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPropulsion::SerializeState(FGStateArchive& ar)
+{
+  FGModel::SerializeState(ar);
+
+  for (unsigned int i=0; i<Engines.size(); i++)
+    Engines[i]->SerializeState(ar);
+
+  for (unsigned int i=0; i<Tanks.size(); i++)
+    Tanks[i]->SerializeState(ar);
+
+  ar & numSelectedFuelTanks & numSelectedOxiTanks & ActiveEngine
+     & FuelFreeze & DumpRate & RefuelRate;
+  ar & vForces & vMoments & vTankXYZ & vXYZtank_arm & tankJ;
+  ar & in.Pressure & in.PressureRatio & in.Temperature & in.Density
+     & in.DensityRatio & in.Soundspeed & in.TotalPressure & in.TAT_c & in.Vt
+     & in.Vc & in.qbar & in.alpha & in.beta & in.H_agl & in.AeroUVW
+     & in.AeroPQR & in.PQRi;
+  ar & in.ThrottleCmd & in.MixtureCmd & in.ThrottlePos & in.MixturePos
+     & in.PropAdvance & in.PropFeather & in.TotalDeltaT;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
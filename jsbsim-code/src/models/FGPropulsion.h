@@ -60,6 +60,7 @@ namespace JSBSim {
 
 class FGTank;
 class FGEngine;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -123,6 +124,7 @@ public:
   bool Run(bool Holding);
 
   bool InitModel(void);
+  void SerializeState(FGStateArchive& ar);
 
   /** Loads the propulsion system (engine[s] and tank[s]).
       Characteristics of the propulsion system are read in from the config file.
@@ -47,6 +47,7 @@ INCLUDES
 #include <cstdlib>
 #include "FGFDMExec.h"
 #include "FGStandardAtmosphere.h"
+#include "input_output/FGStateArchive.h"
 
 namespace JSBSim {
 
@@ -461,6 +462,16 @@ void FGStandardAtmosphere::bind(void)
                                    (PMF)&FGStandardAtmosphere::SetPressureSL);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGStandardAtmosphere::SerializeState(FGStateArchive& ar)
+{
+  FGAtmosphere::SerializeState(ar);
+
+  ar & TemperatureBias & TemperatureDeltaGradient & GradientFadeoutAltitude;
+  ar & LapseRateVector & PressureBreakpointVector;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
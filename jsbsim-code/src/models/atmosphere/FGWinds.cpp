@@ -46,6 +46,7 @@ INCLUDES
 #include <cstdlib>
 #include "FGWinds.h"
 #include "FGFDMExec.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -107,6 +108,8 @@ FGWinds::FGWinds(FGFDMExec* fdmex) : FGModel(fdmex)
     << 6   <<  15.6 <<   17.6 <<   23.0 <<   23.6 <<    22.1 <<    20.0 <<    16.0 <<    15.1 <<    12.1 <<     7.9 <<     6.2 <<     5.1
     << 7   <<  18.7 <<   21.5 <<   28.4 <<   30.2 <<    30.7 <<    31.0 <<    25.2 <<    23.1 <<    17.5 <<    10.7 <<     8.4 <<     7.2;
 
+  RandomStream = fdmex->GetRandomStream();
+
   bind();
   Debug(0);
 }
@@ -134,6 +137,12 @@ bool FGWinds::InitModel(void)
   oneMinusCosineGust.gustProfile.Running = false;
   oneMinusCosineGust.gustProfile.elapsedTime = 0.0;
 
+  xi_u_km1 = nu_u_km1 = 0.0;
+  xi_v_km1 = xi_v_km2 = nu_v_km1 = nu_v_km2 = 0.0;
+  xi_w_km1 = xi_w_km2 = nu_w_km1 = nu_w_km2 = 0.0;
+  xi_p_km1 = nu_p_km1 = 0.0;
+  xi_q_km1 = xi_r_km1 = 0.0;
+
   return true;
 }
 
@@ -216,7 +225,7 @@ void FGWinds::Turbulence(double h)
 
     double random = 0.0;
     if (target_time == 0.0) {
-      strength = random = 1 - 2.0*(double(rand())/double(RAND_MAX));
+      strength = random = RandomStream->GetUniformSigned();
       target_time = time + 0.71 + (random * 0.5);
     }
     if (time > target_time) {
@@ -281,15 +290,9 @@ void FGWinds::Turbulence(double h)
       sig_u = sig_w = POE_Table->GetValue(probability_of_exceedence_index, h);
     }
 
-    // keep values from last timesteps
-    // TODO maybe use deque?
-    static double
-      xi_u_km1 = 0, nu_u_km1 = 0,
-      xi_v_km1 = 0, xi_v_km2 = 0, nu_v_km1 = 0, nu_v_km2 = 0,
-      xi_w_km1 = 0, xi_w_km2 = 0, nu_w_km1 = 0, nu_w_km2 = 0,
-      xi_p_km1 = 0, nu_p_km1 = 0,
-      xi_q_km1 = 0, xi_r_km1 = 0;
-
+    // white noise inputs of the filters for u, v, w and p
+    double nu[4];
+    RandomStream->GetNormal(nu, 4);
 
     double
       T_V = in.totalDeltaT, // for compatibility of nomenclature
@@ -302,10 +305,10 @@ void FGWinds::Turbulence(double h)
       tau_p = L_p/in.V, // eq. (9)
       tau_q = 4*b_w/M_PI/in.V, // eq. (13)
       tau_r =3*b_w/M_PI/in.V, // eq. (17)
-      nu_u = GaussianRandomNumber(),
-      nu_v = GaussianRandomNumber(),
-      nu_w = GaussianRandomNumber(),
-      nu_p = GaussianRandomNumber(),
+      nu_u = nu[0],
+      nu_v = nu[1],
+      nu_w = nu[2],
+      nu_p = nu[3],
       xi_u=0, xi_v=0, xi_w=0, xi_p=0, xi_q=0, xi_r=0;
 
     // values of turbulence NED velocities
@@ -568,6 +571,46 @@ void FGWinds::bind(void)
 
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGWinds::SerializeState(FGStateArchive& ar)
+{
+  FGModel::SerializeState(ar);
+
+  int type = turbType;
+  ar & type;
+  turbType = static_cast<tType>(type);
+
+  ar & MagnitudedAccelDt & MagnitudeAccel & Magnitude & TurbDirection
+     & TurbGain & TurbRate & Rhythmicity & wind_from_clockwise & spike
+     & target_time & strength;
+  ar & vTurbulenceGrad & vBodyTurbGrad & vTurbPQR;
+  ar & windspeed_at_20ft & probability_of_exceedence_index;
+  ar & xi_u_km1 & nu_u_km1 & xi_v_km1 & xi_v_km2 & nu_v_km1 & nu_v_km2
+     & xi_w_km1 & xi_w_km2 & nu_w_km1 & nu_w_km2 & xi_p_km1 & nu_p_km1
+     & xi_q_km1 & xi_r_km1;
+  ar & psiw & vTotalWindNED & vWindNED & vGustNED & vCosineGust & vBurstGust
+     & vTurbulenceNED;
+
+  OneMinusCosineProfile& profile = oneMinusCosineGust.gustProfile;
+  ar & oneMinusCosineGust.vWind & oneMinusCosineGust.vWindTransformed
+     & oneMinusCosineGust.magnitude;
+  int frame = oneMinusCosineGust.gustFrame;
+  ar & frame;
+  oneMinusCosineGust.gustFrame = static_cast<eGustFrame>(frame);
+  ar & profile.Running & profile.elapsedTime & profile.startupDuration
+     & profile.steadyDuration & profile.endDuration;
+
+  for (unsigned int i=0; i<UpDownBurstCells.size(); i++) {
+    struct UpDownBurst* cell = UpDownBurstCells[i];
+    ar & cell->ringLatitude & cell->ringLongitude & cell->ringAltitude
+       & cell->ringRadius & cell->ringCoreRadius & cell->circulation;
+    ar & cell->oneMCosineProfile.Running & cell->oneMCosineProfile.elapsedTime;
+  }
+  ar & in.V & in.wingspan & in.DistanceAGL & in.AltitudeASL & in.longitude
+     & in.latitude & in.planetRadius & in.Tl2b & in.Tw2b & in.totalDeltaT;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -42,6 +42,7 @@ INCLUDES
 #include "math/FGColumnVector3.h"
 #include "math/FGMatrix33.h"
 #include "math/FGTable.h"
+#include "math/FGRandom.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 DEFINITIONS
@@ -55,6 +56,8 @@ FORWARD DECLARATIONS
 
 namespace JSBSim {
 
+class FGStateArchive;
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
@@ -132,6 +135,7 @@ public:
       @return false if no error */
   bool Run(bool Holding);
   bool InitModel(void);
+  void SerializeState(FGStateArchive& ar);
   enum tType {ttNone, ttStandard, ttCulp, ttMilspec, ttTustin} turbType;
 
   // TOTAL WIND access functions (wind + gust + turbulence)
@@ -336,6 +340,14 @@ private:
   double windspeed_at_20ft; ///< in ft/s
   int probability_of_exceedence_index; ///< this is bound as the severity property
   FGTable *POE_Table; ///< probability of exceedence table
+  FGRandom_ptr RandomStream;
+
+  // values of the turbulence filters from the last timesteps
+  double xi_u_km1, nu_u_km1;
+  double xi_v_km1, xi_v_km2, nu_v_km1, nu_v_km2;
+  double xi_w_km1, xi_w_km2, nu_w_km1, nu_w_km2;
+  double xi_p_km1, nu_p_km1;
+  double xi_q_km1, xi_r_km1;
 
   double psiw;
   FGColumnVector3 vTotalWindNED;
@@ -46,6 +46,7 @@ INCLUDES
 #include "models/FGMassBalance.h"
 #include "input_output/FGXMLElement.h"
 #include "models/FGFCS.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -107,6 +108,15 @@ bool FGAccelerometer::Run(void )
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGAccelerometer::SerializeState(FGStateArchive& ar)
+{
+  FGSensor::SerializeState(ar);
+
+  ar & vAccel;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
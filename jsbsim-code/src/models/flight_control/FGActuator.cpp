@@ -43,6 +43,7 @@ INCLUDES
 #include "input_output/FGXMLElement.h"
 #include "math/FGRealValue.h"
 #include "models/FGFCS.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -298,6 +299,18 @@ void FGActuator::bind(void)
   PropertyManager->Tie( tmp_sat, this, &FGActuator::IsSaturated);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGActuator::SerializeState(FGStateArchive& ar)
+{
+  FGFCSComponent::SerializeState(ar);
+
+  ar & bias & hysteresis_width & deadband_width & lag & ca & cb;
+  ar & PreviousOutput & PreviousHystOutput & PreviousRateLimOutput
+     & PreviousLagInput & PreviousLagOutput;
+  ar & fail_zero & fail_hardover & fail_stuck & initialized & saturated;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -44,6 +44,7 @@ INCLUDES
 #include "input_output/FGXMLElement.h"
 #include "math/FGPropertyValue.h"
 #include "models/FGFCS.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -300,6 +301,13 @@ void FGFCSComponent::bind(void)
   PropertyManager->Tie( tmp, this, &FGFCSComponent::GetOutput);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFCSComponent::SerializeState(FGStateArchive& ar)
+{
+  ar & Input & Output & output_array & index;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -57,6 +57,7 @@ namespace JSBSim {
 
 class FGFCS;
 class Element;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -107,6 +108,8 @@ public:
   std::string GetType(void) const { return Type; }
   virtual double GetOutputPct(void) const { return 0; }
   virtual void ResetPastStates(void);
+  /// Saves or restores the output and the delay buffer of the component.
+  virtual void SerializeState(FGStateArchive& ar);
 
 protected:
   FGFCS* fcs;
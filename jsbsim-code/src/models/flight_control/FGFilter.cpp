@@ -40,6 +40,7 @@ INCLUDES
 #include "FGFilter.h"
 #include "input_output/FGXMLElement.h"
 #include "input_output/FGPropertyManager.h"
+#include "input_output/FGStateArchive.h"
 
 #include <iostream>
 #include <string>
@@ -239,6 +240,18 @@ bool FGFilter::Run(void)
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGFilter::SerializeState(FGStateArchive& ar)
+{
+  FGFCSComponent::SerializeState(ar);
+
+  ar & ca & cb & cc & cd & ce;
+  ar.Array(C, 7);
+  ar & PreviousInput1 & PreviousInput2 & PreviousOutput1 & PreviousOutput2
+     & Initialize;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -54,6 +54,7 @@ namespace JSBSim {
 class Element;
 class FGPropertyManager;
 class FGFCS;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -248,6 +249,7 @@ public:
       is particularly useful for first pass. */
   bool Initialize;
   void ResetPastStates(void);
+  void SerializeState(FGStateArchive& ar);
   
   enum {eLag, eLeadLag, eOrder2, eWashout, eIntegrator, eUnknown} FilterType;
 
@@ -43,6 +43,7 @@ INCLUDES
 #include "models/FGAccelerations.h"
 #include "input_output/FGXMLElement.h"
 #include "models/FGFCS.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -88,6 +89,15 @@ bool FGGyro::Run(void )
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGGyro::SerializeState(FGStateArchive& ar)
+{
+  FGSensor::SerializeState(ar);
+
+  ar & vAccel;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -45,6 +45,7 @@ INCLUDES
 #include "simgear/magvar/coremag.hxx"
 #include "input_output/FGXMLElement.h"
 #include "models/FGFCS.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -143,6 +144,17 @@ bool FGMagnetometer::Run(void )
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGMagnetometer::SerializeState(FGStateArchive& ar)
+{
+  FGSensor::SerializeState(ar);
+
+  ar & vMag;
+  ar.Array(field, 6);
+  ar & usedLat & usedLon & usedAlt & counter;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -58,6 +58,7 @@ FORWARD DECLARATIONS
 namespace JSBSim {
 
 class FGFCS;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -131,6 +132,7 @@ public:
   ~FGMagnetometer();
 
   bool Run (void);
+  void SerializeState(FGStateArchive& ar);
 
 private:
   FGPropagate* Propagate;
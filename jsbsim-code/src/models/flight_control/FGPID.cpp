@@ -37,6 +37,7 @@ INCLUDES
 
 #include "FGPID.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
 #include <string>
 #include <iostream>
 
@@ -230,6 +231,15 @@ bool FGPID::Run(void )
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGPID::SerializeState(FGStateArchive& ar)
+{
+  FGFCSComponent::SerializeState(ar);
+
+  ar & Kp & Ki & Kd & I_out_total & Input_prev & Input_prev2;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -42,6 +42,9 @@ INCLUDES
 
 #include "FGSensor.h"
 #include "input_output/FGXMLElement.h"
+#include "models/FGFCS.h"
+#include "FGFDMExec.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -119,6 +122,7 @@ FGSensor::FGSensor(FGFCS* fcs, Element* element) : FGFCSComponent(fcs, element)
       cerr << "Unknown random distribution type in sensor: " << Name << endl;
       cerr << "  defaulting to UNIFORM." << endl;
     }
+    RandomStream = fcs->GetExec()->GetRandomStream();
   }
 
   FGFCSComponent::bind();
@@ -191,9 +195,9 @@ void FGSensor::Noise(void)
   double random_value=0.0;
 
   if (DistributionType == eUniform) {
-    random_value = 2.0*(((double)rand()/(double)RAND_MAX) - 0.5);
+    random_value = RandomStream->GetUniformSigned();
   } else {
-    random_value = GaussianRandomNumber();
+    random_value = RandomStream->GetNormal();
   }
 
   switch( NoiseType ) {
@@ -276,6 +280,19 @@ void FGSensor::bind(void)
 
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGSensor::SerializeState(FGStateArchive& ar)
+{
+  FGFCSComponent::SerializeState(ar);
+
+  // The state of the noise generator is saved with the random streams of the
+  // executive.
+  ar & bias & gain & drift_rate & drift & noise_variance & PreviousOutput
+     & PreviousInput;
+  ar & fail_low & fail_high & fail_stuck;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -38,6 +38,7 @@ INCLUDES
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include "FGFCSComponent.h"
+#include "math/FGRandom.h"
 #include <string>
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -54,6 +55,7 @@ namespace JSBSim {
 
 class FGFCS;
 class Element;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -148,6 +150,7 @@ public:
 
   virtual bool Run (void);
   void ResetPastStates(void);
+  void SerializeState(FGStateArchive& ar);
 
 protected:
   enum eNoiseType {ePercent=0, eAbsolute} NoiseType;
@@ -173,6 +176,7 @@ protected:
   bool fail_high;
   bool fail_stuck;
   std::string quant_property;
+  FGRandom_ptr RandomStream;
 
   void ProcessSensorSignal(void);
   void Noise(void);
@@ -46,6 +46,7 @@ INCLUDES
 #include "FGElectric.h"
 #include "FGPropeller.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -156,6 +157,15 @@ string FGElectric::GetEngineValues(const string& delimiter)
 //    16: When set various parameters are sanity checked and
 //       a message is printed out when they go out of bounds
 
+void FGElectric::SerializeState(FGStateArchive& ar)
+{
+  FGEngine::SerializeState(ar);
+
+  ar & RPM & HP;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGElectric::Debug(int from)
 {
   if (debug_lvl <= 0) return;
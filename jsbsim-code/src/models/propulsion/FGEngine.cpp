@@ -48,6 +48,7 @@ INCLUDES
 #include "FGRotor.h"
 #include "input_output/FGXMLElement.h"
 #include "math/FGColumnVector3.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -205,7 +206,7 @@ bool FGEngine::Load(FGFDMExec *exec, Element *engine_element)
 
   Name = engine_element->GetAttributeValue("name");
 
-  FGModelFunctions::Load(engine_element, PropertyManager, to_string((int)EngineNumber)); // Call ModelFunctions loader
+  FGModelFunctions::Load(engine_element, exec, to_string((int)EngineNumber)); // Call ModelFunctions loader
 
 // Find and set engine location
 
@@ -257,13 +258,26 @@ bool FGEngine::Load(FGFDMExec *exec, Element *engine_element)
   property_name = base_property_name + "/fuel-used-lbs";
   PropertyManager->Tie( property_name.c_str(), this, &FGEngine::GetFuelUsedLbs);
 
-  PostLoad(engine_element, PropertyManager, to_string((int)EngineNumber));
+  PostLoad(engine_element, exec, to_string((int)EngineNumber));
 
   Debug(0);
 
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGEngine::SerializeState(FGStateArchive& ar)
+{
+  FGModelFunctions::SerializeState(ar);
+
+  ar & FuelExpended & FuelFlowRate & PctPower & FuelFlow_gph & FuelFlow_pph
+     & FuelUsedLbs & FuelDensity;
+  ar & Starter & Starved & Running & Cranking & FuelFreeze;
+
+  Thruster->SerializeState(ar);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -65,6 +65,7 @@ class FGFDMExec;
 class FGThruster;
 class Element;
 class FGPropertyManager;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -184,6 +185,8 @@ public:
 
   /** Resets the Engine parameters to the initial conditions */
   virtual void ResetToIC(void);
+  /// Saves or restores the state of the engine and of its thruster.
+  void SerializeState(FGStateArchive& ar);
 
   /** Calculates the thrust of the engine, and other engine functions. */
   virtual void Calculate(void) = 0;
@@ -48,6 +48,7 @@ and the cg.
 #include "models/FGPropagate.h"
 #include "models/FGMassBalance.h"
 #include "models/FGAuxiliary.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -161,6 +162,13 @@ void FGForce::SetAnglesToBody(double broll, double bpitch, double byaw)
   }
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGForce::SerializeState(FGStateArchive& ar)
+{
+  ar & vFn & vMn & vOrient & vXYZn & vActingXYZn & mT & vFb & vM;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -74,6 +74,7 @@ FORWARD DECLARATIONS
 namespace JSBSim {
 
 class FGFDMExec;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -309,6 +310,9 @@ public:
 
   const FGMatrix33& Transform(void) const;
 
+  /// Saves or restores the force, the moment and the orientation.
+  virtual void SerializeState(FGStateArchive& ar);
+
 protected:
   FGFDMExec *fdmex;
   FGColumnVector3 vFn;
@@ -47,6 +47,7 @@ INCLUDES
 #include "FGPiston.h"
 #include "FGPropeller.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -1015,6 +1016,23 @@ string FGPiston::GetEngineValues(const string& delimiter)
 //    16: When set various parameters are sanity checked and
 //       a message is printed out when they go out of bounds
 
+void FGPiston::SerializeState(FGStateArchive& ar)
+{
+  FGEngine::SerializeState(ar);
+
+  ar & crank_counter & BoostSpeed & Magnetos & Magneto_Left & Magneto_Right;
+  ar & IndicatedHorsePower & PMEP & FMEP & FMEPDynamic & FMEPStatic & MAP
+     & TMAP & ISFC & p_amb & p_ram & T_amb & RPM & IAS & Cooling_Factor;
+  ar & rho_air & volumetric_efficiency & volumetric_efficiency_reduced
+     & m_dot_air & v_dot_air & equivalence_ratio & m_dot_fuel & HP
+     & BoostLossHP & combustion_efficiency;
+  ar & ExhaustGasTemp_degK & EGT_degC & ManifoldPressure_inHg
+     & CylinderHeadTemp_degK & OilPressure_psi & OilTemp_degK
+     & MeanPistonSpeed_fps;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
 void FGPiston::Debug(int from)
 {
   if (debug_lvl <= 0) return;
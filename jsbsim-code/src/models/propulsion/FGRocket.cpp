@@ -45,6 +45,7 @@ INCLUDES
 #include "FGRocket.h"
 #include "FGThruster.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -97,7 +98,7 @@ FGRocket::FGRocket(FGFDMExec* exec, Element *el, int engine_number, struct Input
   if (isp_el) {
     Element* isp_func_el = isp_el->FindElement("function");
     if (isp_func_el) {
-      isp_function = new FGFunction(exec->GetPropertyManager(),isp_func_el, strEngineNumber.str());
+      isp_function = new FGFunction(exec, isp_func_el, strEngineNumber.str());
     } else {
     Isp = el->FindElementValueAsNumber("isp");
     }
@@ -316,6 +317,18 @@ void FGRocket::bindmodel(FGPropertyManager* PropertyManager)
   }
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGRocket::SerializeState(FGStateArchive& ar)
+{
+  FGEngine::SerializeState(ar);
+
+  ar & It & ItVac & BurnTime & ThrustVariation & TotalIspVariation
+     & VacThrust & previousFuelNeedPerTank & previousOxiNeedPerTank
+     & OxidizerExpended & TotalPropellantExpended & OxidizerFlowRate
+     & PropellantFlowRate & Flameout;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
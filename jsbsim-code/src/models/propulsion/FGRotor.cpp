@@ -50,6 +50,7 @@ INCLUDES
 #include "models/FGMassBalance.h"
 #include "models/FGPropulsion.h" // to get the GearRatio from a linked rotor
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
 
 using std::cerr;
 using std::cout;
@@ -812,6 +813,20 @@ string FGRotor::GetThrusterValues(int id, const string& delimeter)
 
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGRotor::SerializeState(FGStateArchive& ar)
+{
+  FGThruster::SerializeState(ar);
+
+  damp_hagl.SerializeState(ar);
+  ar & rho & RPM & Omega & a_1 & b_1 & a_dw & H_drag & J_side & Torque & C_T
+     & lambda & mu & nu & v_induced & theta_downwash & phi_downwash
+     & CollectiveCtrl & LateralCtrl & LongitudinalCtrl & EngineRPM;
+
+  if (Transmission) Transmission->SerializeState(ar);
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
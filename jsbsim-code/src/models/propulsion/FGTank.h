@@ -64,6 +64,7 @@ namespace JSBSim {
 class Element;
 class FGPropertyManager;
 class FGFDMExec;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -228,6 +229,8 @@ public:
       @return the current temperature in degrees Celsius.
   */
   double Calculate(double dt, double TempC);
+  /// Saves or restores the contents and the temperature of the tank.
+  void SerializeState(FGStateArchive& ar);
 
   /** Retrieves the type of tank: Fuel or Oxidizer.
       @return the tank type, 0 for undefined, 1 for fuel, and 2 for oxidizer.
@@ -42,6 +42,7 @@ INCLUDES
 #include "input_output/FGPropertyManager.h"
 #include "FGThruster.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -157,6 +158,17 @@ string FGThruster::GetThrusterValues(int id, const string& delimeter)
   return buf.str();
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGThruster::SerializeState(FGStateArchive& ar)
+{
+  FGForce::SerializeState(ar);
+
+  ar & Thrust & PowerRequired & GearRatio & ThrustCoeff & ReverserAngle;
+  ar & in.TotalDeltaT & in.H_agl & in.PQRi & in.AeroPQR & in.AeroUVW
+     & in.Density & in.Pressure & in.Soundspeed & in.Alpha & in.Beta & in.Vt;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -56,6 +56,7 @@ namespace JSBSim {
 
 class Element;
 class FGPropertyManager;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -112,6 +113,7 @@ public:
   virtual std::string GetThrusterValues(int id, const std::string& delimeter);
 
   virtual void ResetToIC(void);
+  void SerializeState(FGStateArchive& ar);
 
   struct Inputs {
     double TotalDeltaT;
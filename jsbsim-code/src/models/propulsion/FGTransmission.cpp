@@ -41,6 +41,7 @@ INCLUDES
 
 
 #include "FGTransmission.h"
+#include "input_output/FGStateArchive.h"
 
 using std::string;
 using std::cout;
@@ -158,6 +159,15 @@ bool FGTransmission::BindModel(int num)
   return true;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTransmission::SerializeState(FGStateArchive& ar)
+{
+  FreeWheelLag.SerializeState(ar);
+  ar & FreeWheelTransmission & ClutchCtrlNorm & BrakeCtrlNorm & EngineRPM
+     & ThrusterRPM;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -47,6 +47,7 @@ INCLUDES
 #include "FGTurbine.h"
 #include "FGThruster.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -592,6 +593,24 @@ int FGTurbine::InitRunning(void)
   return phase=tpRun;
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTurbine::SerializeState(FGStateArchive& ar)
+{
+  FGEngine::SerializeState(ar);
+
+  int Phase = phase;
+  ar & Phase;
+  phase = static_cast<phaseType>(Phase);
+
+  ar & N1 & N2 & ThrottlePos & EGT_degC & EPR & OilPressure_psi
+     & OilTemp_degK & BleedDemand & InletPosition & NozzlePosition
+     & correctedTSFC & InjectionTimer & InjWaterNorm & InjN1increment
+     & InjN2increment;
+  ar & Stalled & Seized & Overtemp & Fire & Injection & Augmentation
+     & Reversed & Cutoff & Ignition & AugMethod;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
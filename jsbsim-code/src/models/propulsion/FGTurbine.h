@@ -52,6 +52,7 @@ namespace JSBSim {
 
 class Element;
 class FGFunction;
+class FGStateArchive;
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 CLASS DOCUMENTATION
@@ -173,6 +174,7 @@ public:
   enum phaseType { tpOff, tpRun, tpSpinUp, tpStart, tpStall, tpSeize, tpTrim };
 
   void Calculate(void);
+  void SerializeState(FGStateArchive& ar);
   double CalcFuelNeed(void);
   double GetPowerAvailable(void);
   /** A lag filter.
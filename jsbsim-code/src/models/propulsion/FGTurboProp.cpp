@@ -50,6 +50,7 @@ INCLUDES
 #include "FGRotor.h"
 #include "math/FGFunction.h"
 #include "input_output/FGXMLElement.h"
+#include "input_output/FGStateArchive.h"
 
 using namespace std;
 
@@ -563,6 +564,22 @@ void FGTurboProp::bindmodel(FGPropertyManager* PropertyManager)
   PropertyManager->Tie( property_name.c_str(), &CombustionEfficiency);
 }
 
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void FGTurboProp::SerializeState(FGStateArchive& ar)
+{
+  FGEngine::SerializeState(ar);
+
+  int Phase = phase;
+  ar & Phase;
+  phase = static_cast<phaseType>(Phase);
+
+  ar & N1 & ThrottlePos & OilPressure_psi & OilTemp_degK & OldThrottle
+     & RPM & CombustionEfficiency & HP & Eng_ITT_degC & Eng_Temperature;
+  ar & Reversed & Cutoff & Ielu_intervent & EngStarting & GeneratorPower
+     & Condition;
+}
+
 //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 //    The bitmasked value choices are as follows:
 //    unset: In this case (the default) JSBSim would only print
@@ -0,0 +1,388 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       output_bench.cpp
+ Date started: 10/17/26
+ Purpose:      Measures the throughput of the output directives of the
+               data_output directory.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+The c172x is flown with each directive file of the data_output directory, the
+output being generated at every time step. The same flight is also run without
+any output directive so that the cost of the output can be isolated from the
+cost of the simulation. The files are written to the current directory and the
+socket outputs are sent to local receivers which discard the data.
+
+The results are written in CSV format, one line per directive file:
+
+  directive,frames,frames_per_sec,output_frames_per_sec,us_per_output
+
+where output_frames_per_sec is the number of outputs that could be generated
+per second if the simulation were free.
+
+Usage:
+
+  output_bench [--root=<dir>] [--directive=<name>]... [--frames=<n>]
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#  include <winsock.h>
+#else
+#  include <dirent.h>
+#  include <unistd.h>
+#  include <sys/socket.h>
+#  include <sys/select.h>
+#  include <netinet/in.h>
+#  include <arpa/inet.h>
+#endif
+
+#include "FGFDMExec.h"
+#include "initialization/FGInitialCondition.h"
+#include "input_output/FGPropertyManager.h"
+#include "input_output/FGXMLFileRead.h"
+#include "models/FGOutput.h"
+
+using namespace std;
+using namespace JSBSim;
+
+#if defined(_WIN32)
+typedef int socklen_t;
+#  define closesocket_ closesocket
+#else
+#  define closesocket_ close
+#endif
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+GLOBAL DATA
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+struct Options {
+  string root;
+  vector<string> directives;
+  unsigned int frames;
+};
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FUNCTIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+// Returns the sorted list of the XML files of a directory.
+
+vector<string> ListDirectives(const SGPath& dir)
+{
+  vector<string> entries;
+
+#if defined(_WIN32)
+  WIN32_FIND_DATAA data;
+  HANDLE h = FindFirstFileA((dir/"*.xml").c_str(), &data);
+  if (h != INVALID_HANDLE_VALUE) {
+    do {
+      entries.push_back(data.cFileName);
+    } while (FindNextFileA(h, &data));
+    FindClose(h);
+  }
+#else
+  DIR* d = opendir(dir.c_str());
+  if (d) {
+    struct dirent* entry;
+    while ((entry = readdir(d))) {
+      string name = entry->d_name;
+      if (name.size() > 4 && name.substr(name.size()-4) == ".xml")
+        entries.push_back(name);
+    }
+    closedir(d);
+  }
+#endif
+
+  sort(entries.begin(), entries.end());
+  return entries;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Receives and discards the data sent to a local port until it is stopped.
+
+class Receiver
+{
+public:
+  Receiver(int port, bool tcp) : Quit(false), sckt(-1)
+  {
+    sckt = socket(AF_INET, tcp ? SOCK_STREAM : SOCK_DGRAM, 0);
+    if (sckt < 0) return;
+
+    int on = 1;
+    setsockopt(sckt, SOL_SOCKET, SO_REUSEADDR, (const char*)&on, sizeof(on));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(sckt, (struct sockaddr*)&addr, sizeof(addr)) < 0
+        || (tcp && listen(sckt, 1) < 0)) {
+      closesocket_(sckt);
+      sckt = -1;
+      return;
+    }
+
+    Thread = thread(&Receiver::Run, this, tcp);
+  }
+
+  ~Receiver()
+  {
+    Quit = true;
+    if (Thread.joinable()) Thread.join();
+    if (sckt >= 0) closesocket_(sckt);
+  }
+
+private:
+  atomic<bool> Quit;
+  int sckt;
+  thread Thread;
+
+  // Waits up to 10ms for a socket to be readable.
+  bool Wait(int s)
+  {
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(s, &fds);
+    struct timeval timeout = {0, 10000};
+    return select(s+1, &fds, 0, 0, &timeout) > 0;
+  }
+
+  void Run(bool tcp)
+  {
+    char buffer[65536];
+    int s = sckt;
+
+    if (tcp) {
+      while (!Quit && !Wait(sckt));
+      if (Quit) return;
+      s = accept(sckt, 0, 0);
+      if (s < 0) return;
+    }
+
+    while (!Quit) {
+      if (Wait(s) && recv(s, buffer, sizeof(buffer), 0) <= 0 && tcp) break;
+    }
+
+    if (tcp) closesocket_(s);
+  }
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns the name of a property of an output.
+
+string OutputProperty(unsigned int idx, const string& name)
+{
+  ostringstream buf;
+  buf << "simulation/output";
+  if (idx > 0) buf << '[' << idx << ']';
+  buf << '/' << name;
+  return buf.str();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Flies the c172x for a number of frames with an output directive file (if
+// any) and returns the time elapsed in seconds. A negative value is returned
+// if the FDM could not be initialized.
+
+double Fly(const Options& options, const SGPath& directive)
+{
+  SGPath root = SGPath::fromLocal8Bit(options.root.c_str()).realpath();
+  FGFDMExec fdm;
+
+  // The output files are written relatively to the root directory.
+  fdm.SetRootDir(SGPath::fromLocal8Bit(".").realpath());
+  fdm.SetAircraftPath(root/"aircraft");
+  fdm.SetEnginePath(root/"engine");
+  fdm.SetSystemsPath(root/"systems");
+
+  if (!fdm.LoadModel("c172x")) return -1.0;
+
+  // The output directives of the aircraft are not benchmarked.
+  FGPropertyManager* pm = fdm.GetPropertyManager();
+  unsigned int nAircraftOutputs = 0;
+  while (pm->HasNode(OutputProperty(nAircraftOutputs, "enabled")))
+    nAircraftOutputs++;
+
+  if (!directive.isNull() && !fdm.SetOutputDirectives(directive)) return -1.0;
+  if (!fdm.GetIC()->Load(SGPath("reset01")) || !fdm.RunIC()) return -1.0;
+
+  // Generates the output at each time step.
+  fdm.GetOutput()->SetRateHz(1.0/fdm.GetDeltaT());
+  for (unsigned int i=0; i<nAircraftOutputs; i++)
+    fdm.SetPropertyValue(OutputProperty(i, "enabled"), 0.0);
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+  for (unsigned int n=0; n<options.frames; n++) {
+    fdm.SetPropertyValue("fcs/elevator-cmd-norm", (n % 200) < 100 ? 0.1 : -0.1);
+    fdm.Run();
+  }
+
+  chrono::steady_clock::time_point stop = chrono::steady_clock::now();
+
+  return chrono::duration<double>(stop-start).count();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void BenchDirective(const Options& options, const string& name, double reference)
+{
+  SGPath root = SGPath::fromLocal8Bit(options.root.c_str()).realpath();
+  SGPath directive = root/"data_output"/name;
+
+  FGXMLFileRead XMLFileRead;
+  Element* document = XMLFileRead.LoadXMLDocument(directive, false);
+  if (!document) {
+    cerr << "Could not read " << directive << endl;
+    return;
+  }
+
+  // The socket outputs need a receiver.
+  string type = document->GetAttributeValue("type");
+  int port = atoi(document->GetAttributeValue("port").c_str());
+  bool tcp = document->GetAttributeValue("protocol") != "UDP";
+  Receiver* receiver = 0;
+
+  if (type == "SOCKET" || type == "FLIGHTGEAR")
+    receiver = new Receiver(port, type == "SOCKET" && tcp);
+
+  double elapsed = Fly(options, directive);
+
+  delete receiver;
+
+  if (elapsed < 0.0) {
+    cerr << "Could not fly the c172x with " << name << endl;
+    return;
+  }
+
+  double output = elapsed - reference;
+
+  cout << name << ',' << options.frames << ',' << fixed << setprecision(0)
+       << options.frames / elapsed << ',';
+  if (output > 0.0)
+    cout << options.frames / output << ',' << setprecision(3)
+         << 1E6 * output / options.frames;
+  else
+    cout << ",";
+  cout << endl;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void PrintUsage(const char* name)
+{
+  cerr << "Usage: " << name << " [options]" << endl
+       << "  --root=<dir>          JSBSim root directory (default: current directory)" << endl
+       << "  --directive=<name>    only benchmark this file of data_output (can be repeated)" << endl
+       << "  --frames=<n>          number of time steps per flight (default: 20000)" << endl;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool ParseOptions(int argc, char* argv[], Options& options)
+{
+  options.root = ".";
+  options.frames = 20000;
+
+  for (int i=1; i<argc; i++) {
+    string arg = argv[i];
+    string value;
+    size_t eq = arg.find('=');
+    if (eq != string::npos) {
+      value = arg.substr(eq+1);
+      arg = arg.substr(0, eq);
+    }
+
+    if (arg == "--root") options.root = value;
+    else if (arg == "--directive") options.directives.push_back(value);
+    else if (arg == "--frames") options.frames = atoi(value.c_str());
+    else {
+      cerr << "Unknown option " << argv[i] << endl;
+      return false;
+    }
+  }
+
+  if (options.frames == 0) {
+    cerr << "The number of frames must be positive" << endl;
+    return false;
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  FGJSBBase::debug_lvl = 0;
+
+#if defined(_WIN32)
+  WSADATA wsaData;
+  WSAStartup(MAKEWORD(1, 1), &wsaData);
+#endif
+
+  vector<string> directives = options.directives;
+  if (directives.empty()) {
+    SGPath root = SGPath::fromLocal8Bit(options.root.c_str());
+    directives = ListDirectives(root/"data_output");
+  }
+
+  double reference = Fly(options, SGPath());
+  if (reference < 0.0) {
+    cerr << "Could not fly the c172x" << endl;
+    return 1;
+  }
+
+  cout << "directive,frames,frames_per_sec,output_frames_per_sec,us_per_output"
+       << endl;
+  cout << "(none)," << options.frames << ',' << fixed << setprecision(0)
+       << options.frames / reference << ",," << endl;
+
+  for (unsigned int i=0; i<directives.size(); i++)
+    BenchDirective(options, directives[i], reference);
+
+  return 0;
+}
@@ -13,7 +13,10 @@
 #include "props.hxx"
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <mutex>
+#include <unordered_set>
 
 #include <set>
 #include <sstream>
@@ -346,6 +349,41 @@ find_child (Itr begin, Itr end, int index, const PropertyList& nodes)
   return -1;
 }
 
+/**
+ * Number of children above which a node indexes them.
+ */
+static const size_t CHILD_INDEX_THRESHOLD = 16;
+
+/**
+ * Get the shared copy of a node name.
+ *
+ * The names are never released: a tree only uses a bounded set of names.
+ */
+static const std::string *
+intern_name (const std::string& name)
+{
+  static std::mutex mutex;
+  // Never destroyed so that the nodes freed at exit keep a valid name.
+  static std::unordered_set<std::string> * names
+    = new std::unordered_set<std::string>;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  return &*names->insert(name).first;
+}
+
+/**
+ * Hash a child name and index (FNV-1a).
+ */
+template<typename Itr>
+static size_t
+hash_child (Itr begin, Itr end, int index)
+{
+  size_t hash = 2166136261u;
+  for (Itr it = begin; it != end; ++it)
+    hash = (hash ^ static_cast<unsigned char>(*it)) * 16777619u;
+  return (hash ^ static_cast<size_t>(index)) * 16777619u;
+}
+
 /**
  * Locate the child node with the highest index of the same name
  */
@@ -390,12 +428,66 @@ template<typename Itr>
 inline SGPropertyNode*
 SGPropertyNode::getExistingChild (Itr begin, Itr end, int index)
 {
-  int pos = find_child(begin, end, index, _children);
-  if (pos >= 0)
-    return _children[pos];
+  if (!_child_index) {
+    if (_children.size() < CHILD_INDEX_THRESHOLD) {
+      int pos = find_child(begin, end, index, _children);
+      if (pos >= 0)
+        return _children[pos];
+      return 0;
+    }
+
+    _child_index = new ChildIndex;
+    for (size_t i = 0; i < _children.size(); i++)
+      indexChild(_children[i]);
+  }
+
+  size_t length = std::distance(begin, end);
+  std::pair<ChildIndex::iterator, ChildIndex::iterator> range
+    = _child_index->equal_range(hash_child(begin, end, index));
+  for (ChildIndex::iterator it = range.first; it != range.second; ++it) {
+    SGPropertyNode * node = it->second;
+    if (node->_index == index && node->_name->size() == length
+        && std::equal(begin, end, node->_name->begin()))
+      return node;
+  }
   return 0;
 }
 
+void
+SGPropertyNode::indexChild (SGPropertyNode * node) const
+{
+  size_t hash = hash_child(node->_name->begin(), node->_name->end(),
+                           node->_index);
+  _child_index->insert(ChildIndex::value_type(hash, node));
+}
+
+void
+SGPropertyNode::clearChildIndex ()
+{
+  delete _child_index;
+  _child_index = 0;
+}
+
+unsigned long
+SGPropertyNode::getStructureChanges () const
+{
+  return getRootNode()->_structure_changes;
+}
+
+std::atomic<SGPropertyTracer*> SGPropertyNode::_tracer(0);
+
+void
+SGPropertyNode::setTracer (SGPropertyTracer * tracer)
+{
+  _tracer = tracer;
+}
+
+SGPropertyTracer *
+SGPropertyNode::getTracer ()
+{
+  return _tracer;
+}
+
 template<typename Itr>
 SGPropertyNode *
 SGPropertyNode::getChildImpl (Itr begin, Itr end, int index, bool create)
@@ -405,8 +497,10 @@ SGPropertyNode::getChildImpl (Itr begin, Itr end, int index, bool create)
     if (node) {
       return node;
     } else if (create) {
-      node = new SGPropertyNode(begin, end, index, this);
+      node = new (_arena) SGPropertyNode(begin, end, index, this);
       _children.push_back(node);
+      if (_child_index)
+        indexChild(node);
       fireChildAdded(node);
       return node;
     } else {
@@ -594,9 +688,11 @@ SGPropertyNode::get_float () const
 inline double
 SGPropertyNode::get_double () const
 {
-  if (_tied)
+  if (_tied) {
+    if (_local_val.double_ptr)
+      return *_local_val.double_ptr;
     return static_cast<SGRawValue<double>*>(_value.val)->getValue();
-  else
+  } else
     return _local_val.double_val;
 }
 
@@ -810,6 +906,11 @@ SGPropertyNode::make_string () const
 void
 SGPropertyNode::trace_write () const
 {
+  SGPropertyTracer * tracer = _tracer;
+  if (tracer) {
+    tracer->write(this);
+    return;
+  }
   SG_LOG(SG_GENERAL, SG_ALERT, "TRACE: Write node " << getPath()
 	 << ", value \"" << make_string() << '"');
 }
@@ -820,6 +921,11 @@ SGPropertyNode::trace_write () const
 void
 SGPropertyNode::trace_read () const
 {
+  SGPropertyTracer * tracer = _tracer;
+  if (tracer) {
+    tracer->read(this);
+    return;
+  }
   SG_LOG(SG_GENERAL, SG_ALERT, "TRACE: Read node " << getPath()
 	 << ", value \"" << make_string() << '"');
 }
@@ -839,11 +945,16 @@ const int SGPropertyNode::LAST_USED_ATTRIBUTE = PRESERVE;
  */
 SGPropertyNode::SGPropertyNode ()
   : _index(0),
+    _name(intern_name(std::string())),
     _parent(0),
     _type(props::NONE),
     _tied(false),
+    _tie_generation(0),
     _attr(READ|WRITE),
-    _listeners(0)
+    _listeners(0),
+    _child_index(0),
+    _arena(0),
+    _structure_changes(0)
 {
   _local_val.string_val = 0;
   _value.val = 0;
@@ -860,8 +971,12 @@ SGPropertyNode::SGPropertyNode (const SGPropertyNode &node)
     _parent(0),			// don't copy the parent
     _type(node._type),
     _tied(node._tied),
+    _tie_generation(0),
     _attr(node._attr),
-    _listeners(0)		// CHECK!!
+    _listeners(0),		// CHECK!!
+    _child_index(0),
+    _arena(0),
+    _structure_changes(0)
 {
   _local_val.string_val = 0;
   _value.val = 0;
@@ -875,6 +990,8 @@ SGPropertyNode::SGPropertyNode (const SGPropertyNode &node)
   }
   if (_tied || _type == props::EXTENDED) {
     _value.val = node._value.val->clone();
+    if (_type == props::DOUBLE)
+      _local_val.double_ptr = node._local_val.double_ptr;
     return;
   }
   switch (_type) {
@@ -911,34 +1028,49 @@ SGPropertyNode::SGPropertyNode (Itr begin, Itr end,
 				int index,
 				SGPropertyNode * parent)
   : _index(index),
-    _name(begin, end),
+    _name(0),
     _parent(parent),
     _type(props::NONE),
     _tied(false),
+    _tie_generation(0),
     _attr(READ|WRITE),
-    _listeners(0)
+    _listeners(0),
+    _child_index(0),
+    _arena(parent ? parent->_arena : 0),
+    _structure_changes(0)
 {
   _local_val.string_val = 0;
   _value.val = 0;
-  if (!validateName(_name))
-    throw std::string("plain name expected instead of '") + _name + '\'';
+  std::string name(begin, end);
+  if (!validateName(name))
+    throw std::string("plain name expected instead of '") + name + '\'';
+  _name = intern_name(name);
+  if (_tracer && _parent)
+    _attr |= _parent->_attr & (TRACE_READ|TRACE_WRITE);
 }
 
 SGPropertyNode::SGPropertyNode( const std::string& name,
                                 int index,
                                 SGPropertyNode * parent)
   : _index(index),
-    _name(name),
+    _name(0),
     _parent(parent),
     _type(props::NONE),
     _tied(false),
+    _tie_generation(0),
     _attr(READ|WRITE),
-    _listeners(0)
+    _listeners(0),
+    _child_index(0),
+    _arena(parent ? parent->_arena : 0),
+    _structure_changes(0)
 {
   _local_val.string_val = 0;
   _value.val = 0;
   if (!validateName(name))
-    throw std::string("plain name expected instead of '") + _name + '\'';
+    throw std::string("plain name expected instead of '") + name + '\'';
+  _name = intern_name(name);
+  if (_tracer && _parent)
+    _attr |= _parent->_attr & (TRACE_READ|TRACE_WRITE);
 }
 
 /**
@@ -950,6 +1082,7 @@ SGPropertyNode::~SGPropertyNode ()
   for (unsigned i = 0; i < _children.size(); ++i)
     _children[i]->_parent = 0;
   clearValue();
+  delete _child_index;
 
   if (_listeners) {
     vector<SGPropertyChangeListener*>::iterator it;
@@ -1051,8 +1184,10 @@ SGPropertyNode::addChild(const char * name, int min_index, bool append)
           : first_unused_index(name, _children, min_index);
 
   SGPropertyNode_ptr node;
-  node = new SGPropertyNode(name, name + strlen(name), pos, this);
+  node = new (_arena) SGPropertyNode(name, name + strlen(name), pos, this);
   _children.push_back(node);
+  if (_child_index)
+    indexChild(node);
   fireChildAdded(node);
   return node;
 }
@@ -1094,8 +1229,10 @@ SGPropertyNode::addChildren( const std::string& name,
     if( used_indices.find(index) == used_indices.end() )
     {
       SGPropertyNode_ptr node;
-      node = new SGPropertyNode(name, index, this);
+      node = new (_arena) SGPropertyNode(name, index, this);
       _children.push_back(node);
+      if (_child_index)
+        indexChild(node);
       fireChildAdded(node);
       nodes.push_back(node);
     }
@@ -1145,17 +1282,17 @@ SGPropertyNode::getChild (const std::string& name, int index, bool create)
 {
 #if PROPS_STANDALONE
   const char *n = name.c_str();
-  int pos = find_child(n, n + strlen(n), index, _children);
-  if (pos >= 0) {
-    return _children[pos];
+  SGPropertyNode* node = getExistingChild(n, n + strlen(n), index);
 #else
   SGPropertyNode* node = getExistingChild(name.begin(), name.end(), index);
+#endif
   if (node) {
       return node;
-#endif
     } else if (create) {
-      SGPropertyNode* node = new SGPropertyNode(name, index, this);
+      node = new (_arena) SGPropertyNode(name, index, this);
       _children.push_back(node);
+      if (_child_index)
+        indexChild(node);
       fireChildAdded(node);
       return node;
     } else {
@@ -1169,11 +1306,9 @@ SGPropertyNode::getChild (const std::string& name, int index, bool create)
 const SGPropertyNode *
 SGPropertyNode::getChild (const char * name, int index) const
 {
-  int pos = find_child(name, name + strlen(name), index, _children);
-  if (pos >= 0)
-    return _children[pos];
-  else
-    return 0;
+  // The lookup only builds the index of the children.
+  return const_cast<SGPropertyNode*>(this)
+    ->getExistingChild(name, name + strlen(name), index);
 }
 
 
@@ -1262,12 +1397,14 @@ SGPropertyNode::removeAllChildren()
   }
 
   _children.clear();
+  clearChildIndex();
+  getRootNode()->_structure_changes++;
 }
 
 std::string
 SGPropertyNode::getDisplayName (bool simplify) const
 {
-  std::string display_name = _name;
+  std::string display_name = *_name;
   if (_index != 0 || !simplify) {
     stringstream sstr;
     sstr << '[' << _index << ']';
@@ -1472,6 +1609,19 @@ SGPropertyNode::getDoubleValue () const
   }
 }
 
+const double *
+SGPropertyNode::getDoubleAddress () const
+{
+  if (_type != props::DOUBLE || !getAttribute(READ)
+      || getAttribute(TRACE_READ))
+    return 0;
+
+  if (_tied)
+    return _local_val.double_ptr;
+  else
+    return &_local_val.double_val;
+}
+
 const char *
 SGPropertyNode::getStringValue () const
 {
@@ -1951,6 +2101,7 @@ bool SGPropertyNode::tie (const SGRawValue<const char *> &rawValue,
     clearValue();
     _type = props::STRING;
     _tied = true;
+    _tie_generation++;
     _value.val = rawValue.clone();
 
     if (useDefault) {
@@ -2027,6 +2178,7 @@ SGPropertyNode::untie ()
   }
 
   _tied = false;
+  _tie_generation++;
   return true;
 }
 
@@ -2054,7 +2206,11 @@ SGPropertyNode::getNode (const char * relative_path, bool create)
 #if PROPS_STANDALONE
   vector<PathComponent> components;
   parse_path(relative_path, components);
-  return find_node(this, components, 0, create);
+  SGPropertyNode * node = find_node(this, components, 0, create);
+  SGPropertyTracer * tracer = _tracer;
+  if (tracer && node)
+    tracer->lookup(node);
+  return node;
 
 #else
   using namespace boost;
@@ -2073,7 +2229,11 @@ SGPropertyNode::getNode (const char * relative_path, int index, bool create)
   parse_path(relative_path, components);
   if (components.size() > 0)
     components.back().index = index;
-  return find_node(this, components, 0, create);
+  SGPropertyNode * node = find_node(this, components, 0, create);
+  SGPropertyTracer * tracer = _tracer;
+  if (tracer && node)
+    tracer->lookup(node);
+  return node;
 
 #else
   using namespace boost;
@@ -2481,9 +2641,117 @@ SGPropertyNode::eraseChild(simgear::PropertyList::iterator child)
   fireChildRemoved(node);
 
   _children.erase(child);
+  clearChildIndex();
+  getRootNode()->_structure_changes++;
   return node;
 }
 
+////////////////////////////////////////////////////////////////////////
+// Implementation of the node allocation.
+////////////////////////////////////////////////////////////////////////
+
+/**
+ * Each node is preceded by a header holding its arena (0 for the nodes
+ * allocated from the heap). The header size keeps the node aligned.
+ */
+static const size_t NODE_HEADER_SIZE = 16;
+static const size_t NODE_SLOT_SIZE
+  = NODE_HEADER_SIZE + (sizeof(SGPropertyNode) + 15) / 16 * 16;
+
+SGPropertyNodeArena::SGPropertyNodeArena (size_t nodes_per_block)
+  : _nodes_per_block(nodes_per_block > 0 ? nodes_per_block : 1),
+    _next(0),
+    _end(0),
+    _free_slots(0),
+    _num_nodes(0)
+{
+}
+
+SGPropertyNodeArena::~SGPropertyNodeArena ()
+{
+  for (size_t i = 0; i < _blocks.size(); i++)
+    ::operator delete(_blocks[i]);
+}
+
+void *
+SGPropertyNodeArena::allocate ()
+{
+  void * slot;
+
+  if (_free_slots) {
+    slot = _free_slots;
+    _free_slots = *static_cast<void **>(slot);
+  } else {
+    if (_next == _end) {
+      _next = static_cast<char *>(::operator new(_nodes_per_block
+                                                 * NODE_SLOT_SIZE));
+      _end = _next + _nodes_per_block * NODE_SLOT_SIZE;
+      _blocks.push_back(_next);
+    }
+    slot = _next;
+    _next += NODE_SLOT_SIZE;
+  }
+
+  _num_nodes++;
+  return slot;
+}
+
+void
+SGPropertyNodeArena::deallocate (void * slot)
+{
+  *static_cast<void **>(slot) = _free_slots;
+  _free_slots = slot;
+  _num_nodes--;
+}
+
+void *
+SGPropertyNode::operator new (size_t size)
+{
+  return operator new(size, 0);
+}
+
+void *
+SGPropertyNode::operator new (size_t size, SGPropertyNodeArena * arena)
+{
+  char * slot;
+
+  // The classes derived with additional members are allocated from the heap.
+  if (arena && NODE_HEADER_SIZE + size <= NODE_SLOT_SIZE) {
+    slot = static_cast<char *>(arena->allocate());
+    SGReferenced::get(arena);
+  } else {
+    slot = static_cast<char *>(::operator new(NODE_HEADER_SIZE + size));
+    arena = 0;
+  }
+
+  *reinterpret_cast<SGPropertyNodeArena **>(slot) = arena;
+  return slot + NODE_HEADER_SIZE;
+}
+
+void
+SGPropertyNode::operator delete (void * node)
+{
+  if (!node)
+    return;
+
+  char * slot = static_cast<char *>(node) - NODE_HEADER_SIZE;
+  SGPropertyNodeArena * arena = *reinterpret_cast<SGPropertyNodeArena **>(slot);
+
+  if (arena) {
+    arena->deallocate(slot);
+    if (!SGReferenced::put(arena))
+      delete arena;
+  } else {
+    ::operator delete(slot);
+  }
+}
+
+void
+SGPropertyNode::operator delete (void * node, SGPropertyNodeArena *)
+{
+  operator delete(node);
+}
+
 ////////////////////////////////////////////////////////////////////////
 // Implementation of SGPropertyChangeListener.
 ////////////////////////////////////////////////////////////////////////
@@ -2716,7 +2984,7 @@ size_t hash_value(const SGPropertyNode& node)
                  end = children.end();
              itr != end;
              ++itr) {
-            hash_combine(seed, (*itr)->_name);
+            hash_combine(seed, *(*itr)->_name);
             hash_combine(seed, (*itr)->_index);
             hash_combine(seed, hash_value(**itr));
         }
@@ -16,8 +16,10 @@
 #define PROPS_STANDALONE 1
 #endif
 
+#include <atomic>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include <iostream>
 #include <sstream>
 #include <typeinfo>
@@ -370,6 +372,15 @@ public:
   virtual bool setValue (T value) = 0;
 
 
+  /**
+   * Return the address of the variable holding the value.
+   *
+   * @return The address of the variable if the value is bound to a
+   * pointer, 0 otherwise.
+   */
+  virtual const T * getPointer () const { return 0; }
+
+
   /**
    * Return the type tag for this raw value type.
    */
@@ -442,6 +453,11 @@ public:
    */
   virtual bool setValue (T value) { *_ptr = value; return true; }
 
+  /**
+   * Get the address of the variable.
+   */
+  virtual const T * getPointer () const { return _ptr; }
+
   /**
    * Create a copy of this raw value.
    *
@@ -636,6 +652,39 @@ private:
   setter_t _setter;
 };
 
+
+/**
+ * A value read from a member variable of an object.
+ *
+ * The value is read directly from the member so, unlike SGRawValueMethods,
+ * it exposes the address of the variable and the node reads it without any
+ * function call. The value is modified through the setter of the object, if
+ * any: a read-only value will not have a setter.
+ */
+template <class C, class T>
+class SGRawValueMember : public SGRawValue<T>
+{
+public:
+  typedef T C::*member_t;
+  typedef void (C::*setter_t)(T);
+  SGRawValueMember (C &obj, member_t member, setter_t setter = 0)
+    : _obj(obj), _member(member), _setter(setter) {}
+  virtual ~SGRawValueMember () {}
+  virtual T getValue () const { return _obj.*_member; }
+  virtual bool setValue (T value) {
+    if (_setter) { (_obj.*_setter)(value); return true; }
+    else return false;
+  }
+  virtual const T * getPointer () const { return &(_obj.*_member); }
+  virtual SGRaw* clone () const {
+    return new SGRawValueMember(_obj, _member, _setter);
+  }
+private:
+  C &_obj;
+  member_t _member;
+  setter_t _setter;
+};
+
 /**
  * A raw value that contains its value. This provides a way for
  * property nodes to contain values that shouldn't be stored in the
@@ -744,6 +793,75 @@ private:
 };
 
 
+/**
+ * The property access tracer interface.
+ *
+ * <p>Once a tracer is installed with SGPropertyNode::setTracer, the reads and
+ * writes of the nodes having the TRACE_READ and TRACE_WRITE attributes are
+ * reported to the tracer instead of being logged, and so are the nodes found
+ * from a path. The nodes created under a traced node are traced as well.</p>
+ */
+class SGPropertyTracer
+{
+public:
+  virtual ~SGPropertyTracer () {}
+
+  /// Called when the value of \a node is read.
+  virtual void read (const SGPropertyNode * node) = 0;
+
+  /// Called when the value of \a node is written.
+  virtual void write (const SGPropertyNode * node) = 0;
+
+  /// Called when \a node has been found from a path.
+  virtual void lookup (const SGPropertyNode * node) = 0;
+};
+
+
+/**
+ * An arena from which the nodes of a property tree are allocated.
+ *
+ * <p>The nodes are carved out of large blocks so that building a tree only
+ * takes a few allocations and that the siblings created in a row sit next to
+ * each other in memory. A freed node is recycled by the next allocation and
+ * the blocks are all released at once when the arena is destroyed. Each node
+ * holds a reference to its arena so the arena outlives its last node.</p>
+ *
+ * <p>An arena is not thread safe: the nodes sharing an arena must be created
+ * and destroyed by one thread at a time, as is already required by their
+ * reference counting.</p>
+ */
+class SGPropertyNodeArena : public SGReferenced
+{
+public:
+  explicit SGPropertyNodeArena (size_t nodes_per_block = 256);
+  ~SGPropertyNodeArena ();
+
+  /// Get the number of nodes currently allocated from the arena.
+  size_t getNumNodes () const { return _num_nodes; }
+
+  /// Get the number of blocks allocated by the arena.
+  size_t getNumBlocks () const { return _blocks.size(); }
+
+private:
+  friend class SGPropertyNode;
+
+  SGPropertyNodeArena (const SGPropertyNodeArena&);
+  SGPropertyNodeArena& operator= (const SGPropertyNodeArena&);
+
+  void * allocate ();
+  void deallocate (void * slot);
+
+  size_t _nodes_per_block;
+  std::vector<char *> _blocks;
+  char * _next;                 // First slot never used of the last block
+  char * _end;
+  void * _free_slots;           // Singly linked list of the freed slots
+  size_t _num_nodes;
+};
+
+typedef SGSharedPtr<SGPropertyNodeArena> SGPropertyNodeArena_ptr;
+
+
 /**
  * A node in a property tree.
  */
@@ -803,6 +921,38 @@ public:
   virtual ~SGPropertyNode ();
 
 
+  /**
+   * Allocate a node from the heap.
+   */
+  static void * operator new (size_t size);
+
+
+  /**
+   * Allocate a node from an arena, or from the heap if \a arena is 0.
+   */
+  static void * operator new (size_t size, SGPropertyNodeArena * arena);
+
+
+  /**
+   * Free a node where it has been allocated.
+   */
+  static void operator delete (void * node);
+  static void operator delete (void * node, SGPropertyNodeArena * arena);
+
+
+  /**
+   * Set the arena from which the children of this node are allocated from
+   * now on. The new children pass the arena on to their own children.
+   */
+  void setArena (SGPropertyNodeArena * arena) { _arena = arena; }
+
+
+  /**
+   * Get the arena from which the children of this node are allocated.
+   */
+  SGPropertyNodeArena * getArena () const { return _arena; }
+
+
 
   //
   // Basic properties.
@@ -817,12 +967,12 @@ public:
   /**
    * Get the node's simple (XML) name.
    */
-  const char * getName () const { return _name.c_str(); }
+  const char * getName () const { return _name->c_str(); }
 
   /**
    * Get the node's simple name as a string.
    */
-  const std::string& getNameString () const { return _name; }
+  const std::string& getNameString () const { return *_name; }
 
   /**
    * Get the node's pretty display name, with subscript when needed.
@@ -1196,6 +1346,41 @@ public:
   double getDoubleValue () const;
 
 
+  /**
+   * Get the number of nodes that have been removed from their parent in the
+   * tree of this node. The count is held by the root node so that the trees
+   * of different FDMs do not affect each other. The nodes found from a path
+   * can be kept as long as this number does not change.
+   */
+  unsigned long getStructureChanges () const;
+
+
+  /**
+   * Set the tracer to which the traced accesses are reported, or 0 to log
+   * them.
+   */
+  static void setTracer (SGPropertyTracer * tracer);
+
+
+  /**
+   * Get the tracer to which the traced accesses are reported.
+   */
+  static SGPropertyTracer * getTracer ();
+
+
+  /**
+   * Get the address where the double value of this node is stored.
+   *
+   * The value can then be read without any call. The address is only
+   * known if the node is a readable and untraced double that is either
+   * untied or tied to a variable; it remains valid until the node is
+   * tied, untied or changes type.
+   *
+   * @return The address of the value, or 0 if it is not known.
+   */
+  const double * getDoubleAddress () const;
+
+
   /**
    * Get a string value for this node.
    */
@@ -1358,6 +1543,12 @@ public:
    */
   bool isTied () const { return _tied; }
 
+  /**
+   * Get the number of times this node has been tied or untied. It tells the
+   * users of getDoubleAddress() when the address must be looked up again.
+   */
+  unsigned int getTieGeneration () const { return _tie_generation; }
+
     /**
      * Bind this node to an external source.
      */
@@ -1759,6 +1950,7 @@ protected:
   SGPropertyNode (Itr begin, Itr end, int index, SGPropertyNode * parent);
 
   static simgear::PropertyInterpolationMgr* _interpolation_mgr;
+  static std::atomic<SGPropertyTracer*> _tracer;
 
 private:
 
@@ -1796,7 +1988,8 @@ private:
   void trace_write () const;
 
   int _index;
-  std::string _name;
+  /// The names are interned: the nodes with the same name share its string.
+  const std::string * _name;
   /// To avoid cyclic reference counting loops this shall not be a reference
   /// counted pointer
   SGPropertyNode * _parent;
@@ -1804,6 +1997,8 @@ private:
   mutable std::string _buffer;
   simgear::props::Type _type;
   bool _tied;
+  // Incremented each time the node is tied or untied.
+  unsigned int _tie_generation;
   int _attr;
 
   // The right kind of pointer...
@@ -1819,10 +2014,22 @@ private:
     float float_val;
     double double_val;
     char * string_val;
+    // The variable of a tied double exposing its address, 0 otherwise.
+    const double * double_ptr;
   } _local_val;
 
   std::vector<SGPropertyChangeListener *> * _listeners;
 
+  // The children indexed by a hash of their name and index. The index is only
+  // built when a node with many children is searched.
+  typedef std::unordered_multimap<size_t, SGPropertyNode *> ChildIndex;
+  mutable ChildIndex * _child_index;
+  SGPropertyNodeArena * _arena;
+  // The number of nodes removed from the tree, only maintained by its root.
+  unsigned long _structure_changes;
+  void indexChild (SGPropertyNode * node) const;
+  void clearChildIndex ();
+
   // Pass name as a pair of iterators
   template<typename Itr>
   SGPropertyNode * getChildImpl (Itr begin, Itr end, int index = 0, bool create = false);
@@ -1981,7 +2188,11 @@ bool SGPropertyNode::tie(const SGRawValue<T> &rawValue, bool useDefault)
     else
         _type = EXTENDED;
     _tied = true;
+    _tie_generation++;
     _value.val = rawValue.clone();
+    if (_type == DOUBLE)
+        _local_val.double_ptr
+            = static_cast<SGRawValue<double>*>(_value.val)->getPointer();
     if (useDefault) {
         int save_attributes = getAttributes();
         setAttribute( WRITE, true );
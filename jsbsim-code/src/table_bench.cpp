@@ -0,0 +1,442 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       table_bench.cpp
+ Date started: 10/17/26
+ Purpose:      Measures the lookup throughput of the tables of the aircraft
+               of the JSBSim tree.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+The <table> elements of the configuration file of each aircraft are loaded in
+FGTable instances and their lookups are timed outside of any simulation. The
+keys are generated in the range of the breakpoints of each axis (extended by
+10% on each side to exercise the clamping) in 2 modes:
+
+- sweep: the keys move slowly across the range as they do during a flight so
+  the breakpoints found at the previous lookup are mostly reused,
+- random: the keys are drawn at random so the breakpoints must be searched at
+  each lookup,
+- batch: the same random keys are looked up by arrays with
+  FGTable::GetValues().
+
+The results are written in CSV format, one line per aircraft, dimension and
+mode:
+
+  aircraft,dimension,mode,tables,lookups,lookups_per_sec,ns_per_lookup
+
+Usage:
+
+  table_bench [--root=<dir>] [--aircraft=<name>]... [--lookups=<n>]
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <dirent.h>
+#endif
+
+#include "FGJSBBase.h"
+#include "input_output/FGPropertyManager.h"
+#include "input_output/FGXMLFileRead.h"
+#include "math/FGTable.h"
+
+using namespace std;
+using namespace JSBSim;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+GLOBAL DATA
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+struct Options {
+  string root;
+  vector<string> aircraft;
+  unsigned int lookups;
+};
+
+// A table with the range of the breakpoints of its axes.
+struct BenchTable {
+  FGTable* table;
+  unsigned int dimension;
+  double min[3], max[3];
+};
+
+enum Mode { eSweep=0, eRandom, eBatch, eNumModes };
+const char* ModeNames[eNumModes] = {"sweep", "random", "batch"};
+
+// Number of keys generated per table. The keys are generated before the
+// timing starts and reused in turn.
+const unsigned int nKeys = 4096;
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FUNCTIONS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+// Returns the sorted list of the entries of a directory.
+
+vector<string> ListDirectory(const SGPath& dir)
+{
+  vector<string> entries;
+
+#if defined(_WIN32)
+  WIN32_FIND_DATAA data;
+  HANDLE h = FindFirstFileA((dir/"*").c_str(), &data);
+  if (h != INVALID_HANDLE_VALUE) {
+    do {
+      string name = data.cFileName;
+      if (name != "." && name != "..") entries.push_back(name);
+    } while (FindNextFileA(h, &data));
+    FindClose(h);
+  }
+#else
+  DIR* d = opendir(dir.c_str());
+  if (d) {
+    struct dirent* entry;
+    while ((entry = readdir(d))) {
+      string name = entry->d_name;
+      if (name != "." && name != "..") entries.push_back(name);
+    }
+    closedir(d);
+  }
+#endif
+
+  sort(entries.begin(), entries.end());
+  return entries;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Extends a range with the numbers of a line of data.
+
+void UpdateRange(const string& line, double& min, double& max)
+{
+  istringstream in(line);
+  double value;
+  while (in >> value) {
+    if (value < min) min = value;
+    if (value > max) max = value;
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Computes the range of the breakpoints of each axis from the XML data.
+
+void FindRanges(Element* el, BenchTable& bt)
+{
+  for (unsigned int i=0; i<3; i++) {
+    bt.min[i] = HUGE_VAL;
+    bt.max[i] = -HUGE_VAL;
+  }
+
+  Element* tableData = el->FindElement("tableData");
+  while (tableData) {
+    for (unsigned int l=0; l<tableData->GetNumDataLines(); l++) {
+      string line = tableData->GetDataLine(l);
+      if (l == 0 && bt.dimension > 1)
+        UpdateRange(line, bt.min[1], bt.max[1]); // The column breakpoints
+      else {
+        // Only the first number of the other lines is a breakpoint.
+        istringstream in(line);
+        double key;
+        if (in >> key) {
+          bt.min[0] = min(bt.min[0], key);
+          bt.max[0] = max(bt.max[0], key);
+        }
+      }
+    }
+    if (bt.dimension == 3) {
+      double key = tableData->GetAttributeValueAsNumber("breakPoint");
+      bt.min[2] = min(bt.min[2], key);
+      bt.max[2] = max(bt.max[2], key);
+    }
+    tableData = el->FindNextElement("tableData");
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Collects the <table> elements of an XML tree.
+
+void FindTables(Element* el, vector<Element*>& tables)
+{
+  for (unsigned int i=0; i<el->GetNumElements(); i++) {
+    Element* child = el->GetElement(i);
+    if (child->GetName() == "table") tables.push_back(child);
+    else FindTables(child, tables);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Loads the tables of an aircraft. The tables that can not be loaded outside of
+// the simulation (because they refer to the properties of a model, for
+// instance) are skipped.
+
+void LoadTables(Element* document, FGPropertyManager* pm,
+                vector<BenchTable>& tables)
+{
+  vector<Element*> elements;
+  FindTables(document, elements);
+
+  for (unsigned int i=0; i<elements.size(); i++) {
+    Element* el = elements[i];
+    BenchTable bt;
+    bt.table = 0;
+    bt.dimension = 0;
+
+    try {
+      // The lookup properties must exist before the table is created.
+      Element* axis = el->FindElement("independentVar");
+      while (axis) {
+        pm->GetNode(axis->GetDataLine(), true);
+        bt.dimension++;
+        axis = el->FindNextElement("independentVar");
+      }
+      if (bt.dimension == 0) continue;
+
+      // The tables are anonymous to avoid the conflicts between their
+      // properties.
+      el->SetAttributeValue("name", "");
+      bt.table = new FGTable(pm, el);
+    }
+    catch (...) {
+      delete bt.table;
+      continue;
+    }
+
+    FindRanges(el, bt);
+    tables.push_back(bt);
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Generates the keys of an axis in the range [min, max] extended by 10%.
+
+vector<double> GenerateKeys(double min, double max, Mode mode,
+                            mt19937& generator)
+{
+  vector<double> keys(nKeys);
+  double margin = 0.1*(max-min);
+  min -= margin;
+  max += margin;
+
+  if (mode == eSweep) {
+    // A triangle wave: the keys go back and forth across the range.
+    for (unsigned int i=0; i<nKeys; i++) {
+      double x = 2.0*i/nKeys;
+      keys[i] = min + (max-min)*(x < 1.0 ? x : 2.0-x);
+    }
+  } else { // Random and batch modes
+    uniform_real_distribution<double> distribution(min, max);
+    for (unsigned int i=0; i<nKeys; i++) keys[i] = distribution(generator);
+  }
+
+  return keys;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Times the lookups of the tables of a given dimension and returns the time per
+// lookup in nanoseconds. nLookups receives the number of lookups made.
+
+double TimeLookups(const vector<BenchTable>& tables, unsigned int dimension,
+                   Mode mode, unsigned int lookups, unsigned int& nTables,
+                   unsigned int& nLookups)
+{
+  mt19937 generator(12345);
+  vector<const BenchTable*> selected;
+  vector< vector<double> > keys[3];
+
+  for (unsigned int i=0; i<tables.size(); i++) {
+    const BenchTable& bt = tables[i];
+    if (bt.dimension != dimension) continue;
+    selected.push_back(&bt);
+    for (unsigned int a=0; a<dimension; a++)
+      keys[a].push_back(GenerateKeys(bt.min[a], bt.max[a], mode, generator));
+  }
+
+  nTables = selected.size();
+  if (nTables == 0) return 0.0;
+
+  // The tables are looked up in turn as they would be during a frame.
+  unsigned int rounds = max(1U, lookups / nTables);
+  double sum = 0.0; // Prevents the compiler from discarding the lookups.
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+  if (mode == eBatch) {
+    // Each table is looked up for all its keys at once.
+    vector<double> values(nKeys);
+    rounds = max(1U, rounds / nKeys);
+    for (unsigned int n=0; n<rounds; n++) {
+      for (unsigned int i=0; i<nTables; i++) {
+        selected[i]->table->GetValues(nKeys, &keys[0][i][0],
+                                      dimension > 1 ? &keys[1][i][0] : 0L,
+                                      dimension > 2 ? &keys[2][i][0] : 0L,
+                                      &values[0]);
+        sum += values[n % nKeys];
+      }
+    }
+    rounds *= nKeys;
+  } else {
+    for (unsigned int n=0; n<rounds; n++) {
+      unsigned int k = n % nKeys;
+      for (unsigned int i=0; i<nTables; i++) {
+        const FGTable* table = selected[i]->table;
+        switch (dimension) {
+        case 1:
+          sum += table->GetValue(keys[0][i][k]);
+          break;
+        case 2:
+          sum += table->GetValue(keys[0][i][k], keys[1][i][k]);
+          break;
+        case 3:
+          sum += table->GetValue(keys[0][i][k], keys[1][i][k], keys[2][i][k]);
+          break;
+        }
+      }
+    }
+  }
+
+  chrono::steady_clock::time_point stop = chrono::steady_clock::now();
+
+  if (sum == HUGE_VAL) cerr << "Unexpected sum" << endl;
+
+  nLookups = rounds*nTables;
+  return chrono::duration<double, nano>(stop-start).count() / (rounds*nTables);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void BenchAircraft(const Options& options, const string& model)
+{
+  SGPath root = SGPath::fromLocal8Bit(options.root.c_str());
+  SGPath config = root/"aircraft"/model/(model + ".xml");
+
+  FGXMLFileRead XMLFileRead;
+  Element* document = XMLFileRead.LoadXMLDocument(config, false);
+  if (!document) {
+    cerr << "Could not read " << config << endl;
+    return;
+  }
+
+  FGPropertyManager pm;
+  vector<BenchTable> tables;
+  LoadTables(document, &pm, tables);
+
+  for (unsigned int dimension=1; dimension<=3; dimension++) {
+    for (unsigned int mode=0; mode<eNumModes; mode++) {
+      unsigned int nTables = 0, lookups = 0;
+      double ns = TimeLookups(tables, dimension, (Mode)mode, options.lookups,
+                              nTables, lookups);
+      if (nTables == 0) continue;
+
+      cout << model << ',' << dimension << ',' << ModeNames[mode] << ','
+           << nTables << ',' << lookups << ',' << fixed << setprecision(0)
+           << 1E9/ns << ',' << setprecision(2) << ns << endl;
+    }
+  }
+
+  for (unsigned int i=0; i<tables.size(); i++) delete tables[i].table;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void PrintUsage(const char* name)
+{
+  cerr << "Usage: " << name << " [options]" << endl
+       << "  --root=<dir>          JSBSim root directory (default: current directory)" << endl
+       << "  --aircraft=<name>     only benchmark this aircraft (can be repeated)" << endl
+       << "  --lookups=<n>         number of lookups per case (default: 2000000)" << endl;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool ParseOptions(int argc, char* argv[], Options& options)
+{
+  options.root = ".";
+  options.lookups = 2000000;
+
+  for (int i=1; i<argc; i++) {
+    string arg = argv[i];
+    string value;
+    size_t eq = arg.find('=');
+    if (eq != string::npos) {
+      value = arg.substr(eq+1);
+      arg = arg.substr(0, eq);
+    }
+
+    if (arg == "--root") options.root = value;
+    else if (arg == "--aircraft") options.aircraft.push_back(value);
+    else if (arg == "--lookups") options.lookups = atoi(value.c_str());
+    else {
+      cerr << "Unknown option " << argv[i] << endl;
+      return false;
+    }
+  }
+
+  if (options.lookups == 0) {
+    cerr << "The number of lookups must be positive" << endl;
+    return false;
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  FGJSBBase::debug_lvl = 0;
+
+  SGPath root = SGPath::fromLocal8Bit(options.root.c_str());
+
+  if (options.aircraft.empty()) {
+    vector<string> entries = ListDirectory(root/"aircraft");
+    for (unsigned int i=0; i<entries.size(); i++) {
+      SGPath config = root/"aircraft"/entries[i]/(entries[i] + ".xml");
+      if (config.isFile()) options.aircraft.push_back(entries[i]);
+    }
+  }
+
+  cout << "aircraft,dimension,mode,tables,lookups,lookups_per_sec,ns_per_lookup"
+       << endl;
+
+  for (unsigned int i=0; i<options.aircraft.size(); i++)
+    BenchAircraft(options, options.aircraft[i]);
+
+  return 0;
+}
@@ -0,0 +1,148 @@
+# read_binary_output.py
+#
+# Reads the files written by the JSBSim outputs of type BINARY.
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+"""Reads the files written by the JSBSim outputs of type BINARY.
+
+The format of the files is described in the documentation of the class
+FGOutputBinaryFile. A file is made of a header followed by fixed size records,
+so the records can be mapped in memory with NumPy without being parsed:
+
+    import numpy as np
+    from read_binary_output import read_header, record_dtype
+
+    header = read_header('datalog.bin')
+    data = np.memmap('datalog.bin', dtype=record_dtype(header), mode='r',
+                     offset=header['header_size'])
+    altitude = data['/fdm/jsbsim/position/h-sl-ft']
+
+The function load() does the same and ignores the last record if the file has
+been truncated while it was written.
+
+When run as a script, the file is converted to CSV:
+
+    python read_binary_output.py datalog.bin [datalog.csv]
+"""
+
+import os
+import struct
+import sys
+
+import numpy as np
+
+SIGNATURE = b'JSBSBIN\0'
+VERSION = 1
+TYPES = {b'd': '<f8', b'f': '<f4'}
+
+
+def read_header(filename):
+    """Returns the header of a binary output file as a dictionary.
+
+    The dictionary contains the version of the format, the size of the header,
+    the size of a record, the output rate in Hz and the list of the columns.
+    Each column is a dictionary with its name, its unit and its NumPy type.
+    """
+    with open(filename, 'rb') as f:
+        if f.read(8) != SIGNATURE:
+            raise IOError('%s is not a JSBSim binary output file' % filename)
+
+        version, header_size, record_size, num_columns = struct.unpack('<4I', f.read(16))
+        if version > VERSION:
+            raise IOError('%s has an unsupported version: %d' % (filename,
+                                                                 version))
+        rate, = struct.unpack('<d', f.read(8))
+
+        def read_string():
+            length, = struct.unpack('<H', f.read(2))
+            return f.read(length).decode('utf-8')
+
+        columns = []
+        for i in range(num_columns):
+            kind = f.read(1)
+            if kind not in TYPES:
+                raise IOError('%s has an unknown column type: %r' % (filename,
+                                                                     kind))
+            name = read_string()
+            unit = read_string()
+            columns.append({'name': name, 'unit': unit, 'type': TYPES[kind]})
+
+    return {'version': version, 'header_size': header_size,
+            'record_size': record_size, 'rate': rate, 'columns': columns}
+
+
+def record_dtype(header):
+    """Returns the NumPy structured type of the records.
+
+    The fields are named after the columns. A name which is used by several
+    columns is suffixed with '_1', '_2', ... from its second occurrence.
+    """
+    names = []
+    for column in header['columns']:
+        name = column['name']
+        count = 1
+        while name in names:
+            name = '%s_%d' % (column['name'], count)
+            count += 1
+        names.append(name)
+
+    dtype = np.dtype({'names': names,
+                      'formats': [c['type'] for c in header['columns']]})
+    assert dtype.itemsize == header['record_size']
+    return dtype
+
+
+def load(filename):
+    """Returns the header and the records of a binary output file.
+
+    The records are mapped in memory: they are read from the file when they
+    are accessed.
+    """
+    header = read_header(filename)
+    dtype = record_dtype(header)
+    size = os.path.getsize(filename) - header['header_size']
+    num_records = size // dtype.itemsize
+
+    if num_records == 0:
+        return header, np.zeros(0, dtype=dtype)
+
+    return header, np.memmap(filename, dtype=dtype, mode='r',
+                             offset=header['header_size'],
+                             shape=(num_records,))
+
+
+def to_csv(filename, output):
+    """Converts a binary output file to CSV."""
+    header, data = load(filename)
+    with open(output, 'w') as f:
+        f.write(','.join(data.dtype.names) + '\n')
+        for record in data:
+            f.write(','.join(repr(float(v)) for v in record) + '\n')
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        print('Usage: %s <binary file> [<CSV file>]' % sys.argv[0])
+        sys.exit(1)
+
+    if len(sys.argv) > 2:
+        to_csv(sys.argv[1], sys.argv[2])
+    else:
+        header, data = load(sys.argv[1])
+        print('%d records at %g Hz' % (len(data), header['rate']))
+        for column in header['columns']:
+            print('  %s (%s) %s' % (column['name'], column['unit'],
+                                    column['type']))
@@ -0,0 +1,478 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestBatchEvaluation.cpp
+ Date started: 10/17/26
+ Purpose:      Checks that the evaluation of tables and functions over arrays
+               returns the same values than their evaluation point by point.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+FGTable::GetValues() and FGFunction::GetValues() are compared bit for bit with
+GetValue() called at each point:
+
+- 1D, 2D and 3D tables looked up with keys inside and outside of their
+  breakpoints, on breakpoints and NaNs,
+- functions made of arithmetic operations, properties and tables (evaluated by
+  blocks) and functions with conditions (evaluated point by point),
+- the aerodynamic functions of the f16 with the control surface positions as
+  inputs.
+
+The test is called with the JSBSim root directory as its first argument and
+returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "FGFDMExec.h"
+#include "initialization/FGInitialCondition.h"
+#include "input_output/FGXMLParse.h"
+#include "math/FGFunction.h"
+#include "math/FGTable.h"
+#include "models/FGAerodynamics.h"
+#include "test_utilities.h"
+
+using namespace std;
+using namespace JSBSim;
+
+// Not a multiple of the size of the blocks.
+const unsigned int nPoints = 1000;
+
+const char* tablesXML =
+  "<tables>"
+  "  <table>"
+  "    <independentVar>test/x</independentVar>"
+  "    <tableData>"
+  "      -10.0  -0.0\n"
+  "       -2.0   1.5\n"
+  "        0.0   2.0\n"
+  "        3.0  -1.0\n"
+  "       12.0   4.0\n"
+  "    </tableData>"
+  "  </table>"
+  "  <table>"
+  "    <independentVar lookup='row'>test/x</independentVar>"
+  "    <independentVar lookup='column'>test/y</independentVar>"
+  "    <tableData>"
+  "               -1.0   0.0   0.5   2.0\n"
+  "      -10.0     1.0   2.0   3.0   4.0\n"
+  "       -5.0    -1.0   0.5   0.0   1.0\n"
+  "        0.0     2.0   2.5   3.5   1.0\n"
+  "        5.0     0.0  -2.0  -4.0  -6.0\n"
+  "       10.0     1.0   1.0   1.0   1.0\n"
+  "    </tableData>"
+  "  </table>"
+  "  <table>"
+  "    <independentVar lookup='row'>test/x</independentVar>"
+  "    <independentVar lookup='column'>test/y</independentVar>"
+  "    <independentVar lookup='table'>test/z</independentVar>"
+  "    <tableData breakPoint='-1.0'>"
+  "              -1.0   1.0\n"
+  "      -5.0     1.0   2.0\n"
+  "       5.0     3.0   4.0\n"
+  "    </tableData>"
+  "    <tableData breakPoint='0.0'>"
+  "              -1.0   0.0   1.0\n"
+  "      -5.0    -1.0   0.0   1.0\n"
+  "       0.0     2.0   5.0  -2.0\n"
+  "       5.0    -3.0   0.0   3.0\n"
+  "    </tableData>"
+  "    <tableData breakPoint='2.0'>"
+  "              -1.0   1.0\n"
+  "     -10.0     0.5   1.5\n"
+  "      10.0     2.5   3.5\n"
+  "    </tableData>"
+  "  </table>"
+  "</tables>";
+
+// The first functions are evaluated by blocks, the last ones point by point.
+const char* functionsXML =
+  "<functions>"
+  "  <function>"
+  "    <product>"
+  "      <p>test/x</p><v>0.5</v><p>test/w</p>"
+  "      <table>"
+  "        <independentVar>test/y</independentVar>"
+  "        <tableData>"
+  "          -1.0   0.2\n"
+  "           0.0   1.0\n"
+  "           1.0   0.7\n"
+  "        </tableData>"
+  "      </table>"
+  "      <sum><p>test/y</p><v>1.0</v></sum>"
+  "    </product>"
+  "  </function>"
+  "  <function>"
+  "    <sum>"
+  "      <quotient><p>test/x</p><p>test/y</p></quotient>"
+  "      <difference><p>test/z</p><pow><p>test/y</p><v>2</v></pow></difference>"
+  "      <sqrt><abs><p>test/x</p></abs></sqrt>"
+  "      <atan2><p>test/y</p><p>test/x</p></atan2>"
+  "      <min><p>test/x</p><p>test/y</p><v>0.25</v></min>"
+  "      <max><p>test/x</p><p>test/z</p></max>"
+  "      <avg><p>test/x</p><p>test/y</p><p>test/z</p></avg>"
+  "      <sin><p>test/x</p></sin><cos><p>test/y</p></cos>"
+  "      <exp><p>test/z</p></exp><ln><p>test/x</p></ln>"
+  "      <log10><p>test/y</p></log10><log2><p>test/z</p></log2>"
+  "      <toradians><p>test/x</p></toradians><todegrees><p>test/y</p></todegrees>"
+  "      <fraction><p>test/x</p></fraction><integer><p>test/y</p></integer>"
+  "      <mod><p>test/x</p><v>3</v></mod>"
+  "      <sign><p>test/z</p></sign>"
+  "    </sum>"
+  "  </function>"
+  "  <function>"
+  "    <sum>"
+  "      <lt><p>test/x</p><p>test/y</p></lt><le><p>test/x</p><v>0</v></le>"
+  "      <gt><p>test/y</p><p>test/z</p></gt><ge><p>test/z</p><v>0</v></ge>"
+  "      <eq><p>test/x</p><v>0</v></eq><nq><p>test/y</p><v>0</v></nq>"
+  "      <not><lt><p>test/x</p><v>1</v></lt></not>"
+  "      <interpolate1d><p>test/x</p><v>-5</v><v>1</v><v>0</v><v>-2</v><v>5</v><v>3</v></interpolate1d>"
+  "    </sum>"
+  "  </function>"
+  "  <function>"
+  "    <difference>"
+  "      <product><p>test/w</p><p>test/x</p></product>"
+  "      <table>"
+  "        <independentVar lookup='row'>test/z</independentVar>"
+  "        <independentVar lookup='column'>test/w</independentVar>"
+  "        <tableData>"
+  "                 0.0   5.0\n"
+  "          -1.0   1.0   2.0\n"
+  "           1.0   3.0  -4.0\n"
+  "        </tableData>"
+  "      </table>"
+  "      <table>"
+  "        <independentVar lookup='row'>test/x</independentVar>"
+  "        <independentVar lookup='column'>test/y</independentVar>"
+  "        <independentVar lookup='table'>test/z</independentVar>"
+  "        <tableData breakPoint='-1.0'>"
+  "                -1.0   1.0\n"
+  "        -5.0     1.0   2.0\n"
+  "         5.0     3.0   4.0\n"
+  "        </tableData>"
+  "        <tableData breakPoint='1.0'>"
+  "                -1.0   1.0\n"
+  "        -5.0    -1.0   0.0\n"
+  "         5.0     2.0   5.0\n"
+  "        </tableData>"
+  "      </table>"
+  "    </difference>"
+  "  </function>"
+  "  <function>"
+  "    <ifthen>"
+  "      <lt><p>test/x</p><p>test/y</p></lt>"
+  "      <product><p>test/x</p><p>test/w</p></product>"
+  "      <sum><p>test/y</p><p>test/z</p></sum>"
+  "    </ifthen>"
+  "  </function>"
+  "  <function>"
+  "    <switch>"
+  "      <abs><mod><p>test/z</p><v>3</v></mod></abs>"
+  "      <p>test/x</p><p>test/y</p><v>3.0</v>"
+  "    </switch>"
+  "  </function>"
+  "</functions>";
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns true if 2 values are identical, NaNs included.
+
+bool Identical(double a, double b)
+{
+  if (std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b);
+  return a == b && std::signbit(a) == std::signbit(b);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Generates keys in [min, max] including some of the values in exact, which
+// are the breakpoints of the tables.
+
+vector<double> MakeKeys(double min, double max, const vector<double>& exact,
+                        mt19937& generator)
+{
+  uniform_real_distribution<double> distribution(min, max);
+  vector<double> keys(nPoints);
+
+  for (unsigned int i=0; i<nPoints; i++) {
+    switch (i % 10) {
+    case 3:
+      keys[i] = exact[(i/10) % exact.size()];
+      break;
+    case 7:
+      keys[i] = (i % 70) == 7 ? NAN : keys[i-1];
+      break;
+    default:
+      keys[i] = distribution(generator);
+      break;
+    }
+  }
+
+  return keys;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool CheckTables(mt19937& generator)
+{
+  FGPropertyManager pm;
+  FGPropertyNode* x = pm.GetNode("test/x", true);
+  FGPropertyNode* y = pm.GetNode("test/y", true);
+  FGPropertyNode* z = pm.GetNode("test/z", true);
+  double bp[] = {-10.0, -5.0, -2.0, -1.0, 0.0, 0.5, 1.0, 2.0, 3.0, 5.0, 10.0,
+                 12.0};
+  vector<double> breakpoints(bp, bp + sizeof(bp)/sizeof(bp[0]));
+
+  vector<double> xKeys = MakeKeys(-15.0, 15.0, breakpoints, generator);
+  vector<double> yKeys = MakeKeys(-2.0, 3.0, breakpoints, generator);
+  vector<double> zKeys = MakeKeys(-2.0, 3.0, breakpoints, generator);
+  vector<FGPropertyNode*> inputs;
+  vector<const double*> columns;
+  inputs.push_back(x); columns.push_back(&xKeys[0]);
+  inputs.push_back(y); columns.push_back(&yKeys[0]);
+
+  FGXMLParse parser;
+  istringstream input(tablesXML);
+  readXML(input, parser);
+  Element* el = parser.GetDocument()->FindElement("table");
+  bool success = true;
+  vector<double> values(nPoints), bound(nPoints);
+
+  for (unsigned int dimension=1; el; el=parser.GetDocument()->FindNextElement("table"), dimension++) {
+    FGTable table(&pm, el);
+
+    // Only x and y are bound: z keeps its value for all the points.
+    z->setDoubleValue(0.75);
+    table.GetValues(nPoints, &xKeys[0], &yKeys[0], &zKeys[0], &values[0]);
+    table.GetValues(nPoints, inputs, columns, &bound[0]);
+
+    for (unsigned int i=0; i<nPoints; i++) {
+      double expected;
+      switch (dimension) {
+      case 1:
+        expected = table.GetValue(xKeys[i]);
+        break;
+      case 2:
+        expected = table.GetValue(xKeys[i], yKeys[i]);
+        break;
+      default:
+        expected = table.GetValue(xKeys[i], yKeys[i], zKeys[i]);
+        break;
+      }
+
+      if (!Identical(values[i], expected)) {
+        cerr << dimension << "D table: " << values[i] << " instead of "
+             << expected << " at point " << i << endl;
+        success = false;
+        break;
+      }
+
+      x->setDoubleValue(xKeys[i]);
+      y->setDoubleValue(yKeys[i]);
+      expected = table.GetValue();
+      if (!Identical(bound[i], expected)) {
+        cerr << dimension << "D table with properties: " << bound[i]
+             << " instead of " << expected << " at point " << i << endl;
+        success = false;
+        break;
+      }
+    }
+  }
+
+  return success;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Compares the evaluation of a function over arrays with its evaluation point
+// by point and checks that the inputs are restored afterwards.
+
+bool CheckFunction(const string& name, const FGFunction& function,
+                   const vector<FGPropertyNode*>& inputs,
+                   const vector< vector<double> >& columns)
+{
+  vector<const double*> pointers;
+  vector<double> saved, values(nPoints);
+  unsigned int i, j;
+
+  for (j=0; j<inputs.size(); j++) {
+    pointers.push_back(&columns[j][0]);
+    saved.push_back(inputs[j]->getDoubleValue());
+  }
+
+  function.GetValues(nPoints, inputs, pointers, &values[0]);
+
+  for (j=0; j<inputs.size(); j++) {
+    if (!Identical(inputs[j]->getDoubleValue(), saved[j])) {
+      cerr << name << ": " << inputs[j]->GetFullyQualifiedName()
+           << " has not been restored" << endl;
+      return false;
+    }
+  }
+
+  bool success = true;
+
+  for (i=0; i<nPoints && success; i++) {
+    for (j=0; j<inputs.size(); j++) inputs[j]->setDoubleValue(columns[j][i]);
+    double expected = function.GetValue();
+
+    if (!Identical(values[i], expected)) {
+      cerr << name << ": " << values[i] << " instead of "
+           << expected << " at point " << i << endl;
+      for (j=0; j<inputs.size(); j++)
+        cerr << "  " << inputs[j]->GetFullyQualifiedName() << " = "
+             << columns[j][i] << endl;
+      success = false;
+    }
+  }
+
+  for (j=0; j<inputs.size(); j++) inputs[j]->setDoubleValue(saved[j]);
+
+  return success;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool CheckFunctions(mt19937& generator)
+{
+  FGFDMExec fdm;
+  FGPropertyManager* pm = fdm.GetPropertyManager();
+  const char* names[] = {"test/x", "test/y", "test/z"};
+  double bp[] = {-10.0, -5.0, -1.0, 0.0, 0.5, 1.0, 5.0};
+  vector<double> breakpoints(bp, bp + sizeof(bp)/sizeof(bp[0]));
+  vector<FGPropertyNode*> inputs;
+  vector< vector<double> > columns;
+
+  for (unsigned int j=0; j<3; j++) {
+    inputs.push_back(pm->GetNode(names[j], true));
+    columns.push_back(MakeKeys(-12.0, 12.0, breakpoints, generator));
+  }
+  // test/w is not an input and keeps its value.
+  pm->GetNode("test/w", true)->setDoubleValue(2.5);
+
+  FGXMLParse parser;
+  istringstream input(functionsXML);
+  readXML(input, parser);
+  Element* el = parser.GetDocument()->FindElement("function");
+  bool success = true;
+
+  for (unsigned int k=1; el; el=parser.GetDocument()->FindNextElement("function"), k++) {
+    ostringstream name;
+    name << "function #" << k;
+    FGFunction function(&fdm, el);
+    if (!CheckFunction(name.str(), function, inputs, columns)) success = false;
+
+    // The first input alone.
+    vector<FGPropertyNode*> input(1, inputs[0]);
+    vector< vector<double> > column(1, columns[0]);
+    if (!CheckFunction(name.str(), function, input, column)) success = false;
+  }
+
+  return success;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool CheckAircraft(const string& root, mt19937& generator)
+{
+  FGFDMExec fdm;
+  // The properties must be writable to compute the expected values: the
+  // outputs of the FCS components that are named after them are not.
+  const char* names[] = {"fcs/elevator-pos-rad", "fcs/aileron-pos-rad",
+                         "fcs/rudder-pos-rad", "fcs/speedbrake-pos-rad"};
+  vector<FGPropertyNode*> inputs;
+  vector< vector<double> > columns;
+  vector<double> breakpoints(1, 0.0);
+
+  SetupFDM(&fdm, root);
+
+  if (!fdm.LoadModel("f16") || !fdm.GetIC()->Load(SGPath("reset00"))) {
+    cerr << "f16: the model could not be loaded" << endl;
+    return false;
+  }
+
+  // In flight so that the dynamic pressure is not null.
+  FGInitialCondition* ic = fdm.GetIC();
+  ic->SetAltitudeASLFtIC(10000.0);
+  ic->SetVcalibratedKtsIC(300.0);
+  ic->SetAlphaDegIC(4.0);
+  ic->SetBetaDegIC(2.0);
+  if (!fdm.RunIC()) {
+    cerr << "f16: the model could not be initialized" << endl;
+    return false;
+  }
+
+  for (unsigned int j=0; j<sizeof(names)/sizeof(names[0]); j++) {
+    FGPropertyNode* node = fdm.GetPropertyManager()->GetNode(names[j]);
+    if (!node) {
+      cerr << "f16: " << names[j] << " is not defined" << endl;
+      return false;
+    }
+    inputs.push_back(node);
+    columns.push_back(MakeKeys(-0.5, 0.5, breakpoints, generator));
+  }
+
+  vector<FGFunction*>* functions = fdm.GetAerodynamics()->GetAeroFunctions();
+  bool success = true;
+
+  for (unsigned int axis=0; axis<6; axis++) {
+    for (unsigned int i=0; i<functions[axis].size(); i++) {
+      FGFunction* function = functions[axis][i];
+      // The aerodynamic functions are cached during each frame.
+      function->cacheValue(false);
+      if (!CheckFunction("f16 " + function->GetName(), *function, inputs,
+                         columns))
+        success = false;
+    }
+  }
+
+  return success;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    cerr << "Usage: " << argv[0] << " <JSBSim root directory>" << endl;
+    return 1;
+  }
+
+  mt19937 generator(20261017);
+  bool success = true;
+
+  FGJSBBase::debug_lvl = 0;
+  cerr.precision(17);
+
+  try {
+    if (!CheckTables(generator)) success = false;
+    if (!CheckFunctions(generator)) success = false;
+    if (!CheckAircraft(argv[1], generator)) success = false;
+  }
+  catch (const string& msg) {
+    cerr << msg << endl;
+    success = false;
+  }
+
+  return success ? 0 : 1;
+}
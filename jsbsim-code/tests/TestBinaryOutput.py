@@ -0,0 +1,110 @@
+# TestBinaryOutput.py
+#
+# Check that the binary output files hold the same data than the CSV files.
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import os
+import sys
+import xml.etree.ElementTree as et
+import numpy as np
+import pandas as pd
+from JSBSim_utils import JSBSimTestCase, CreateFDM, ExecuteUntil, RunTest
+
+sys.path.append(os.path.join(sys.argv[1], 'src', 'utilities'))
+from read_binary_output import load
+
+properties = ['position/h-sl-ft', 'velocities/vc-kts', 'attitude/phi-rad',
+              'fcs/throttle-cmd-norm']
+
+
+class TestBinaryOutput(JSBSimTestCase):
+    def add_output(self, root, name, type, precision=None):
+        output_tag = et.SubElement(root, 'output')
+        output_tag.attrib['name'] = name
+        output_tag.attrib['type'] = type
+        output_tag.attrib['rate'] = '10'
+        if precision:
+            output_tag.attrib['precision'] = precision
+        for p in properties:
+            property_tag = et.SubElement(output_tag, 'property')
+            property_tag.text = p
+        property_tag = et.SubElement(output_tag, 'property')
+        property_tag.attrib['caption'] = 'Altitude AGL'
+        property_tag.text = 'position/h-agl-ft'
+
+    def run_script(self):
+        script_path = self.sandbox.path_to_jsbsim_file('scripts', 'c1722.xml')
+        tree = et.parse(script_path)
+        root = tree.getroot()
+        self.add_output(root, 'test.csv', 'CSV')
+        self.add_output(root, 'test.bin', 'BINARY')
+        self.add_output(root, 'single.bin', 'BINARY', 'single')
+        tree.write('c1722_0.xml')
+
+        fdm = CreateFDM(self.sandbox)
+        fdm.load_script('c1722_0.xml')
+        fdm.run_ic()
+        ExecuteUntil(fdm, 10.)
+        del fdm
+
+    def test_header(self):
+        self.run_script()
+        header, data = load('test.bin')
+
+        self.assertEqual(header['version'], 1)
+        self.assertAlmostEqual(header['rate'], 10.0, delta=1E-4)
+        self.assertEqual(header['record_size'], 8*(len(properties)+2))
+        self.assertEqual(header['header_size'] % 8, 0)
+
+        columns = header['columns']
+        self.assertEqual(len(columns), len(properties)+2)
+        self.assertEqual(columns[0]['name'], 'Time')
+        self.assertEqual(columns[0]['unit'], 'sec')
+        for c, p in zip(columns[1:], properties):
+            self.assertEqual(c['name'], '/fdm/jsbsim/'+p)
+            self.assertEqual(c['type'], '<f8')
+        self.assertEqual(columns[1]['unit'], 'ft')
+        self.assertEqual(columns[2]['unit'], 'kts')
+        self.assertEqual(columns[4]['unit'], 'norm')
+        self.assertEqual(columns[-1]['name'], 'Altitude AGL')
+        self.assertEqual(columns[-1]['unit'], 'ft')
+
+        header, data = load('single.bin')
+        self.assertEqual(header['record_size'], 8+4*(len(properties)+1))
+        self.assertEqual(header['columns'][0]['type'], '<f8')
+        for c in header['columns'][1:]:
+            self.assertEqual(c['type'], '<f4')
+
+    def test_data(self):
+        self.run_script()
+        ref = pd.read_csv('test.csv', float_precision='round_trip')
+        header, data = load('test.bin')
+        header, single = load('single.bin')
+
+        self.assertEqual(len(data), len(ref))
+        self.assertEqual(len(single), len(ref))
+        self.assertTrue(np.allclose(data['Time'], ref['Time'], rtol=0.,
+                                    atol=1E-8))
+        self.assertTrue((data['Time'] == single['Time']).all())
+
+        # The CSV file holds the values of the properties with 18 digits so
+        # they are identical to the binary values.
+        for name in data.dtype.names[1:]:
+            self.assertTrue((data[name] == ref[name]).all(), msg=name)
+            self.assertTrue((single[name] == ref[name].astype(np.float32)).all(),
+                            msg=name)
+
+RunTest(TestBinaryOutput)
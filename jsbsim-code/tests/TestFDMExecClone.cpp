@@ -0,0 +1,151 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestFDMExecClone.cpp
+ Date started: 10/17/26
+ Purpose:      Checks that the instances built by FGFDMExec::Clone() fly like
+               the instances loaded from the XML files.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+An aircraft is loaded and cloned, then the instance it has been cloned from is
+deleted. The clone, a clone of the clone and an instance loaded from the XML
+files are flown side by side and their trajectories must match bit for bit.
+
+The test is called with the JSBSim root directory as its first argument and
+returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <string>
+
+#include "FGFDMExec.h"
+#include "initialization/FGInitialCondition.h"
+#include "test_utilities.h"
+
+using namespace std;
+using namespace JSBSim;
+
+const unsigned int nSteps = 1000;
+
+const char* outputs[] = {"position/h-sl-ft", "attitude/theta-rad",
+                         "velocities/u-fps", "velocities/q-rad_sec",
+                         "aero/coefficient/CLalpha",
+                         "propulsion/engine/thrust-lbs",
+                         "propulsion/total-fuel-lbs"};
+const unsigned int nOutputs = sizeof(outputs)/sizeof(outputs[0]);
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGFDMExec* LoadFDM(const string& root, const string& model, const string& ic)
+{
+  FGFDMExec* fdm = new FGFDMExec();
+
+  SetupFDM(fdm, root);
+
+  if (!fdm->LoadModel(model) || !fdm->GetIC()->Load(SGPath(ic))) {
+    delete fdm;
+    return 0L;
+  }
+
+  return fdm;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool CheckClone(const string& root, const string& model, const string& ic)
+{
+  FGFDMExec* source = LoadFDM(root, model, ic);
+  if (!source) return false;
+
+  FGFDMExec* fdm[3];
+  fdm[0] = LoadFDM(root, model, ic);
+  fdm[1] = source->Clone();
+  // The clones must not depend on the instance they have been cloned from.
+  delete source;
+  fdm[2] = fdm[1] ? fdm[1]->Clone() : 0L;
+
+  bool success = fdm[0] && fdm[1] && fdm[2];
+
+  if (!success) cerr << model << ": the instances could not be built" << endl;
+
+  for (unsigned int i=0; i<3 && success; i++) {
+    if (!fdm[i]->RunIC()) {
+      cerr << model << ": RunIC() failed for instance #" << i << endl;
+      success = false;
+    }
+  }
+
+  for (unsigned int n=0; n<nSteps && success; n++) {
+    for (unsigned int i=0; i<3; i++) {
+      fdm[i]->SetPropertyValue("fcs/elevator-cmd-norm", (n % 200) < 100 ? 0.1 : -0.1);
+      fdm[i]->Run();
+    }
+
+    for (unsigned int j=0; j<nOutputs; j++) {
+      FGPropertyNode* node = fdm[0]->GetPropertyManager()->GetNode(outputs[j]);
+      if (!node) continue;
+
+      double expected = node->getDoubleValue();
+      for (unsigned int i=1; i<3; i++) {
+        double value = fdm[i]->GetPropertyValue(outputs[j]);
+        if (value != expected) {
+          cerr << model << ": " << outputs[j] << " is " << value
+               << " instead of " << expected << " for clone #" << i
+               << " at step " << n << endl;
+          success = false;
+        }
+      }
+    }
+  }
+
+  for (unsigned int i=0; i<3; i++) delete fdm[i];
+
+  return success;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    cerr << "Usage: " << argv[0] << " <JSBSim root directory>" << endl;
+    return 1;
+  }
+
+  string root = argv[1];
+  bool success = true;
+
+  // An instance with no aircraft can not be cloned.
+  FGFDMExec empty;
+  empty.SetDebugLevel(0);
+  FGFDMExec* clone = empty.Clone();
+  if (clone) {
+    cerr << "An instance with no aircraft has been cloned" << endl;
+    delete clone;
+    success = false;
+  }
+
+  if (!CheckClone(root, "c172x", "reset01")) success = false;
+  if (!CheckClone(root, "737", "cruise_init")) success = false;
+
+  return success ? 0 : 1;
+}
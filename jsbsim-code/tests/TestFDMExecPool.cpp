@@ -0,0 +1,194 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestFDMExecPool.cpp
+ Date started: 10/17/26
+ Purpose:      Checks that the FDMs stepped by FGFDMExecPool give the same
+               results than FDMs stepped one by one.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+A pool of c172x is flown with a different elevator command for each aircraft.
+The same aircraft are flown one by one outside of the pool and the results must
+match bit for bit. An exception thrown by one of the aircraft must be reported
+by StepAll() on the calling thread.
+
+The test is called with the JSBSim root directory as its first argument and
+returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "FGFDMExec.h"
+#include "FGFDMExecPool.h"
+#include "initialization/FGInitialCondition.h"
+#include "models/FGPropagate.h"
+#include "test_utilities.h"
+
+using namespace std;
+using namespace JSBSim;
+
+const unsigned int nFDMs = 6;
+const unsigned int nThreads = 3;
+const unsigned int nSteps = 5;
+const unsigned int nIterations = 40;
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool InitFDM(FGFDMExec* fdm, const string& root)
+{
+  SetupFDM(fdm, root);
+
+  if (!fdm->LoadModel("c172x")) return false;
+  if (!fdm->GetIC()->Load(SGPath("reset01"))) return false;
+
+  return fdm->RunIC();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double ElevatorCmd(unsigned int idx)
+{
+  return -0.5 + idx/double(nFDMs);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    cerr << "Usage: " << argv[0] << " <JSBSim root directory>" << endl;
+    return 1;
+  }
+
+  string root = argv[1];
+  vector<string> inputs, outputs;
+
+  inputs.push_back("fcs/elevator-cmd-norm");
+  outputs.push_back("position/h-sl-ft");
+  outputs.push_back("attitude/theta-rad");
+  outputs.push_back("velocities/u-fps");
+
+  FGFDMExecPool pool(nFDMs, nThreads);
+
+  if (pool.GetNumFDMs() != nFDMs || pool.GetNumThreads() != nThreads) {
+    cerr << "Wrong pool size" << endl;
+    return 1;
+  }
+
+  for (unsigned int i=0; i<nFDMs; i++)
+    if (!InitFDM(pool.GetFDM(i), root)) return 1;
+
+  pool.SetInputProperties(inputs);
+  pool.SetOutputProperties(outputs);
+
+  double* u = pool.GetInputBuffer();
+  const double* y = pool.GetOutputBuffer();
+
+  for (unsigned int i=0; i<nFDMs; i++)
+    u[i] = ElevatorCmd(i);
+
+  // The reference FDMs are stepped one by one.
+  vector<FGFDMExec*> ref;
+  for (unsigned int i=0; i<nFDMs; i++) {
+    ref.push_back(new FGFDMExec());
+    if (!InitFDM(ref[i], root)) return 1;
+    ref[i]->SetPropertyValue(inputs[0], ElevatorCmd(i));
+  }
+
+  // StepAll(0) only reads the outputs.
+  pool.StepAll(0);
+  if (y[0] != ref[0]->GetPropertyValue(outputs[0])) {
+    cerr << "The outputs have not been read" << endl;
+    return 1;
+  }
+
+  bool success = true;
+
+  for (unsigned int n=0; n<nIterations && success; n++) {
+    if (!pool.StepAll(nSteps)) {
+      cerr << "Run() failed at iteration " << n << endl;
+      success = false;
+    }
+
+    for (unsigned int i=0; i<nFDMs; i++) {
+      for (unsigned int k=0; k<nSteps; k++) ref[i]->Run();
+
+      for (unsigned int j=0; j<outputs.size(); j++) {
+        double expected = ref[i]->GetPropertyValue(outputs[j]);
+        if (y[i*outputs.size()+j] != expected) {
+          cerr << "FDM #" << i << ": " << outputs[j] << " is "
+               << y[i*outputs.size()+j] << " instead of " << expected
+               << " at iteration " << n << endl;
+          success = false;
+        }
+      }
+    }
+  }
+
+  // The aircraft must not all have flown the same trajectory.
+  if (y[1] == y[(nFDMs-1)*outputs.size()+1]) {
+    cerr << "The inputs have not been applied" << endl;
+    success = false;
+  }
+
+  // An exception thrown by an instance is caught by the thread that steps it
+  // and thrown again from the calling thread. The position cannot be
+  // integrated with the Buss integrator so FGPropagate throws.
+  FGFDMExec* faulty = pool.GetFDM(2);
+  faulty->SetPropertyValue("simulation/integrator/position/translational",
+                           FGPropagate::eBuss1);
+  bool thrown = false;
+  try {
+    pool.StepAll(nSteps);
+  } catch (const string& msg) {
+    thrown = msg.find("FDM #2") != string::npos;
+  }
+  if (!thrown) {
+    cerr << "The exception of FDM #2 has not been thrown by StepAll()" << endl;
+    success = false;
+  }
+  for (unsigned int i=0; i<nFDMs; i++) {
+    if (pool.GetStatus(i) != (i != 2) || pool.GetError(i).empty() != (i != 2)) {
+      cerr << "Wrong status of FDM #" << i << " after an exception" << endl;
+      success = false;
+    }
+  }
+
+  faulty->SetPropertyValue("simulation/integrator/position/translational",
+                           FGPropagate::eAdamsBashforth3);
+  try {
+    if (!pool.StepAll(nSteps) || !pool.GetError(2).empty()) {
+      cerr << "The error of FDM #2 has not been cleared" << endl;
+      success = false;
+    }
+  } catch (const string& msg) {
+    cerr << "Unexpected exception: " << msg << endl;
+    success = false;
+  }
+
+  for (unsigned int i=0; i<nFDMs; i++)
+    delete ref[i];
+
+  return success ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+# TestFrameProfile.py
+#
+# Check the statistics of the frame profiler exposed in the property tree.
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+from JSBSim_utils import JSBSimTestCase, CreateFDM, RunTest
+
+sections = ['propagate', 'atmosphere', 'systems', 'propulsion',
+            'aerodynamics', 'groundreactions', 'accelerations',
+            'systems/c172/pitch', 'systems/mixture-control/automatic-mixture-control']
+
+
+class TestFrameProfile(JSBSimTestCase):
+    def initFDM(self):
+        fdm = CreateFDM(self.sandbox)
+        fdm.load_model('c172x')
+        fdm.load_ic('reset01', True)
+        fdm.run_ic()
+        return fdm
+
+    def test_disabled(self):
+        fdm = self.initFDM()
+        self.assertEqual(fdm['simulation/profile/enabled'], 0)
+        for i in range(10):
+            fdm.run()
+
+        for name in sections:
+            self.assertEqual(fdm['simulation/profile/'+name+'/count'], 0)
+            self.assertEqual(fdm['simulation/profile/'+name+'/mean-us'], 0.0)
+
+    def test_statistics(self):
+        fdm = self.initFDM()
+        fdm['simulation/profile/enabled'] = 1
+        for i in range(200):
+            fdm.run()
+
+        for name in sections:
+            prefix = 'simulation/profile/'+name+'/'
+            self.assertEqual(fdm[prefix+'count'], 200)
+            tmin = fdm[prefix+'min-us']
+            mean = fdm[prefix+'mean-us']
+            p99 = fdm[prefix+'p99-us']
+            tmax = fdm[prefix+'max-us']
+            self.assertGreater(tmin, 0.0)
+            self.assertLessEqual(tmin, mean)
+            self.assertLessEqual(mean, tmax)
+            self.assertLessEqual(tmin, p99)
+            self.assertLessEqual(p99, tmax)
+
+        # The time spent in the channels is part of the time spent in the
+        # systems.
+        self.assertLess(fdm['simulation/profile/systems/c172/pitch/mean-us'],
+                        fdm['simulation/profile/systems/mean-us'])
+
+        # Stop profiling
+        fdm['simulation/profile/enabled'] = 0
+        for i in range(10):
+            fdm.run()
+        self.assertEqual(fdm['simulation/profile/aerodynamics/count'], 200)
+
+        # Reset the statistics
+        fdm['simulation/profile/reset'] = 1
+        for name in sections:
+            self.assertEqual(fdm['simulation/profile/'+name+'/count'], 0)
+            self.assertEqual(fdm['simulation/profile/'+name+'/max-us'], 0.0)
+
+RunTest(TestFrameProfile)
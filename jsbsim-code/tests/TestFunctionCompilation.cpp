@@ -0,0 +1,189 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestFunctionCompilation.cpp
+ Date started: 10/17/26
+ Purpose:      Checks that the compiled functions return the same values than
+               the evaluation of their tree.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+An aircraft is loaded three times: the functions of the first instance are
+evaluated by walking their tree, the functions of the second instance are
+compiled and the functions of the third instance are compiled and reuse their
+value when their properties are unchanged. The instances are flown side by side
+and their trajectories must match bit for bit. The functions must also be
+compiled as soon as the model is loaded.
+
+The test is called with the JSBSim root directory as its first argument and
+returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <string>
+
+#include "FGFDMExec.h"
+#include "initialization/FGInitialCondition.h"
+#include "math/FGFunction.h"
+#include "models/FGAerodynamics.h"
+#include "test_utilities.h"
+
+using namespace std;
+using namespace JSBSim;
+
+const unsigned int nSteps = 1000;
+
+const char* outputs[] = {"position/h-sl-ft", "attitude/phi-rad",
+                         "attitude/theta-rad", "velocities/u-fps",
+                         "velocities/p-rad_sec", "velocities/q-rad_sec",
+                         "velocities/r-rad_sec", "forces/fbx-aero-lbs",
+                         "forces/fby-aero-lbs", "forces/fbz-aero-lbs",
+                         "moments/l-aero-lbsft", "moments/m-aero-lbsft",
+                         "moments/n-aero-lbsft", "fcs/elevator-pos-rad",
+                         "propulsion/engine/thrust-lbs"};
+const unsigned int nOutputs = sizeof(outputs)/sizeof(outputs[0]);
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGFDMExec* LoadFDM(const string& root, const string& model, const string& ic,
+                   bool compile, bool memoize)
+{
+  FGFDMExec* fdm = new FGFDMExec();
+
+  SetupFDM(fdm, root);
+
+  // The functions are compiled once the model is loaded.
+  FGFunction::SetCompilation(compile);
+  FGFunction::SetMemoization(memoize);
+
+  if (!fdm->LoadModel(model) || !fdm->GetIC()->Load(SGPath(ic))
+      || !fdm->RunIC()) {
+    delete fdm;
+    fdm = 0L;
+  }
+
+  FGFunction::SetCompilation(true);
+  FGFunction::SetMemoization(true);
+
+  return fdm;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool CheckCompilation(const string& root, const string& model,
+                      const string& ic)
+{
+  const unsigned int nFDM = 3;
+  FGFDMExec* fdm[nFDM];
+  fdm[0] = LoadFDM(root, model, ic, false, false);
+  fdm[1] = LoadFDM(root, model, ic, true, false);
+  fdm[2] = LoadFDM(root, model, ic, true, true);
+
+  bool success = fdm[0] && fdm[1] && fdm[2];
+
+  if (!success) cerr << model << ": the instances could not be initialized" << endl;
+
+  for (unsigned int n=0; n<nSteps && success; n++) {
+    for (unsigned int i=0; i<nFDM; i++) {
+      fdm[i]->SetPropertyValue("fcs/elevator-cmd-norm", (n % 200) < 100 ? 0.1 : -0.1);
+      fdm[i]->SetPropertyValue("fcs/aileron-cmd-norm", (n % 300) < 150 ? 0.2 : -0.2);
+      fdm[i]->SetPropertyValue("fcs/rudder-cmd-norm", (n % 500) < 250 ? 0.1 : -0.1);
+      fdm[i]->Run();
+    }
+
+    for (unsigned int j=0; j<nOutputs; j++) {
+      FGPropertyNode* node = fdm[0]->GetPropertyManager()->GetNode(outputs[j]);
+      if (!node) continue;
+
+      double expected = node->getDoubleValue();
+      for (unsigned int i=1; i<nFDM; i++) {
+        double value = fdm[i]->GetPropertyValue(outputs[j]);
+        if (value != expected) {
+          cerr << model << ": " << outputs[j] << " is " << value
+               << " instead of " << expected << " at step " << n
+               << " for instance " << i << endl;
+          success = false;
+        }
+      }
+    }
+  }
+
+  for (unsigned int i=0; i<nFDM; i++) delete fdm[i];
+
+  return success;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// The aerodynamic functions must be compiled as soon as the model is loaded,
+// before any time step.
+bool CheckLoadCompilation(const string& root, const string& model)
+{
+  FGFDMExec fdm;
+
+  SetupFDM(&fdm, root);
+
+  if (!fdm.LoadModel(model)) {
+    cerr << model << ": the model could not be loaded" << endl;
+    return false;
+  }
+
+  vector<FGFunction*>* functions = fdm.GetAerodynamics()->GetAeroFunctions();
+  unsigned int count = 0;
+
+  for (unsigned int axis=0; axis<6; axis++) {
+    for (unsigned int i=0; i<functions[axis].size(); i++) {
+      if (!functions[axis][i]->IsCompiled()) {
+        cerr << model << ": " << functions[axis][i]->GetName()
+             << " has not been compiled after the model is loaded" << endl;
+        return false;
+      }
+      count++;
+    }
+  }
+
+  if (count == 0) {
+    cerr << model << ": no aerodynamic function has been found" << endl;
+    return false;
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    cerr << "Usage: " << argv[0] << " <JSBSim root directory>" << endl;
+    return 1;
+  }
+
+  string root = argv[1];
+  bool success = true;
+
+  if (!CheckCompilation(root, "f16", "reset00")) success = false;
+  if (!CheckCompilation(root, "737", "cruise_init")) success = false;
+  if (!CheckCompilation(root, "X15", "reset01")) success = false;
+  if (!CheckLoadCompilation(root, "c172x")) success = false;
+
+  return success ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestLateBinding.cpp
+ Date started: 10/17/26
+ Purpose:      Checks that the late bound property values are bound to their
+               node once their property is defined.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+Property values are created for properties that are not yet defined. The test
+checks that they are reported as undefined by the resolution pass until their
+property is created, that they then return the value of the property, and that
+a value can safely outlive its property manager.
+
+The test returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "input_output/FGPropertyManager.h"
+#include "math/FGPropertyValue.h"
+#include "test_utilities.h"
+
+using namespace std;
+using namespace JSBSim;
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool Throws(const FGPropertyValue& value)
+{
+  try {
+    value.GetValue();
+  } catch (const string&) {
+    return true;
+  }
+
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(void)
+{
+  FGPropertyManager* pm = new FGPropertyManager;
+  FGPropertyValue x("test/x", pm);
+  FGPropertyValue minusY("-test/y", pm);
+  FGPropertyValue* z = new FGPropertyValue("test/z", pm);
+
+  Check(!x.FindNode() && Throws(x), "test/x is defined");
+
+  vector<string> undefined = pm->ResolveLateBoundValues();
+  Check(undefined.size() == 3 && undefined[0] == "test/x"
+        && undefined[1] == "test/y" && undefined[2] == "test/z",
+        "The resolution pass does not list all the undefined properties");
+
+  // Evaluating a value binds it to its node.
+  pm->GetNode("test/x", true)->setDoubleValue(2.0);
+  Check(x.GetValue() == 2.0, "test/x does not return its property value");
+  Check(x.GetName() == "test/x", "test/x has lost its name");
+
+  // The resolution pass binds the values which property has been defined.
+  pm->GetNode("test/y", true)->setDoubleValue(3.0);
+  undefined = pm->ResolveLateBoundValues();
+  Check(undefined.size() == 1 && undefined[0] == "test/z",
+        "The resolution pass lists defined properties");
+  Check(minusY.FindNode() == pm->GetNode("test/y"),
+        "test/y is not bound to its node");
+  Check(minusY.GetValue() == -3.0, "-test/y does not return its negated value");
+
+  // A destroyed value is no longer listed.
+  delete z;
+  Check(pm->ResolveLateBoundValues().empty(),
+        "A destroyed value is listed by the resolution pass");
+
+  // The values outlive the manager: the bound ones keep their node and the
+  // others remain undefined.
+  FGPropertyValue w("test/w", pm);
+  delete pm;
+  Check(x.GetValue() == 2.0, "test/x has lost its node");
+  Check(!w.FindNode() && Throws(w), "test/w is defined");
+
+  return TestResult();
+}
@@ -0,0 +1,347 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestMultiThreadedTerrain.cpp
+ Date started: 10/17/26
+ Purpose:      Checks that FGFDMExec instances running concurrently in separate
+               threads use their own ground callback.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+Two c172x are dropped from 10 ft above two different terrain elevations. Each
+one is first run alone to build a reference trajectory then both are run
+concurrently from separate threads. The concurrent trajectories must match the
+references bit for bit and each aircraft must come to rest on its own terrain.
+The touchdowns post landing gear messages from both threads at the same time so
+the test is also meant to be run under ThreadSanitizer.
+
+A c172x which carries another c172x as a child FDM is also loaded from a
+temporary directory: the child must use the ground callback of its parent,
+whether the callback is installed before or after the aircraft is loaded.
+Finally the ground callback of a running c172x is replaced twice and the
+properties computed from the copies of its location are read right away.
+
+The test is called with the JSBSim root directory as its first argument and
+returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "FGFDMExec.h"
+#include "input_output/FGGroundCallback.h"
+#include "models/FGInertial.h"
+#include "test_utilities.h"
+
+using namespace std;
+using namespace JSBSim;
+
+const int nSteps = 1200;
+
+struct Trajectory {
+  vector<double> h_agl;
+  vector<double> h_sl;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGFDMExec* CreateFDM(const string& root, double terrain_elevation)
+{
+  FGFDMExec* fdm = new FGFDMExec();
+
+  SetupFDM(fdm, root);
+
+  if (!fdm->LoadModel("c172x")) {
+    delete fdm;
+    return 0;
+  }
+
+  fdm->SetPropertyValue("ic/lat-gc-deg", 47.0);
+  fdm->SetPropertyValue("ic/long-gc-deg", 122.0);
+  fdm->SetPropertyValue("ic/terrain-elevation-ft", terrain_elevation);
+  fdm->SetPropertyValue("ic/h-agl-ft", 10.0);
+  fdm->SetPropertyValue("ic/vc-kts", 0.0);
+  fdm->SetPropertyValue("ic/psi-true-deg", 0.0);
+  fdm->SetPropertyValue("ic/theta-deg", 0.0);
+  fdm->SetPropertyValue("ic/phi-deg", 0.0);
+
+  if (!fdm->RunIC()) {
+    delete fdm;
+    return 0;
+  }
+
+  return fdm;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Fly(FGFDMExec* fdm, Trajectory* traj)
+{
+  for (int i=0; i<nSteps; ++i) {
+    fdm->Run();
+    traj->h_agl.push_back(fdm->GetPropertyValue("position/h-agl-ft"));
+    traj->h_sl.push_back(fdm->GetPropertyValue("position/h-sl-ft"));
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Compare(const Trajectory& ref, const Trajectory& traj, const string& name)
+{
+  for (int i=0; i<nSteps; ++i) {
+    if (ref.h_agl[i] != traj.h_agl[i] || ref.h_sl[i] != traj.h_sl[i]) {
+      ostringstream msg;
+      msg << name << ": trajectories differ at frame " << i;
+      Check(false, msg.str());
+      return;
+    }
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// Checks the result of a call to the file system and reports errno otherwise.
+bool CheckCall(bool success, const string& call, const SGPath& path)
+{
+  Check(success, call + " " + path.utf8Str() + " failed: " + strerror(errno));
+  return success;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// The files of the aircraft c172x_child, relative to its aircraft directory.
+const char* childFiles[] = { "c172x_child/c172x_child.xml",
+                             "c172x_child/c172ap.xml", "c172x" };
+const char* childDirs[] = { "c172x_child" };
+
+// Writes the aircraft c172x_child, a c172x carrying a c172x, in a temporary
+// directory created in the working directory. Returns false on failure, in
+// which case the directory may be partially written.
+bool WriteChildAircraft(const string& root, SGPath& aircraftDir)
+{
+  string dirTemplate = (SGPath::fromLocal8Bit(".").realpath()
+                        /"child_aircraft_XXXXXX").utf8Str();
+  vector<char> dirName(dirTemplate.begin(), dirTemplate.end());
+  dirName.push_back('\0');
+
+  if (!CheckCall(mkdtemp(&dirName[0]) != 0, "mkdtemp", SGPath(dirTemplate)))
+    return false;
+
+  aircraftDir = SGPath(&dirName[0]);
+  SGPath rootDir = SGPath::fromLocal8Bit(root.c_str()).realpath();
+  SGPath c172x = rootDir/"aircraft"/"c172x";
+  SGPath childDir = aircraftDir/childDirs[0];
+
+  if (!CheckCall(mkdir(childDir.c_str(), 0755) == 0, "mkdir", childDir)
+      || !CheckCall(symlink(c172x.c_str(), (aircraftDir/"c172x").c_str()) == 0,
+                    "symlink", aircraftDir/"c172x")
+      || !CheckCall(symlink((c172x/"c172ap.xml").c_str(),
+                            (childDir/"c172ap.xml").c_str()) == 0,
+                    "symlink", childDir/"c172ap.xml"))
+    return false;
+
+  ifstream in((c172x/"c172x.xml").utf8Str().c_str());
+  ostringstream config;
+  config << in.rdbuf();
+
+  string xml = config.str();
+  size_t end = xml.rfind("</fdm_config>");
+  Check(end != string::npos, "The c172x configuration could not be read");
+  if (end == string::npos) return false;
+
+  xml.insert(end,
+             "<child name=\"c172x\">\n"
+             "  <location unit=\"IN\"> <x> 0 </x> <y> 0 </y> <z> 50 </z> </location>\n"
+             "</child>\n");
+
+  SGPath childConfig = childDir/"c172x_child.xml";
+  ofstream out(childConfig.c_str());
+  out << xml;
+  out.close();
+
+  return CheckCall(!out.fail(), "Writing", childConfig);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// Removes the directory written by WriteChildAircraft(), whether it has been
+// completely written or not.
+void RemoveChildAircraft(const SGPath& aircraftDir)
+{
+  for (unsigned int i=0; i<sizeof(childFiles)/sizeof(childFiles[0]); ++i)
+    unlink((aircraftDir/childFiles[i]).c_str());
+  for (unsigned int i=0; i<sizeof(childDirs)/sizeof(childDirs[0]); ++i)
+    rmdir((aircraftDir/childDirs[i]).c_str());
+
+  CheckCall(rmdir(aircraftDir.c_str()) == 0, "rmdir", aircraftDir);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CheckChildTerrain(FGFDMExec& fdm, const string& root,
+                       const SGPath& aircraftDir)
+{
+  SetupFDM(&fdm, root);
+  fdm.SetAircraftPath(aircraftDir);
+
+  double radius = fdm.GetInertial()->GetRefRadius();
+  FGGroundCallback_ptr before = new FGDefaultGroundCallback(radius);
+  FGGroundCallback_ptr after = new FGDefaultGroundCallback(radius);
+
+  fdm.SetGroundCallback(before);
+  if (!fdm.LoadModel("c172x_child") || fdm.GetFDMCount() != 1) {
+    Check(false, "The aircraft with a child FDM could not be loaded");
+    return;
+  }
+
+  FGFDMExec* child = fdm.GetChildFDM(0)->exec;
+
+  Check(child->GetGroundCallback() == before,
+        "The child FDM does not use the ground callback installed before its "
+        "parent is loaded");
+
+  fdm.SetGroundCallback(after);
+  Check(child->GetGroundCallback() == after,
+        "The child FDM does not use the ground callback installed after its "
+        "parent is loaded");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CheckChildTerrain(const string& root)
+{
+  SGPath aircraftDir;
+
+  if (WriteChildAircraft(root, aircraftDir)) {
+    // The FDM must release the files before they are removed.
+    FGFDMExec fdm;
+    CheckChildTerrain(fdm, root, aircraftDir);
+  }
+
+  if (!aircraftDir.isNull()) RemoveChildAircraft(aircraftDir);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// Replaces the ground callback of a running FDM twice and reads the properties
+// tied to the copies of the vehicle location held by the models. The FDM must
+// keep the previous callbacks alive until these copies are updated by the next
+// time step.
+void CheckCallbackSwap(const string& root)
+{
+  FGFDMExec* fdm = CreateFDM(root, 0.0);
+  if (!fdm) {
+    Check(false, "The c172x could not be initialized");
+    return;
+  }
+
+  fdm->SetDebugLevel(0);
+  fdm->Run();
+
+  double radius = fdm->GetInertial()->GetRefRadius();
+  fdm->SetGroundCallback(new FGDefaultGroundCallback(radius));
+  fdm->SetGroundCallback(new FGDefaultGroundCallback(radius));
+
+  const char* properties[] = { "position/distance-from-start-mag-mt",
+                               "position/distance-from-start-lat-mt",
+                               "position/distance-from-start-lon-mt",
+                               "position/h-agl-ft" };
+
+  for (int step=0; step<2; ++step) {
+    for (unsigned int i=0; i<sizeof(properties)/sizeof(properties[0]); ++i) {
+      double value = fdm->GetPropertyValue(properties[i]);
+      Check(!std::isnan(value), string(properties[i]) + " is not a number "
+            "after the ground callback has been replaced");
+    }
+    fdm->Run();
+  }
+
+  delete fdm;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    cerr << "Usage: " << argv[0] << " <JSBSim root directory>" << endl;
+    return 1;
+  }
+
+  string root = argv[1];
+  const double elevation[2] = { 0.0, 1500.0 };
+  Trajectory ref[2], traj[2];
+  FGFDMExec* fdm[2];
+
+  // Build the reference trajectories: each FDM is run alone.
+  for (int i=0; i<2; ++i) {
+    fdm[i] = CreateFDM(root, elevation[i]);
+    Check(fdm[i] != 0, "The c172x could not be initialized");
+    if (!fdm[i]) return TestResult();
+    fdm[i]->SetDebugLevel(0);
+    Fly(fdm[i], &ref[i]);
+    delete fdm[i];
+  }
+
+  // Now run both FDMs at the same time from separate threads.
+  for (int i=0; i<2; ++i) {
+    fdm[i] = CreateFDM(root, elevation[i]);
+    Check(fdm[i] != 0, "The c172x could not be initialized");
+    if (!fdm[i]) return TestResult();
+  }
+
+  thread t0(Fly, fdm[0], &traj[0]);
+  thread t1(Fly, fdm[1], &traj[1]);
+  t0.join();
+  t1.join();
+
+  for (int i=0; i<2; ++i) {
+    const char* name = i == 0 ? "FDM #0" : "FDM #1";
+    Compare(ref[i], traj[i], name);
+
+    // Each aircraft must rest on its gears above its own terrain.
+    double h_agl = traj[i].h_agl.back();
+    double terrain = traj[i].h_sl.back() - h_agl;
+    ostringstream msg;
+    msg << name << ": terrain elevation " << terrain << " ft, expected "
+        << elevation[i] << " ft (h-agl " << h_agl << " ft)";
+    Check(fabs(terrain - elevation[i]) <= 1E-6 && h_agl >= 0.0 && h_agl <= 10.0,
+          msg.str());
+
+    delete fdm[i];
+  }
+
+  CheckChildTerrain(root);
+  CheckCallbackSwap(root);
+
+  return TestResult();
+}
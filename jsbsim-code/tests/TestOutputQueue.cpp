@@ -0,0 +1,286 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestOutputQueue.cpp
+ Date started: 10/17/26
+ Purpose:      Checks the asynchronous outputs.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+An output whose writer thread is held on a gate checks that the queue drops the
+outputs once it is full, that the counters report the drops and that the
+queued outputs are written in order, including when the writer thread is
+stopped. The c172x is then flown with the same CSV output generated
+synchronously and asynchronously: the files must be identical once the FDM is
+destroyed and the writer thread must not have been woken up for each output.
+Finally the queue sizes out of range must be clamped.
+
+The test returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "FGFDMExec.h"
+#include "initialization/FGInitialCondition.h"
+#include "input_output/FGOutputType.h"
+#include "test_utilities.h"
+
+using namespace std;
+using namespace JSBSim;
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// An output which numbers its samples and whose writer thread waits for the
+// gate to be opened.
+class GatedOutput : public FGOutputType
+{
+public:
+  GatedOutput(FGFDMExec* fdmex) : FGOutputType(fdmex), Count(0), Open(false) {}
+  ~GatedOutput() { StopWriter(); }
+
+  void Print(void) { Printed.push_back(-1.0); }
+  size_t GetSampleSize(void) const { return sizeof(double); }
+  void Sample(char* sample) { *reinterpret_cast<double*>(sample) = Count++; }
+  void PrintSample(const char* sample) {
+    unique_lock<mutex> lock(Mutex);
+    while (!Open) Gate.wait(lock);
+    Printed.push_back(*reinterpret_cast<const double*>(sample));
+  }
+
+  void SetGate(bool open) {
+    lock_guard<mutex> lock(Mutex);
+    Open = open;
+    Gate.notify_all();
+  }
+
+  double Count;
+  vector<double> Printed;
+
+private:
+  bool Open;
+  mutex Mutex;
+  condition_variable Gate;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool CheckPrinted(const GatedOutput& output, unsigned int num)
+{
+  if (output.Printed.size() != num) return false;
+
+  for (unsigned int i=0; i<num; i++)
+    if (output.Printed[i] != i) return false;
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CheckQueue(void)
+{
+  FGFDMExec fdm;
+  fdm.SetDebugLevel(0);
+
+  GatedOutput output(&fdm);
+  output.SetIdx(0);
+  output.SetAsynchronous(true, 4);
+
+  // The writer thread holds the first sample so the queue is full after 4
+  // outputs and the next ones are dropped.
+  for (unsigned int i=0; i<10; i++)
+    output.Generate();
+
+  Check(output.Count == 4, "The dropped outputs have been sampled");
+  Check(fdm.GetPropertyValue("simulation/output/queue/pending") == 4,
+        "The queue does not hold 4 outputs");
+  Check(fdm.GetPropertyValue("simulation/output/queue/dropped") == 6,
+        "6 outputs should have been dropped");
+  Check(fdm.GetPropertyValue("simulation/output/queue/overflows") == 1,
+        "The queue should have overflowed once");
+
+  output.SetGate(true);
+  output.Flush();
+
+  Check(CheckPrinted(output, 4), "The queued outputs are not printed in order");
+  Check(fdm.GetPropertyValue("simulation/output/queue/written") == 4,
+        "4 outputs should have been written");
+  Check(fdm.GetPropertyValue("simulation/output/queue/pending") == 0,
+        "The queue is not empty after a flush");
+
+  // The queued outputs are written when the writer thread is stopped and the
+  // counters are kept.
+  output.SetGate(false);
+  for (unsigned int i=0; i<6; i++)
+    output.Generate();
+  output.SetGate(true);
+  output.StopWriter();
+
+  Check(CheckPrinted(output, 8),
+        "The queued outputs are not written when the writer thread stops");
+  Check(fdm.GetPropertyValue("simulation/output/queue/written") == 8,
+        "8 outputs should have been written");
+  Check(fdm.GetPropertyValue("simulation/output/queue/dropped") == 8,
+        "8 outputs should have been dropped");
+  Check(fdm.GetPropertyValue("simulation/output/queue/overflows") == 2,
+        "The queue should have overflowed twice");
+
+  // The output is printed by the simulation thread once it is synchronous.
+  output.SetAsynchronous(false);
+  output.Generate();
+  Check(output.Printed.size() == 9 && output.Printed.back() == -1.0,
+        "The synchronous output is not printed");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void WriteDirectives(const string& fname, const string& name, bool async,
+                     const string& queue_size = "1024")
+{
+  ofstream out(fname.c_str());
+
+  out << "<output name=\"" << name << "\" type=\"CSV\" rate=\"20\"";
+  if (async) out << " async=\"true\" queue_size=\"" << queue_size << "\"";
+  out << ">" << endl
+      << "  <property> position/h-sl-ft </property>" << endl
+      << "  <property> velocities/vc-kts </property>" << endl
+      << "  <property> attitude/theta-rad </property>" << endl
+      << "  <property> fcs/elevator-pos-rad </property>" << endl
+      << "</output>" << endl;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+string ReadFile(const string& fname)
+{
+  ifstream in(fname.c_str());
+  ostringstream buffer;
+
+  buffer << in.rdbuf();
+  return buffer.str();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CheckCSV(const string& root)
+{
+  SGPath cwd = SGPath::fromLocal8Bit(".").realpath();
+  SGPath syncDirectives = cwd/"output_queue_sync.xml";
+  SGPath asyncDirectives = cwd/"output_queue_async.xml";
+
+  WriteDirectives(syncDirectives.utf8Str(), "output_queue_sync.csv", false);
+  WriteDirectives(asyncDirectives.utf8Str(), "output_queue_async.csv", true);
+
+  // The output files are written relatively to the root directory.
+  FGFDMExec* fdm = new FGFDMExec();
+  SetupFDM(fdm, root, cwd);
+
+  if (!fdm->LoadModel("c172x") || !fdm->GetIC()->Load(SGPath("reset01"))
+      || !fdm->SetOutputDirectives(syncDirectives)
+      || !fdm->SetOutputDirectives(asyncDirectives) || !fdm->RunIC()) {
+    Check(false, "The c172x could not be initialized");
+    delete fdm;
+    return;
+  }
+
+  for (unsigned int n=0; n<2400; n++) {
+    fdm->SetPropertyValue("fcs/elevator-cmd-norm", (n % 200) < 100 ? 0.1 : -0.1);
+    fdm->Run();
+  }
+
+  // The output #0 is defined by the c172x.
+  Check(fdm->GetPropertyValue("simulation/output[1]/queue/written") == 0,
+        "The synchronous output has been queued");
+  Check(fdm->GetPropertyValue("simulation/output[2]/queue/written") > 0,
+        "The asynchronous output has not been queued");
+  Check(fdm->GetPropertyValue("simulation/output[2]/queue/dropped") == 0,
+        "The asynchronous output has dropped outputs");
+
+  // The writer thread polls the queue by itself: the simulation thread must
+  // not wake it up for each output.
+  double written = fdm->GetPropertyValue("simulation/output[2]/queue/written");
+  double wakeups = fdm->GetPropertyValue("simulation/output[2]/queue/wakeups");
+  Check(wakeups * 10 < written,
+        "The writer thread has been woken up for most of the outputs");
+
+  // The queued outputs must be written when the FDM is destroyed.
+  delete fdm;
+
+  string expected = ReadFile("output_queue_sync.csv");
+  string result = ReadFile("output_queue_async.csv");
+
+  Check(!expected.empty(), "The synchronous output is empty");
+  Check(result == expected,
+        "The asynchronous output differs from the synchronous output");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// The queue sizes out of range are clamped: the outputs must still be written.
+void CheckQueueSizeRange(const string& root)
+{
+  const char* sizes[] = { "-5", "0", "1e12" };
+  SGPath cwd = SGPath::fromLocal8Bit(".").realpath();
+
+  for (unsigned int i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+    SGPath directives = cwd/"output_queue_range.xml";
+    WriteDirectives(directives.utf8Str(), "output_queue_range.csv", true,
+                    sizes[i]);
+    remove("output_queue_range.csv");
+
+    FGFDMExec* fdm = new FGFDMExec();
+    SetupFDM(fdm, root, cwd);
+
+    if (!fdm->LoadModel("c172x") || !fdm->GetIC()->Load(SGPath("reset01"))
+        || !fdm->SetOutputDirectives(directives) || !fdm->RunIC()) {
+      Check(false, "The c172x could not be initialized");
+      delete fdm;
+      return;
+    }
+
+    for (unsigned int n=0; n<120; n++) fdm->Run();
+
+    delete fdm;
+
+    Check(!ReadFile("output_queue_range.csv").empty(),
+          string("The output with a queue size of ") + sizes[i]
+          + " has not been written");
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  string root = argc > 1 ? argv[1] : ".";
+
+  CheckQueue();
+  CheckCSV(root);
+  CheckQueueSizeRange(root);
+
+  return TestResult();
+}
@@ -0,0 +1,131 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestPropertyArena.cpp
+ Date started: 10/17/26
+ Purpose:      Checks the allocation of the property nodes from an arena.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+A tree is built from an arena with small blocks. The test checks that the
+children are allocated next to each other, that the nodes passed on the arena
+to their children, that freed nodes are recycled, that the names are shared
+between the nodes and that a node can outlive both its tree and its arena.
+It then checks that an FDM allocates its properties from an arena unless the
+arena has been disabled.
+
+The test is called with the JSBSim root directory as its first argument and
+returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <string>
+
+#include "FGFDMExec.h"
+#include "test_utilities.h"
+
+using namespace std;
+using namespace JSBSim;
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CheckFDM(const string& root, bool arena)
+{
+  FGFDMExec fdm;
+  SetupFDM(&fdm, root);
+  fdm.LoadModel("c172x");
+
+  SGPropertyNodeArena* nodes = fdm.GetPropertyManager()->GetNode()->getArena();
+  if (arena)
+    Check(nodes && nodes->getNumNodes() > 500,
+          "The properties of the FDM are not allocated from an arena");
+  else
+    Check(!nodes, "The properties of the FDM are allocated from an arena");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    cerr << "Usage: " << argv[0] << " <JSBSim root directory>" << endl;
+    return 1;
+  }
+
+  SGPropertyNodeArena_ptr arena = new SGPropertyNodeArena(4);
+  SGPropertyNode_ptr root = new SGPropertyNode;
+  root->setArena(arena);
+
+  SGPropertyNode* test = root->getNode("test", true);
+  SGPropertyNode* x[10];
+  for (int i=0; i<10; i++)
+    x[i] = test->getChild("x", i, true);
+
+  Check(arena->getNumNodes() == 11 && arena->getNumBlocks() == 3,
+        "The nodes are not allocated from the arena");
+  Check(test->getArena() == arena && x[9]->getArena() == arena,
+        "The children do not pass the arena on");
+  ptrdiff_t step = (char*)x[2] - (char*)x[1];
+  Check(step > 0 && (char*)x[1] - (char*)x[0] == step,
+        "The siblings are not next to each other");
+
+  // The names are shared by the nodes.
+  Check(&x[0]->getNameString() == &x[9]->getNameString(),
+        "The names are not shared");
+  Check(x[3]->getNameString() == "x" && x[3]->getIndex() == 3,
+        "test/x[3] has lost its name");
+
+  // The freed nodes are recycled.
+  test->removeChild("x", 9);
+  test->removeChild("x", 8);
+  Check(arena->getNumNodes() == 9, "The removed nodes have not been freed");
+  test->getChild("y", 0, true);
+  test->getChild("y", 1, true);
+  Check(arena->getNumNodes() == 11 && arena->getNumBlocks() == 3,
+        "The freed nodes have not been recycled");
+
+  // A node outlives its tree and its arena.
+  SGPropertyNode_ptr kept = x[5];
+  x[5]->setDoubleValue(5.0);
+  root = 0;
+  Check(arena->getNumNodes() == 1, "The nodes of the tree have not been freed");
+  arena = 0;
+  Check(kept->getDoubleValue() == 5.0 && kept->getNameString() == "x",
+        "The node did not outlive its arena");
+  kept = 0;
+
+  // A node which is not allocated from an arena does not pass one on.
+  SGPropertyNode_ptr heap = new SGPropertyNode;
+  Check(!heap->getNode("a/b", true)->getArena(),
+        "The children of a node are allocated from an arena");
+
+  // Invalid names are rejected.
+  try {
+    heap->getChild("1x", 0, true);
+    Check(false, "An invalid name has been accepted");
+  } catch (const string&) {}
+
+  CheckFDM(argv[1], true);
+  FGFDMExec::SetPropertyArena(false);
+  CheckFDM(argv[1], false);
+
+  return TestResult();
+}
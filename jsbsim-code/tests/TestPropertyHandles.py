@@ -0,0 +1,116 @@
+# TestPropertyHandles.py
+#
+# Check that the property handles read and write the same values than the
+# property names.
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import numpy as np
+import jsbsim
+from JSBSim_utils import JSBSimTestCase, CreateFDM, RunTest
+
+properties = ['position/h-sl-ft', 'attitude/theta-rad', 'velocities/u-fps',
+              'fcs/elevator-cmd-norm', 'fcs/throttle-cmd-norm']
+
+
+class TestPropertyHandles(JSBSimTestCase):
+    def setUp(self):
+        JSBSimTestCase.setUp(self)
+        self.fdm = CreateFDM(self.sandbox)
+        self.fdm.load_model('c172x')
+        self.fdm.load_ic('reset01', True)
+        self.fdm.run_ic()
+        for i in range(10):
+            self.fdm.run()
+
+    def tearDown(self):
+        del self.fdm
+        JSBSimTestCase.tearDown(self)
+
+    def test_handle(self):
+        fdm = self.fdm
+        for name in properties:
+            h = fdm.get_property_handle(name)
+            self.assertEqual(h.get_name(), '/fdm/jsbsim/'+name)
+            self.assertEqual(h.get(), fdm[name])
+
+        h = fdm.get_property_handle('fcs/elevator-cmd-norm')
+        h.set(0.25)
+        self.assertEqual(fdm['fcs/elevator-cmd-norm'], 0.25)
+
+        with self.assertRaises(KeyError):
+            fdm.get_property_handle('test/new-property')
+        h = fdm.get_property_handle('test/new-property', True)
+        h.set(1.5)
+        self.assertEqual(fdm['test/new-property'], 1.5)
+
+        # A handle which is not returned by the FDM is not bound to a property.
+        h = jsbsim.PropertyHandle()
+        with self.assertRaises(RuntimeError):
+            h.get_name()
+        with self.assertRaises(RuntimeError):
+            h.get()
+        with self.assertRaises(RuntimeError):
+            h.set(0.0)
+        with self.assertRaises(ValueError):
+            jsbsim.PropertyHandleArray([h])
+
+    def test_array(self):
+        fdm = self.fdm
+        handles = fdm.get_property_handles(properties)
+        self.assertEqual(len(handles), len(properties))
+        self.assertEqual(handles.get_names(),
+                         ['/fdm/jsbsim/'+name for name in properties])
+        self.assertEqual(handles[1].get(), fdm[properties[1]])
+
+        values = handles.gather()
+        self.assertEqual(list(values), [fdm[name] for name in properties])
+
+        # The values are stored in the supplied buffer.
+        buf = np.zeros(len(properties))
+        self.assertIs(handles.gather(buf), buf)
+        self.assertTrue((buf == values).all())
+
+        controls = fdm.get_property_handles(properties[3:])
+        controls.scatter([-0.1, 0.7])
+        self.assertEqual(fdm['fcs/elevator-cmd-norm'], -0.1)
+        self.assertEqual(fdm['fcs/throttle-cmd-norm'], 0.7)
+
+        with self.assertRaises(ValueError):
+            controls.scatter([0.0])
+        with self.assertRaises(ValueError):
+            handles.gather(np.zeros(2))
+        with self.assertRaises(IndexError):
+            handles[len(properties)]
+
+    def test_run_steps(self):
+        fdm = self.fdm
+        u = fdm.get_property_handles(properties[3:])
+        y = fdm.get_property_handles(properties[:3])
+        out = np.empty(3)
+        fdm.run_steps(5, u, [0.1, 0.8], y, out)
+        self.assertTrue((out == y.gather()).all())
+        self.assertEqual(fdm['fcs/throttle-cmd-norm'], 0.8)
+
+        # Handles of different FDMs can not be mixed.
+        fdm2 = CreateFDM(self.sandbox)
+        fdm2.load_model('c172x')
+        h2 = fdm2.get_property_handle(properties[0])
+        with self.assertRaises(ValueError):
+            fdm.run_steps(1, u, [0.1, 0.8], fdm2.get_property_handles(properties[:3]), out)
+        with self.assertRaises(ValueError):
+            jsbsim.PropertyHandleArray([y[0], h2])
+
+RunTest(TestPropertyHandles)
@@ -0,0 +1,144 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestPropertyLookup.cpp
+ Date started: 10/17/26
+ Purpose:      Checks that the properties are found by their path when their
+               parent indexes its children and when the paths are cached.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+A node is given enough children with the same name or with different names for
+their lookup to go through its index. The test checks that each child is found
+by its name and index, that children added after the index has been built are
+found too, and that a removed node is no longer returned by the path cache of
+the property manager, neither before nor after it has been created again. The
+removals must only be counted by the tree they are made in.
+
+The test returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "input_output/FGPropertyManager.h"
+#include "test_utilities.h"
+
+using namespace std;
+using namespace JSBSim;
+
+const int N = 100;
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+string Path(const string& name, int i)
+{
+  ostringstream path;
+  path << "test/" << name << "[" << i << "]";
+  return path.str();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CheckChildren(FGPropertyManager& pm, int n)
+{
+  FGPropertyNode* test = pm.GetNode("test");
+
+  for (int i = 0; i < n; i++) {
+    Check(pm.HasNode(Path("x", i)), Path("x", i) + " does not exist");
+    Check(pm.GetNode(Path("x", i))->getDoubleValue() == i,
+          Path("x", i) + " has not been found");
+    Check(test->getChild("x", i) == pm.GetNode(Path("x", i)),
+          Path("x", i) + " is not found by its parent");
+  }
+
+  for (int i = 0; i < N; i++) {
+    ostringstream name;
+    name << "test/x" << i;
+    Check(pm.GetNode(name.str())->getDoubleValue() == -i,
+          name.str() + " has not been found");
+  }
+
+  Check(!pm.HasNode(Path("x", n)), Path("x", n) + " exists");
+  Check(!pm.HasNode("test/xx"), "test/xx exists");
+  Check(!test->getChild("y", 0), "test/y exists");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(void)
+{
+  FGPropertyManager pm;
+
+  for (int i = 0; i < N; i++) {
+    ostringstream name;
+    name << "test/x" << i;
+    pm.GetNode(Path("x", i), true)->setDoubleValue(i);
+    pm.GetNode(name.str(), true)->setDoubleValue(-i);
+  }
+
+  CheckChildren(pm, N);
+
+  // Children added after the index has been built are found.
+  pm.GetNode(Path("x", N), true)->setDoubleValue(N);
+  pm.GetNode("test", 0)->addChild("x")->setDoubleValue(N+1);
+  CheckChildren(pm, N+2);
+
+  // A removed node is no longer found through the path cache.
+  FGPropertyNode* test = pm.GetNode("test");
+  test->removeChild("x", 10);
+  Check(!pm.HasNode(Path("x", 10)), Path("x", 10) + " has not been removed");
+  Check(!test->getChild("x", 10), Path("x", 10) + " is found by its parent");
+
+  // It is found again once it has been created again.
+  FGPropertyNode* newX10 = pm.GetNode(Path("x", 10), true);
+  newX10->setDoubleValue(10.0);
+  Check(pm.GetNode(Path("x", 10)) == newX10,
+        "The cache returns a former " + Path("x", 10));
+  Check(test->getChild("x", 10) == newX10,
+        Path("x", 10) + " is not found by its parent");
+  CheckChildren(pm, N+2);
+
+  // The lookups give the same results without the cache.
+  pm.SetPathCache(false);
+  CheckChildren(pm, N+2);
+
+  test->removeAllChildren();
+  Check(!pm.HasNode(Path("x", 0)), "The children of test have not been removed");
+  Check(!test->getChild("x", 0), Path("x", 0) + " is found by its parent");
+
+  // The removals are counted per tree: the caches of the other trees are kept.
+  FGPropertyManager other;
+  other.GetNode(Path("x", 0), true);
+  unsigned long changes = pm.GetNode()->getStructureChanges();
+  unsigned long otherChanges = other.GetNode()->getStructureChanges();
+  other.GetNode("test")->removeChild("x", 0);
+  Check(pm.GetNode()->getStructureChanges() == changes,
+        "A removal in another tree is counted");
+  Check(other.GetNode()->getStructureChanges() != otherChanges,
+        "A removal is not counted by its tree");
+  Check(pm.GetNode(Path("x", 3), true)->getStructureChanges()
+        == pm.GetNode()->getStructureChanges(),
+        "The nodes of a tree do not share its count");
+
+  return TestResult();
+}
@@ -0,0 +1,136 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestPropertyProfiler.cpp
+ Date started: 10/17/26
+ Purpose:      Checks that the property profiler counts the accesses to the
+               properties and attributes them to their caller.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+Two property managers are created and only the first one is profiled. The
+test reads, writes and looks up properties from different scopes and checks
+the counters, the report and that the properties of the second manager are
+not counted. It then checks that disabling the profiler restores the direct
+reads of the values.
+
+The test returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "input_output/FGPropertyManager.h"
+#include "input_output/FGPropertyProfiler.h"
+#include "test_utilities.h"
+
+using namespace std;
+using namespace JSBSim;
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(void)
+{
+  FGPropertyManager pm, other;
+  FGPropertyProfiler profiler(&pm);
+  double variable = 1.0;
+
+  pm.Tie("test/variable", &variable);
+  FGPropertyNode* x = pm.GetNode("test/x", true);
+  FGPropertyNode* otherX = other.GetNode("test/x", true);
+
+  profiler.SetEnabled(true);
+
+  // Nodes created after the profiler is enabled are profiled as well.
+  FGPropertyNode* y = pm.GetNode("test/y", true);
+
+  x->setDoubleValue(2.0);
+  x->setDoubleValue(3.0);
+  otherX->setDoubleValue(2.0);
+  {
+    FGPropertyProfiler::Scope function(FGPropertyProfiler::ecFunction);
+    x->getDoubleValue();
+    y->getDoubleValue();
+    pm.GetNode("test/variable")->getDoubleValue();
+    otherX->getDoubleValue();
+    {
+      FGPropertyProfiler::Scope table(FGPropertyProfiler::ecTable);
+      x->getDoubleValue();
+    }
+    x->getDoubleValue();
+  }
+  y->setDoubleValue(4.0);
+  // Found once from the tree and once from the cache.
+  pm.GetNode("test/y");
+  pm.HasNode("test/y");
+
+  FGPropertyProfiler::Counters c = profiler.GetCounters(x);
+  Check(c.Writes[FGPropertyProfiler::ecOther] == 2 && c.GetWrites() == 2,
+        "test/x has not been written twice");
+  Check(c.Reads[FGPropertyProfiler::ecFunction] == 2
+        && c.Reads[FGPropertyProfiler::ecTable] == 1 && c.GetReads() == 3,
+        "The reads of test/x are not attributed to their caller");
+
+  c = profiler.GetCounters(y);
+  Check(c.GetReads() == 1 && c.GetWrites() == 1,
+        "The accesses to test/y have not been counted");
+  Check(c.GetLookups() >= 2, "The lookups of test/y have not been counted");
+
+  c = profiler.GetCounters(pm.GetNode("test/variable"));
+  Check(c.Reads[FGPropertyProfiler::ecFunction] == 1,
+        "The read of test/variable has not been counted");
+
+  c = profiler.GetCounters(otherX);
+  Check(c.GetReads() == 0 && c.GetWrites() == 0 && c.GetLookups() == 0,
+        "The accesses to the properties of another tree have been counted");
+
+  ostringstream report;
+  profiler.Print(report);
+  Check(report.str().find("test/x") != string::npos,
+        "test/x is missing from the report");
+  Check(report.str().find("test/x[") == string::npos,
+        "The report does not simplify the paths");
+
+  // A property which is written but never read is reported as such.
+  pm.GetNode("test/unread", true)->setDoubleValue(1.0);
+  report.str("");
+  profiler.Print(report);
+  string unread = report.str().substr(report.str().find("never read"));
+  Check(unread.find("test/unread") != string::npos,
+        "test/unread is not reported as written but never read");
+  Check(unread.find("test/x") == string::npos,
+        "test/x is reported as written but never read");
+
+  // Once disabled, the values are read from their storage again.
+  profiler.SetEnabled(false);
+  Check(x->getDoubleAddress() != 0L && y->getDoubleAddress() != 0L,
+        "The values can not be read from their storage");
+  x->getDoubleValue();
+  Check(profiler.GetCounters(x).GetReads() == 3,
+        "The profiler counts the accesses once disabled");
+
+  profiler.ResetStatistics();
+  Check(profiler.GetCounters(y).GetWrites() == 0,
+        "The counters have not been reset");
+
+  return TestResult();
+}
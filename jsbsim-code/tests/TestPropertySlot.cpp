@@ -0,0 +1,154 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestPropertySlot.cpp
+ Date started: 10/17/26
+ Purpose:      Checks that the property slots read the values from where they
+               are stored.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+Slots are created for properties tied to a variable, to methods, to the member
+of an object, for properties holding their own value and for a property which is
+not yet set. The test
+checks that each slot returns the same value than the node and that it reads
+the value directly only when it is stored in a double, including after the
+property has been set, tied or untied, or untied and tied again to another
+variable between two reads.
+
+The test returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "input_output/FGPropertyManager.h"
+#include "test_utilities.h"
+
+using namespace std;
+using namespace JSBSim;
+
+class Model {
+public:
+  Model(void) : x(0.5) {}
+  double GetX(void) const { return x; }
+  void SetX(double value) { x = value; }
+  double x;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CheckSlot(const FGPropertySlot& slot, bool direct, const string& name)
+{
+  double expected = slot.GetNode()->getDoubleValue();
+  ostringstream msg;
+
+  msg << name << " is " << slot.getDoubleValue() << " instead of " << expected;
+  Check(slot.getDoubleValue() == expected, msg.str());
+  Check(slot.IsDirect() == direct,
+        name + (direct ? " is not" : " is") + " read directly");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(void)
+{
+  FGPropertyManager pm;
+  Model model;
+  double variable = 1.0;
+  int counter = 3;
+
+  pm.Tie("test/variable", &variable);
+  pm.Tie("test/counter", &counter);
+  pm.Tie("test/method", &model, &Model::GetX, &Model::SetX);
+  pm.Tie("test/member", &model, &Model::x, &Model::SetX);
+  pm.Tie("test/read-only", &model, &Model::x);
+
+  FGPropertySlot tied(pm.GetNode("test/variable"));
+  FGPropertySlot integer(pm.GetNode("test/counter"));
+  FGPropertySlot method(pm.GetNode("test/method"));
+  FGPropertySlot member(pm.GetNode("test/member"));
+  FGPropertySlot local(pm.GetNode("test/local", true));
+
+  CheckSlot(tied, true, "test/variable");
+  CheckSlot(integer, false, "test/counter");
+  CheckSlot(method, false, "test/method");
+  CheckSlot(member, true, "test/member");
+  // The storage of a property which is not set is not yet known.
+  CheckSlot(local, false, "test/local");
+
+  variable = 2.0;
+  counter = 4;
+  model.x = 0.25;
+  local.GetNode()->setDoubleValue(-1.5);
+
+  CheckSlot(tied, true, "test/variable");
+  CheckSlot(integer, false, "test/counter");
+  CheckSlot(method, false, "test/method");
+  CheckSlot(member, true, "test/member");
+  CheckSlot(local, true, "test/local");
+
+  // A member is modified through the setter of its object, if any.
+  member.GetNode()->setDoubleValue(0.75);
+  Check(model.x == 0.75, "test/member does not modify its member");
+  CheckSlot(member, true, "test/member");
+
+  SGPropertyNode* readOnly = pm.GetNode("test/read-only");
+  Check(!readOnly->setDoubleValue(1.0) && model.x == 0.75
+        && readOnly->getDoubleValue() == 0.75, "test/read-only is modifiable");
+
+  // The slot follows the property when it is tied or untied.
+  double other = 7.0;
+  pm.Tie("test/local", &other, false);
+  CheckSlot(local, true, "test/local");
+  Check(local.getDoubleValue() == 7.0,
+        "test/local is not read from its new variable");
+
+  pm.Untie("test/local");
+  other = 8.0;
+  CheckSlot(local, true, "test/local");
+  Check(local.getDoubleValue() == 7.0,
+        "test/local is still read from its former variable");
+
+  pm.Untie("test/variable");
+  CheckSlot(tied, true, "test/variable");
+
+  pm.Tie("test/variable", &model, &Model::GetX, &Model::SetX);
+  CheckSlot(tied, false, "test/variable");
+
+  // The slot must not keep reading a former variable when the property has
+  // been untied and tied again to another variable between two reads.
+  double* first = new double(3.0);
+  double second = 4.0;
+  pm.Tie("test/retied", first);
+  FGPropertySlot retied(pm.GetNode("test/retied"));
+  CheckSlot(retied, true, "test/retied");
+
+  pm.Untie("test/retied");
+  delete first;
+  pm.Tie("test/retied", &second, false);
+  CheckSlot(retied, true, "test/retied");
+  Check(retied.getDoubleValue() == 4.0,
+        "test/retied is not read from the variable it has been tied again to");
+
+  return TestResult();
+}
@@ -0,0 +1,72 @@
+# TestRandomSeed.py
+#
+# Check that the random numbers of an FDM only depend on the property
+# simulation/randomseed so that runs can be replayed.
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+from JSBSim_utils import JSBSimTestCase, CreateFDM, RunTest
+
+turb_props = ['atmosphere/turb-north-fps', 'atmosphere/turb-east-fps',
+              'atmosphere/turb-down-fps', 'atmosphere/p-turb-rad_sec']
+
+
+class TestRandomSeed(JSBSimTestCase):
+    def initFDM(self, seed):
+        fdm = CreateFDM(self.sandbox)
+        fdm.load_model('c172x')
+        fdm.load_ic('reset01', True)
+        fdm['atmosphere/turb-type'] = 3  # Milspec
+        fdm['atmosphere/turbulence/milspec/windspeed_at_20ft_AGL-fps'] = 30.0
+        fdm['atmosphere/turbulence/milspec/severity'] = 4
+        fdm['simulation/randomseed'] = seed
+        fdm.run_ic()
+        return fdm
+
+    def step(self, fdm):
+        fdm.run()
+        return [fdm[prop] for prop in turb_props]
+
+    def record(self, fdm, n=200):
+        return [self.step(fdm) for i in range(n)]
+
+    def test_replay(self):
+        fdm = self.initFDM(1)
+        ref = self.record(fdm)
+
+        # Setting the seed again restarts the random sequences.
+        fdm['simulation/randomseed'] = 1
+        fdm.reset_to_initial_conditions(0)
+        self.assertEqual(self.record(fdm), ref)
+
+        # Another seed gives another turbulence.
+        fdm['simulation/randomseed'] = 2
+        fdm.reset_to_initial_conditions(0)
+        self.assertNotEqual(self.record(fdm), ref)
+
+    def test_independent_instances(self):
+        fdm = self.initFDM(1)
+        ref = self.record(fdm)
+        del fdm
+
+        # Two instances with the same seed run in lockstep must not disturb
+        # each other's random sequences.
+        fdm1 = self.initFDM(1)
+        fdm2 = self.initFDM(1)
+        for x in ref:
+            self.assertEqual(self.step(fdm1), x)
+            self.assertEqual(self.step(fdm2), x)
+
+RunTest(TestRandomSeed)
@@ -0,0 +1,110 @@
+# TestRunSteps.py
+#
+# Check that FGFDMExec.run_steps() gives the same results than run() and that
+# it can be called from several threads.
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License as published by the Free Software
+# Foundation; either version 3 of the License, or (at your option) any later
+# version.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+# details.
+#
+# You should have received a copy of the GNU General Public License along with
+# this program; if not, see <http://www.gnu.org/licenses/>
+#
+
+import threading
+import numpy as np
+from JSBSim_utils import JSBSimTestCase, CreateFDM, RunTest
+
+actions = ['fcs/elevator-cmd-norm', 'fcs/aileron-cmd-norm']
+observations = ['position/h-sl-ft', 'attitude/theta-rad', 'attitude/phi-rad',
+                'velocities/u-fps']
+
+
+class TestRunSteps(JSBSimTestCase):
+    def initFDM(self):
+        fdm = CreateFDM(self.sandbox)
+        fdm.load_model('c172x')
+        fdm.load_ic('reset01', True)
+        fdm.run_ic()
+        u = [fdm.get_property_handle(name) for name in actions]
+        y = [fdm.get_property_handle(name) for name in observations]
+        return fdm, u, y
+
+    def command(self, k):
+        return np.array([0.1*np.sin(0.3*k), -0.05*k])
+
+    def reference(self, n, nsteps):
+        fdm = CreateFDM(self.sandbox)
+        fdm.load_model('c172x')
+        fdm.load_ic('reset01', True)
+        fdm.run_ic()
+        record = []
+        for k in range(n):
+            for name, value in zip(actions, self.command(k)):
+                fdm[name] = value
+            for i in range(nsteps):
+                fdm.run()
+                record.append([fdm[name] for name in observations])
+        return np.array(record)
+
+    def test_run_steps(self):
+        ref = self.reference(10, 12)
+        fdm, u, y = self.initFDM()
+        obs = np.empty(len(observations))
+        for k in range(10):
+            self.assertTrue(fdm.run_steps(12, u, self.command(k), y, obs))
+            self.assertTrue((obs == ref[12*k+11]).all())
+
+    def test_record(self):
+        ref = self.reference(5, 20)
+        fdm, u, y = self.initFDM()
+        obs = np.empty((20, len(observations)))
+        for k in range(5):
+            fdm.run_steps(20, u, self.command(k), y, obs)
+            self.assertTrue((obs == ref[20*k:20*(k+1)]).all())
+
+    def test_bad_arguments(self):
+        fdm, u, y = self.initFDM()
+        fdm2, u2, y2 = self.initFDM()
+        obs = np.empty(len(observations))
+
+        with self.assertRaises(ValueError):
+            fdm.run_steps(1, u, [0.0], y, obs)
+        with self.assertRaises(ValueError):
+            fdm.run_steps(1, u, [0.0, 0.0], y, np.empty(2))
+        with self.assertRaises(ValueError):
+            fdm.run_steps(1, u, [0.0, 0.0], y, np.empty(len(observations),
+                                                         dtype=np.float32))
+        with self.assertRaises(ValueError):
+            fdm.run_steps(1, u, [0.0, 0.0], y2, obs)
+        with self.assertRaises(TypeError):
+            fdm.run_steps(1, actions, [0.0, 0.0], y, obs)
+        with self.assertRaises(KeyError):
+            fdm.get_property_handle('no/such/property')
+
+    def test_threads(self):
+        ref = self.reference(10, 12)
+        fdms = [self.initFDM() for i in range(4)]
+        results = [np.empty((120, len(observations))) for fdm in fdms]
+
+        def fly(fdm, u, y, out):
+            for k in range(10):
+                fdm.run_steps(12, u, self.command(k), y, out[12*k:12*(k+1)])
+
+        threads = [threading.Thread(target=fly, args=fdm+(out,))
+                   for fdm, out in zip(fdms, results)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+
+        for out in results:
+            self.assertTrue((out == ref).all())
+
+RunTest(TestRunSteps)
@@ -0,0 +1,397 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestSocketInput.cpp
+ Date started: 10/17/26
+ Purpose:      Checks the binary protocol of the socket inputs.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+The c172x is loaded with a text socket input and a binary socket input. A client
+connected on the loopback interface registers properties with the binary input
+and checks that its set and vector messages are applied as a whole, at the time
+step that follows their reception. The rejected messages must not change any
+property. The reply to the registration of many properties, which does not fit
+in the connection, must be received whole and followed by the next reply.
+
+The same controls are then driven through the text commands and through the
+binary messages, and the number of commands applied per second of input
+processing is printed for both protocols.
+
+The test returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FGFDMExec.h"
+#include "initialization/FGInitialCondition.h"
+#include "input_output/FGInputSocket.h"
+#include "input_output/binary_utilities.h"
+#include "models/FGInput.h"
+#include "socket_test_utilities.h"
+#include "test_utilities.h"
+
+using namespace std;
+using namespace JSBSim;
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// Builds the messages of the binary protocol.
+class Message
+{
+public:
+  Message(uint32_t type) {
+    AppendValue(Data, type);
+    AppendValue(Data, static_cast<uint32_t>(0));
+  }
+
+  template <typename T> Message& operator<<(T value) {
+    AppendValue(Data, value);
+    return *this;
+  }
+  Message& operator<<(const string& str) {
+    AppendString(Data, str);
+    return *this;
+  }
+
+  const vector<char>& Get(void) {
+    PackValue(&Data[sizeof(uint32_t)], static_cast<uint32_t>(Data.size()));
+    return Data;
+  }
+
+private:
+  vector<char> Data;
+};
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+Message SetMessage(void) { return Message(FGInputSocket::msgSet); }
+Message VectorMessage(void) { return Message(FGInputSocket::msgVector); }
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// Returns the type of the single message of a reply or 0 if the reply is not
+// made of a single message.
+uint32_t GetReplyType(const vector<char>& reply)
+{
+  uint32_t type, size;
+
+  if (reply.size() < 8) return 0;
+  UnpackValue(UnpackValue(&reply[0], type), size);
+  return size == reply.size() ? type : 0;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+const unsigned int NumControls = 50;
+
+string ControlName(unsigned int i)
+{
+  ostringstream name;
+  name << "test/control[" << i << "]";
+  return name.str();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGFDMExec* CreateFDM(const string& root, int textPort, int binaryPort)
+{
+  SGPath cwd = SGPath::fromLocal8Bit(".").realpath();
+  SGPath textInput = cwd/"socket_input_text.xml";
+  SGPath binaryInput = cwd/"socket_input_binary.xml";
+
+  ofstream(textInput.utf8Str().c_str())
+    << "<input port=\"" << textPort << "\"/>" << endl;
+  ofstream(binaryInput.utf8Str().c_str())
+    << "<input port=\"" << binaryPort << "\" format=\"binary\"/>" << endl;
+
+  FGFDMExec* fdm = new FGFDMExec();
+  SetupFDM(fdm, root, cwd);
+
+  if (!fdm->LoadModel("c172x") || !fdm->GetIC()->Load(SGPath("reset01"))
+      || !fdm->GetInput()->SetDirectivesFile(textInput)
+      || !fdm->GetInput()->SetDirectivesFile(binaryInput)
+      || !fdm->RunIC()) {
+    delete fdm;
+    return 0;
+  }
+
+  // The nodes must hold a value to be leaf properties.
+  for (unsigned int i=0; i<NumControls; i++)
+    fdm->GetPropertyManager()->GetNode(ControlName(i), true)->setDoubleValue(0.0);
+
+  return fdm;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+double GetControl(FGFDMExec* fdm, unsigned int i)
+{
+  return fdm->GetPropertyValue(ControlName(i));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CheckBinaryProtocol(FGFDMExec* fdm, LoopbackClient& client)
+{
+  // Registration
+  Message reg(FGInputSocket::msgRegister);
+  reg << static_cast<uint32_t>(NumControls + 2);
+  for (unsigned int i=0; i<NumControls; i++) reg << ControlName(i);
+  reg << string("test/unknown") << string("test");
+  client.Send(reg.Get());
+  fdm->Run();
+
+  vector<char> reply = client.Receive(1000);
+  bool registered = GetReplyType(reply) == FGInputSocket::msgRegister
+                    && reply.size() == 12 + 4*(NumControls + 2);
+  if (registered) {
+    uint32_t count;
+    const char* data = UnpackValue(&reply[8], count);
+    registered = count == NumControls + 2;
+    for (unsigned int i=0; i<count; i++) {
+      int32_t id;
+      data = UnpackValue(data, id);
+      registered &= id == (i < NumControls ? (int32_t)i : -1);
+    }
+  }
+  Check(registered, "The properties have not been registered");
+
+  // The values of a set message are applied in order.
+  client.Send((SetMessage() << 3u << 3u << 1.5 << 7u << -2.0 << 3u << 2.5).Get());
+  fdm->Run();
+  Check(GetControl(fdm, 3) == 2.5 && GetControl(fdm, 7) == -2.0,
+        "The set message has not been applied");
+
+  client.Send((VectorMessage() << 10u << 5u << 10.0 << 11.0 << 12.0 << 13.0
+                               << 14.0).Get());
+  fdm->Run();
+  bool applied = true;
+  for (unsigned int i=10; i<15; i++) applied &= GetControl(fdm, i) == i;
+  Check(applied && GetControl(fdm, 9) == 0.0 && GetControl(fdm, 15) == 0.0,
+        "The vector message has not been applied");
+  Check(client.Receive(0).empty(), "Valid messages have been replied to");
+
+  // The messages with an unknown ID are rejected as a whole.
+  client.Send((SetMessage() << 2u << 1u << 9.0 << 60u << 1.0).Get());
+  fdm->Run();
+  Check(GetReplyType(client.Receive(1000)) == FGInputSocket::msgError
+        && GetControl(fdm, 1) == 0.0, "The invalid set message is applied");
+
+  client.Send((VectorMessage() << 48u << 3u << 1.0 << 1.0 << 1.0).Get());
+  fdm->Run();
+  Check(GetReplyType(client.Receive(1000)) == FGInputSocket::msgError
+        && GetControl(fdm, 48) == 0.0, "The invalid vector message is applied");
+
+  // A message is applied once it is completely received.
+  vector<char> split = (SetMessage() << 1u << 0u << 4.0).Get();
+  client.Send(&split[0], 5);
+  fdm->Run();
+  Check(GetControl(fdm, 0) == 0.0, "An incomplete message is applied");
+  client.Send(&split[5], split.size() - 5);
+  fdm->Run();
+  Check(GetControl(fdm, 0) == 4.0, "A split message has not been applied");
+
+  // The messages received before a time step are all applied at this step.
+  vector<char> both = (SetMessage() << 1u << 2u << 1.0).Get();
+  vector<char> values = (VectorMessage() << 0u << 3u << 7.0 << 8.0 << 9.0).Get();
+  both.insert(both.end(), values.begin(), values.end());
+  client.Send(both);
+  fdm->Run();
+  Check(GetControl(fdm, 0) == 7.0 && GetControl(fdm, 2) == 9.0,
+        "The messages are not applied in order");
+
+  Check(client.Receive(0).empty(), "Unexpected replies have been received");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// Registers so many properties that the reply does not fit in the socket. The
+// input must send its end at the next time steps and send the next reply after
+// it. The client reads nothing until the registration is received.
+void CheckLargeRegistration(FGFDMExec* fdm, LoopbackClient& client)
+{
+  const uint32_t count = 2000000;
+  const uint32_t firstID = NumControls; // Registered by CheckBinaryProtocol
+
+  // Most of the paths are "test", which is found quickly but is not a leaf
+  // property, so that the registration is fast.
+  Message reg(FGInputSocket::msgRegister);
+  reg << count;
+  for (unsigned int i=0; i<count; i++)
+    reg << (i % 1000 == 0 ? ControlName((i / 1000) % NumControls) : "test");
+
+  // The message is larger than the socket buffers so it is sent while the
+  // input reads it.
+  vector<char> message = reg.Get();
+  atomic<bool> sent(false);
+  thread sender([&]() { client.Send(message); sent = true; });
+  while (!sent) {
+    fdm->GetInput()->Run(false);
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+  sender.join();
+  fdm->GetInput()->Run(false);
+
+  // An invalid message is replied to after the registration.
+  client.Send((SetMessage() << 1u << 1000000u << 1.0).Get());
+  fdm->GetInput()->Run(false);
+
+  const size_t registerSize = 12 + 4*count;
+  vector<char> replies;
+  for (unsigned int i=0; i<10000 && replies.size() <= registerSize; i++) {
+    vector<char> data = client.Receive(1);
+    replies.insert(replies.end(), data.begin(), data.end());
+    fdm->GetInput()->Run(false);
+  }
+  vector<char> data = client.Receive(100);
+  replies.insert(replies.end(), data.begin(), data.end());
+
+  bool registered = replies.size() > registerSize;
+  if (registered) {
+    vector<char> reply(replies.begin(), replies.begin() + registerSize);
+    registered = GetReplyType(reply) == FGInputSocket::msgRegister;
+    uint32_t num;
+    const char* data = UnpackValue(&reply[8], num);
+    registered &= num == count;
+    for (unsigned int i=0; i<count && registered; i++) {
+      int32_t id;
+      data = UnpackValue(data, id);
+      registered = id == (i % 1000 == 0 ? (int32_t)(firstID + i/1000) : -1);
+    }
+  }
+  Check(registered, "The reply to a large registration is truncated");
+
+  vector<char> error(replies.begin() + min(registerSize, replies.size()),
+                     replies.end());
+  Check(GetReplyType(error) == FGInputSocket::msgError,
+        "The reply that follows a large registration is not a whole message");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// Runs the inputs until the last control is set to value and returns the time
+// spent in the inputs. The data sent may take a moment to be received.
+double RunInputs(FGFDMExec* fdm, double value)
+{
+  FGInput* input = fdm->GetInput();
+  chrono::steady_clock::duration elapsed(0);
+
+  for (unsigned int i=0; i<1000; i++) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    input->Run(false);
+    elapsed += chrono::steady_clock::now() - start;
+
+    if (GetControl(fdm, NumControls-1) == value) break;
+    this_thread::sleep_for(chrono::microseconds(100));
+  }
+
+  return chrono::duration<double>(elapsed).count();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void MeasureRates(FGFDMExec* fdm, LoopbackClient& text, LoopbackClient& binary)
+{
+  const unsigned int numFrames = 2000;
+  const double numCommands = numFrames * NumControls;
+  double textTime = 0.0, setTime = 0.0, vectorTime = 0.0;
+  bool textApplied = true, setApplied = true, vectorApplied = true;
+
+  // The connection of the text client is accepted and greeted.
+  fdm->GetInput()->Run(false);
+  text.Receive(1000);
+
+  for (unsigned int f=1; f<=numFrames; f++) {
+    ostringstream commands;
+    for (unsigned int i=0; i<NumControls; i++)
+      commands << "set " << ControlName(i) << " " << f + 0.25 * i << "\n";
+    text.Send(commands.str());
+    textTime += RunInputs(fdm, f + 0.25 * (NumControls-1));
+    textApplied &= GetControl(fdm, 0) == f;
+    text.Receive(0); // The prompts
+  }
+
+  for (unsigned int f=1; f<=numFrames; f++) {
+    Message set = SetMessage();
+    set << NumControls;
+    for (unsigned int i=0; i<NumControls; i++) set << i << -(f + 0.25 * i);
+    binary.Send(set.Get());
+    setTime += RunInputs(fdm, -(f + 0.25 * (NumControls-1)));
+    setApplied &= GetControl(fdm, 0) == -(double)f;
+  }
+
+  for (unsigned int f=1; f<=numFrames; f++) {
+    Message values = VectorMessage();
+    values << 0u << NumControls;
+    for (unsigned int i=0; i<NumControls; i++) values << f + 0.5 * i;
+    binary.Send(values.Get());
+    vectorTime += RunInputs(fdm, f + 0.5 * (NumControls-1));
+    vectorApplied &= GetControl(fdm, 0) == f;
+  }
+
+  Check(textApplied, "The text commands have not been applied");
+  Check(setApplied, "The set messages have not been applied");
+  Check(vectorApplied, "The vector messages have not been applied");
+
+  cout << "Commands applied per second of input processing ("
+       << NumControls << " controls per frame):" << endl;
+  cout << "  text commands:   " << numCommands / textTime << endl;
+  cout << "  set messages:    " << numCommands / setTime << endl;
+  cout << "  vector messages: " << numCommands / vectorTime << endl;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  string root = argc > 1 ? argv[1] : ".";
+  int textPort = FreePort(), binaryPort = FreePort();
+  while (binaryPort == textPort) binaryPort = FreePort();
+
+  FGFDMExec* fdm = CreateFDM(root, textPort, binaryPort);
+  if (!fdm) {
+    cerr << "The c172x could not be initialized" << endl;
+    return 1;
+  }
+
+  // The binary client has a small receive buffer so that the large replies
+  // do not fit in the connection.
+  LoopbackClient text(textPort), binary(binaryPort, 4096);
+  Check(text.Connected && binary.Connected, "The clients could not connect");
+
+  if (TestStatus()) {
+    CheckBinaryProtocol(fdm, binary);
+    CheckLargeRegistration(fdm, binary);
+    MeasureRates(fdm, text, binary);
+  }
+
+  delete fdm;
+
+  return TestResult();
+}
@@ -0,0 +1,495 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestSocketOutput.cpp
+ Date started: 10/17/26
+ Purpose:      Checks the binary format of the socket outputs.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+The c172x is flown with a binary socket output and a CSV output of the same
+properties. A client listening on the loopback interface decodes the messages
+and checks the schema, the sequence numbers and the batches. The values of the
+frames must be the values of the CSV file. The output is checked over TCP and
+UDP, and over a non-blocking TCP socket whose client stops reading so that
+frames are dropped. Finally the batch sizes out of range must be clamped.
+
+The test returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FGFDMExec.h"
+#include "initialization/FGInitialCondition.h"
+#include "input_output/FGOutputSocket.h"
+#include "input_output/binary_utilities.h"
+#include "socket_test_utilities.h"
+#include "test_utilities.h"
+
+using namespace std;
+using namespace JSBSim;
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+struct Message
+{
+  uint32_t type;
+  vector<char> body;
+};
+
+// Splits the TCP stream in messages. Returns false if the stream ends with an
+// incomplete message.
+bool SplitStream(const vector<char>& stream, vector<Message>& messages)
+{
+  size_t pos = 0;
+
+  while (pos + 8 <= stream.size()) {
+    Message msg;
+    uint32_t size;
+    UnpackValue(UnpackValue(&stream[pos], msg.type), size);
+    if (size < 8 || pos + size > stream.size()) return false;
+    msg.body.assign(stream.begin() + pos + 8, stream.begin() + pos + size);
+    messages.push_back(msg);
+    pos += size;
+  }
+
+  return pos == stream.size();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool SplitDatagrams(const vector<vector<char> >& datagrams,
+                    vector<Message>& messages)
+{
+  for (unsigned int i=0; i<datagrams.size(); i++) {
+    vector<Message> msg;
+    if (!SplitStream(datagrams[i], msg) || msg.size() != 1) return false;
+    messages.push_back(msg[0]);
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+struct Frame
+{
+  uint64_t sequence;
+  double time;
+  vector<double> values;
+};
+
+struct Decoded
+{
+  uint32_t frameSize, numColumns, framesPerPacket;
+  vector<string> names;
+  vector<Frame> frames;
+  unsigned int maxFramesPerPacket;
+  vector<string> status;
+};
+
+// Decodes the schema, the frames and the status messages.
+bool Decode(const vector<Message>& messages, Decoded& result)
+{
+  result.maxFramesPerPacket = 0;
+
+  if (messages.empty() || messages[0].type != FGOutputSocket::msgSchema)
+    return false;
+
+  const vector<char>& schema = messages[0].body;
+  if (schema.size() < 24 || string(&schema[0]) != "JSBSSCK") return false;
+
+  uint32_t version;
+  const char* data = UnpackValue(&schema[8], version);
+  data = UnpackValue(data, result.frameSize);
+  data = UnpackValue(data, result.numColumns);
+  data = UnpackValue(data, result.framesPerPacket);
+  if (version != FGOutputSocket::Version) return false;
+
+  vector<char> types;
+  for (unsigned int i=0; i<result.numColumns; i++) {
+    uint16_t length;
+    types.push_back(*data++);
+    data = UnpackValue(data, length);
+    result.names.push_back(string(data, length));
+    data += length;
+    data = UnpackValue(data, length); // The unit
+    data += length;
+  }
+
+  for (unsigned int m=1; m<messages.size(); m++) {
+    const Message& msg = messages[m];
+
+    if (msg.type == FGOutputSocket::msgStatus) {
+      result.status.push_back(string(msg.body.begin(), msg.body.end()));
+      continue;
+    }
+    if (msg.type != FGOutputSocket::msgFrames) return false;
+
+    uint32_t numFrames;
+    data = UnpackValue(&msg.body[0], numFrames);
+    data += sizeof(uint32_t);
+    if (msg.body.size() != 8 + numFrames*result.frameSize) return false;
+
+    if (numFrames > result.maxFramesPerPacket)
+      result.maxFramesPerPacket = numFrames;
+
+    for (unsigned int f=0; f<numFrames; f++) {
+      Frame frame;
+      data = UnpackValue(data, frame.sequence);
+      data = UnpackValue(data, frame.time);
+      for (unsigned int i=1; i<result.numColumns; i++) {
+        if (types[i] == 'f') {
+          float value;
+          data = UnpackValue(data, value);
+          frame.values.push_back(value);
+        } else {
+          double value;
+          data = UnpackValue(data, value);
+          frame.values.push_back(value);
+        }
+      }
+      result.frames.push_back(frame);
+    }
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+const char* Properties[] = {"position/h-sl-ft", "velocities/vc-kts",
+                            "attitude/theta-rad", "fcs/elevator-pos-rad"};
+const unsigned int NumProperties = sizeof(Properties)/sizeof(Properties[0]);
+
+void WriteDirectives(const string& fname, const string& attributes,
+                     unsigned int repeat)
+{
+  ofstream out(fname.c_str());
+
+  out << "<output " << attributes << " rate=\"120\">" << endl;
+  for (unsigned int r=0; r<repeat; r++)
+    for (unsigned int i=0; i<NumProperties; i++)
+      out << "  <property> " << Properties[i] << " </property>" << endl;
+  out << "</output>" << endl;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+vector<vector<double> > ReadCSV(const string& fname)
+{
+  ifstream in(fname.c_str());
+  vector<vector<double> > rows;
+  string line;
+
+  getline(in, line); // The captions
+  while (getline(in, line)) {
+    vector<double> row;
+    istringstream fields(line);
+    string field;
+    while (getline(fields, field, ','))
+      row.push_back(strtod(field.c_str(), 0));
+    rows.push_back(row);
+  }
+
+  return rows;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// Checks the values of the frames against the rows of the CSV file, the row
+// of a frame being its sequence number.
+void CheckFrames(const Decoded& decoded, const vector<vector<double> >& rows,
+                 bool singlePrecision, const string& test)
+{
+  bool ordered = true, matching = true;
+
+  for (unsigned int f=0; f<decoded.frames.size(); f++) {
+    const Frame& frame = decoded.frames[f];
+
+    if (f > 0 && frame.sequence <= decoded.frames[f-1].sequence)
+      ordered = false;
+    if (frame.sequence >= rows.size()) {
+      matching = false;
+      continue;
+    }
+
+    const vector<double>& row = rows[frame.sequence];
+    // The time is written to the CSV file with 10 digits.
+    if (row.size() != frame.values.size() + 1
+        || fabs(row[0] - frame.time) > 1E-9 * fmax(1.0, frame.time)) {
+      matching = false;
+      continue;
+    }
+    for (unsigned int i=0; i<frame.values.size(); i++) {
+      // The CSV file has enough digits to restore the values exactly.
+      double expected = singlePrecision ? (float)row[i+1] : row[i+1];
+      if (frame.values[i] != expected) matching = false;
+    }
+  }
+
+  Check(ordered, test + ": the sequence numbers are not increasing");
+  Check(matching, test + ": the frames do not match the CSV file");
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+FGFDMExec* CreateFDM(const string& root, const vector<SGPath>& directives)
+{
+  // The output files are written relatively to the root directory.
+  SGPath cwd = SGPath::fromLocal8Bit(".").realpath();
+  FGFDMExec* fdm = new FGFDMExec();
+  SetupFDM(fdm, root, cwd);
+
+  bool ok = fdm->LoadModel("c172x") && fdm->GetIC()->Load(SGPath("reset01"));
+  for (unsigned int i=0; ok && i<directives.size(); i++)
+    ok = fdm->SetOutputDirectives(directives[i]);
+
+  if (!ok || !fdm->RunIC()) {
+    delete fdm;
+    return 0;
+  }
+
+  return fdm;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Fly(FGFDMExec* fdm, unsigned int n)
+{
+  fdm->SetPropertyValue("fcs/elevator-cmd-norm", (n % 200) < 100 ? 0.1 : -0.1);
+  fdm->Run();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// The output #0 is defined by the c172x, the CSV output is #1 and the socket
+// output #2.
+double GetCounter(FGFDMExec* fdm, const string& name)
+{
+  return fdm->GetPropertyValue("simulation/output[2]/socket/" + name);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CheckBatches(const string& root, bool tcp)
+{
+  const string test = tcp ? "TCP" : "UDP";
+  const unsigned int numFrames = 1200, batch = tcp ? 7 : 10;
+  LoopbackReceiver client(tcp, 1 << 22);
+  SGPath cwd = SGPath::fromLocal8Bit(".").realpath();
+  vector<SGPath> directives;
+  ostringstream attributes;
+
+  attributes << "name=\"localhost\" type=\"SOCKET\" protocol=\""
+             << (tcp ? "TCP" : "UDP") << "\" port=\"" << client.Port
+             << "\" format=\"binary\" batch=\"" << batch << "\"";
+  if (!tcp) attributes << " precision=\"single\"";
+
+  directives.push_back(cwd/"socket_output_csv.xml");
+  directives.push_back(cwd/"socket_output_binary.xml");
+  WriteDirectives(directives[0].utf8Str(),
+                  "name=\"socket_output.csv\" type=\"CSV\"", 1);
+  WriteDirectives(directives[1].utf8Str(), attributes.str(), 1);
+
+  client.Start();
+  FGFDMExec* fdm = CreateFDM(root, directives);
+  if (!fdm) {
+    Check(false, test + ": the c172x could not be initialized");
+    return;
+  }
+
+  for (unsigned int n=0; n<numFrames; n++)
+    Fly(fdm, n);
+
+  double sent = GetCounter(fdm, "frames-sent");
+  double dropped = GetCounter(fdm, "frames-dropped");
+  delete fdm;
+
+  // The UDP datagrams are received once the FDM is closed.
+  if (!tcp) this_thread::sleep_for(chrono::milliseconds(100));
+  client.Stop();
+
+  vector<vector<double> > rows = ReadCSV("socket_output.csv");
+  vector<Message> messages;
+  Decoded decoded;
+
+  Check(rows.size() > numFrames / 2, test + ": the CSV output is missing");
+  Check(tcp ? SplitStream(client.Stream, messages)
+            : SplitDatagrams(client.Datagrams, messages),
+        test + ": the messages are truncated");
+  Check(Decode(messages, decoded), test + ": the messages are not valid");
+  Check(dropped == 0, test + ": frames have been dropped");
+  Check(decoded.numColumns == NumProperties + 1
+        && decoded.names[0] == "Time"
+        && decoded.names[1] == string("/fdm/jsbsim/") + Properties[0],
+        test + ": the columns are not described");
+  Check(decoded.framesPerPacket == batch
+        && decoded.maxFramesPerPacket == batch,
+        test + ": the frames are not batched");
+
+  // All the frames but the last batch are sent during the flight.
+  Check(sent + batch > rows.size(), test + ": the frames are not counted");
+
+  // The loopback interface may drop datagrams.
+  if (tcp)
+    Check(decoded.frames.size() == rows.size(), test + ": frames are missing");
+  else
+    Check(!decoded.frames.empty(), test + ": no frames have been received");
+
+  CheckFrames(decoded, rows, !tcp, test);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CheckNonBlocking(const string& root)
+{
+  const string test = "Non-blocking TCP";
+  LoopbackReceiver client(true, 4096);
+  SGPath cwd = SGPath::fromLocal8Bit(".").realpath();
+  vector<SGPath> directives;
+  ostringstream attributes;
+
+  attributes << "name=\"localhost\" type=\"SOCKET\" protocol=\"TCP\" port=\""
+             << client.Port << "\" format=\"binary\" nonblocking=\"true\"";
+
+  directives.push_back(cwd/"socket_output_csv.xml");
+  directives.push_back(cwd/"socket_output_binary.xml");
+  // Large frames fill the buffers of the socket faster.
+  WriteDirectives(directives[0].utf8Str(),
+                  "name=\"socket_output.csv\" type=\"CSV\"", 25);
+  WriteDirectives(directives[1].utf8Str(), attributes.str(), 25);
+
+  // The client stops reading so that the socket can not send the frames.
+  client.Pause(true);
+  client.Start();
+  FGFDMExec* fdm = CreateFDM(root, directives);
+  if (!fdm) {
+    Check(false, test + ": the c172x could not be initialized");
+    return;
+  }
+
+  unsigned int n = 0;
+  while (GetCounter(fdm, "frames-dropped") == 0 && n < 200000)
+    Fly(fdm, n++);
+
+  // The frames are sent again once the client reads.
+  client.Pause(false);
+  double dropped = GetCounter(fdm, "frames-dropped");
+  for (unsigned int i=0; i<200; i++) {
+    this_thread::sleep_for(chrono::milliseconds(1));
+    Fly(fdm, n++);
+  }
+
+  double sent = GetCounter(fdm, "frames-sent");
+  double dropped2 = GetCounter(fdm, "frames-dropped");
+  delete fdm;
+  client.Stop();
+
+  vector<vector<double> > rows = ReadCSV("socket_output.csv");
+  vector<Message> messages;
+  Decoded decoded;
+
+  Check(dropped > 0, test + ": no frames have been dropped");
+  Check(dropped2 < dropped + 200, test + ": the frames are no longer sent");
+  Check(sent + dropped2 == rows.size(),
+        test + ": the frames sent and dropped are not counted");
+  Check(SplitStream(client.Stream, messages),
+        test + ": the messages are truncated");
+  Check(Decode(messages, decoded), test + ": the messages are not valid");
+  Check(decoded.frames.size() == sent,
+        test + ": the frames received are not the frames sent");
+  Check(!decoded.frames.empty() && decoded.frames.back().sequence + 1 == rows.size(),
+        test + ": the last frames have not been received");
+
+  CheckFrames(decoded, rows, false, test);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// The batch sizes out of range are clamped between 1 and 4096 frames.
+void CheckBatchRange(const string& root)
+{
+  const char* batches[] = { "-3", "1e12" };
+  const unsigned int expected[] = { 1, 4096 };
+
+  for (unsigned int i=0; i<2; i++) {
+    const string test = string("Batch of ") + batches[i] + " frames";
+    LoopbackReceiver client(true, 1 << 22);
+    SGPath cwd = SGPath::fromLocal8Bit(".").realpath();
+    vector<SGPath> directives;
+    ostringstream attributes;
+
+    attributes << "name=\"localhost\" type=\"SOCKET\" protocol=\"TCP\" port=\""
+               << client.Port << "\" format=\"binary\" batch=\"" << batches[i]
+               << "\"";
+
+    directives.push_back(cwd/"socket_output_csv.xml");
+    directives.push_back(cwd/"socket_output_binary.xml");
+    WriteDirectives(directives[0].utf8Str(),
+                    "name=\"socket_output.csv\" type=\"CSV\"", 1);
+    WriteDirectives(directives[1].utf8Str(), attributes.str(), 1);
+
+    client.Start();
+    FGFDMExec* fdm = CreateFDM(root, directives);
+    if (!fdm) {
+      Check(false, test + ": the c172x could not be initialized");
+      return;
+    }
+
+    for (unsigned int n=0; n<10; n++)
+      Fly(fdm, n);
+
+    delete fdm;
+    client.Stop();
+
+    vector<Message> messages;
+    Decoded decoded;
+
+    Check(SplitStream(client.Stream, messages),
+          test + ": the messages are truncated");
+    Check(Decode(messages, decoded), test + ": the messages are not valid");
+    Check(decoded.framesPerPacket == expected[i],
+          test + ": the batch size is not clamped");
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  string root = argc > 1 ? argv[1] : ".";
+
+  CheckBatches(root, true);
+  CheckBatches(root, false);
+  CheckNonBlocking(root);
+  CheckBatchRange(root);
+
+  return TestResult();
+}
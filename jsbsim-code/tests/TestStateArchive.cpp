@@ -0,0 +1,213 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestStateArchive.cpp
+ Date started: 10/17/26
+ Purpose:      Checks that a state saved by FGFDMExec::SaveState() is exactly
+               restored by FGFDMExec::RestoreState().
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+A c172x is flown in a turbulent atmosphere. Its state is saved, the flight is
+continued and recorded then the state is restored: the same flight must be
+replayed bit for bit. The state is also restored in a second instance of the
+same aircraft. A truncated state and the state of another aircraft must be
+rejected without modifying the simulation.
+
+The test is called with the JSBSim root directory as its first argument and
+returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "FGFDMExec.h"
+#include "initialization/FGInitialCondition.h"
+#include "test_utilities.h"
+
+using namespace std;
+using namespace JSBSim;
+
+const unsigned int nStepsBefore = 100;
+const unsigned int nStepsAfter = 500;
+
+const char* outputs[] = {"position/h-sl-ft", "attitude/theta-rad",
+                         "velocities/u-fps", "velocities/q-rad_sec",
+                         "atmosphere/turb-north-fps",
+                         "fcs/left-aileron-pos-rad",
+                         "propulsion/engine/engine-rpm",
+                         "propulsion/tank/contents-lbs",
+                         "simulation/sim-time-sec"};
+const unsigned int nOutputs = sizeof(outputs)/sizeof(outputs[0]);
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool InitFDM(FGFDMExec* fdm, const string& root,
+             const string& model = "c172x")
+{
+  SetupFDM(fdm, root);
+
+  if (!fdm->LoadModel(model)) return false;
+  if (!fdm->GetIC()->Load(SGPath("reset01"))) return false;
+
+  fdm->SetPropertyValue("atmosphere/turb-type", 3); // Milspec
+  fdm->SetPropertyValue("atmosphere/turbulence/milspec/windspeed_at_20ft_AGL-fps", 30.0);
+  fdm->SetPropertyValue("atmosphere/turbulence/milspec/severity", 4);
+  fdm->SetPropertyValue("fcs/throttle-cmd-norm", 1.0);
+  fdm->SetPropertyValue("fcs/mixture-cmd-norm", 1.0);
+  fdm->SetPropertyValue("propulsion/magneto_cmd", 3);
+  fdm->SetPropertyValue("propulsion/starter_cmd", 1);
+
+  return fdm->RunIC();
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void Record(FGFDMExec* fdm, vector<double>& record)
+{
+  record.clear();
+
+  for (unsigned int i=0; i<nStepsAfter; i++) {
+    // Some control inputs so that the FCS filters and actuators are excited.
+    fdm->SetPropertyValue("fcs/aileron-cmd-norm", (i % 50) < 25 ? 0.3 : -0.3);
+    fdm->Run();
+    for (unsigned int j=0; j<nOutputs; j++)
+      record.push_back(fdm->GetPropertyValue(outputs[j]));
+  }
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool Compare(const vector<double>& record, const vector<double>& ref,
+             const string& msg)
+{
+  for (unsigned int i=0; i<ref.size(); i++) {
+    if (record[i] != ref[i]) {
+      cerr << msg << ": " << outputs[i % nOutputs] << " is " << record[i]
+           << " instead of " << ref[i] << " at step " << i / nOutputs << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    cerr << "Usage: " << argv[0] << " <JSBSim root directory>" << endl;
+    return 1;
+  }
+
+  string root = argv[1];
+  bool success = true;
+  vector<double> state, ref, record;
+
+  FGFDMExec fdm;
+  if (!InitFDM(&fdm, root)) return 1;
+
+  for (unsigned int i=0; i<nStepsBefore; i++) fdm.Run();
+
+  if (!fdm.SaveState(state)) {
+    cerr << "SaveState() failed" << endl;
+    return 1;
+  }
+
+  Record(&fdm, ref);
+
+  // Saving again must neither allocate nor change the size of the state.
+  size_t size = state.size();
+  const double* data = &state[0];
+  vector<double> last;
+  fdm.SaveState(last);
+  if (last.size() != size) {
+    cerr << "The size of the state has changed" << endl;
+    success = false;
+  }
+
+  // Restoring the state in the same instance replays the same flight.
+  for (unsigned int n=0; n<2 && success; n++) {
+    if (!fdm.RestoreState(state)) {
+      cerr << "RestoreState() failed" << endl;
+      return 1;
+    }
+    Record(&fdm, record);
+    success = Compare(record, ref, "Same instance");
+  }
+
+  if (success && (state.size() != size || &state[0] != data)) {
+    cerr << "The state has been reallocated" << endl;
+    success = false;
+  }
+
+  // The state can be restored in another instance of the same aircraft.
+  FGFDMExec fdm2;
+  if (!InitFDM(&fdm2, root)) return 1;
+
+  if (success) {
+    if (!fdm2.RestoreState(state)) {
+      cerr << "RestoreState() failed for the second instance" << endl;
+      return 1;
+    }
+    Record(&fdm2, record);
+    success = Compare(record, ref, "Second instance");
+  }
+
+  // A truncated state must be rejected, even when its header is consistent
+  // with its size, and the simulation must be left untouched.
+  vector<double> before, after;
+  fdm.SaveState(before);
+  state.pop_back();
+  state[2] = state.size();
+  if (fdm.RestoreState(state)) {
+    cerr << "A truncated state has been restored" << endl;
+    success = false;
+  }
+  fdm.SaveState(after);
+  if (after != before) {
+    cerr << "A truncated state has been partially restored" << endl;
+    success = false;
+  }
+
+  // The state of another aircraft must be rejected by an instance which has
+  // never saved nor restored a state.
+  FGFDMExec fdm3;
+  if (!InitFDM(&fdm3, root, "p51d")) return 1;
+  vector<double> other;
+  fdm3.SaveState(other);
+
+  FGFDMExec fdm4;
+  if (!InitFDM(&fdm4, root)) return 1;
+  fdm4.SaveState(before);
+  if (fdm4.RestoreState(other)) {
+    cerr << "The state of another aircraft has been restored" << endl;
+    success = false;
+  }
+  fdm4.SaveState(after);
+  if (after != before) {
+    cerr << "The state of another aircraft has been partially restored" << endl;
+    success = false;
+  }
+
+  return success ? 0 : 1;
+}
@@ -0,0 +1,382 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestTableLookup.cpp
+ Date started: 10/17/26
+ Purpose:      Checks that the search of the table intervals returns the same
+               values than walking the breakpoints one by one.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+FGTable locates the interval of a key arithmetically when the breakpoints are
+evenly spaced and by bisection when the key has moved by more than a few
+intervals since the previous lookup. This test compares the values returned by
+1D, 2D and 3D tables with a reference implementation that walks the breakpoints
+one by one from the previous interval. The keys alternate between small
+variations, large jumps, values outside the table, NaNs and values equal to a
+breakpoint (for which the interval that is selected matters to the last bit).
+
+The test returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "input_output/FGPropertyManager.h"
+#include "input_output/FGXMLParse.h"
+#include "math/FGTable.h"
+
+using namespace std;
+using namespace JSBSim;
+
+const unsigned int nLookups = 200000;
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Returns true if 2 values are identical, NaNs included.
+
+bool Identical(double a, double b)
+{
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Reference implementation of the 1D lookup.
+
+double Reference1D(const FGTable& t, double key, int& lastRowIndex)
+{
+  unsigned int nRows = t.GetNumRows();
+  unsigned int r = lastRowIndex;
+
+  if (key <= t(1,0)) {
+    lastRowIndex = 2;
+    return t(1,1);
+  } else if (key >= t(nRows,0)) {
+    lastRowIndex = nRows;
+    return t(nRows,1);
+  }
+
+  while (r > 2     && t(r-1,0) > key) { r--; }
+  while (r < nRows && t(r,0)   < key) { r++; }
+
+  lastRowIndex = r;
+
+  double Factor = 1.0;
+  double Span = t(r,0) - t(r-1,0);
+  if (Span != 0.0) {
+    Factor = (key - t(r-1,0)) / Span;
+    if (Factor > 1.0) Factor = 1.0;
+  }
+
+  return Factor*(t(r,1) - t(r-1,1)) + t(r-1,1);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Reference implementation of the 2D lookup.
+
+double Reference2D(const FGTable& t, unsigned int nCols, double rowKey,
+                   double colKey, int& lastRowIndex, int& lastColumnIndex)
+{
+  unsigned int nRows = t.GetNumRows();
+  unsigned int r = lastRowIndex;
+  unsigned int c = lastColumnIndex;
+
+  while (r > 2     && t(r-1,0) > rowKey) { r--; }
+  while (r < nRows && t(r,0)   < rowKey) { r++; }
+
+  while (c > 2     && t(0,c-1) > colKey) { c--; }
+  while (c < nCols && t(0,c)   < colKey) { c++; }
+
+  lastRowIndex = r;
+  lastColumnIndex = c;
+
+  double rFactor = (rowKey - t(r-1,0)) / (t(r,0) - t(r-1,0));
+  double cFactor = (colKey - t(0,c-1)) / (t(0,c) - t(0,c-1));
+
+  if (rFactor > 1.0) rFactor = 1.0;
+  else if (rFactor < 0.0) rFactor = 0.0;
+
+  if (cFactor > 1.0) cFactor = 1.0;
+  else if (cFactor < 0.0) cFactor = 0.0;
+
+  double col1temp = rFactor*(t(r,c-1) - t(r-1,c-1)) + t(r-1,c-1);
+  double col2temp = rFactor*(t(r,c) - t(r-1,c)) + t(r-1,c);
+
+  return col1temp + cFactor*(col2temp - col1temp);
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Generates n increasing breakpoints, evenly spaced or not.
+
+vector<double> MakeBreakpoints(unsigned int n, double first, double step,
+                               bool uniform, mt19937& generator)
+{
+  uniform_real_distribution<double> distribution(0.2, 1.8);
+  vector<double> keys(n);
+  keys[0] = first;
+  for (unsigned int i=1; i<n; i++)
+    keys[i] = uniform ? first + i*step : keys[i-1] + step*distribution(generator);
+  return keys;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// Generates a sequence of keys for the breakpoints of an axis.
+
+vector<double> MakeKeys(const vector<double>& breakpoints, mt19937& generator)
+{
+  double min = breakpoints.front();
+  double max = breakpoints.back();
+  double margin = 0.2*(max-min);
+  uniform_real_distribution<double> range(min-margin, max+margin);
+  uniform_real_distribution<double> small(-0.05*(max-min), 0.05*(max-min));
+  uniform_int_distribution<int> kind(0, 19);
+  uniform_int_distribution<int> index(0, breakpoints.size()-1);
+
+  vector<double> keys(nLookups);
+  double key = min;
+  for (unsigned int i=0; i<nLookups; i++) {
+    switch (kind(generator)) {
+    case 0: case 1: case 2: case 3: // Jump anywhere
+      key = range(generator);
+      break;
+    case 4: case 5: case 6: case 7: // Exactly on a breakpoint
+      key = breakpoints[index(generator)];
+      break;
+    case 8:                         // Not a number
+      keys[i] = NAN;
+      continue;
+    default:                        // Small variation
+      key += small(generator);
+      break;
+    }
+    keys[i] = key;
+  }
+
+  return keys;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool Check1D(unsigned int nRows, bool uniform, mt19937& generator)
+{
+  vector<double> rows = MakeBreakpoints(nRows, -10.0, 2.0, uniform, generator);
+  uniform_real_distribution<double> values(-1.0, 1.0);
+
+  FGTable table(nRows);
+  for (unsigned int r=0; r<nRows; r++) table << rows[r] << values(generator);
+
+  vector<double> keys = MakeKeys(rows, generator);
+  int lastRowIndex = 2;
+
+  for (unsigned int i=0; i<nLookups; i++) {
+    double expected = Reference1D(table, keys[i], lastRowIndex);
+    double value = table.GetValue(keys[i]);
+    if (!Identical(value, expected)) {
+      cerr << "1D table (" << nRows << (uniform ? " uniform" : "")
+           << " rows): " << value << " instead of " << expected << " for "
+           << keys[i] << endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+bool Check2D(unsigned int nRows, unsigned int nCols, bool uniform,
+             mt19937& generator)
+{
+  vector<double> rows = MakeBreakpoints(nRows, -10.0, 2.0, uniform, generator);
+  vector<double> cols = MakeBreakpoints(nCols, 0.0, 0.1, !uniform, generator);
+  uniform_real_distribution<double> values(-1.0, 1.0);
+
+  FGTable table(nRows, nCols);
+  for (unsigned int c=0; c<nCols; c++) table << cols[c];
+  for (unsigned int r=0; r<nRows; r++) {
+    table << rows[r];
+    for (unsigned int c=0; c<nCols; c++) table << values(generator);
+  }
+
+  vector<double> rowKeys = MakeKeys(rows, generator);
+  vector<double> colKeys = MakeKeys(cols, generator);
+  int lastRowIndex = 2, lastColumnIndex = 2;
+
+  for (unsigned int i=0; i<nLookups; i++) {
+    double expected = Reference2D(table, nCols, rowKeys[i], colKeys[i],
+                                  lastRowIndex, lastColumnIndex);
+    double value = table.GetValue(rowKeys[i], colKeys[i]);
+    if (!Identical(value, expected)) {
+      cerr << "2D table (" << nRows << "x" << nCols << "): " << value
+           << " instead of " << expected << " for " << rowKeys[i] << ", "
+           << colKeys[i] << endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// The 3D table is loaded from XML. Its layers are compared with 2D tables
+// filled with the same data.
+
+bool Check3D(unsigned int nTables, mt19937& generator)
+{
+  const unsigned int nRows = 25, nCols = 9;
+  vector<double> breakpoints = MakeBreakpoints(nTables, 0.0, 0.5, true,
+                                               generator);
+  uniform_real_distribution<double> values(-1.0, 1.0);
+
+  vector<FGTable*> layers;
+  ostringstream xml;
+  xml.precision(17);
+  xml << "<table>" << endl
+      << "  <independentVar lookup=\"row\">test/row</independentVar>" << endl
+      << "  <independentVar lookup=\"column\">test/column</independentVar>" << endl
+      << "  <independentVar lookup=\"table\">test/table</independentVar>" << endl;
+
+  for (unsigned int t=0; t<nTables; t++) {
+    vector<double> rows = MakeBreakpoints(nRows, -10.0, 2.0, t % 2 == 0,
+                                          generator);
+    vector<double> cols = MakeBreakpoints(nCols, 0.0, 0.1, t % 2 == 1,
+                                          generator);
+    FGTable* layer = new FGTable(nRows, nCols);
+    xml << "  <tableData breakPoint=\"" << breakpoints[t] << "\">" << endl;
+    for (unsigned int c=0; c<nCols; c++) {
+      *layer << cols[c];
+      xml << " " << cols[c];
+    }
+    xml << endl;
+    for (unsigned int r=0; r<nRows; r++) {
+      *layer << rows[r];
+      xml << rows[r];
+      for (unsigned int c=0; c<nCols; c++) {
+        double value = values(generator);
+        *layer << value;
+        xml << " " << value;
+      }
+      xml << endl;
+    }
+    xml << "  </tableData>" << endl;
+    layers.push_back(layer);
+  }
+  xml << "</table>" << endl;
+
+  FGPropertyManager pm;
+  pm.GetNode("test/row", true);
+  pm.GetNode("test/column", true);
+  pm.GetNode("test/table", true);
+
+  FGXMLParse parser;
+  istringstream input(xml.str());
+  readXML(input, parser);
+  FGTable table(&pm, parser.GetDocument());
+
+  vector<double> rowKeys = MakeKeys(MakeBreakpoints(nRows, -10.0, 2.0, true,
+                                                    generator), generator);
+  vector<double> colKeys = MakeKeys(MakeBreakpoints(nCols, 0.0, 0.1, true,
+                                                    generator), generator);
+  vector<double> tableKeys = MakeKeys(breakpoints, generator);
+  vector<int> lastRowIndex(nTables, 2), lastColumnIndex(nTables, 2);
+  int lastTableIndex = 2;
+  bool success = true;
+
+  for (unsigned int i=0; i<nLookups && success; i++) {
+    // Same algorithm as Reference1D with the 2D layers as values.
+    double key = tableKeys[i];
+    unsigned int r = lastTableIndex;
+    double expected;
+
+    if (key <= breakpoints[0]) {
+      lastTableIndex = 2;
+      expected = Reference2D(*layers[0], nCols, rowKeys[i], colKeys[i],
+                             lastRowIndex[0], lastColumnIndex[0]);
+    } else if (key >= breakpoints[nTables-1]) {
+      lastTableIndex = nTables;
+      expected = Reference2D(*layers[nTables-1], nCols, rowKeys[i], colKeys[i],
+                             lastRowIndex[nTables-1],
+                             lastColumnIndex[nTables-1]);
+    } else {
+      while (r > 2       && breakpoints[r-2] > key) { r--; }
+      while (r < nTables && breakpoints[r-1] < key) { r++; }
+      lastTableIndex = r;
+
+      double Factor = 1.0;
+      double Span = breakpoints[r-1] - breakpoints[r-2];
+      if (Span != 0.0) {
+        Factor = (key - breakpoints[r-2]) / Span;
+        if (Factor > 1.0) Factor = 1.0;
+      }
+
+      double Value0 = Reference2D(*layers[r-2], nCols, rowKeys[i], colKeys[i],
+                                  lastRowIndex[r-2], lastColumnIndex[r-2]);
+      double Value1 = Reference2D(*layers[r-1], nCols, rowKeys[i], colKeys[i],
+                                  lastRowIndex[r-1], lastColumnIndex[r-1]);
+      expected = Factor*(Value1 - Value0) + Value0;
+    }
+
+    double value = table.GetValue(rowKeys[i], colKeys[i], key);
+    if (!Identical(value, expected)) {
+      cerr << "3D table (" << nTables << " tables): " << value
+           << " instead of " << expected << " for " << rowKeys[i] << ", "
+           << colKeys[i] << ", " << key << endl;
+      success = false;
+    }
+  }
+
+  for (unsigned int t=0; t<nTables; t++) delete layers[t];
+
+  return success;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(void)
+{
+  mt19937 generator(20261017);
+  bool success = true;
+
+  FGJSBBase::debug_lvl = 0;
+  cerr.precision(17);
+
+  try {
+    if (!Check1D(2, true, generator)) success = false;
+    if (!Check1D(21, true, generator)) success = false;
+    if (!Check1D(50, false, generator)) success = false;
+    if (!Check1D(400, true, generator)) success = false;
+    if (!Check1D(400, false, generator)) success = false;
+    if (!Check2D(30, 12, true, generator)) success = false;
+    if (!Check2D(30, 12, false, generator)) success = false;
+    if (!Check2D(2, 2, true, generator)) success = false;
+    if (!Check3D(2, generator)) success = false;
+    if (!Check3D(7, generator)) success = false;
+  }
+  catch (const string& msg) {
+    cerr << msg << endl;
+    success = false;
+  }
+
+  return success ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Module:       TestTextBuffer.cpp
+ Date started: 10/17/26
+ Purpose:      Checks that the text buffer formats the numbers as the streams.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+Numbers are formatted with several precisions and widths by FGTextBuffer and by
+an std::ostringstream, which the text outputs formerly used. The texts must be
+identical, first in the "C" locale and then once the C locale has been set to
+a locale with a comma as its decimal point, as an application embedding JSBSim
+may do with setlocale(LC_ALL, ""). The second check is skipped when no such
+locale is installed.
+
+The test returns a non zero value on failure.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <clocale>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include "input_output/FGTextBuffer.h"
+#include "test_utilities.h"
+
+using namespace std;
+using namespace JSBSim;
+
+const double values[] = { 0.0, -0.0, 1.0, -3.0, 1.5, -0.25, 0.1, 1.0/3.0,
+                          -2.0/3.0, 123456.789, 1234567.0, 1E-7, -6.02214076E23,
+                          3.14159265358979, 1E300, 5E-324, 42.125,
+                          numeric_limits<double>::infinity(),
+                          -numeric_limits<double>::infinity() };
+const int precisions[] = { 0, 1, 6, 10, 16 };
+const int widths[] = { 0, 12 };
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+void CheckFormat(const string& locale)
+{
+  for (unsigned int i=0; i<sizeof(values)/sizeof(values[0]); i++) {
+    for (unsigned int p=0; p<sizeof(precisions)/sizeof(precisions[0]); p++) {
+      for (unsigned int w=0; w<sizeof(widths)/sizeof(widths[0]); w++) {
+        ostringstream expected;
+        FGTextBuffer buffer;
+
+        expected << setw(widths[w]) << setprecision(precisions[p]) << values[i];
+        buffer.Append(values[i], precisions[p], widths[w]);
+
+        Check(buffer.GetString() == expected.str(),
+              locale + ": " + buffer.GetString() + " is formatted instead of "
+              + expected.str());
+      }
+    }
+  }
+
+  // The numbers appended with << use the precision of the buffer.
+  FGTextBuffer buffer;
+  ostringstream expected;
+
+  buffer.SetPrecision(10);
+  expected << setprecision(10);
+  buffer << 0.5 << ',' << -1.75 << ',' << 2.0;
+  expected << 0.5 << ',' << -1.75 << ',' << 2.0;
+  Check(buffer.GetString() == expected.str(),
+        locale + ": " + buffer.GetString() + " is formatted instead of "
+        + expected.str());
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+// Sets the C locale to a locale whose decimal point is a comma. Returns false
+// if none is installed.
+bool SetCommaLocale(void)
+{
+  const char* names[] = { "", "de_DE.UTF-8", "de_DE.utf8", "de_DE",
+                          "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR", "German",
+                          "French" };
+
+  for (unsigned int i=0; i<sizeof(names)/sizeof(names[0]); i++) {
+    if (setlocale(LC_ALL, names[i])
+        && strcmp(localeconv()->decimal_point, ".") != 0)
+      return true;
+  }
+
+  setlocale(LC_ALL, "C");
+  return false;
+}
+
+//%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+int main(void)
+{
+  CheckFormat("C");
+
+  if (SetCommaLocale())
+    CheckFormat(setlocale(LC_NUMERIC, 0));
+  else
+    cout << "No locale with a comma as its decimal point is installed: the "
+            "formatting is only checked in the \"C\" locale." << endl;
+
+  return TestResult();
+}
@@ -61,9 +61,15 @@ cdef extern from "models/FGPropagate.h" namespace "JSBSim":
         c_FGColumnVector3& GetUVW()
 
 cdef extern from "input_output/FGPropertyManager.h" namespace "JSBSim":
+    cdef cppclass c_FGPropertyNode "JSBSim::FGPropertyNode":
+        double getDoubleValue() nogil
+        bool setDoubleValue(double value) nogil
+        string GetFullyQualifiedName()
+
     cdef cppclass c_FGPropertyManager "JSBSim::FGPropertyManager":
         c_FGPropertyManager()
         bool HasNode(string path)
+        c_FGPropertyNode* GetNode(string path, bool create)
 
 cdef extern from "models/FGGroundReactions.h" namespace "JSBSim":
     cdef cppclass c_FGGroundReactions "JSBSim::FGGroundReactions":
@@ -101,8 +107,11 @@ cdef extern from "FGFDMExec.h" namespace "JSBSim":
     cdef cppclass c_FGFDMExec "JSBSim::FGFDMExec":
         c_FGFDMExec(c_FGPropertyManager* root, unsigned int* fdmctr)
         void Unbind()
-        bool Run() except +convertJSBSimToPyExc
+        bool Run() except +convertJSBSimToPyExc nogil
         bool RunIC() except +convertJSBSimToPyExc
+        bool SaveState(vector[double]& state)
+        bool RestoreState(const vector[double]& state)
+        c_FGFDMExec* Clone()
         bool LoadModel(string model,
                        bool add_model_to_path)
         bool LoadModel(const c_SGPath aircraft_path,
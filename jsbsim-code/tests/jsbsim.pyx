@@ -16,6 +16,7 @@
 # this program; if not, see <http://www.gnu.org/licenses/>
 
 import os, platform, numpy
+cimport cython
 
 cdef convertToNumpyMat(const c_FGMatrix33& m):
     return numpy.mat([[m.Entry(1, 1), m.Entry(1, 2), m.Entry(1, 3)],
@@ -52,6 +53,131 @@ cdef class FGPropertyManager:
      def hasNode(self, path):
          return self.thisptr.HasNode(path.encode())
 
+cdef class PropertyHandle:
+    """
+    A property of an FDM resolved once for all so that it can be accessed
+    without looking up its name. Handles are returned by
+    FGFDMExec.get_property_handle() and are invalidated when a new model is
+    loaded.
+    """
+
+    cdef c_FGPropertyNode *node
+    cdef object fdm  # keeps the property tree alive
+
+    def __init__(self):
+        self.node = NULL
+
+    cdef check_node(self):
+        if self.node == NULL:
+            raise RuntimeError("The handle is not bound to a property")
+
+    def get_name(self):
+        self.check_node()
+        return self.node.GetFullyQualifiedName().decode()
+
+    def get(self):
+        """
+        Retrieves the value of the property.
+        """
+        self.check_node()
+        return self.node.getDoubleValue()
+
+    def set(self, double value):
+        """
+        Sets the value of the property.
+        """
+        self.check_node()
+        self.node.setDoubleValue(value)
+
+cdef class PropertyHandleArray:
+    """
+    A list of property handles of an FDM whose values are read or written
+    from/to a numpy array in one call. Arrays are returned by
+    FGFDMExec.get_property_handles().
+    """
+
+    cdef vector[c_FGPropertyNode*] nodes
+    cdef object fdm  # keeps the property tree alive
+
+    def __init__(self, handles=[]):
+        cdef PropertyHandle handle
+        self.fdm = None
+        for h in handles:
+            handle = <PropertyHandle?>h
+            if handle.node == NULL:
+                raise ValueError("The handle is not bound to a property")
+            if self.fdm is None:
+                self.fdm = handle.fdm
+            elif handle.fdm is not self.fdm:
+                raise ValueError("The properties belong to different FDMs")
+            self.nodes.push_back(handle.node)
+
+    def __len__(self):
+        return self.nodes.size()
+
+    def __getitem__(self, unsigned int i):
+        if i >= self.nodes.size():
+            raise IndexError("Property handle index out of range")
+        handle = PropertyHandle()
+        handle.node = self.nodes[i]
+        handle.fdm = self.fdm
+        return handle
+
+    def get_names(self):
+        return [self[i].get_name() for i in range(self.nodes.size())]
+
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def gather(self, out=None):
+        """
+        Reads the values of the properties.
+        @param out a C contiguous numpy array of float64 in which the values
+            are stored. A new array is allocated if it is not supplied.
+        @return the array of values
+        """
+        if out is None:
+            out = numpy.empty(self.nodes.size())
+        cdef double[::1] y = out
+        cdef size_t i
+        if y.shape[0] != self.nodes.size():
+            raise ValueError("{0} values for {1} properties"
+                             .format(y.shape[0], self.nodes.size()))
+        for i in range(self.nodes.size()):
+            y[i] = self.nodes[i].getDoubleValue()
+        return out
+
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def scatter(self, values):
+        """
+        Sets the values of the properties.
+        @param values the values, one per property
+        """
+        cdef double[::1] u = numpy.ascontiguousarray(values, dtype=numpy.float64).reshape(-1)
+        cdef size_t i
+        if u.shape[0] != self.nodes.size():
+            raise ValueError("{0} values for {1} properties"
+                             .format(u.shape[0], self.nodes.size()))
+        for i in range(self.nodes.size()):
+            self.nodes[i].setDoubleValue(u[i])
+
+cdef vector[c_FGPropertyNode*] getPropertyNodes(handles, fdm) except *:
+    cdef vector[c_FGPropertyNode*] nodes
+    cdef PropertyHandle handle
+    cdef PropertyHandleArray array
+    if isinstance(handles, PropertyHandleArray):
+        array = handles
+        if array.nodes.size() > 0 and array.fdm is not fdm:
+            raise ValueError("The properties do not belong to this FDM")
+        return array.nodes
+    for h in handles:
+        handle = <PropertyHandle?>h
+        if handle.fdm is not fdm:
+            raise ValueError("The property {0} does not belong to this FDM"
+                             .format(handle.get_name()))
+        nodes.push_back(handle.node)
+    return nodes
+
 cdef class FGGroundReactions:
 
     cdef c_FGGroundReactions *thisptr
@@ -213,6 +339,94 @@ cdef class FGFDMExec:
         """
         return self.thisptr.Run()
 
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def run_steps(self, unsigned int n, action_handles, action_values,
+                  obs_handles, out_array):
+        """
+        Sets the actions, executes n time steps and reads the observations
+        without going back to Python between the steps. The GIL is released
+        while the steps are executed.
+        @param n the number of time steps
+        @param action_handles the handles of the properties set before the
+            first step, as a list of PropertyHandle or a PropertyHandleArray
+        @param action_values the values of the actions
+        @param obs_handles the handles of the properties to read, as a list of
+            PropertyHandle or a PropertyHandleArray
+        @param out_array a C contiguous numpy array of float64 that receives
+            the observations. If it has one row per time step (shape
+            (n, len(obs_handles))), the observations are recorded after each
+            step otherwise (shape (len(obs_handles),)) they are only read
+            after the last step.
+        @return false if the sim should be ended, in which case the steps
+            that remain are not executed.
+        """
+        cdef vector[c_FGPropertyNode*] actions = getPropertyNodes(action_handles, self)
+        cdef vector[c_FGPropertyNode*] obs = getPropertyNodes(obs_handles, self)
+        cdef double[::1] u = numpy.ascontiguousarray(action_values, dtype=numpy.float64).reshape(-1)
+        cdef size_t nobs = obs.size()
+        cdef bool record
+
+        if u.shape[0] != actions.size():
+            raise ValueError("{0} action values for {1} actions"
+                             .format(u.shape[0], actions.size()))
+        if not isinstance(out_array, numpy.ndarray) \
+           or out_array.dtype != numpy.float64 \
+           or not out_array.flags.c_contiguous:
+            raise ValueError("out_array must be a C contiguous array of float64")
+        if out_array.shape == (n, nobs):
+            record = True
+        elif out_array.size == nobs:
+            record = False
+        else:
+            raise ValueError("out_array has the shape {0} for {1} observations"
+                             .format(out_array.shape, nobs))
+
+        cdef double[::1] y = out_array.reshape(-1)
+        cdef bool result = True
+        cdef size_t i, j
+
+        with nogil:
+            for j in range(actions.size()):
+                actions[j].setDoubleValue(u[j])
+            for i in range(n):
+                result = self.thisptr.Run()
+                if record:
+                    for j in range(nobs):
+                        y[i*nobs+j] = obs[j].getDoubleValue()
+                if not result:
+                    break
+            if not record:
+                for j in range(nobs):
+                    y[j] = obs[j].getDoubleValue()
+
+        return result
+
+    def get_property_handle(self, name, create=False):
+        """
+        Resolves a property so that it can be passed to run_steps().
+        @param name the name of the property
+        @param create if True, the property is created if it does not exist
+        @return the property handle
+        """
+        cdef c_FGPropertyNode* node = self.thisptr.GetPropertyManager().GetNode(name.encode(), create)
+        if node is NULL:
+            raise KeyError("No property named {0}".format(name))
+        handle = PropertyHandle()
+        handle.node = node
+        handle.fdm = self
+        return handle
+
+    def get_property_handles(self, names, create=False):
+        """
+        Resolves a list of properties.
+        @param names the names of the properties
+        @param create if True, the properties are created if they do not exist
+        @return a PropertyHandleArray
+        """
+        return PropertyHandleArray([self.get_property_handle(name, create)
+                                    for name in names])
+
     def run_ic(self):
         """
         Initializes the sim from the initial condition object and executes
@@ -221,6 +435,38 @@ cdef class FGFDMExec:
         """
         return  self.thisptr.RunIC()
 
+    def save_state(self):
+        """
+        Saves the state of the simulation.
+        @return a numpy array containing the state
+        """
+        cdef vector[double] state
+        if not self.thisptr.SaveState(state):
+            raise RuntimeError("The state could not be saved")
+        return numpy.array(state)
+
+    def clone(self):
+        """
+        Creates a new instance of the loaded aircraft without reading the XML
+        files again.
+        @return the new instance
+        """
+        cdef c_FGFDMExec* ptr = self.thisptr.Clone()
+        if ptr is NULL:
+            raise RuntimeError("The FDM could not be cloned")
+        cdef FGFDMExec fdm = FGFDMExec(self.get_root_dir().decode())
+        del fdm.thisptr
+        fdm.thisptr = ptr
+        return fdm
+
+    def restore_state(self, state):
+        """
+        Restores a state saved by save_state() for the same aircraft.
+        @param state the array returned by save_state()
+        @return true if successful
+        """
+        return self.thisptr.RestoreState(state)
+
     def load_model(self, model, add_model_to_path=True):
         """
         Loads an aircraft model.
@@ -0,0 +1,253 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       socket_test_utilities.h
+ Date started: 10/17/26
+ Purpose:      Loopback sockets shared by the tests of the socket outputs and
+               inputs.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+The helpers rely on the BSD sockets API so this header is kept apart from
+test_utilities.h: only the tests of the sockets include it. Each test is built
+from a single source file so the functions are defined inline.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef SOCKET_TEST_UTILITIES_H
+#define SOCKET_TEST_UTILITIES_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+LOOPBACK SOCKETS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Receives the messages of a socket output on the loopback interface.
+    The receiver listens on a free port (see Port) from a thread started by
+    Start(). The TCP stream is received until the output closes the connection,
+    the UDP datagrams until Stop() is called. */
+class LoopbackReceiver
+{
+public:
+  /** Constructor.
+      @param tcp true for a TCP socket, false for an UDP socket.
+      @param bufferSize the size of the receive buffer. */
+  LoopbackReceiver(bool tcp, int bufferSize)
+    : TCP(tcp), Paused(false), Quit(false)
+  {
+    Socket = socket(AF_INET, tcp ? SOCK_STREAM : SOCK_DGRAM, 0);
+    // The size of the receive buffer is inherited by the accepted socket.
+    setsockopt(Socket, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+
+    sockaddr_in addr;
+    socklen_t len = sizeof(addr);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    bind(Socket, (sockaddr*)&addr, sizeof(addr));
+    getsockname(Socket, (sockaddr*)&addr, &len);
+    Port = ntohs(addr.sin_port);
+    if (tcp) listen(Socket, 1);
+  }
+
+  ~LoopbackReceiver() {
+    Stop();
+    close(Socket);
+  }
+
+  /// Starts the thread which receives the data.
+  void Start(void) { Receiver = std::thread(&LoopbackReceiver::Receive, this); }
+  /// Stops or resumes reading the TCP stream.
+  void Pause(bool flag) { Paused = flag; }
+  /// Stops the thread which receives the data.
+  void Stop(void) {
+    Quit = true;
+    if (Receiver.joinable()) Receiver.join();
+  }
+
+  /// The port on which the receiver listens.
+  int Port;
+  /// The data received over TCP.
+  std::vector<char> Stream;
+  /// The datagrams received over UDP.
+  std::vector<std::vector<char> > Datagrams;
+
+private:
+  bool TCP;
+  int Socket;
+  std::atomic<bool> Paused, Quit;
+  std::thread Receiver;
+
+  // Waits up to 10ms for data on a socket.
+  bool WaitFor(int s) {
+    fd_set fds;
+    timeval timeout = {0, 10000};
+    FD_ZERO(&fds);
+    FD_SET(s, &fds);
+    return select(s+1, &fds, 0, 0, &timeout) > 0;
+  }
+
+  void Receive(void) {
+    char buffer[65536];
+
+    if (!TCP) {
+      while (!Quit) {
+        if (!WaitFor(Socket)) continue;
+        ssize_t size = recv(Socket, buffer, sizeof(buffer), 0);
+        if (size > 0)
+          Datagrams.push_back(std::vector<char>(buffer, buffer + size));
+      }
+      return;
+    }
+
+    while (!Quit && !WaitFor(Socket));
+    if (Quit) return;
+    int s = accept(Socket, 0, 0);
+
+    while (true) {
+      if (Paused) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        continue;
+      }
+      if (!WaitFor(s)) {
+        if (Quit) break;
+        continue;
+      }
+      ssize_t size = recv(s, buffer, sizeof(buffer), 0);
+      if (size <= 0) break;
+      Stream.insert(Stream.end(), buffer, buffer + size);
+    }
+
+    close(s);
+  }
+};
+
+
+/// Returns a port of the loopback interface that is not in use.
+inline int FreePort(void)
+{
+  int s = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr;
+  socklen_t len = sizeof(addr);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  bind(s, (sockaddr*)&addr, sizeof(addr));
+  getsockname(s, (sockaddr*)&addr, &len);
+  close(s);
+
+  return ntohs(addr.sin_port);
+}
+
+/** Sends commands to a socket input over a TCP connection on the loopback
+    interface and receives its replies. */
+class LoopbackClient
+{
+public:
+  /** Constructor. Connects to the input: check Connected for the result.
+      @param port the port on which the input listens.
+      @param receiveBuffer the size of the receive buffer of the socket or 0
+                           to keep the default size. */
+  LoopbackClient(int port, int receiveBuffer = 0) {
+    Socket = socket(AF_INET, SOCK_STREAM, 0);
+
+    // A small buffer makes the input fill the connection with large replies.
+    if (receiveBuffer > 0)
+      setsockopt(Socket, SOL_SOCKET, SO_RCVBUF, &receiveBuffer,
+                 sizeof(receiveBuffer));
+
+    // The messages must not be delayed until the previous ones are
+    // acknowledged: the binary input does not reply to the set messages.
+    int flag = 1;
+    setsockopt(Socket, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    Connected = connect(Socket, (sockaddr*)&addr, sizeof(addr)) == 0;
+  }
+
+  ~LoopbackClient() { close(Socket); }
+
+  /// Sends all the data, unless the connection is closed.
+  void Send(const char* data, size_t size) {
+    while (size > 0) {
+      ssize_t sent = send(Socket, data, size, 0);
+      if (sent <= 0) return;
+      data += sent;
+      size -= sent;
+    }
+  }
+  void Send(const std::vector<char>& data) { Send(&data[0], data.size()); }
+  void Send(const std::string& data) { Send(data.data(), data.size()); }
+
+  /// Receives the data available within timeout milliseconds.
+  std::vector<char> Receive(int timeout) {
+    std::vector<char> data;
+    char buffer[4096];
+
+    while (WaitFor(timeout)) {
+      ssize_t size = recv(Socket, buffer, sizeof(buffer), 0);
+      if (size <= 0) break;
+      data.insert(data.end(), buffer, buffer + size);
+      timeout = 0;
+    }
+
+    return data;
+  }
+
+  /// True if the connection has been established.
+  bool Connected;
+
+private:
+  int Socket;
+
+  bool WaitFor(int timeout) {
+    fd_set fds;
+    timeval t = {timeout / 1000, (timeout % 1000) * 1000};
+    FD_ZERO(&fds);
+    FD_SET(Socket, &fds);
+    return select(Socket+1, &fds, 0, 0, &t) > 0;
+  }
+};
+
+#endif
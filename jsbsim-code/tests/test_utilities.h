@@ -0,0 +1,104 @@
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+ Header:       test_utilities.h
+ Date started: 10/17/26
+ Purpose:      Helpers shared by the tests written in C++.
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Lesser General Public License as published by the Free Software
+ Foundation; either version 2 of the License, or (at your option) any later
+ version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ Further information about the GNU Lesser General Public License can also be found on
+ the world wide web at http://www.gnu.org.
+
+FUNCTIONAL DESCRIPTION
+--------------------------------------------------------------------------------
+
+Each test is built from a single source file which includes this header. The
+functions are therefore defined inline.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifndef TEST_UTILITIES_H
+#define TEST_UTILITIES_H
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+INCLUDES
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "FGFDMExec.h"
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+TEST STATUS
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/// Returns the status of the test: false as soon as a check has failed.
+inline bool& TestStatus(void)
+{
+  static bool success = true;
+  return success;
+}
+
+/** Prints a message and marks the test as failed if a condition is false.
+    The test goes on so that all the failures are reported.
+    @param condition the condition to check.
+    @param msg the message printed if the condition is false. */
+inline void Check(bool condition, const std::string& msg)
+{
+  if (!condition) {
+    std::cerr << msg << std::endl;
+    TestStatus() = false;
+  }
+}
+
+/// Returns the exit code of the test: non zero if a check has failed.
+inline int TestResult(void)
+{
+  return TestStatus() ? 0 : 1;
+}
+
+/*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+FDM SETUP
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/** Silences an FDM and points it to the aircraft, engines and systems of the
+    JSBSim root directory.
+    @param fdm the FDM.
+    @param root the JSBSim root directory.
+    @param workDir the root directory of the FDM, from which the directives
+                   are read and to which the output files are written. If it
+                   is null, the JSBSim root directory is used. */
+inline void SetupFDM(JSBSim::FGFDMExec* fdm, const std::string& root,
+                     const SGPath& workDir = SGPath())
+{
+  fdm->SetDebugLevel(0);
+
+  if (workDir.isNull()) {
+    fdm->SetRootDir(SGPath(root));
+    fdm->SetAircraftPath(SGPath("aircraft"));
+    fdm->SetEnginePath(SGPath("engine"));
+    fdm->SetSystemsPath(SGPath("systems"));
+  } else {
+    SGPath rootDir = SGPath::fromLocal8Bit(root.c_str()).realpath();
+    fdm->SetRootDir(workDir);
+    fdm->SetAircraftPath(rootDir/"aircraft");
+    fdm->SetEnginePath(rootDir/"engine");
+    fdm->SetSystemsPath(rootDir/"systems");
+  }
+}
+
+#endif